@@ -0,0 +1,75 @@
+#pragma once
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/vector.h>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace uipc::test
+{
+namespace detail
+{
+    template <typename T>
+    vector<std::byte> to_bytes(const T& value)
+    {
+        vector<std::byte> bytes;
+        // contiguous containers, spans and Eigen dense objects
+        if constexpr(requires { value.data(); value.size(); })
+        {
+            using V = std::remove_cvref_t<decltype(*value.data())>;
+            static_assert(std::is_trivially_copyable_v<V>, "Only trivially copyable values can be compared bitwise");
+            bytes.resize(value.size() * sizeof(V));
+            if(!bytes.empty())
+                std::memcpy(bytes.data(), value.data(), bytes.size());
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be compared bitwise");
+            bytes.resize(sizeof(T));
+            std::memcpy(bytes.data(), &value, sizeof(T));
+        }
+        return bytes;
+    }
+}  // namespace detail
+
+/**
+ * @brief Run `f()` in deterministic mode with each of the thread counts, and check the results are bit-identical.
+ *
+ * `f` returns a trivially copyable value, or a contiguous container (e.g. vector, span, Eigen matrix) of them.
+ * The previous thread count and deterministic mode are restored afterwards.
+ */
+template <typename F>
+bool thread_count_invariant(F&& f, std::initializer_list<SizeT> thread_counts = {1, 2, 3, 8})
+{
+    struct Restore
+    {
+        SizeT thread_count  = parallel_thread_count();
+        bool  deterministic = is_deterministic();
+        ~Restore()
+        {
+            set_parallel_thread_count(thread_count);
+            set_deterministic(deterministic);
+        }
+    } restore;
+
+    set_deterministic(true);
+
+    vector<std::byte> expected;
+    bool              first = true;
+    for(SizeT count : thread_counts)
+    {
+        set_parallel_thread_count(count);
+        auto bytes = detail::to_bytes(f());
+        if(first)
+        {
+            expected = std::move(bytes);
+            first    = false;
+        }
+        else if(bytes != expected)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace uipc::test
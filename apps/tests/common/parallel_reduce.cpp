@@ -0,0 +1,97 @@
+#include <app/test_common.h>
+#include <app/thread_count_invariance.h>
+#include <uipc/common/parallel_reduce.h>
+#include <uipc/common/type_define.h>
+#include <random>
+
+using namespace uipc;
+
+// values spanning many orders of magnitude, so the naive sum depends on the order
+static vector<Float> ill_conditioned_values(SizeT N)
+{
+    std::mt19937_64                       rng{42};
+    std::uniform_real_distribution<Float> mantissa{-1.0, 1.0};
+    std::uniform_int_distribution<int>    exponent{-20, 20};
+
+    vector<Float> values(N);
+    for(auto& v : values)
+        v = std::ldexp(mantissa(rng), exponent(rng));
+    return values;
+}
+
+TEST_CASE("parallel_for", "[parallel]")
+{
+    SizeT          N = 100000;
+    vector<IndexT> visited(N, 0);
+
+    REQUIRE(test::thread_count_invariant(
+        [&]
+        {
+            std::ranges::fill(visited, 0);
+            parallel_for(N, [&](SizeT i) { visited[i] += 1; }, 128);
+            return visited;
+        }));
+
+    REQUIRE(std::ranges::all_of(visited, [](IndexT v) { return v == 1; }));
+}
+
+TEST_CASE("parallel_sum", "[parallel]")
+{
+    auto values = ill_conditioned_values(100000);
+
+    SECTION("deterministic")
+    {
+        REQUIRE(test::thread_count_invariant(
+            [&] {
+                return parallel_sum<Float>(values.size(), [&](SizeT i) { return values[i]; }, 1000);
+            }));
+
+        REQUIRE(test::thread_count_invariant(
+            [&]
+            {
+                return parallel_sum<Vector3>(
+                    values.size(),
+                    [&](SizeT i) { return Vector3{values[i], -values[i], 1.0}; },
+                    1000);
+            }));
+    }
+
+    SECTION("fixed blocks")
+    {
+        // the blocks don't depend on the thread count, even out of deterministic mode
+        SizeT thread_count = parallel_thread_count();
+        set_deterministic(false);
+
+        vector<Float> sums;
+        for(SizeT count : {1, 2, 3, 8})
+        {
+            set_parallel_thread_count(count);
+            sums.push_back(parallel_sum<Float>(values.size(), [&](SizeT i) { return values[i]; }, 1000));
+        }
+        set_parallel_thread_count(thread_count);
+
+        REQUIRE(std::ranges::all_of(sums, [&](Float s) { return s == sums.front(); }));
+    }
+
+    SECTION("accuracy")
+    {
+        // a reference in extended precision
+        long double ref = 0.0L;
+        for(auto v : values)
+            ref += v;
+
+        for(bool deterministic : {true, false})
+        {
+            set_deterministic(deterministic);
+            Float sum = parallel_sum<Float>(values.size(), [&](SizeT i) { return values[i]; });
+            REQUIRE(std::abs(sum - static_cast<Float>(ref)) <= 1e-12 * std::abs(static_cast<Float>(ref)));
+        }
+        set_deterministic(false);
+    }
+
+    SECTION("empty")
+    {
+        REQUIRE(parallel_sum<Float>(0, [](SizeT) { return 1.0; }) == 0.0);
+        REQUIRE(parallel_sum<Vector3>(0, [](SizeT) { return Vector3::Ones(); }).isZero());
+    }
+}
@@ -0,0 +1,185 @@
+#include <app/test_common.h>
+#include <uipc/common/task_scheduler.h>
+#include <uipc/common/parallel_for.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+using namespace uipc;
+
+// run `f` with the scheduler restarted with different thread counts
+template <typename F>
+static void for_each_thread_count(F&& f)
+{
+    auto& scheduler = TaskScheduler::instance();
+    auto  old_count = scheduler.thread_count();
+
+    for(SizeT thread_count : {1, 2, 4})
+    {
+        scheduler.set_thread_count(thread_count);
+        REQUIRE(scheduler.thread_count() == thread_count);
+        f();
+    }
+
+    scheduler.set_thread_count(old_count);
+}
+
+TEST_CASE("task_group", "[parallel]")
+{
+    SECTION("run")
+    {
+        for_each_thread_count(
+            []
+            {
+                std::atomic<SizeT> sum = 0;
+                TaskGroup          group;
+                for(SizeT i = 1; i <= 100; ++i)
+                    group.run([&, i] { sum += i; });
+                group.wait();
+                REQUIRE(sum == 5050);
+            });
+    }
+
+    SECTION("nested")
+    {
+        // tasks waiting for their own tasks, every thread is waiting at some point
+        for_each_thread_count(
+            []
+            {
+                vector<SizeT> rows(64, 0);
+                parallel_for(rows.size(),
+                             [&](SizeT i)
+                             {
+                                 std::atomic<SizeT> row = 0;
+                                 parallel_for(100, [&](SizeT j) { row += j; });
+                                 rows[i] = row;
+                             });
+                REQUIRE(std::ranges::all_of(rows, [](SizeT r) { return r == 4950; }));
+            });
+    }
+
+    SECTION("restart")
+    {
+        // another thread keeps running parallel work while the pool is restarted
+        auto old_count = TaskScheduler::instance().thread_count();
+
+        std::atomic<bool> done    = false;
+        bool              correct = true;
+        std::thread       runner{[&]
+                           {
+                               for(SizeT round = 0; round < 50; ++round)
+                               {
+                                   std::atomic<SizeT> sum = 0;
+                                   parallel_for(1000, [&](SizeT i) { sum += i; });
+                                   correct = correct && sum == 499500;
+                               }
+                               done = true;
+                           }};
+
+        for(SizeT thread_count = 1; !done; thread_count = thread_count % 4 + 1)
+            TaskScheduler::instance().set_thread_count(thread_count);
+
+        runner.join();
+        REQUIRE(correct);
+        TaskScheduler::instance().set_thread_count(old_count);
+    }
+
+    SECTION("exception")
+    {
+        for_each_thread_count(
+            []
+            {
+                std::atomic<SizeT> done = 0;
+                TaskGroup          group;
+                for(SizeT i = 0; i < 16; ++i)
+                    group.run(
+                        [&, i]
+                        {
+                            if(i == 3)
+                                throw Exception{"task 3 failed"};
+                            ++done;
+                        });
+                REQUIRE_THROWS_AS(group.wait(), Exception);
+                // the other tasks still run
+                REQUIRE(done == 15);
+
+                REQUIRE_THROWS_AS(parallel_for(1000,
+                                               [](SizeT i)
+                                               {
+                                                   if(i == 500)
+                                                       throw Exception{"500"};
+                                               }),
+                                  Exception);
+            });
+    }
+}
+
+TEST_CASE("task_graph", "[parallel]")
+{
+    SECTION("order")
+    {
+        // a diamond: a -> {b, c} -> d
+        std::atomic<SizeT> clock = 0;
+        SizeT              a_time, b_time, c_time, d_time;
+
+        TaskGraph graph;
+        auto      a = graph.add([&] { a_time = clock++; });
+        auto      b = graph.add([&] { b_time = clock++; });
+        auto      c = graph.add([&] { c_time = clock++; });
+        auto      d = graph.add([&] { d_time = clock++; });
+        graph.precede(a, b);
+        graph.precede(a, c);
+        graph.precede(b, d);
+        graph.precede(c, d);
+        REQUIRE(graph.size() == 4);
+
+        // runs again from the start
+        for(int run = 0; run < 2; ++run)
+        {
+            clock = 0;
+            graph.run();
+            REQUIRE(a_time == 0);
+            REQUIRE(d_time == 3);
+            REQUIRE(std::min(b_time, c_time) == 1);
+        }
+    }
+
+    SECTION("chain")
+    {
+        vector<SizeT> order;
+        TaskGraph     graph;
+
+        SizeT N = 100;
+        for(SizeT i = 0; i < N; ++i)
+            graph.add([&, i] { order.push_back(i); });
+        for(SizeT i = 1; i < N; ++i)
+            graph.precede(i - 1, i);
+
+        graph.run();
+        vector<SizeT> expected(N);
+        std::iota(expected.begin(), expected.end(), 0);
+        REQUIRE(order == expected);
+    }
+
+    SECTION("exception")
+    {
+        bool      after_run = false;
+        TaskGraph graph;
+        auto      fail  = graph.add([] { throw Exception{"fail"}; });
+        auto      after = graph.add([&] { after_run = true; });
+        graph.precede(fail, after);
+
+        REQUIRE_THROWS_AS(graph.run(), Exception);
+        REQUIRE(!after_run);
+    }
+
+    SECTION("cycle")
+    {
+        TaskGraph graph;
+        auto      a = graph.add([] {});
+        auto      b = graph.add([] {});
+        graph.precede(a, b);
+        graph.precede(b, a);
+        REQUIRE_THROWS_AS(graph.run(), TaskGraphException);
+    }
+}
@@ -0,0 +1,83 @@
+#include <app/test_common.h>
+#include <uipc/common/timer.h>
+#include <thread>
+
+using namespace uipc;
+using namespace std::chrono_literals;
+
+TEST_CASE("frame_timer_stats", "[timer]")
+{
+    GlobalTimer timer{"FrameTimer"};
+    timer.set_as_current();
+    Timer::enable_all();
+
+    timer.set_frame_window(16);
+    timer.set_spike_threshold(2.0, 8);
+
+    SizeT spike_frame = 30;
+    for(SizeT frame = 0; frame < 40; ++frame)
+    {
+        {
+            Timer t{"Frame"};
+            {
+                Timer t{"Step"};
+                std::this_thread::sleep_for(frame == spike_frame ? 20ms : 2ms);
+            }
+            // twice in a frame, summed up into one sample
+            {
+                Timer t{"Sub"};
+            }
+            {
+                Timer t{"Sub"};
+            }
+        }
+        timer.end_frame(frame);
+    }
+
+    Timer::disable_all();
+
+    auto step = timer.frame_stats("/FrameTimer/Frame/Step");
+    REQUIRE(step != nullptr);
+    REQUIRE(timer.frame_stats("/FrameTimer/Frame/Sub") != nullptr);
+    REQUIRE(timer.frame_stats("/FrameTimer/None") == nullptr);
+
+    REQUIRE(step->frame_count() == 40);
+    REQUIRE(step->window().size() == 16);
+    REQUIRE(step->window().front().frame == 24);
+    REQUIRE(step->window().back().frame == 39);
+
+    // the percentiles are ordered, the spike only moves the tail
+    REQUIRE(step->percentile(50) >= 0.002);
+    REQUIRE(step->percentile(50) < 0.02);
+    REQUIRE(step->percentile(50) <= step->percentile(95));
+    REQUIRE(step->percentile(95) <= step->percentile(99));
+    REQUIRE(step->percentile(100) == step->max());
+    REQUIRE(step->histogram_percentile(50) <= step->histogram_percentile(99));
+
+    SizeT histogram_total = 0;
+    for(auto count : step->histogram())
+        histogram_total += count;
+    REQUIRE(histogram_total == 40);
+
+    // the 10x frame is flagged
+    auto spike = std::ranges::find_if(step->window(),
+                                      [&](const FrameTimerStats::Sample& s)
+                                      { return s.frame == spike_frame; });
+    REQUIRE(spike->is_spike);
+    REQUIRE(step->spike_count() >= 1);
+
+    auto j = timer.report_frames_as_json();
+    REQUIRE(j["frame_count"] == 40);
+    REQUIRE(j["timers"].contains("/FrameTimer/Frame/Step"));
+    bool reported = false;
+    for(auto& s : j["spikes"])
+        reported |= s["frame"] == spike_frame && s["timer"] == "/FrameTimer/Frame/Step";
+    REQUIRE(reported);
+
+    timer.clear_frames();
+    REQUIRE(timer.frame_stats("/FrameTimer/Frame/Step") == nullptr);
+
+    // disabled timers don't produce frames
+    timer.end_frame(40);
+    REQUIRE(timer.report_frames_as_json()["frame_count"] == 0);
+}
@@ -0,0 +1,165 @@
+#include <catch.hpp>
+#include <uipc/diff_sim/adjoint_solver.h>
+#include <Eigen/Dense>
+#include <random>
+#include <numeric>
+
+using namespace uipc;
+using namespace uipc::diff_sim;
+
+namespace
+{
+using DenseMatrix = AdjointSolver::DenseMatrix;
+
+// a COO matrix with shuffled and duplicated entries
+class COO
+{
+  public:
+    vector<IndexT> rows;
+    vector<IndexT> cols;
+    vector<Float>  values;
+    Vector2i       shape;
+
+    COO(const DenseMatrix& A, std::mt19937& rng)
+        : shape{A.rows(), A.cols()}
+    {
+        for(IndexT i = 0; i < A.rows(); ++i)
+            for(IndexT j = 0; j < A.cols(); ++j)
+            {
+                if(A(i, j) == 0)
+                    continue;
+                // split each entry in two halves to test the merging
+                rows.insert(rows.end(), {i, i});
+                cols.insert(cols.end(), {j, j});
+                values.insert(values.end(), {A(i, j) * 0.5, A(i, j) * 0.5});
+            }
+
+        vector<SizeT> perm(rows.size());
+        std::iota(perm.begin(), perm.end(), 0);
+        std::ranges::shuffle(perm, rng);
+        auto permute = [&](auto& v)
+        {
+            auto copy = v;
+            for(SizeT k = 0; k < perm.size(); ++k)
+                v[k] = copy[perm[k]];
+        };
+        permute(rows);
+        permute(cols);
+        permute(values);
+    }
+
+    SparseCOOView view() const { return SparseCOOView{rows, cols, values, shape}; }
+};
+
+DenseMatrix random_sparse(IndexT M, IndexT N, Float density, std::mt19937& rng)
+{
+    std::uniform_real_distribution<Float> dist{-1.0, 1.0};
+    DenseMatrix                           A = DenseMatrix::Zero(M, N);
+    for(IndexT i = 0; i < M; ++i)
+        for(IndexT j = 0; j < N; ++j)
+            if(std::abs(dist(rng)) < density)
+                A(i, j) = dist(rng);
+    return A;
+}
+}  // namespace
+
+TEST_CASE("csr_pattern", "[diff_sim]")
+{
+    std::mt19937 rng{42};
+    DenseMatrix  A   = random_sparse(37, 23, 0.2, rng);
+    COO          coo{A, rng};
+
+    REQUIRE(coo.view().to_dense().isApprox(A));
+    REQUIRE(DenseMatrix{coo.view().to_csr()}.isApprox(A));
+    REQUIRE(DenseMatrix{coo.view().to_sparse()}.isApprox(A));
+
+    CSRPattern pattern;
+    pattern.build(coo.view(), true);
+    REQUIRE(pattern.matches(coo.view(), true));
+    REQUIRE(!pattern.matches(coo.view(), false));
+    REQUIRE(DenseMatrix{pattern.to_csr(coo.view())}.isApprox(A.transpose()));
+
+    // same pattern, new values
+    for(auto& v : coo.values)
+        v *= 2;
+    REQUIRE(DenseMatrix{pattern.to_csr(coo.view())}.isApprox(2 * A.transpose()));
+}
+
+TEST_CASE("adjoint_solver", "[diff_sim]")
+{
+    std::mt19937 rng{7};
+
+    constexpr IndexT N = 60;  // dofs
+    constexpr IndexT P = 5;   // parameters
+    constexpr IndexT K = 3;   // losses
+
+    // diagonally dominant, so both factorizations are well defined
+    DenseMatrix B = random_sparse(N, N, 0.1, rng);
+    DenseMatrix H = B + B.transpose() + DenseMatrix::Identity(N, N) * (2.0 * N);
+    DenseMatrix G = random_sparse(N, P, 0.3, rng);
+    DenseMatrix dLdX = DenseMatrix::Random(N, K);
+
+    // dL/dP = - G^T H^-T dL/dX
+    auto expected = [&](const DenseMatrix& H)
+    { return DenseMatrix{-G.transpose() * H.transpose().lu().solve(dLdX)}; };
+
+    COO H_coo{H, rng};
+    COO G_coo{G, rng};
+
+    SECTION("ldlt")
+    {
+        AdjointSolver solver{AdjointSolver::Method::LDLT};
+        solver.factorize(H_coo.view());
+        REQUIRE(solver.solve_dLdP(G_coo.view(), dLdX).isApprox(expected(H)));
+    }
+
+    SECTION("lu")
+    {
+        // a non-symmetric H, like the one of multiple frames
+        DenseMatrix L = H;
+        L.triangularView<Eigen::StrictlyUpper>().setZero();
+        COO L_coo{L, rng};
+
+        AdjointSolver solver;
+        solver.factorize(L_coo.view());
+        REQUIRE(solver.solve_dLdP(G_coo.view(), dLdX).isApprox(expected(L)));
+    }
+
+    SECTION("reuse symbolic")
+    {
+        AdjointSolver solver;
+        solver.factorize(H_coo.view());
+        REQUIRE(solver.analyze_count() == 1);
+
+        // same pattern, new values: only the numeric factorization is redone
+        for(auto& v : H_coo.values)
+            v *= 0.5;
+        solver.factorize(H_coo.view());
+        REQUIRE(solver.analyze_count() == 1);
+        REQUIRE(solver.factorize_count() == 2);
+        REQUIRE(solver.solve_dLdP(G_coo.view(), dLdX).isApprox(expected(H * 0.5)));
+
+        // same structure, different entry order: still reused
+        COO shuffled{H * 0.5, rng};
+        solver.factorize(shuffled.view());
+        REQUIRE(solver.analyze_count() == 1);
+
+        // a new pattern: fill a zero entry
+        DenseMatrix H2 = H;
+        IndexT      j  = 1;
+        while(H2(0, j) != 0)
+            ++j;
+        H2(0, j) = H2(j, 0) = 1.0;
+        COO H2_coo{H2, rng};
+        solver.factorize(H2_coo.view());
+        REQUIRE(solver.analyze_count() == 2);
+        REQUIRE(solver.solve_dLdP(G_coo.view(), dLdX).isApprox(expected(H2)));
+    }
+
+    SECTION("errors")
+    {
+        AdjointSolver solver;
+        REQUIRE_THROWS_AS(solver.solve(dLdX), AdjointSolverError);
+        REQUIRE_THROWS_AS(solver.factorize(G_coo.view()), AdjointSolverError);
+    }
+}
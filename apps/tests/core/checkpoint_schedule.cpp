@@ -0,0 +1,105 @@
+#include <catch.hpp>
+#include <uipc/diff_sim/checkpoint_schedule.h>
+#include <set>
+
+using namespace uipc;
+using namespace uipc::diff_sim;
+
+namespace
+{
+// replay the schedule and check that every frame is reversed once, in order,
+// from a freshly solved state, with only the available checkpoints
+void check_schedule(const CheckpointSchedule& schedule)
+{
+    using Type = CheckpointSchedule::ActionType;
+
+    std::set<SizeT> checkpoints{0};
+    SizeT           current       = 0;
+    SizeT           next_reversed = schedule.frame_count();
+    bool            solved        = false;
+    SizeT           advance_count = 0;
+
+    for(auto&& action : schedule.actions())
+    {
+        switch(action.type)
+        {
+            case Type::Advance:
+                REQUIRE(action.frame == current + 1);
+                current = action.frame;
+                solved  = true;
+                ++advance_count;
+                break;
+            case Type::Dump:
+                REQUIRE(action.frame == current);
+                checkpoints.insert(current);
+                break;
+            case Type::Recover:
+                REQUIRE(checkpoints.contains(action.frame));
+                current = action.frame;
+                solved  = false;
+                break;
+            case Type::Backward:
+                REQUIRE(solved);
+                REQUIRE(action.frame == current);
+                REQUIRE(action.frame == next_reversed);
+                --next_reversed;
+                break;
+            case Type::Drop:
+                REQUIRE(action.frame != 0);
+                REQUIRE(checkpoints.erase(action.frame) == 1);
+                // the frames left to reverse never go back past the dropped checkpoint
+                REQUIRE(next_reversed <= action.frame);
+                break;
+        }
+    }
+
+    REQUIRE(next_reversed == 0);
+    // all the checkpoints are dropped, only the start state is kept
+    REQUIRE(checkpoints == std::set<SizeT>{0});
+    REQUIRE(advance_count == schedule.advance_count());
+    REQUIRE(schedule.peak_checkpoint_count() <= schedule.checkpoint_count());
+}
+}  // namespace
+
+TEST_CASE("checkpoint_schedule", "[diff_sim]")
+{
+    SECTION("valid")
+    {
+        for(SizeT N : {0, 1, 2, 3, 7, 10, 33, 100, 257})
+            for(SizeT C : {0, 1, 2, 3, 5, 16})
+                check_schedule(CheckpointSchedule{N, C});
+    }
+
+    SECTION("no checkpoint")
+    {
+        // recompute from the start for every frame: N + (N-1) + ... + 1
+        CheckpointSchedule schedule{10, 0};
+        REQUIRE(schedule.advance_count() == 55);
+        REQUIRE(schedule.peak_checkpoint_count() == 0);
+    }
+
+    SECTION("enough checkpoints")
+    {
+        // a checkpoint for every frame, each frame but the last is only recomputed
+        // once from its own checkpoint before being reversed
+        CheckpointSchedule schedule{10, 16};
+        REQUIRE(schedule.advance_count() == 2 * 10 - 1);
+    }
+
+    SECTION("trade-off")
+    {
+        // more checkpoints, less recomputation
+        SizeT last = std::numeric_limits<SizeT>::max();
+        for(SizeT C = 0; C <= 8; ++C)
+        {
+            CheckpointSchedule schedule{200, C};
+            REQUIRE(schedule.advance_count() <= last);
+            last = schedule.advance_count();
+        }
+
+        // binomial bound: 4 checkpoints (+ start) reverse C(5 + 3, 5) = 56 frames in 3 sweeps,
+        // plus the recomputation of each frame right before it is reversed
+        CheckpointSchedule schedule{56, 4};
+        REQUIRE(schedule.advance_count() <= (3 + 1) * 56);
+    }
+}
@@ -2,6 +2,8 @@
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
 #include <uipc/constitution/affine_body_constitution.h>
+#include <uipc/constitution/stable_neo_hookean.h>
+#include <uipc/builtin/attribute_name.h>
 
 TEST_CASE("abd", "[constitution]")
 {
@@ -28,3 +30,72 @@ TEST_CASE("abd", "[constitution]")
     // this name is important for the AffineBodyConstitution
     REQUIRE(kappa->name() == "kappa");
 }
+
+TEST_CASE("batch_apply", "[constitution]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::constitution;
+
+    geometry::SimplicialComplexIO io;
+    auto mesh = io.read_msh(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+
+    SECTION("abd")
+    {
+        AffineBodyConstitution abd;
+
+        vector<geometry::SimplicialComplex>  meshes(16, mesh);
+        vector<geometry::SimplicialComplex*> ptrs;
+        for(auto& m : meshes)
+            ptrs.push_back(&m);
+        abd.apply_to(ptrs, 1e8);
+
+        for(auto& m : meshes)
+        {
+            auto kappa = m.instances().find<Float>("kappa");
+            REQUIRE(kappa);
+            REQUIRE(std::ranges::all_of(kappa->view(), [](auto v) { return v == 1e8; }));
+        }
+
+        auto instances = mesh;
+        instances.instances().resize(3);
+        vector<Float> kappas = {1e7, 1e8, 1e9};
+        abd.apply_to(instances, kappas);
+        auto kappa = instances.instances().find<Float>("kappa");
+        REQUIRE(std::ranges::equal(kappa->view(), kappas));
+    }
+
+    SECTION("stable_neo_hookean")
+    {
+        StableNeoHookean snh;
+
+        vector<geometry::SimplicialComplex>  meshes(16, mesh);
+        vector<geometry::SimplicialComplex*> ptrs;
+        for(auto& m : meshes)
+            ptrs.push_back(&m);
+        auto moduli = ElasticModuli::youngs_poisson(1e5, 0.4);
+        snh.apply_to(ptrs, moduli);
+
+        for(auto& m : meshes)
+        {
+            auto mu = m.tetrahedra().find<Float>("mu");
+            REQUIRE(mu);
+            REQUIRE(std::ranges::all_of(mu->view(), [&](auto v) { return v == moduli.mu(); }));
+            REQUIRE(m.vertices().find<Float>(builtin::volume));
+        }
+
+        vector<ElasticModuli> per_tet;
+        for(SizeT i = 0; i < mesh.tetrahedra().size(); ++i)
+            per_tet.push_back(ElasticModuli::youngs_poisson(1e5 * (i + 1), 0.4));
+
+        auto hetero = mesh;
+        snh.apply_to(hetero, per_tet);
+        auto mu     = hetero.tetrahedra().find<Float>("mu")->view();
+        auto lambda = hetero.tetrahedra().find<Float>("lambda")->view();
+        for(SizeT i = 0; i < per_tet.size(); ++i)
+        {
+            REQUIRE(mu[i] == per_tet[i].mu());
+            REQUIRE(lambda[i] == per_tet[i].lambda());
+        }
+    }
+}
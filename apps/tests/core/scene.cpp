@@ -2,6 +2,8 @@
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
 #include <uipc/backend/visitors/scene_visitor.h>
+#include <uipc/constitution/affine_body_constitution.h>
+#include <thread>
 
 
 TEST_CASE("scene", "[scene]")
@@ -267,3 +269,222 @@ TEST_CASE("pending destroy", "[scene]")
         REQUIRE(visitor.pending_rest_geometries().size() == 0);
     }
 }
+
+TEST_CASE("pending change set", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene                 scene;
+    backend::SceneVisitor visitor{scene};
+
+    SimplicialComplexIO io;
+    auto mesh = io.read_msh(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+
+    // geometry ids: 0, 1, 2
+    auto obj_a = scene.objects().create("a");
+    obj_a->geometries().create(mesh);
+    auto obj_b = scene.objects().create("b");
+    obj_b->geometries().create(mesh);
+    auto obj_c = scene.objects().create("c");
+    obj_c->geometries().create(mesh);
+
+    visitor.begin_pending();
+
+    REQUIRE(visitor.pending_change_set().empty());
+
+    // destroy geometry 1, create geometry 3
+    scene.objects().destroy(obj_b->id());
+    auto obj_d = scene.objects().create("d");
+    obj_d->geometries().create(mesh);
+
+    auto change_set = visitor.pending_change_set();
+    REQUIRE(!change_set.empty());
+    REQUIRE(change_set.old_size() == 3);
+    REQUIRE(change_set.new_size() == 3);
+
+    REQUIRE(change_set.created_ids().size() == 1);
+    REQUIRE(change_set.created_ids()[0] == 3);
+    REQUIRE(change_set.created_slots()[0] == 2);
+
+    REQUIRE(change_set.destroyed_ids().size() == 1);
+    REQUIRE(change_set.destroyed_ids()[0] == 1);
+
+    // old slots [0, 1, 2] -> new slots [0, -1, 1]
+    auto remap = change_set.slot_remap();
+    REQUIRE(remap[0] == 0);
+    REQUIRE(remap[1] == -1);
+    REQUIRE(remap[2] == 1);
+
+    visitor.solve_pending();
+
+    auto& last = visitor.last_change_set();
+    REQUIRE(std::ranges::equal(last.slot_remap(), remap));
+    REQUIRE(visitor.geometries().size() == 3);
+    REQUIRE(visitor.geometries()[change_set.created_slots()[0]]->id() == 3);
+
+    // nothing pending after solving
+    REQUIRE(visitor.pending_change_set().empty());
+}
+
+TEST_CASE("indexed queries", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+    using namespace uipc::constitution;
+
+    Scene                 scene;
+    backend::SceneVisitor visitor{scene};
+
+    AffineBodyConstitution abd;
+    auto                   mesh = tetmesh(vector<Vector3>{Vector3{0, 0, 0},
+                                                          Vector3{1, 0, 0},
+                                                          Vector3{0, 1, 0},
+                                                          Vector3{0, 0, 1}},
+                                          vector<Vector4i>{Vector4i{0, 1, 2, 3}});
+    auto                   abd_mesh = mesh;
+    abd.apply_to(abd_mesh, 1e8);
+
+    auto a = scene.objects().create("body");
+    auto b = scene.objects().create("body");
+    auto c = scene.objects().create("other");
+    a->geometries().create(abd_mesh);
+    b->geometries().create(mesh);
+    c->geometries().create(abd_mesh);
+
+    // name index
+    REQUIRE(std::ranges::equal(scene.objects().find_ids("body"), vector<IndexT>{0, 1}));
+    REQUIRE(scene.objects().find_ids("missing").empty());
+    REQUIRE(scene.objects().find("body").size() == 2);
+
+    // tag index follows retagging
+    a->tag("driver");
+    c->tag("driver");
+    REQUIRE(std::ranges::equal(scene.objects().find_ids_by_tag("driver"), vector<IndexT>{0, 2}));
+    c->tag("sensor");
+    REQUIRE(std::ranges::equal(scene.objects().find_ids_by_tag("driver"), vector<IndexT>{0}));
+    REQUIRE(std::ranges::equal(scene.objects().find_ids_by_tag("sensor"), vector<IndexT>{2}));
+
+    // constitution index
+    auto uid = abd.uid();
+    REQUIRE(std::ranges::equal(scene.geometries().find_ids_by_constitution(uid),
+                               vector<IndexT>{0, 2}));
+
+    // pending geometries join the index when they are solved
+    visitor.begin_pending();
+    auto d = scene.objects().create("body");
+    d->geometries().create(abd_mesh);
+    REQUIRE(scene.geometries().find_ids_by_constitution(uid).size() == 2);
+    scene.objects().destroy(a->id());
+    visitor.solve_pending();
+
+    REQUIRE(std::ranges::equal(scene.geometries().find_ids_by_constitution(uid),
+                               vector<IndexT>{2, 3}));
+    REQUIRE(std::ranges::equal(scene.objects().find_ids("body"), vector<IndexT>{1, 3}));
+    REQUIRE(scene.objects().find_ids_by_tag("driver").empty());
+
+    // a constitution applied after the geometry entered the scene
+    auto& b_mesh = *scene.geometries().find(1).geometry->geometry().as<SimplicialComplex>();
+    abd.apply_to(b_mesh, 1e8);
+    REQUIRE(std::ranges::equal(scene.geometries().find_ids_by_constitution(uid),
+                               vector<IndexT>{2, 3}));
+    scene.geometries().update_constitution_index(1);
+    REQUIRE(std::ranges::equal(scene.geometries().find_ids_by_constitution(uid),
+                               vector<IndexT>{1, 2, 3}));
+
+    // and a removed one
+    auto& c_mesh = *scene.geometries().find(2).geometry->geometry().as<SimplicialComplex>();
+    c_mesh.meta().destroy(builtin::constitution_uid);
+    scene.geometries().update_constitution_index(2);
+    REQUIRE(std::ranges::equal(scene.geometries().find_ids_by_constitution(uid),
+                               vector<IndexT>{1, 3}));
+}
+
+TEST_CASE("memory report", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+
+    vector<Vector4i> Ts = {Vector4i{0, 1, 2, 3}};
+    vector<Vector3>  Vs = {Vector3{0, 0, 0},
+                           Vector3{1, 0, 0},
+                           Vector3{0, 1, 0},
+                           Vector3{0, 0, 1}};
+
+    auto mesh = tetmesh(Vs, Ts);
+    auto obj  = scene.objects().create("obj");
+    // both geometries share the attributes of the mesh
+    obj->geometries().create(mesh);
+    obj->geometries().create(mesh);
+
+    auto report = scene.memory_report();
+
+    REQUIRE(report["objects"].size() == 1);
+    REQUIRE(report["geometries"].size() == 2);
+    REQUIRE(report["rest_geometries"].size() == 2);
+
+    SizeT sum             = report["contact_tabular"]["bytes"].get<SizeT>();
+    SizeT uncounted_bytes = 0;
+    for(auto& key : {"geometries", "rest_geometries"})
+    {
+        for(auto& geo : report[key])
+        {
+            sum += geo["bytes"].get<SizeT>();
+            for(auto& [name, ac] : geo["attribute_collections"].items())
+                for(auto& [attr_name, attr] : ac["attributes"].items())
+                    if(!attr["counted"].get<bool>())
+                        uncounted_bytes += attr["bytes"].get<SizeT>();
+        }
+    }
+
+    REQUIRE(report["total_bytes"].get<SizeT>() == sum);
+    REQUIRE(report["total_bytes"].get<SizeT>() > 0);
+    // the shared positions are counted only once
+    REQUIRE(uncounted_bytes > 0);
+    REQUIRE(report["objects"][0]["bytes"].get<SizeT>() + report["contact_tabular"]["bytes"].get<SizeT>()
+            == sum);
+}
+
+
+TEST_CASE("scene lock", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+
+    vector<Vector4i> Ts = {Vector4i{0, 1, 2, 3}};
+    vector<Vector3>  Vs = {Vector3{0, 0, 0},
+                           Vector3{1, 0, 0},
+                           Vector3{0, 1, 0},
+                           Vector3{0, 0, 1}};
+
+    auto mesh = tetmesh(Vs, Ts);
+    auto obj  = scene.objects().create("obj");
+
+    backend::SceneVisitor visitor{scene};
+
+    // the locking thread can still change the scene
+    std::thread{[&]
+                {
+                    visitor.lock();
+                    obj->geometries().create(mesh);
+                }}
+        .join();
+
+    REQUIRE_THROWS_AS(scene.objects().create("other"), SceneException);
+    REQUIRE_THROWS_AS(scene.objects().destroy(obj->id()), SceneException);
+    REQUIRE_THROWS_AS(obj->geometries().create(mesh), SceneException);
+    REQUIRE_THROWS_AS(obj->tag("locked"), SceneException);
+    REQUIRE(obj->geometries().ids().size() == 1);
+
+    visitor.unlock();
+    obj->geometries().create(mesh);
+    REQUIRE(obj->geometries().ids().size() == 2);
+}
@@ -1,6 +1,7 @@
 #include <app/test_common.h>
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
+#include <fstream>
 
 TEST_CASE("scene_io", "[scene]")
 {
@@ -58,3 +59,137 @@ TEST_CASE("scene_io", "[scene]")
     auto objects_find = scene_loaded->objects().find("objects");
     REQUIRE(objects_find.size() == 1);
 }
+
+TEST_CASE("scene_io_surface_cache", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+    auto  object = scene.objects().create("objects");
+
+    SimplicialComplexIO io;
+    auto cube_mesh = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    label_surface(cube_mesh);
+    label_triangle_orient(cube_mesh);
+    cube_mesh.instances().resize(3);
+
+    auto [geo_slot, rest_geo_slot] = object->geometries().create(cube_mesh);
+
+    SceneIO scene_io{scene};
+
+    auto surface         = extract_surface(cube_mesh);
+    auto surf_vert_count = surface.vertices().size();
+    auto surf_face_count = surface.triangles().size();
+
+    auto first = scene_io.simplicial_surface();
+    REQUIRE(first.vertices().size() == 3 * surf_vert_count);
+    REQUIRE(first.triangles().size() == 3 * surf_face_count);
+
+    // move the mesh, the cached surface must see the new positions
+    auto pos_view = view(geo_slot->geometry().positions());
+    for(auto& p : pos_view)
+        p += Vector3::UnitX();
+
+    auto second = scene_io.simplicial_surface();
+    REQUIRE(second.vertices().size() == first.vertices().size());
+    auto first_pos  = first.positions().view();
+    auto second_pos = second.positions().view();
+    for(SizeT i = 0; i < first_pos.size(); ++i)
+        REQUIRE((second_pos[i] - first_pos[i] - Vector3::UnitX()).norm() < 1e-12);
+
+    // the streamed .obj has the same vertices and faces as the merged surface
+    auto obj_path = fmt::format("{}scene_cache.obj", AssetDir::output_path(__FILE__));
+    scene_io.write_surface(obj_path);
+
+    std::ifstream file(obj_path);
+    std::string   line;
+    SizeT         v_count = 0;
+    SizeT         f_count = 0;
+    while(std::getline(file, line))
+    {
+        if(line.starts_with("v "))
+            ++v_count;
+        else if(line.starts_with("f "))
+            ++f_count;
+    }
+    REQUIRE(v_count == second.vertices().size());
+    REQUIRE(f_count == second.triangles().size());
+
+    // edit the `is_surf` labels, the second time in place (the buffer is already owned)
+    auto& tris = geo_slot->geometry().triangles();
+    std::ranges::fill(view(*tris.find<IndexT>(builtin::is_surf)), 0);
+    REQUIRE(scene_io.simplicial_surface().triangles().size() == 0);
+
+    std::ranges::fill(view(*tris.find<IndexT>(builtin::is_surf)), 1);
+    REQUIRE(scene_io.simplicial_surface().triangles().size() == 3 * tris.size());
+}
+
+TEST_CASE("scene_io_chunked", "[scene]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+
+    Scene scene;
+
+    vector<Vector4i> Ts = {Vector4i{0, 1, 2, 3}};
+    vector<Vector3>  Vs = {Vector3{0, 0, 0},
+                           Vector3{1, 0, 0},
+                           Vector3{0, 1, 0},
+                           Vector3{0, 0, 1}};
+    auto mesh = tetmesh(Vs, Ts);
+    label_surface(mesh);
+
+    auto a = scene.objects().create("a");
+    auto b = scene.objects().create("b");
+    auto c = scene.objects().create("c");
+    a->geometries().create(mesh);
+    b->geometries().create(mesh);
+    b->geometries().create(mesh);
+    c->geometries().create(mesh);
+
+    auto path = fmt::format("{}scene.uipcs", AssetDir::output_path(__FILE__));
+    SceneIO::save(scene, path);
+
+    SECTION("all")
+    {
+        auto loaded = SceneIO::load(path);
+        REQUIRE(loaded->objects().size() == 3);
+        REQUIRE(loaded->geometries().find(2).geometry);
+        REQUIRE(loaded->geometries().find(2).rest_geometry);
+        auto objects = loaded->objects().find("b");
+        REQUIRE(objects.size() == 1);
+        REQUIRE(objects[0]->geometries().ids().size() == 2);
+    }
+
+    SECTION("subset")
+    {
+        SceneIO::LoadOptions options;
+        options.object_names = {"b"};
+        options.object_ids   = {c->id()};
+        options.max_workers  = 1;
+
+        auto loaded = SceneIO::load(path, options);
+        REQUIRE(loaded->objects().size() == 2);
+        REQUIRE(!loaded->objects().find(a->id()));
+        REQUIRE(loaded->objects().find(b->id()));
+        REQUIRE(loaded->objects().find(c->id()));
+        // the geometry of `a` is not loaded
+        REQUIRE(!loaded->geometries().find(0).geometry);
+
+        auto sc = loaded->geometries().find(1).geometry->geometry().as<SimplicialComplex>();
+        REQUIRE(sc->vertices().size() == 4);
+        REQUIRE(sc->tetrahedra().size() == 1);
+    }
+
+    SECTION("subset needs chunked file")
+    {
+        auto json_path = fmt::format("{}scene_chunked.json", AssetDir::output_path(__FILE__));
+        SceneIO::save(scene, json_path);
+        SceneIO::LoadOptions options;
+        options.object_ids = {0};
+        REQUIRE_THROWS_AS(SceneIO::load(json_path, options), SceneIOError);
+    }
+}
@@ -132,6 +132,40 @@ TEST_CASE("create_delete_share_attribute", "[simplicial_complex]")
     REQUIRE_THROWS_AS(VA.share("velocity", point_cloud.positions()), GeometryAttributeError);
 }
 
+TEST_CASE("attribute_key", "[simplicial_complex]")
+{
+    auto mesh = create_tetrahedron();
+    auto VA   = mesh.vertices();
+
+    // builtin keys are interned at compile time
+    REQUIRE(AttributeKey{builtin::position} == builtin::key::position);
+    REQUIRE(builtin::key::position.name() == builtin::position);
+    REQUIRE(VA.find<Vector3>(builtin::key::position) == VA.find<Vector3>(builtin::position));
+
+    // runtime keys are interned on construction
+    AttributeKey stiffness{"stiffness"};
+    REQUIRE(AttributeKey{"stiffness"}.id() == stiffness.id());
+    REQUIRE(!VA.find<Float>(stiffness));
+
+    auto slot = VA.create<Float>("stiffness", 1.0);
+    REQUIRE(VA.find<Float>(stiffness) == slot);
+
+    // the key index follows copies and destruction
+    auto copy = mesh;
+    REQUIRE(copy.vertices().find<Float>(stiffness));
+
+    VA.destroy("stiffness");
+    REQUIRE(!VA.find<Float>(stiffness));
+    REQUIRE(copy.vertices().find<Float>(stiffness));
+    REQUIRE(VA.find<Vector3>(builtin::key::position));
+
+    // looking up by name never interns it
+    auto interned = AttributeKey::interned_count();
+    REQUIRE(!VA.find<Float>("never_created"));
+    VA.destroy("never_created");
+    REQUIRE(AttributeKey::interned_count() == interned);
+}
+
 TEST_CASE("const_attribute", "[simplicial_complex]")
 {
     auto mesh = create_tetrahedron();
@@ -0,0 +1,129 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/core/telemetry.h>
+#include <fstream>
+
+using namespace uipc;
+using namespace uipc::core;
+
+static FrameTelemetry make_record(SizeT frame)
+{
+    FrameTelemetry r;
+    r.frame                    = frame;
+    r.dt                       = 0.01;
+    r.substep_count            = 2;
+    r.substep_dts              = {0.004, 0.006};
+    r.newton_iterations        = 3 + frame;
+    r.linear_solver_iterations = {10, 20, 30};
+    r.line_search_steps        = frame;
+    r.min_ccd_alpha            = 0.5;
+    r.contact_candidates["PT"] = 100 * frame;
+    if(frame % 2)
+        r.energies["ABD"] = 1.5;
+    return r;
+}
+
+static vector<std::string> read_lines(std::string_view file)
+{
+    std::ifstream       ifs{std::string{file}};
+    vector<std::string> lines;
+    std::string         line;
+    while(std::getline(ifs, line))
+        lines.push_back(line);
+    return lines;
+}
+
+TEST_CASE("telemetry_stream", "[telemetry]")
+{
+    SECTION("ring")
+    {
+        TelemetryStream stream{4};
+        REQUIRE(stream.capacity() == 4);
+        REQUIRE(stream.size() == 0);
+        REQUIRE(!stream.pop());
+
+        for(SizeT i = 0; i < 6; ++i)
+            stream.push(make_record(i));
+
+        // full, the newest records are dropped
+        REQUIRE(stream.size() == 4);
+        REQUIRE(stream.dropped_count() == 2);
+
+        auto first = stream.pop();
+        REQUIRE(first);
+        REQUIRE(first->frame == 0);
+
+        auto rest = stream.pop_all();
+        REQUIRE(rest.size() == 3);
+        for(SizeT i = 0; i < rest.size(); ++i)
+            REQUIRE(rest[i].frame == i + 1);
+        REQUIRE(stream.size() == 0);
+
+        // wraps around
+        for(SizeT i = 0; i < 3; ++i)
+            REQUIRE(stream.push(make_record(10 + i)));
+        REQUIRE(stream.pop_all().back().frame == 12);
+    }
+
+    SECTION("disable")
+    {
+        TelemetryStream stream{4};
+        stream.enable(false);
+        REQUIRE(!stream.push(make_record(0)));
+        REQUIRE(stream.size() == 0);
+        REQUIRE(stream.dropped_count() == 0);
+
+        stream.enable(true);
+        REQUIRE(stream.push(make_record(0)));
+    }
+
+    SECTION("export")
+    {
+        auto this_output_path = AssetDir::output_path(__FILE__);
+
+        vector<FrameTelemetry> records;
+        for(SizeT i = 0; i < 3; ++i)
+            records.push_back(make_record(i));
+
+        auto csv = fmt::format("{}telemetry.csv", this_output_path);
+        TelemetryStream::write_csv(csv, records);
+        auto csv_lines = read_lines(csv);
+        REQUIRE(csv_lines.size() == 4);
+        REQUIRE(csv_lines[0].find("contact/PT") != std::string::npos);
+        REQUIRE(csv_lines[0].find("energy/ABD") != std::string::npos);
+        REQUIRE(csv_lines[1].starts_with("0,0.01,2,0.004,"));
+        // frame 0 doesn't have the energy, the column is left empty
+        REQUIRE(csv_lines[1].back() == ',');
+
+        auto jsonl = fmt::format("{}telemetry.jsonl", this_output_path);
+        TelemetryStream::write_json_lines(jsonl, records);
+        auto json_lines = read_lines(jsonl);
+        REQUIRE(json_lines.size() == 3);
+        for(SizeT i = 0; i < json_lines.size(); ++i)
+        {
+            auto j = Json::parse(json_lines[i]);
+            REQUIRE(j["frame"] == i);
+            REQUIRE(j["linear_solver_iterations"].size() == 3);
+            REQUIRE(j["substep_dts"].size() == 2);
+            REQUIRE(j["contact_candidates"]["PT"] == 100 * i);
+        }
+    }
+}
+
+TEST_CASE("engine_telemetry", "[telemetry]")
+{
+    auto this_output_path = AssetDir::output_path(__FILE__);
+
+    Engine engine{"none", this_output_path};
+    World  world{engine};
+    Scene  scene;
+    world.init(scene);
+
+    for(SizeT i = 0; i < 3; ++i)
+        world.advance();
+
+    auto records = engine.telemetry().pop_all();
+    REQUIRE(records.size() == 3);
+    REQUIRE(records.back().frame == world.frame());
+}
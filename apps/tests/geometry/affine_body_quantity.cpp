@@ -4,6 +4,7 @@
 #include <uipc/geometry/utils/compute_vertex_volume.h>
 #include <uipc/geometry/utils/affine_body/compute_dyadic_mass.h>
 #include <uipc/geometry/utils/affine_body/compute_body_force.h>
+#include <uipc/geometry/utils/affine_body/compute_mass_properties.h>
 #include <iostream>
 
 static constexpr bool DebugPrint = false;
@@ -91,3 +92,103 @@ TEST_CASE("affine_body_quantity", "[abd]")
     affine_body_quantity_test("link");
     affine_body_quantity_test("bunny0");
 }
+
+TEST_CASE("affine_body_mass_properties_batch", "[abd]")
+{
+    using namespace uipc;
+    using namespace uipc::geometry;
+
+    SimplicialComplexIO io;
+
+    vector<SimplicialComplex> meshes;
+    for(auto msh : {"tet", "cube", "ball", "link", "bunny0"})
+        meshes.push_back(io.read(fmt::format("{}{}.msh", AssetDir::tetmesh_path(), msh)));
+
+    // a closed trimesh body
+    label_surface(meshes[1]);
+    label_triangle_orient(meshes[1]);
+    meshes.push_back(extract_surface(meshes[1]));
+
+    // many instanced bodies: every mesh appears several times
+    vector<const SimplicialComplex*> bodies;
+    for(SizeT i = 0; i < 100; ++i)
+        bodies.push_back(&meshes[i % meshes.size()]);
+
+    affine_body::MassPropertiesCache cache;
+    auto props = affine_body::compute_mass_properties(bodies, &cache);
+    REQUIRE(props.size() == bodies.size());
+    REQUIRE(cache.size() == meshes.size());
+    REQUIRE(cache.miss_count() == meshes.size());
+    REQUIRE(cache.hit_count() == bodies.size() - meshes.size());
+
+    Float    rho           = 1000.0;
+    Vector3  force_density = rho * Vector3{0, -9.8, 0};
+    for(auto&& [i, body] : enumerate(bodies))
+    {
+        Float     m, batch_m;
+        Vector3   m_x_bar, batch_m_x_bar;
+        Matrix3x3 m_x_bar_x_bar, batch_m_x_bar_x_bar;
+
+        affine_body::compute_dyadic_mass(*body, rho, m, m_x_bar, m_x_bar_x_bar);
+        props[i].dyadic_mass(rho, batch_m, batch_m_x_bar, batch_m_x_bar_x_bar);
+
+        // same blocks, same order: bitwise identical
+        REQUIRE(m == batch_m);
+        REQUIRE(m_x_bar == batch_m_x_bar);
+        REQUIRE(m_x_bar_x_bar == batch_m_x_bar_x_bar);
+        REQUIRE(affine_body::compute_body_force(*body, force_density)
+                == props[i].body_force(force_density));
+    }
+
+    // the second call is served by the cache
+    auto cached_props = affine_body::compute_mass_properties(bodies, &cache);
+    REQUIRE(cache.miss_count() == meshes.size());
+    for(auto&& [i, p] : enumerate(cached_props))
+        REQUIRE(p.second_moment == props[i].second_moment);
+
+    // a moved copy has other content
+    SimplicialComplex moved = meshes[2];
+    auto              Ps    = view(moved.positions());
+    for(auto& P : Ps)
+        P += Vector3{1, 2, 3};
+
+    const SimplicialComplex* moved_body[] = {&moved};
+    auto moved_props = affine_body::compute_mass_properties(moved_body, &cache);
+    REQUIRE(cache.size() == meshes.size() + 1);
+    REQUIRE(moved_props[0].volume == Catch::Approx(props[2].volume));
+    REQUIRE(moved_props[0].first_moment.isApprox(
+        props[2].first_moment + props[2].volume * Vector3{1, 2, 3}, 1e-8));
+}
+
+TEST_CASE("affine_body_mass_properties_cache_key", "[abd]")
+{
+    using namespace uipc;
+    using namespace uipc::geometry;
+
+    SimplicialComplexIO io;
+    auto path = fmt::format("{}cube.msh", AssetDir::tetmesh_path());
+
+    affine_body::MassPropertiesCache cache;
+
+    // two separately loaded meshes share no buffer, but have the same content
+    SimplicialComplex a = io.read(path);
+    SimplicialComplex b = io.read(path);
+
+    const SimplicialComplex* bodies[] = {&a, &b};
+    auto props = affine_body::compute_mass_properties(bodies, &cache);
+    REQUIRE(cache.miss_count() == 1);
+    REQUIRE(cache.hit_count() == 1);
+    REQUIRE(props[0].second_moment == props[1].second_moment);
+
+    // editing a non-shared mesh in place keeps its buffers, but changes the content
+    REQUIRE(!a.positions().is_shared());
+    auto Ps = view(a.positions());
+    for(auto& P : Ps)
+        P *= 2.0;
+
+    const SimplicialComplex* edited[] = {&a};
+    auto edited_props = affine_body::compute_mass_properties(edited, &cache);
+    REQUIRE(cache.miss_count() == 2);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(edited_props[0].volume == Catch::Approx(8.0 * props[0].volume));
+}
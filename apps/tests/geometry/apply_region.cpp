@@ -108,3 +108,52 @@ TEST_CASE("apply_region", "[connected_components]")
         io.write(fmt::format("{}apart_mesh_1.obj", output_path), apart_meshes[1]);
     }
 }
+
+TEST_CASE("apply_region_many_regions", "[connected_components]")
+{
+    // N disjoint tetrahedra, the vertices of the k-th tet are (k, N+k, 2N+k, 3N+k),
+    // so the union-find has to merge vertices far from each other
+    constexpr IndexT N = 10000;
+
+    vector<Vector3>  Vs(4 * N);
+    vector<Vector4i> Ts(N);
+    for(IndexT k = 0; k < N; ++k)
+    {
+        Ts[k] = Vector4i{k, N + k, 2 * N + k, 3 * N + k};
+        Vector3 offset{2.0 * k, 0, 0};
+        Vs[Ts[k][0]] = offset + Vector3{0, 0, 0};
+        Vs[Ts[k][1]] = offset + Vector3{1, 0, 0};
+        Vs[Ts[k][2]] = offset + Vector3{0, 1, 0};
+        Vs[Ts[k][3]] = offset + Vector3{0, 0, 1};
+    }
+
+    auto mesh = tetmesh(Vs, Ts);
+    label_region(mesh);
+
+    REQUIRE(mesh.meta().find<IndexT>("region_count")->view()[0] == N);
+
+    // regions are numbered in the order of their smallest vertex
+    auto vert_region_view = mesh.vertices().find<IndexT>("region")->view();
+    for(auto&& [i, r] : enumerate(vert_region_view))
+        REQUIRE(r == static_cast<IndexT>(i) % N);
+
+    auto tet_region_view = mesh.tetrahedra().find<IndexT>("region")->view();
+    for(auto&& [i, r] : enumerate(tet_region_view))
+        REQUIRE(r == static_cast<IndexT>(i));
+
+    auto apart_meshes = apply_region(mesh);
+    REQUIRE(apart_meshes.size() == N);
+
+    for(auto&& [k, apart_mesh] : enumerate(apart_meshes))
+    {
+        REQUIRE(apart_mesh.vertices().size() == 4);
+        REQUIRE(apart_mesh.edges().size() == 6);
+        REQUIRE(apart_mesh.triangles().size() == 4);
+        REQUIRE(apart_mesh.tetrahedra().size() == 1);
+        REQUIRE(apart_mesh.tetrahedra().topo().view()[0] == Vector4i{0, 1, 2, 3});
+
+        auto Ps = apart_mesh.positions().view();
+        for(IndexT i = 0; i < 4; ++i)
+            REQUIRE(Ps[i] == Vs[Ts[k][i]]);
+    }
+}
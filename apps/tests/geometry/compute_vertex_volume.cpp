@@ -0,0 +1,111 @@
+#include <app/test_common.h>
+#include <app/asset_dir.h>
+#include <app/thread_count_invariance.h>
+#include <uipc/uipc.h>
+#include <uipc/geometry/utils/compute_vertex_volume.h>
+#include <uipc/geometry/utils/affine_body/compute_mass_properties.h>
+#include <numeric>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+// the straightforward serial scatter, in the simplex order
+template <typename F>
+static vector<Float> reference_vertex_volume(SizeT vert_count, span<const Vector4i> Ts, F&& tet_volume)
+{
+    vector<Float> volumes(vert_count, 0.0);
+    for(auto&& [i, t] : enumerate(Ts))
+        for(auto v : t)
+            volumes[v] += tet_volume(t) / 4.0;
+    return volumes;
+}
+
+TEST_CASE("compute_vertex_volume", "[volume]")
+{
+    SimplicialComplexIO io;
+
+    SECTION("tetmesh")
+    {
+        auto tet_ball = io.read(fmt::format("{}ball.msh", AssetDir::tetmesh_path()));
+
+        auto Vs = tet_ball.positions().view();
+        auto Ts = tet_ball.tetrahedra().topo().view();
+
+        auto volume      = compute_vertex_volume(tet_ball);
+        auto volume_view = volume->view();
+
+        auto ref = reference_vertex_volume(Vs.size(),
+                                           Ts,
+                                           [&](const Vector4i& t)
+                                           {
+                                               Matrix3x3 A;
+                                               A.col(0) = Vs[t[1]] - Vs[t[0]];
+                                               A.col(1) = Vs[t[2]] - Vs[t[0]];
+                                               A.col(2) = Vs[t[3]] - Vs[t[0]];
+                                               return A.determinant() / 6.0;
+                                           });
+
+        for(auto&& [i, V] : enumerate(volume_view))
+            REQUIRE(V == Catch::Approx(ref[i]).epsilon(1e-12));
+
+        // the volume is conserved
+        Float total = std::accumulate(volume_view.begin(), volume_view.end(), 0.0);
+        Float inst_volume = compute_instance_volume(tet_ball)->view()[0];
+        REQUIRE(total == Catch::Approx(inst_volume).epsilon(1e-10));
+
+        // computing again gives exactly the same values
+        vector<Float> first(volume_view.begin(), volume_view.end());
+        auto          again = compute_vertex_volume(tet_ball)->view();
+        REQUIRE(std::ranges::equal(first, again));
+    }
+
+    SECTION("trimesh")
+    {
+        auto cube = io.read(fmt::format("{}cube.obj", AssetDir::trimesh_path()));
+
+        auto  volume_view = compute_vertex_volume(cube)->view();
+        Float total = std::accumulate(volume_view.begin(), volume_view.end(), 0.0);
+        // the surface area of a unit cube
+        REQUIRE(total == Catch::Approx(6.0));
+    }
+
+    SECTION("linemesh")
+    {
+        vector<Vector3>  Vs = {Vector3{0, 0, 0}, Vector3{1, 0, 0}, Vector3{1, 2, 0}};
+        vector<Vector2i> Es = {Vector2i{0, 1}, Vector2i{1, 2}};
+        auto             mesh        = linemesh(Vs, Es);
+        auto             volume_view = compute_vertex_volume(mesh)->view();
+
+        REQUIRE(volume_view[0] == Catch::Approx(0.5));
+        REQUIRE(volume_view[1] == Catch::Approx(1.5));
+        REQUIRE(volume_view[2] == Catch::Approx(1.0));
+    }
+}
+
+TEST_CASE("volume_thread_count_invariance", "[volume]")
+{
+    SimplicialComplexIO io;
+    auto tet_ball = io.read(fmt::format("{}ball.msh", AssetDir::tetmesh_path()));
+
+    REQUIRE(test::thread_count_invariant(
+        [&]
+        {
+            auto view = compute_vertex_volume(tet_ball)->view();
+            return vector<Float>(view.begin(), view.end());
+        }));
+
+    REQUIRE(test::thread_count_invariant([&]
+                                         { return compute_instance_volume(tet_ball)->view()[0]; }));
+
+    REQUIRE(test::thread_count_invariant(
+        [&]
+        {
+            auto props = affine_body::compute_mass_properties(tet_ball);
+            vector<Float> values{props.volume};
+            auto&         M1 = props.first_moment;
+            auto&         M2 = props.second_moment;
+            values.insert(values.end(), M1.data(), M1.data() + M1.size());
+            values.insert(values.end(), M2.data(), M2.data() + M2.size());
+            return values;
+        }));
+}
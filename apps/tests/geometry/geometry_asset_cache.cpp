@@ -0,0 +1,105 @@
+#include <catch.hpp>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/io/geometry_asset_cache.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+TEST_CASE("geometry_asset_cache", "[io]")
+{
+    auto output_path = AssetDir::output_path(__FILE__);
+    auto cache_dir   = fmt::format("{}asset_cache/", output_path);
+    auto source      = fmt::format("{}cube.obj", AssetDir::trimesh_path());
+
+    GeometryAssetCache cache{cache_dir};
+    cache.clear();
+
+    Json params              = Json::object();
+    params["tetrahedralize"] = Json::object();
+
+    SizeT process_count = 0;
+    auto  process       = [&](const SimplicialComplex& input, const Json& params)
+    {
+        ++process_count;
+        auto tet = tetrahedralize(input, params["tetrahedralize"]);
+        label_surface(tet);
+        return tet;
+    };
+
+    REQUIRE(!cache.contains(source, params));
+
+    auto first = cache.read(source, params, process);
+    REQUIRE(process_count == 1);
+    REQUIRE(cache.miss_count() == 1);
+    REQUIRE(cache.contains(source, params));
+
+    SECTION("hit")
+    {
+        auto second = cache.read(source, params, process);
+        REQUIRE(process_count == 1);
+        REQUIRE(cache.hit_count() == 1);
+        REQUIRE(second.to_json() == first.to_json());
+
+        // a new cache object (i.e. a new run) reuses the entry on disk
+        GeometryAssetCache other{cache_dir};
+        auto               third = other.read(source, params, process);
+        REQUIRE(process_count == 1);
+        REQUIRE(other.hit_count() == 1);
+        REQUIRE(third.to_json() == first.to_json());
+    }
+
+    SECTION("key")
+    {
+        Json other_params                   = params;
+        other_params["tetrahedralize"]["Y"] = true;
+        REQUIRE(cache.key(source, params) != cache.key(source, other_params));
+
+        Transform T = Transform::Identity();
+        T.scale(2.0);
+        GeometryAssetCache scaled{cache_dir, T};
+        REQUIRE(scaled.key(source, params) != cache.key(source, params));
+        REQUIRE(!scaled.contains(source, params));
+    }
+
+    SECTION("source stamp")
+    {
+        namespace fs = std::filesystem;
+        auto copy    = fmt::format("{}cube_copy.obj", output_path);
+        fs::copy_file(source, copy, fs::copy_options::overwrite_existing);
+        auto copy_key = cache.key(copy, params);
+        // the key only depends on the content
+        REQUIRE(copy_key == cache.key(source, params));
+
+        // same size and last write time: the content is not hashed again
+        auto mtime = fs::last_write_time(copy);
+        {
+            std::fstream fs{copy, std::ios::in | std::ios::out | std::ios::binary};
+            fs.seekp(1);
+            fs.put('#');
+        }
+        fs::last_write_time(copy, mtime);
+        REQUIRE(cache.key(copy, params) == copy_key);
+
+        // a new last write time rehashes the content
+        fs::last_write_time(copy, mtime + std::chrono::seconds{1});
+        REQUIRE(cache.key(copy, params) != copy_key);
+
+        fs::remove(copy);
+    }
+
+    SECTION("corrupted entry")
+    {
+        auto entry = fmt::format("{}{}.uipcgeo", cache_dir, cache.key(source, params));
+        std::filesystem::resize_file(entry, 12);
+
+        auto again = cache.read(source, params, process);
+        REQUIRE(process_count == 2);
+        REQUIRE(again.to_json() == first.to_json());
+    }
+
+    REQUIRE_THROWS_AS(cache.read(fmt::format("{}NOMESH.obj", AssetDir::trimesh_path())),
+                      GeometryAssetCacheError);
+}
@@ -0,0 +1,199 @@
+#include <app/test_common.h>
+#include <uipc/uipc.h>
+#include <uipc/geometry/utils/distance.h>
+
+using namespace uipc;
+using namespace uipc::geometry;
+
+static SimplicialComplex unit_cube()
+{
+    vector<Vector3> Vs = {Vector3{-0.5, -0.5, -0.5},
+                          Vector3{0.5, -0.5, -0.5},
+                          Vector3{0.5, 0.5, -0.5},
+                          Vector3{-0.5, 0.5, -0.5},
+                          Vector3{-0.5, -0.5, 0.5},
+                          Vector3{0.5, -0.5, 0.5},
+                          Vector3{0.5, 0.5, 0.5},
+                          Vector3{-0.5, 0.5, 0.5}};
+
+    // outward oriented
+    vector<Vector3i> Fs = {Vector3i{0, 2, 1},
+                           Vector3i{0, 3, 2},
+                           Vector3i{4, 5, 6},
+                           Vector3i{4, 6, 7},
+                           Vector3i{0, 1, 5},
+                           Vector3i{0, 5, 4},
+                           Vector3i{3, 7, 6},
+                           Vector3i{3, 6, 2},
+                           Vector3i{0, 4, 7},
+                           Vector3i{0, 7, 3},
+                           Vector3i{1, 2, 6},
+                           Vector3i{1, 6, 5}};
+    return trimesh(Vs, Fs);
+}
+
+static vector<Vector3> sample_points(SizeT N, Float scale)
+{
+    vector<Vector3> Ps(N);
+    std::srand(0);
+    for(auto& P : Ps)
+        P = Vector3::Random() * scale;
+    return Ps;
+}
+
+TEST_CASE("analytic_implicit_geometry_distance", "[implicit_geometry]")
+{
+    auto Ps = sample_points(4096, 2.0);
+
+    vector<Float>   ds(Ps.size());
+    vector<Vector3> grads(Ps.size());
+
+    SECTION("sphere")
+    {
+        Vector3 C{0.1, 0.2, 0.3};
+        auto    ig = sphere(C, 0.5);
+        REQUIRE(ig.name() == "Sphere");
+        REQUIRE(is_implicit_geometry_distance_supported(ig));
+
+        implicit_geometry_signed_distance(ig, 0, Ps, ds, grads);
+        for(SizeT i = 0; i < Ps.size(); ++i)
+        {
+            REQUIRE(ds[i] == Catch::Approx(sphere_vertex_signed_distance(C, 0.5, Ps[i])));
+            REQUIRE((grads[i] - (Ps[i] - C).normalized()).norm() < 1e-12);
+        }
+    }
+
+    SECTION("capsule")
+    {
+        Vector3 P0{-0.5, 0, 0};
+        Vector3 P1{0.5, 0, 0};
+        auto    ig = capsule(P0, P1, 0.25);
+        REQUIRE(ig.name() == "Capsule");
+
+        implicit_geometry_signed_distance(ig, 0, Ps, ds, grads);
+        for(SizeT i = 0; i < Ps.size(); ++i)
+            REQUIRE(ds[i] == Catch::Approx(capsule_vertex_signed_distance(P0, P1, 0.25, Ps[i])));
+
+        Vector3 V{0, 1, 0};
+        implicit_geometry_signed_distance(ig, 0, span{&V, 1}, span{ds.data(), 1}, span{grads.data(), 1});
+        REQUIRE(ds[0] == Catch::Approx(0.75));
+        REQUIRE((grads[0] - Vector3::UnitY()).norm() < 1e-12);
+    }
+
+    SECTION("box")
+    {
+        Transform T = Transform::Identity();
+        T.translate(Vector3{0.1, 0.0, -0.2});
+        T.rotate(Eigen::AngleAxis<Float>(0.3, Vector3{1, 1, 0}.normalized()));
+        Vector3 H{0.5, 0.25, 1.0};
+
+        auto ig = box(H, T.matrix());
+        REQUIRE(ig.name() == "Box");
+
+        implicit_geometry_signed_distance(ig, 0, Ps, ds, grads);
+        for(SizeT i = 0; i < Ps.size(); ++i)
+        {
+            REQUIRE(ds[i] == Catch::Approx(box_vertex_signed_distance(T.matrix(), H, Ps[i])));
+            REQUIRE(grads[i].norm() == Catch::Approx(1.0));
+        }
+
+        // the center is as deep as the smallest half extent
+        Vector3 V = T.translation();
+        implicit_geometry_signed_distance(ig, 0, span{&V, 1}, span{ds.data(), 1});
+        REQUIRE(ds[0] == Catch::Approx(-0.25));
+    }
+}
+
+TEST_CASE("bake_sdf", "[implicit_geometry]")
+{
+    auto  cube    = unit_cube();
+    Float spacing = 0.02;
+    Float band    = 0.1;
+
+    auto sdf = bake_sdf(cube, spacing, band);
+    REQUIRE(sdf.name() == "SDFGrid");
+    REQUIRE(is_implicit_geometry_distance_supported(sdf));
+
+    auto ref = box(Vector3::Constant(0.5));
+
+    auto            Ps = sample_points(4096, 0.8);
+    vector<Float>   ds(Ps.size());
+    vector<Float>   ref_ds(Ps.size());
+    vector<Vector3> grads(Ps.size());
+    vector<Vector3> ref_grads(Ps.size());
+
+    implicit_geometry_signed_distance(sdf, 0, Ps, ds, grads);
+    implicit_geometry_signed_distance(ref, 0, Ps, ref_ds, ref_grads);
+
+    for(SizeT i = 0; i < Ps.size(); ++i)
+    {
+        Float ref_d = std::clamp(ref_ds[i], -band, band);
+
+        // the sign is always right, far away from the surface the distance is clamped to the band
+        if(std::abs(ref_d) > spacing)
+            REQUIRE((ds[i] > 0) == (ref_d > 0));
+
+        // inside the band, trilinear interpolation of an exact distance
+        if(std::abs(ref_d) < band - 2 * spacing)
+            REQUIRE(std::abs(ds[i] - ref_d) < spacing);
+
+        // outside, the distance field of a box is smooth
+        if(ref_d > 2 * spacing && ref_d < band - 2 * spacing)
+            REQUIRE(grads[i].dot(ref_grads[i]) > 0.9);
+    }
+
+    // outside of the grid, extrapolated
+    Vector3 far{5.0, 0, 0};
+    implicit_geometry_signed_distance(sdf, 0, span{&far, 1}, span{ds.data(), 1}, span{grads.data(), 1});
+    REQUIRE(ds[0] > 4.0);
+    REQUIRE(grads[0].x() > 0.99);
+
+    // only the bricks touching the narrow band store values
+    auto resolution = sdf.meta().find<Vector3i>("resolution")->view()[0];
+    auto bricks     = sdf.meta().find<VectorXi>("bricks")->view()[0];
+    auto V1         = sdf.meta().find<VectorX>("values")->view()[0];
+    REQUIRE((bricks.array() == -2).any());  // entirely inside
+    REQUIRE(V1.size() < resolution.cast<SizeT>().prod());
+
+    // baking again gives exactly the same values (brick rows are independent)
+    auto sdf2 = bake_sdf(cube, spacing, band);
+    auto V2   = sdf2.meta().find<VectorX>("values")->view()[0];
+    REQUIRE(V1 == V2);
+    REQUIRE(bricks == sdf2.meta().find<VectorXi>("bricks")->view()[0]);
+
+    // a scaled instance measures the distance in the world
+    Transform T = Transform::Identity();
+    T.scale(2.0);
+    view(*sdf.instances().find<Matrix4x4>(builtin::transform))[0] = T.matrix();
+    Vector3 P{1.1, 0, 0};
+    implicit_geometry_signed_distance(sdf, 0, span{&P, 1}, span{ds.data(), 1}, span{grads.data(), 1});
+    REQUIRE(std::abs(ds[0] - 0.1) < 2 * spacing);
+    REQUIRE(grads[0].x() > 0.99);
+}
+
+TEST_CASE("sdf_grid", "[implicit_geometry]")
+{
+    // the signed distance to the plane x = 0.5 on a thin grid, a single point along z
+    Vector3i      resolution{20, 3, 1};
+    Float         spacing = 0.1;
+    Float         band    = 0.3;
+    vector<Float> values(resolution.cast<SizeT>().prod());
+    for(IndexT k = 0; k < resolution[2]; ++k)
+        for(IndexT j = 0; j < resolution[1]; ++j)
+            for(IndexT i = 0; i < resolution[0]; ++i)
+                values[i + resolution[0] * (j + resolution[1] * k)] =
+                    std::clamp(i * spacing - 0.5, -band, band);
+
+    auto sdf = sdf_grid(Vector3::Zero(), spacing, resolution, values, band);
+
+    // the bricks far from the plane are not stored
+    auto bricks = sdf.meta().find<VectorXi>("bricks")->view()[0];
+    REQUIRE((bricks.array() < 0).any());
+
+    vector<Vector3> Ps = {Vector3{0.55, 0.1, 0.0}, Vector3{0.05, 0.1, 0.3}, Vector3{1.8, 0.0, 0.0}};
+    vector<Float>   ds(Ps.size());
+    implicit_geometry_signed_distance(sdf, 0, Ps, ds);
+    REQUIRE(ds[0] == Catch::Approx(0.05));
+    REQUIRE(ds[1] == Catch::Approx(0.0).margin(1e-12));  // -0.3 in the grid, 0.3 above it along z
+    REQUIRE(ds[2] == Catch::Approx(band));
+}
@@ -1,6 +1,8 @@
 #include <catch.hpp>
 #include <app/asset_dir.h>
 #include <uipc/uipc.h>
+#include <uipc/common/enumerate.h>
+#include <numeric>
 
 using namespace uipc;
 using namespace uipc::geometry;
@@ -22,4 +24,56 @@ TEST_CASE("instancing", "[instance]")
     {
         REQUIRE(t == Matrix4x4::Identity());
     }
-}
\ No newline at end of file
+}
+TEST_CASE("bulk_clone", "[instance]")
+{
+    SimplicialComplexIO io;
+
+    auto mesh = io.read(fmt::format("{}cube.msh", AssetDir::tetmesh_path()));
+    mesh.vertices().create<Float>("temperature", 0.0);
+
+    constexpr SizeT   N = 8;
+    vector<Matrix4x4> transforms(N, Matrix4x4::Identity());
+    for(auto&& [i, T] : enumerate(transforms))
+        T(0, 3) = static_cast<Float>(i);
+
+    SECTION("clone")
+    {
+        vector<std::string> owned = {"temperature"};
+
+        auto clones = clone(mesh, transforms, owned);
+        REQUIRE(clones.size() == N);
+
+        for(auto&& [i, c] : enumerate(clones))
+        {
+            REQUIRE(c.transforms().view()[0] == transforms[i]);
+            // untouched attributes stay shared with the prototype
+            REQUIRE(c.positions().is_shared());
+            REQUIRE(c.tetrahedra().topo().is_shared());
+            // listed attributes are owned
+            REQUIRE(!c.vertices().find<Float>("temperature")->is_shared());
+        }
+
+        // per-clone overrides
+        vector<Float> kappas(N);
+        std::iota(kappas.begin(), kappas.end(), 1.0);
+        override_instance_attribute<Float>(clones, "kappa", kappas);
+        for(auto&& [i, c] : enumerate(clones))
+            REQUIRE(c.instances().find<Float>("kappa")->view()[0] == kappas[i]);
+
+        // the prototype is not affected
+        REQUIRE(!mesh.instances().find<Float>("kappa"));
+    }
+
+    SECTION("instantiate")
+    {
+        mesh.instances().create<Float>("kappa", 42.0);
+
+        auto inst = instantiate(mesh, transforms);
+        REQUIRE(inst.instances().size() == N);
+        REQUIRE(inst.positions().is_shared());
+        REQUIRE(std::ranges::equal(inst.transforms().view(), transforms));
+        for(auto k : inst.instances().find<Float>("kappa")->view())
+            REQUIRE(k == 42.0);
+    }
+}
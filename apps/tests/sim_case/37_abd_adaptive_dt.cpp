@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <app/asset_dir.h>
+#include <uipc/uipc.h>
+#include <uipc/constitution/affine_body_constitution.h>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("37_abd_adaptive_dt", "[abd]")
+{
+    using namespace uipc;
+    using namespace uipc::core;
+    using namespace uipc::geometry;
+    using namespace uipc::constitution;
+
+    std::string tetmesh_dir{AssetDir::tetmesh_path()};
+    auto        this_output_path = AssetDir::output_path(__FILE__);
+
+
+    Engine engine{"cuda", this_output_path};
+    World  world{engine};
+
+    auto config                             = Scene::default_config();
+    config["gravity"]                       = Vector3{0, -9.8, 0};
+    config["contact"]["friction"]["enable"] = false;
+    config["dt"]                            = 0.05;
+    config["adaptive_dt"]["enable"]         = true;
+
+    {  // dump config
+        std::ofstream ofs(fmt::format("{}config.json", this_output_path));
+        ofs << config.dump(4);
+    }
+
+    Scene scene{config};
+    {
+        // create constitution and contact model
+        AffineBodyConstitution abd;
+        scene.constitution_tabular().insert(abd);
+        scene.contact_tabular().default_model(0.5, 1.0_GPa);
+        auto default_contact = scene.contact_tabular().default_element();
+
+        // create object
+        auto object = scene.objects().create("tet");
+        {
+            vector<Vector4i> Ts = {Vector4i{0, 1, 2, 3}};
+            vector<Vector3>  Vs = {Vector3{0, 1, 0},
+                                   Vector3{0, 0, 1},
+                                   Vector3{-std::sqrt(3) / 2, 0, -0.5},
+                                   Vector3{std::sqrt(3) / 2, 0, -0.5}};
+
+            std::transform(Vs.begin(),
+                           Vs.end(),
+                           Vs.begin(),
+                           [&](auto& v)
+                           { return v * 0.3 + Vector3::UnitY() * 1.0; });
+
+            auto tet = tetmesh(Vs, Ts);
+
+            label_surface(tet);
+            label_triangle_orient(tet);
+            abd.apply_to(tet, 100.0_MPa);
+
+            object->geometries().create(tet);
+        }
+
+        // create a ground geometry
+        ImplicitGeometry half_plane = ground(0.0);
+
+        auto ground = scene.objects().create("ground");
+        {
+            ground->geometries().create(half_plane);
+        }
+    }
+
+    world.init(scene); REQUIRE(world.is_valid());
+    SceneIO sio{scene};
+    sio.write_surface(fmt::format("{}scene_surface{}.obj", this_output_path, 0));
+
+    for(int i = 1; i < 50; i++)
+    {
+        world.advance();
+        REQUIRE(world.is_valid());
+        world.retrieve();
+        sio.write_surface(fmt::format("{}scene_surface{}.obj", this_output_path, i));
+    }
+}
\ No newline at end of file
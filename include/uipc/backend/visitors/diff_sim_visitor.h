@@ -17,6 +17,22 @@ class UIPC_CORE_API DiffSimVisitor
     const diff_sim::ParameterCollection& parameters() const;
     core::DiffSim&                       ref();
 
+    /**
+     * @brief The Hessian of the assembled frames, as set by `H(const SparseCOOView&)`.
+     *
+     * No backend sets it yet (the cuda backend doesn't assemble the adjoint system in this version),
+     * so the caller supplies it. Feed it to diff_sim::AdjointSolver to solve the adjoint system on host.
+     */
+    diff_sim::SparseCOOView H() const;
+    /**
+     * @brief The dG/dP of the assembled frames, as set by `pGpP(const SparseCOOView&)`, see `H()`.
+     */
+    diff_sim::SparseCOOView pGpP() const;
+
+    // only a view is kept, the caller keeps the storage alive while it's used
+    void H(const diff_sim::SparseCOOView& H);
+    void pGpP(const diff_sim::SparseCOOView& pGpP);
+
   private:
     core::DiffSim& m_diff_sim;
 };
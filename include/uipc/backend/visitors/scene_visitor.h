@@ -23,6 +23,14 @@ class UIPC_CORE_API SceneVisitor
     void solve_pending() noexcept;
     bool is_pending() const noexcept;
 
+    /**
+     * @brief Only allow the calling thread to change the scene (objects, geometries, tags) until `unlock()`.
+     *
+     * Changes from other threads throw `core::SceneException`.
+     */
+    void lock() noexcept;
+    void unlock() noexcept;
+
     span<S<geometry::GeometrySlot>> geometries() const noexcept;
     S<geometry::GeometrySlot>       find_geometry(IndexT id) noexcept;
     span<S<geometry::GeometrySlot>> pending_geometries() const noexcept;
@@ -32,6 +40,16 @@ class UIPC_CORE_API SceneVisitor
     span<S<geometry::GeometrySlot>> pending_rest_geometries() const noexcept;
 
     span<IndexT> pending_destroy_ids() const noexcept;
+
+    /**
+     * @brief The geometry change set that the next `solve_pending()` will apply.
+     */
+    geometry::GeometryChangeSet pending_change_set() const;
+    /**
+     * @brief The geometry change set applied by the last `solve_pending()`.
+     */
+    const geometry::GeometryChangeSet& last_change_set() const noexcept;
+
     const Json&  info() const noexcept;
 
     const core::ConstitutionTabular& constitution_tabular() const noexcept;
@@ -14,9 +14,14 @@ class UIPC_CORE_API WorldVisitor
 {
   public:
     WorldVisitor(core::World& w) noexcept;
+    /**
+     * @brief Whether `World::init()` has set the scene, `scene()` and `animator()` require it.
+     */
+    bool            has_scene() const noexcept;
     SceneVisitor    scene() noexcept;
     AnimatorVisitor animator() noexcept;
     core::World&    ref() noexcept;
+    core::Engine&   engine() noexcept;
 
   private:
     core::World& m_world;
@@ -0,0 +1,36 @@
+#pragma once
+#include <uipc/geometry/attribute_key.h>
+
+namespace uipc::builtin::detail
+{
+struct AttributeKeyMaker
+{
+    static constexpr geometry::AttributeKey make(IndexT id, std::string_view name) noexcept
+    {
+        return geometry::AttributeKey{id, name};
+    }
+};
+
+// the builtin keys are numbered in the order of declaration
+constexpr IndexT attribute_key_counter_base = __COUNTER__;
+}  // namespace uipc::builtin::detail
+
+#define UIPC_BUILTIN_ATTRIBUTE(name)                                                  \
+    constexpr ::uipc::geometry::AttributeKey name =                                   \
+        ::uipc::builtin::detail::AttributeKeyMaker::make(                             \
+            __COUNTER__ - ::uipc::builtin::detail::attribute_key_counter_base - 1, #name)
+
+/**
+ * @brief Compile-time interned keys of the builtin attribute names.
+ */
+namespace uipc::builtin::key
+{
+#include <uipc/builtin/details/attribute_name.h>
+}  // namespace uipc::builtin::key
+
+#undef UIPC_BUILTIN_ATTRIBUTE
+
+namespace uipc::builtin::detail
+{
+constexpr IndexT builtin_attribute_key_count = __COUNTER__ - attribute_key_counter_base - 1;
+}  // namespace uipc::builtin::detail
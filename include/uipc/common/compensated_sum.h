@@ -0,0 +1,74 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <cmath>
+#include <type_traits>
+
+namespace uipc
+{
+/**
+ * @brief Compensated (Kahan-Babuska-Neumaier) summation of a scalar or a fixed size Eigen matrix.
+ *
+ * The rounding error of each addition is kept in a separate term, so the result of summing
+ * millions of small contributions is (nearly) independent of their count and magnitude spread.
+ * Matrices are compensated coefficient-wise.
+ */
+template <typename T>
+class CompensatedSum
+{
+  public:
+    CompensatedSum() noexcept
+    {
+        if constexpr(std::is_arithmetic_v<T>)
+        {
+            m_sum          = T{0};
+            m_compensation = T{0};
+        }
+        else
+        {
+            m_sum.setZero();
+            m_compensation.setZero();
+        }
+    }
+
+    CompensatedSum& operator+=(const T& x) noexcept
+    {
+        if constexpr(std::is_arithmetic_v<T>)
+        {
+            add(m_sum, m_compensation, x);
+        }
+        else
+        {
+            for(IndexT i = 0; i < m_sum.size(); ++i)
+                add(m_sum.data()[i], m_compensation.data()[i], x.data()[i]);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Merge another partial sum, e.g. of another block of a parallel reduction.
+     */
+    CompensatedSum& operator+=(const CompensatedSum& other) noexcept
+    {
+        *this += other.m_sum;
+        *this += other.m_compensation;
+        return *this;
+    }
+
+    T value() const noexcept { return m_sum + m_compensation; }
+
+  private:
+    template <typename S>
+    static void add(S& sum, S& compensation, S x) noexcept
+    {
+        S t = sum + x;
+        if(std::abs(sum) >= std::abs(x))
+            compensation += (sum - t) + x;
+        else
+            compensation += (x - t) + sum;
+        sum = t;
+    }
+
+    T m_sum;
+    T m_compensation;
+};
+}  // namespace uipc
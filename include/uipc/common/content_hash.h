@@ -0,0 +1,68 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/span.h>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+
+namespace uipc
+{
+/**
+ * @brief 64-bit FNV-1a hash of a byte stream.
+ *
+ * Stable across platforms and standard libraries (unlike std::hash), so it can key persistent caches.
+ */
+class ContentHash
+{
+    // plain coefficients in memory, e.g. scalars and Eigen fixed-size matrices
+    // (which are not trivially copyable because of their user-declared copy)
+    template <typename T>
+    static constexpr bool is_plain_v =
+        std::is_standard_layout_v<T> && std::is_trivially_destructible_v<T>;
+
+    template <typename T>
+    struct is_span : std::false_type
+    {
+    };
+    template <typename T, SizeT N>
+    struct is_span<span<T, N>> : std::true_type
+    {
+    };
+
+  public:
+    void update(const void* data, SizeT size) noexcept
+    {
+        auto bytes = static_cast<const std::uint8_t*>(data);
+        for(SizeT i = 0; i < size; ++i)
+        {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ull;
+        }
+    }
+
+    void update(std::string_view str) noexcept
+    {
+        update(str.data(), str.size());
+    }
+
+    // spans hash their elements, never the pointer and the size
+    template <typename T>
+        requires(is_plain_v<T> && !is_span<T>::value)
+    void update(const T& value) noexcept
+    {
+        update(&value, sizeof(T));
+    }
+
+    template <typename T>
+        requires is_plain_v<T>
+    void update(span<const T> values) noexcept
+    {
+        update(values.data(), values.size_bytes());
+    }
+
+    U64 value() const noexcept { return m_hash; }
+
+  private:
+    U64 m_hash = 14695981039346656037ull;
+};
+}  // namespace uipc
@@ -0,0 +1,40 @@
+#include <uipc/common/task_scheduler.h>
+#include <algorithm>
+
+namespace uipc
+{
+template <typename F>
+void parallel_for(SizeT N, F&& f, SizeT grain_size)
+{
+    if(N == 0)
+        return;
+
+    grain_size = std::max<SizeT>(grain_size, 1);
+
+    SizeT max_chunks  = (N + grain_size - 1) / grain_size;
+    SizeT chunk_count = std::min(parallel_thread_count(), max_chunks);
+
+    if(chunk_count <= 1)
+    {
+        for(SizeT i = 0; i < N; ++i)
+            f(i);
+        return;
+    }
+
+    SizeT chunk_size = (N + chunk_count - 1) / chunk_count;
+
+    // the calling thread runs chunks too while waiting
+    TaskGroup group;
+    for(SizeT begin = 0; begin < N; begin += chunk_size)
+    {
+        SizeT end = std::min(begin + chunk_size, N);
+        group.run(
+            [&f, begin, end]
+            {
+                for(SizeT i = begin; i < end; ++i)
+                    f(i);
+            });
+    }
+    group.wait();
+}
+}  // namespace uipc
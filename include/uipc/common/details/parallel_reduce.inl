@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <vector>
+
+namespace uipc
+{
+namespace detail
+{
+    // combine [begin, end) pairwise, the tree only depends on the partial count
+    template <typename T, typename Combine>
+    T pairwise_combine(const std::vector<T>& partials, SizeT begin, SizeT end, Combine& combine)
+    {
+        if(end - begin == 1)
+            return partials[begin];
+
+        SizeT mid = begin + (end - begin) / 2;
+        return combine(pairwise_combine(partials, begin, mid, combine),
+                       pairwise_combine(partials, mid, end, combine));
+    }
+}  // namespace detail
+
+template <typename T, typename Fold, typename Combine>
+T parallel_reduce(SizeT N, const T& identity, Fold&& fold, Combine&& combine, SizeT block_size)
+{
+    if(N == 0)
+        return identity;
+
+    // the chunks never depend on the thread count, the scheduler balances the blocks over the threads
+    block_size = std::max<SizeT>(block_size, 1);
+
+    SizeT block_count = (N + block_size - 1) / block_size;
+
+    std::vector<T> partials(block_count, identity);
+    parallel_for(block_count,
+                 [&](SizeT b)
+                 {
+                     SizeT end = std::min((b + 1) * block_size, N);
+                     for(SizeT i = b * block_size; i < end; ++i)
+                         fold(partials[b], i);
+                 });
+
+    return detail::pairwise_combine(partials, 0, block_count, combine);
+}
+
+template <typename T, typename F>
+T parallel_sum(SizeT N, F&& f, SizeT block_size)
+{
+    using Sum = CompensatedSum<T>;
+
+    return parallel_reduce(
+               N,
+               Sum{},
+               [&](Sum& acc, SizeT i) { acc += f(i); },
+               [](Sum a, const Sum& b)
+               {
+                   a += b;
+                   return a;
+               },
+               block_size)
+        .value();
+}
+}  // namespace uipc
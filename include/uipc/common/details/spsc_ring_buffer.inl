@@ -0,0 +1,59 @@
+#include <uipc/common/log.h>
+
+namespace uipc
+{
+template <typename T>
+SPSCRingBuffer<T>::SPSCRingBuffer(SizeT capacity)
+    : m_slots(capacity + 1)
+{
+    UIPC_ASSERT(capacity > 0, "Capacity of a ring buffer must be positive");
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::try_push(T&& value)
+{
+    SizeT head = m_head.load(std::memory_order_relaxed);
+    SizeT next = (head + 1) % m_slots.size();
+    if(next == m_tail.load(std::memory_order_acquire))
+        return false;
+
+    m_slots[head] = std::move(value);
+    // publish the slot to the consumer
+    m_head.store(next, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::optional<T> SPSCRingBuffer<T>::try_pop()
+{
+    SizeT tail = m_tail.load(std::memory_order_relaxed);
+    if(tail == m_head.load(std::memory_order_acquire))
+        return std::nullopt;
+
+    std::optional<T> value = std::move(m_slots[tail]);
+    m_slots[tail].reset();
+    // give the slot back to the producer
+    m_tail.store((tail + 1) % m_slots.size(), std::memory_order_release);
+    return value;
+}
+
+template <typename T>
+SizeT SPSCRingBuffer<T>::size() const noexcept
+{
+    SizeT head = m_head.load(std::memory_order_acquire);
+    SizeT tail = m_tail.load(std::memory_order_acquire);
+    return (head + m_slots.size() - tail) % m_slots.size();
+}
+
+template <typename T>
+SizeT SPSCRingBuffer<T>::capacity() const noexcept
+{
+    return m_slots.size() - 1;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::empty() const noexcept
+{
+    return size() == 0;
+}
+}  // namespace uipc
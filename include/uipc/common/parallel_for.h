@@ -0,0 +1,41 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/dllexport.h>
+
+namespace uipc
+{
+/**
+ * @brief Set the max number of threads used by the host parallel algorithms, 0 means the hardware concurrency.
+ *
+ * Same as `TaskScheduler::instance().set_thread_count(count)`.
+ */
+UIPC_CORE_API void set_parallel_thread_count(SizeT count);
+
+/**
+ * @brief The max number of threads used by the host parallel algorithms (at least 1).
+ */
+UIPC_CORE_API SizeT parallel_thread_count() noexcept;
+
+/**
+ * @brief Enable (or disable) the deterministic mode.
+ *
+ * The host reductions (see `parallel_reduce()`) are always bit-identical for any thread count.
+ * The deterministic mode extends this to the algorithms that otherwise trade reproducibility for speed,
+ * e.g. the concurrent energy evaluation of the line search which may exit early.
+ */
+UIPC_CORE_API void set_deterministic(bool value) noexcept;
+UIPC_CORE_API bool is_deterministic() noexcept;
+
+/**
+ * @brief Call `f(i)` for each `i` in `[0, N)` on host threads.
+ *
+ * The range is split into contiguous chunks of at least `grain_size` elements (at most one per thread),
+ * each chunk runs as a task on the shared TaskScheduler.
+ * The calls must be independent of each other. If some calls throw, the first exception is rethrown
+ * after all the chunks are done.
+ */
+template <typename F>
+void parallel_for(SizeT N, F&& f, SizeT grain_size = 1);
+}  // namespace uipc
+
+#include "details/parallel_for.inl"
@@ -0,0 +1,32 @@
+#pragma once
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/compensated_sum.h>
+
+namespace uipc
+{
+/**
+ * @brief Reduce `[0, N)` on host threads.
+ *
+ * The range is split into fixed blocks of `block_size`, whatever the thread count is. Each block starts
+ * from `identity` and folds its indices in order with `fold(acc, i)`, then the block results are combined
+ * with `combine(a, b)` in a pairwise tree, in the index order. So the result is bit-identical for any thread count.
+ *
+ * @param fold void(T& acc, SizeT i)
+ * @param combine T(const T& a, const T& b), must be associative
+ */
+template <typename T, typename Fold, typename Combine>
+T parallel_reduce(SizeT N, const T& identity, Fold&& fold, Combine&& combine, SizeT block_size = 4096);
+
+/**
+ * @brief Sum `f(i)` for each `i` in `[0, N)` on host threads, with compensated summation.
+ *
+ * A `parallel_reduce()` of CompensatedSum, the result is bit-identical for any thread count.
+ *
+ * @tparam T Float or a fixed size Eigen matrix
+ * @param f T(SizeT), must be independent of each other
+ */
+template <typename T, typename F>
+T parallel_sum(SizeT N, F&& f, SizeT block_size = 4096);
+}  // namespace uipc
+
+#include "details/parallel_reduce.inl"
@@ -0,0 +1,55 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace uipc
+{
+/**
+ * @brief A bounded, lock-free ring buffer for one producer thread and one consumer thread.
+ *
+ * `try_push()` must only be called by the producer, `try_pop()` only by the consumer,
+ * they never block each other. When the buffer is full, `try_push()` drops the new element.
+ */
+template <typename T>
+class SPSCRingBuffer
+{
+  public:
+    explicit SPSCRingBuffer(SizeT capacity);
+
+    SPSCRingBuffer(const SPSCRingBuffer&)            = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    /**
+     * @brief Push an element (producer only).
+     *
+     * @return false if the buffer is full, the element is dropped
+     */
+    bool try_push(T&& value);
+
+    /**
+     * @brief Pop the oldest element (consumer only).
+     *
+     * @return std::nullopt if the buffer is empty
+     */
+    std::optional<T> try_pop();
+
+    /**
+     * @brief The number of elements in the buffer, only a hint while the other side is running.
+     */
+    SizeT size() const noexcept;
+    SizeT capacity() const noexcept;
+    bool  empty() const noexcept;
+
+  private:
+    // one slot is kept empty to tell full from empty
+    std::vector<std::optional<T>> m_slots;
+
+    // separate cache lines, the producer and the consumer don't fight over them
+    alignas(64) std::atomic<SizeT> m_head = 0;  // next slot to write, owned by the producer
+    alignas(64) std::atomic<SizeT> m_tail = 0;  // next slot to read, owned by the consumer
+};
+}  // namespace uipc
+
+#include "details/spsc_ring_buffer.inl"
@@ -0,0 +1,168 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/dllexport.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/vector.h>
+#include <uipc/common/span.h>
+#include <uipc/common/exception.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+namespace uipc
+{
+class TaskGroup;
+class TaskGraph;
+
+/**
+ * @brief The work-stealing thread pool shared by all the host parallel algorithms of libuipc.
+ *
+ * Each worker has its own task deque: it pops its own tasks LIFO and steals from the others FIFO.
+ * A thread waiting for its tasks (see `TaskGroup::wait()`) runs pending tasks instead of blocking,
+ * so nested parallel algorithms never deadlock and never oversubscribe the cores.
+ *
+ * The pool is owned by the uipc runtime and configured by `uipc::init()`
+ * (`thread_count` and `thread_affinity` in the config).
+ */
+class UIPC_CORE_API TaskScheduler
+{
+    class Impl;
+    friend class TaskGroup;
+
+  public:
+    /**
+     * @brief The scheduler of the uipc runtime.
+     */
+    static TaskScheduler& instance();
+
+    TaskScheduler(const TaskScheduler&)            = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief The number of threads running the tasks, including the waiting thread (at least 1).
+     */
+    SizeT thread_count() const noexcept;
+
+    /**
+     * @brief Restart the pool with `count` threads, 0 means the hardware concurrency.
+     *
+     * The pool keeps `count - 1` workers, the thread waiting for the tasks is the last one.
+     * Must not be called from a task. Other threads may keep running parallel work meanwhile,
+     * the pending tasks are handed over to the new workers.
+     */
+    void set_thread_count(SizeT count);
+
+    /**
+     * @brief Pin the worker threads to the CPUs, worker `i` runs on `cpus[i % cpus.size()]`.
+     *
+     * An empty list removes the pinning. Only supported on Windows and Linux, ignored with a warning elsewhere.
+     * Must not be called from a task or while parallel work is running.
+     */
+    void set_affinity(span<const IndexT> cpus);
+
+    vector<IndexT> affinity() const;
+
+    /**
+     * @brief If the calling thread is a worker of this scheduler.
+     */
+    bool is_worker_thread() const noexcept;
+
+  private:
+    TaskScheduler();
+    ~TaskScheduler();
+
+    void submit(std::function<void()>&& task);
+    // run one pending task on the calling thread, false if there is none
+    bool try_run_one();
+
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief A set of tasks running on the TaskScheduler, waited for together.
+ *
+ * The tasks may spawn more tasks into the same group. If some tasks throw,
+ * the first exception is rethrown by `wait()`, the remaining tasks still run.
+ */
+class UIPC_CORE_API TaskGroup
+{
+  public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance());
+    /**
+     * @brief Wait for the remaining tasks, the exception (if any) is dropped.
+     */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+
+    /**
+     * @brief Run the pending tasks on the calling thread until all the tasks of this group are done.
+     */
+    void wait();
+
+  private:
+    void wait_all() noexcept;
+
+    TaskScheduler&          m_scheduler;
+    std::atomic<SizeT>      m_pending = 0;
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::exception_ptr      m_exception;
+};
+
+/**
+ * @brief A DAG of tasks, a task starts after all its predecessors are done.
+ *
+ * ```cpp
+ * TaskGraph graph;
+ * auto load  = graph.add([&] { ... });
+ * auto build = graph.add([&] { ... });
+ * graph.precede(load, build);
+ * graph.run();
+ * ```
+ */
+class UIPC_CORE_API TaskGraph
+{
+    class Impl;
+
+  public:
+    using TaskId = SizeT;
+
+    TaskGraph();
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&)            = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    TaskId add(std::function<void()> task);
+
+    /**
+     * @brief `after` starts after `before` is done.
+     */
+    void precede(TaskId before, TaskId after);
+
+    SizeT size() const noexcept;
+
+    /**
+     * @brief Run the graph on the TaskScheduler and wait for it, the graph can be run again.
+     *
+     * If some tasks throw, the tasks not started yet are skipped and the first exception is rethrown.
+     * Throws TaskGraphException if the graph has a cycle.
+     */
+    void run(TaskScheduler& scheduler = TaskScheduler::instance());
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_CORE_API TaskGraphException : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc
@@ -2,6 +2,7 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <uipc/common/type_define.h>
 #include <uipc/common/vector.h>
 #include <uipc/common/smart_pointer.h>
 #include <uipc/common/stack.h>
@@ -13,6 +14,8 @@
 #include <uipc/common/unordered_map.h>
 #include <uipc/common/set.h>
 #include <uipc/common/string.h>
+#include <uipc/common/map.h>
+#include <uipc/common/span.h>
 #include <functional>
 
 namespace uipc
@@ -74,6 +77,15 @@ class UIPC_CORE_API Timer
     static void report(std::ostream& o = std::cout);
     static Json report_as_json();
 
+    /**
+     * @brief Close the frame `frame` of the current GlobalTimer, see `GlobalTimer::end_frame()`.
+     */
+    static void end_frame(SizeT frame);
+    /**
+     * @brief The per-frame statistics of the current GlobalTimer, see `GlobalTimer::report_frames_as_json()`.
+     */
+    static Json report_frames_as_json();
+
   private:
     void                         sync() const;
     details::ScopedTimer*        m_timer = nullptr;
@@ -82,6 +94,75 @@ class UIPC_CORE_API Timer
     static std::function<void()> m_sync;
 };
 
+/**
+ * @brief The per-frame durations of one timer path (e.g. `/GlobalTimer/Pipeline/Simulation`).
+ *
+ * A sample is the total duration of the path in one frame. The last frames are kept in a rolling window
+ * for exact percentiles, all the frames go into a log-scale histogram (4 bins per octave from 1us).
+ * A sample greater than `spike_ratio` times the median of the window before it is flagged as a spike.
+ */
+class UIPC_CORE_API FrameTimerStats
+{
+  public:
+    class Sample
+    {
+      public:
+        SizeT  frame    = 0;
+        double duration = 0.0;  // in seconds
+        bool   is_spike = false;
+    };
+
+    constexpr static double HistogramMinDuration   = 1e-6;
+    constexpr static SizeT  HistogramBinsPerOctave = 4;
+    // [0, 1us), 30 octaves, [~1000s, inf)
+    constexpr static SizeT HistogramBinCount = 30 * HistogramBinsPerOctave + 2;
+
+    /**
+     * @brief The samples of the last frames, oldest first.
+     */
+    span<const Sample> window() const noexcept { return m_window; }
+
+    /**
+     * @brief The `p`-th percentile (`p` in [0, 100]) of the window, linearly interpolated, 0 if empty.
+     */
+    double percentile(double p) const;
+
+    /**
+     * @brief The `p`-th percentile of all the frames, the upper edge of the histogram bin containing it.
+     */
+    double histogram_percentile(double p) const;
+
+    span<const SizeT> histogram() const noexcept { return m_histogram; }
+    /**
+     * @brief The exclusive upper edge of the histogram bin, infinity for the last one.
+     */
+    static double histogram_bin_upper(SizeT bin);
+
+    SizeT  frame_count() const noexcept { return m_frame_count; }
+    SizeT  spike_count() const noexcept { return m_spike_count; }
+    double max() const noexcept { return m_max; }
+    double mean() const noexcept;
+
+    Json to_json() const;
+
+  private:
+    friend class GlobalTimer;
+    // returns true if the sample is a spike, `median` is the running median it's compared with
+    bool push(SizeT  frame,
+              double duration,
+              SizeT  window_size,
+              double spike_ratio,
+              SizeT  min_frames,
+              double& median);
+
+    vector<Sample> m_window;
+    vector<SizeT>  m_histogram   = vector<SizeT>(HistogramBinCount, 0);
+    SizeT          m_frame_count = 0;
+    SizeT          m_spike_count = 0;
+    double         m_total       = 0.0;
+    double         m_max         = 0.0;
+};
+
 class UIPC_CORE_API GlobalTimer
 {
     using STimer = details::ScopedTimer;
@@ -121,6 +202,17 @@ class UIPC_CORE_API GlobalTimer
     unordered_map<string, U<MergeResult>> m_merge_timers;
     MergeResult*                          m_merge_root = nullptr;
 
+    constexpr static SizeT MaxSpikeCount = 1024;
+
+    // the total duration of each path in the current frame
+    unordered_map<string, double> m_frame_durations;
+    map<string, FrameTimerStats>  m_frame_stats;
+    SizeT                         m_frame_count      = 0;
+    SizeT                         m_frame_window     = 256;
+    double                        m_spike_ratio      = 2.0;
+    SizeT                         m_spike_min_frames = 8;
+    list<Json>                    m_spikes;
+
     void merge_timers();
     void _print_merged_timings(std::ostream&      o,
                                const MergeResult* timer,
@@ -146,6 +238,41 @@ class UIPC_CORE_API GlobalTimer
 
     void print_merged_timings(std::ostream& o = std::cout);
 
+    /**
+     * @brief Close a frame: the durations of the timers finished since the last call
+     * become one sample of their paths (see FrameTimerStats).
+     *
+     * Does nothing if no timer finished, e.g. when the timers are disabled.
+     */
+    void end_frame(SizeT frame);
+
+    /**
+     * @brief The number of frames kept for the percentiles and the spike median, 256 by default.
+     */
+    void set_frame_window(SizeT frames);
+
+    /**
+     * @brief Flag the samples greater than `ratio` times their running median,
+     * once the path has at least `min_frames` samples. 2.0 and 8 by default.
+     */
+    void set_spike_threshold(double ratio, SizeT min_frames = 8);
+
+    /**
+     * @brief The per-frame statistics of the path, nullptr if never sampled.
+     */
+    const FrameTimerStats* frame_stats(std::string_view full_name) const;
+
+    /**
+     * @brief The statistics of all the paths and the last spikes
+     * (`{"frame", "timer", "duration", "median"}`, at most 1024).
+     */
+    Json report_frames_as_json() const;
+
+    /**
+     * @brief Drop all the per-frame statistics, the timers are kept.
+     */
+    void clear_frames();
+
     void clear();
 };
 }  // namespace uipc
@@ -1,6 +1,7 @@
 #pragma once
 #include <uipc/constitution/constitution.h>
 #include <uipc/geometry/simplicial_complex.h>
+#include <uipc/common/span.h>
 
 namespace uipc::constitution
 {
@@ -30,6 +31,18 @@ class UIPC_CONSTITUTION_API AffineBodyConstitution : public IConstitution
 
     void apply_to(geometry::SimplicialComplex& sc, Float kappa, Float mass_density = 1e3) const;
 
+    /**
+     * @brief Apply with heterogeneous stiffness, `kappa[i]` is for the i-th instance.
+     */
+    void apply_to(geometry::SimplicialComplex& sc, span<const Float> kappa, Float mass_density = 1e3) const;
+
+    /**
+     * @brief Apply the same material to many simplicial complexes in parallel.
+     */
+    void apply_to(span<geometry::SimplicialComplex* const> scs,
+                  Float                                    kappa,
+                  Float mass_density = 1e3) const;
+
     static Json default_config() noexcept;
 
   protected:
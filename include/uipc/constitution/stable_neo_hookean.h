@@ -2,6 +2,7 @@
 #include <uipc/constitution/finite_element_constitution.h>
 #include <uipc/constitution/elastic_moduli.h>
 #include <uipc/common/unit.h>
+#include <uipc/common/span.h>
 
 namespace uipc::constitution
 {
@@ -16,6 +17,20 @@ class UIPC_CONSTITUTION_API StableNeoHookean : public FiniteElementConstitution
                   const ElasticModuli& moduli = ElasticModuli::youngs_poisson(20.0_kPa, 0.49),
                   Float mass_density = 1e3) const;
 
+    /**
+     * @brief Apply with heterogeneous moduli, `moduli[i]` is for the i-th tetrahedron.
+     */
+    void apply_to(geometry::SimplicialComplex& sc,
+                  span<const ElasticModuli>    moduli,
+                  Float                        mass_density = 1e3) const;
+
+    /**
+     * @brief Apply the same material to many simplicial complexes in parallel.
+     */
+    void apply_to(span<geometry::SimplicialComplex* const> scs,
+                  const ElasticModuli& moduli = ElasticModuli::youngs_poisson(20.0_kPa, 0.49),
+                  Float mass_density = 1e3) const;
+
     static Json default_config() noexcept;
 
   protected:
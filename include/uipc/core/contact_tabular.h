@@ -56,6 +56,7 @@ class UIPC_CORE_API ContactTabular final
     class Impl;
     U<Impl> m_impl;
     friend class SceneFactory;
+    friend class Scene;
     geometry::AttributeCollection& internal_contact_models() const noexcept;
     span<ContactElement>           contact_elements() const noexcept;
     void build_from(const geometry::AttributeCollection& ac, span<ContactElement> ce);
@@ -5,6 +5,8 @@ template <std::derived_from<geometry::Geometry> GeometryT>
 ObjectGeometrySlots<GeometryT> Object::Geometries::create(const GeometryT& geometry,
                                                           const GeometryT& rest_geometry) &&
 {
+    m_object.check_scene_unlocked("create a geometry");
+
     m_object.m_geometry_ids.push_back(m_object.geometry_collection().next_id());
 
     UIPC_ASSERT(m_object.geometry_collection().next_id()
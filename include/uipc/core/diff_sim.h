@@ -33,5 +33,8 @@ class UIPC_CORE_API DiffSim
     U<Impl> m_impl;
 
     void init(backend::SceneVisitor& scene);  // only be called by Scene
+
+    diff_sim::SparseCOOView& _H() noexcept;     // only be called by DiffSimVisitor
+    diff_sim::SparseCOOView& _pGpP() noexcept;  // only be called by DiffSimVisitor
 };
 }  // namespace uipc::core
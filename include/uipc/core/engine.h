@@ -24,8 +24,20 @@ class UIPC_CORE_API Engine final
     EngineStatusCollection&  status();
     const FeatureCollection& features();
 
+    /**
+     * @brief The per-frame solver statistics reported by the backend.
+     */
+    TelemetryStream& telemetry();
+
     Json to_json() const;
 
+    /**
+     * @brief Report the memory used by the backend.
+     * 
+     * @return Json with `total_bytes` and the buffers of each SimSystem in `sim_systems`
+     */
+    Json memory_report() const;
+
     static Json default_config();
 
   private:
@@ -3,6 +3,7 @@
 #include <uipc/backend/visitors/world_visitor.h>
 #include <uipc/core/engine_status.h>
 #include <uipc/core/feature_collection.h>
+#include <uipc/core/telemetry.h>
 
 namespace uipc::core
 {
@@ -18,12 +19,14 @@ class UIPC_CORE_API IEngine
     void sync();
     void retrieve();
     Json to_json() const;
+    Json memory_report() const;
 
     bool                     dump();
     bool                     recover(SizeT dst_frame);
     SizeT                    frame() const;
     EngineStatusCollection&  status();
     const FeatureCollection& features() const;
+    TelemetryStream&         telemetry();
 
   protected:
     virtual void                     do_init(backend::WorldVisitor v) = 0;
@@ -32,10 +35,12 @@ class UIPC_CORE_API IEngine
     virtual void                     do_sync()                        = 0;
     virtual void                     do_retrieve()                    = 0;
     virtual Json                     do_to_json() const;
+    virtual Json                     do_memory_report() const;
     virtual bool                     do_dump();
     virtual bool                     do_recover(SizeT dst_frame);
     virtual SizeT                    get_frame() const    = 0;
     virtual EngineStatusCollection&  get_status()         = 0;
     virtual const FeatureCollection& get_features() const = 0;
+    virtual TelemetryStream&         get_telemetry()      = 0;
 };
 }  // namespace uipc::core
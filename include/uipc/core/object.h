@@ -107,6 +107,12 @@ class UIPC_CORE_API Object : public IObject
     [[nodiscard]] Geometries  geometries() noexcept;
     [[nodiscard]] CGeometries geometries() const noexcept;
 
+    /**
+     * @brief A user defined label, objects can be queried by tag through `Scene::objects().find_ids_by_tag()`.
+     */
+    [[nodiscard]] std::string_view tag() const noexcept;
+    void                           tag(std::string_view tag);
+
   protected:
     [[nodiscard]] std::string_view get_name() const noexcept override;
     [[nodiscard]] IndexT           get_id() const noexcept override;
@@ -117,11 +123,13 @@ class UIPC_CORE_API Object : public IObject
     Scene*                        m_scene = nullptr;
     IndexT                        m_id;
     string                        m_name;
+    string                        m_tag;
     vector<IndexT>                m_geometry_ids;
     geometry::GeometryCollection& geometry_collection() noexcept;
     geometry::GeometryCollection& rest_geometry_collection() noexcept;
     bool                          scene_started() const noexcept;
     bool                          scene_pending() const noexcept;
+    void                          check_scene_unlocked(std::string_view op) const;
 
     void scene(Scene& scene) noexcept;
 
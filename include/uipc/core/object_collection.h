@@ -25,6 +25,15 @@ class UIPC_CORE_API ObjectCollection : public IObjectCollection
     vector<S<Object>>       find(std::string_view name) noexcept;
     vector<S<const Object>> find(std::string_view name) const noexcept;
 
+    /**
+     * @brief Ids of the objects with the given name, sorted ascending.
+     */
+    span<const IndexT> find_ids(std::string_view name) const noexcept;
+    /**
+     * @brief Ids of the objects with the given tag, sorted ascending.
+     */
+    span<const IndexT> find_ids_by_tag(std::string_view tag) const noexcept;
+
     void destroy(IndexT id) noexcept;
 
     void   reserve(SizeT size) noexcept;
@@ -32,9 +41,32 @@ class UIPC_CORE_API ObjectCollection : public IObjectCollection
     IndexT next_id() const noexcept;
 
   private:
+    friend class Object;
+
+    // allows finding by std::string_view without creating a temporary string
+    struct NameHash
+    {
+        using is_transparent = void;
+        SizeT operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+    using IdIndex = unordered_map<string, vector<IndexT>, NameHash, std::equal_to<>>;
+
     mutable IndexT                   m_next_id = 0;
     unordered_map<IndexT, S<Object>> m_objects;
 
+    // secondary indices, kept in sync with m_objects
+    IdIndex m_name_to_ids;
+    IdIndex m_tag_to_ids;
+
+    static void index_insert(IdIndex& index, std::string_view key, IndexT id);
+    static void index_erase(IdIndex& index, std::string_view key, IndexT id);
+    static span<const IndexT> index_find(const IdIndex& index, std::string_view key) noexcept;
+
+    void retag(const Object& object, std::string_view new_tag);
+
     unordered_map<IndexT, S<Object>>&       objects();
     const unordered_map<IndexT, S<Object>>& objects() const;
 
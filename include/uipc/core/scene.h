@@ -38,7 +38,15 @@ class UIPC_CORE_API Scene final
         S<Object>         create(std::string_view name = "") &&;
         S<Object>         find(IndexT id) && noexcept;
         vector<S<Object>> find(std::string_view name) && noexcept;
-        void              destroy(IndexT id) &&;
+        /**
+         * @brief Ids of the objects with the given name, sorted ascending, without touching the objects.
+         */
+        span<const IndexT> find_ids(std::string_view name) && noexcept;
+        /**
+         * @brief Ids of the objects with the given tag, sorted ascending.
+         */
+        span<const IndexT> find_ids_by_tag(std::string_view tag) && noexcept;
+        void               destroy(IndexT id) &&;
         SizeT             size() const noexcept;
         SizeT             created_count() const noexcept;
 
@@ -54,6 +62,8 @@ class UIPC_CORE_API Scene final
       public:
         S<const Object>         find(IndexT id) && noexcept;
         vector<S<const Object>> find(std::string_view name) && noexcept;
+        span<const IndexT>      find_ids(std::string_view name) && noexcept;
+        span<const IndexT>      find_ids_by_tag(std::string_view tag) && noexcept;
         SizeT                   size() const noexcept;
         SizeT                   created_count() const noexcept;
 
@@ -68,6 +78,19 @@ class UIPC_CORE_API Scene final
 
       public:
         ObjectGeometrySlots<geometry::Geometry> find(IndexT id) && noexcept;
+        /**
+         * @brief Ids of the geometries with the given constitution uid, sorted ascending.
+         *
+         * The span is invalidated by the next geometry create or destroy.
+         */
+        span<const IndexT> find_ids_by_constitution(U64 uid) && noexcept;
+        /**
+         * @brief Index the constitution uid of geometry `id` again.
+         *
+         * Call it after applying a constitution to a geometry that is already in the scene,
+         * `world.init(scene)` indexes all the geometries again anyway.
+         */
+        void update_constitution_index(IndexT id) &&;
 
       private:
         Geometries(Scene& scene) noexcept;
@@ -80,6 +103,7 @@ class UIPC_CORE_API Scene final
 
       public:
         ObjectGeometrySlots<const geometry::Geometry> find(IndexT id) && noexcept;
+        span<const IndexT> find_ids_by_constitution(U64 uid) && noexcept;
 
       private:
         CGeometries(const Scene& scene) noexcept;
@@ -111,6 +135,17 @@ class UIPC_CORE_API Scene final
     SanityChecker&       sanity_checker();
     const SanityChecker& sanity_checker() const;
 
+    /**
+     * @brief Report the host memory used by the scene.
+     * 
+     * Bytes are reported per object, geometry, attribute collection and attribute.
+     * An attribute shared by several slots (copy-on-write) is counted once, by the first geometry
+     * that references it, the other references are reported with `"counted": false`.
+     * 
+     * @return Json with `total_bytes`, `objects`, `geometries`, `rest_geometries` and `contact_tabular`
+     */
+    Json memory_report() const;
+
   private:
     class Impl;
     U<Impl> m_impl;
@@ -132,6 +167,17 @@ class UIPC_CORE_API Scene final
 
     DiffSim& _diff_sim() noexcept;  // only called by SceneVisitor
     bool     is_pending() const noexcept;
+
+    void lock() noexcept;  // only called by SceneVisitor
+    void unlock() noexcept;
+    bool is_locked() const noexcept;
+    void check_unlocked(std::string_view op) const;
+};
+
+class UIPC_CORE_API SceneException : public Exception
+{
+  public:
+    using Exception::Exception;
 };
 }  // namespace uipc::core
 
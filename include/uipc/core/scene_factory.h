@@ -1,5 +1,6 @@
 #pragma once
 #include <uipc/core/scene.h>
+#include <uipc/geometry/geometry_slot.h>
 
 namespace uipc::core
 {
@@ -14,6 +15,49 @@ class UIPC_CORE_API SceneFactory
     [[nodiscard]] S<Scene> from_json(const Json& j);
     [[nodiscard]] Json     to_json(const Scene& scene);
 
+    /**
+     * @brief The geometries of one object, decoded from an object chunk.
+     */
+    class UIPC_CORE_API ObjectChunk
+    {
+      public:
+        IndexT object_id() const noexcept;
+
+      private:
+        friend class SceneFactory;
+        IndexT                            m_object_id = -1;
+        vector<S<geometry::GeometrySlot>> m_geometries;
+        vector<S<geometry::GeometrySlot>> m_rest_geometries;
+    };
+
+    /**
+     * @brief The chunked representation of a scene, used for streaming.
+     * 
+     * The header holds the config, the contact tabular and the objects (without geometries).
+     * Each object chunk holds the geometries and rest geometries of one object, so that objects
+     * can be stored, decoded and loaded independently.
+     *
+     * Attribute buffers shared between objects are duplicated in each chunk, and no longer
+     * shared after `from_chunks()`. Sharing inside one object is kept.
+     */
+    [[nodiscard]] Json to_header_json(const Scene& scene);
+    /**
+     * @brief Create the chunk of the object with the given id.
+     */
+    [[nodiscard]] Json to_object_json(const Scene& scene, IndexT object_id);
+
+    /**
+     * @brief Decode an object chunk, can be called on any thread.
+     */
+    [[nodiscard]] static ObjectChunk decode_object(const Json& j);
+
+    /**
+     * @brief Build a scene from the header and the decoded object chunks.
+     * 
+     * Only the objects in `objects` are created, other objects listed in the header are skipped.
+     */
+    [[nodiscard]] S<Scene> from_chunks(const Json& header, span<ObjectChunk> objects);
+
   private:
     U<Impl> m_impl;
 };
@@ -0,0 +1,133 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/span.h>
+#include <uipc/common/vector.h>
+#include <uipc/common/map.h>
+#include <uipc/common/json.h>
+#include <uipc/common/exception.h>
+#include <optional>
+
+namespace uipc::core
+{
+/**
+ * @brief The solver statistics of one frame, reported by the backend.
+ */
+class UIPC_CORE_API FrameTelemetry
+{
+  public:
+    SizeT frame         = 0;
+    Float dt            = 0.0;  // the frame dt
+    SizeT substep_count = 0;
+    /**
+     * @brief The dt of each substep in order, they sum up to the frame dt.
+     */
+    vector<Float> substep_dts;
+    /**
+     * @brief Newton iterations of all the substeps.
+     */
+    SizeT newton_iterations = 0;
+    /**
+     * @brief Iterations of each linear (e.g. PCG) solve, in order.
+     */
+    vector<SizeT> linear_solver_iterations;
+    /**
+     * @brief Backtracking steps of all the line searches.
+     */
+    SizeT line_search_steps = 0;
+    /**
+     * @brief The smallest step size allowed by CCD in this frame, 1.0 means not limited.
+     */
+    Float min_ccd_alpha = 1.0;
+    /**
+     * @brief The smallest step size allowed by the CFL condition in this frame, 1.0 means not limited.
+     */
+    Float min_cfl_alpha = 1.0;
+    /**
+     * @brief The peak contact candidate count of each primitive pair type (e.g. PT, EE, PE, PP, PH).
+     */
+    map<std::string, SizeT> contact_candidates;
+    /**
+     * @brief The energy terms of the last line search evaluation.
+     */
+    map<std::string, Float> energies;
+    /**
+     * @brief Wall time of the frame in seconds.
+     */
+    Float wall_time = 0.0;
+
+    Json to_json() const;
+};
+
+/**
+ * @brief A bounded stream of FrameTelemetry from the engine to the user.
+ *
+ * The engine pushes one record per frame into a lock-free ring buffer, so it never waits for the readers.
+ * When the buffer is full, the new records are dropped (see `dropped_count()`) until the user pops some.
+ * Readers on different threads are serialized among themselves.
+ */
+class UIPC_CORE_API TelemetryStream
+{
+    class Impl;
+
+  public:
+    explicit TelemetryStream(SizeT capacity = 1024);
+    ~TelemetryStream();
+
+    TelemetryStream(const TelemetryStream&)            = delete;
+    TelemetryStream& operator=(const TelemetryStream&) = delete;
+
+    /**
+     * @brief Push a record, only called by the engine.
+     *
+     * @return false if the stream is full or disabled, the record is dropped
+     */
+    bool push(FrameTelemetry&& record);
+
+    /**
+     * @brief Pop the oldest record.
+     */
+    std::optional<FrameTelemetry> pop();
+
+    /**
+     * @brief Pop all the records in the stream, oldest first.
+     */
+    vector<FrameTelemetry> pop_all();
+
+    /**
+     * @brief Stop (or resume) accepting records, the engine may skip collecting when disabled.
+     */
+    void enable(bool value) noexcept;
+    bool is_enabled() const noexcept;
+
+    SizeT size() const noexcept;
+    SizeT capacity() const noexcept;
+    /**
+     * @brief The number of records dropped because the stream was full.
+     */
+    SizeT dropped_count() const noexcept;
+
+    /**
+     * @brief Write the records as CSV, one row per frame.
+     *
+     * The candidate counts and the energies become the `contact/<type>` and `energy/<name>` columns
+     * (the union over all the records, empty if a record doesn't have it).
+     */
+    static void write_csv(std::string_view file, span<const FrameTelemetry> records);
+
+    /**
+     * @brief Write the records as JSON Lines, one `FrameTelemetry::to_json()` per line.
+     */
+    static void write_json_lines(std::string_view file, span<const FrameTelemetry> records);
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_CORE_API TelemetryStreamException : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::core
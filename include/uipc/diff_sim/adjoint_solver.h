@@ -0,0 +1,92 @@
+#pragma once
+#include <uipc/diff_sim/csr_pattern.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/common/exception.h>
+
+namespace uipc::diff_sim
+{
+/**
+ * @brief Host sparse solver for the adjoint system of DiffSim.
+ *
+ * Given the Hessian $H$ and $\frac{\partial G}{\partial P}$ (as SparseCOOView, e.g. from DiffSimVisitor),
+ * solves the adjoint system and computes the parameter gradient:
+ *
+ *$$
+ * H^T \lambda = \frac{\partial L}{\partial X}, \quad
+ * \frac{\partial L}{\partial P} = -\left(\frac{\partial G}{\partial P}\right)^T \lambda
+ *$$
+ *
+ * The COO matrices are compressed through a CSRPattern that is kept across `factorize()` calls.
+ * If the pattern doesn't change (the usual case between frames or fitting iterations),
+ * only the values are scattered and only the numeric factorization is redone,
+ * the symbolic analysis (ordering, elimination tree) is reused.
+ *
+ * The right-hand side can have many columns (one per loss), they are solved in parallel.
+ */
+class UIPC_CORE_API AdjointSolver
+{
+    class Impl;
+
+  public:
+    using DenseMatrix = Matrix<Float, Eigen::Dynamic, Eigen::Dynamic>;
+
+    enum class Method
+    {
+        /**
+         * @brief Sparse LU, for a general (e.g. multi-frame, block-triangular) $H$.
+         */
+        LU,
+        /**
+         * @brief Simplicial LDLT, for a symmetric $H$ (e.g. a single frame).
+         */
+        LDLT
+    };
+
+    explicit AdjointSolver(Method method = Method::LU);
+    ~AdjointSolver();
+
+    AdjointSolver(const AdjointSolver&)            = delete;
+    AdjointSolver& operator=(const AdjointSolver&) = delete;
+
+    /**
+     * @brief Factorize $H^T$, reusing the symbolic analysis if the pattern is unchanged.
+     */
+    void factorize(const SparseCOOView& H);
+
+    /**
+     * @brief Solve $H^T \lambda = \frac{\partial L}{\partial X}$, one column per loss.
+     */
+    DenseMatrix solve(const DenseMatrix& dLdX) const;
+
+    /**
+     * @brief Compute $-\left(\frac{\partial G}{\partial P}\right)^T \lambda$, one column per loss.
+     */
+    DenseMatrix compute_dLdP(const SparseCOOView& pGpP, const DenseMatrix& lambda);
+
+    /**
+     * @brief `solve()` and `compute_dLdP()` in one go.
+     */
+    DenseMatrix solve_dLdP(const SparseCOOView& pGpP, const DenseMatrix& dLdX);
+
+    Method method() const noexcept;
+
+    /**
+     * @brief The number of symbolic analyses, less than `factorize_count()` when the pattern is reused.
+     */
+    SizeT analyze_count() const noexcept;
+
+    /**
+     * @brief The number of numeric factorizations.
+     */
+    SizeT factorize_count() const noexcept;
+
+  private:
+    U<Impl> m_impl;
+};
+
+class UIPC_CORE_API AdjointSolverError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::diff_sim
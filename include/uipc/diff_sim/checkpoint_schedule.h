@@ -0,0 +1,88 @@
+#pragma once
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+#include <uipc/common/vector.h>
+#include <uipc/common/span.h>
+
+namespace uipc::diff_sim
+{
+/**
+ * @brief A binomial (revolve-style) checkpointing schedule for the adjoint of a multi-frame simulation.
+ *
+ * The adjoint visits the frames in reverse order, and each frame needs the state it was solved from.
+ * Instead of keeping the per-frame Hessians of all the frames, the schedule keeps at most
+ * `checkpoint_count` state checkpoints (plus the start state) and recomputes the frames in between.
+ *
+ * With `c` checkpoints and `r` recomputation sweeps, up to `C(c + r, c)` frames can be reversed,
+ * so for a fixed memory budget the recomputation grows only slowly with the trajectory length.
+ *
+ * Frames are relative to the start state, which is frame 0. The schedule covers the forward sweep too,
+ * so the actions start with `Advance(1)`.
+ */
+class UIPC_CORE_API CheckpointSchedule
+{
+  public:
+    enum class ActionType
+    {
+        /**
+         * @brief Advance one frame, the state becomes `frame`.
+         */
+        Advance,
+        /**
+         * @brief Store the current state (at `frame`) as a checkpoint.
+         */
+        Dump,
+        /**
+         * @brief Restore the checkpoint at `frame`.
+         */
+        Recover,
+        /**
+         * @brief Assemble the adjoint of `frame`, the current state is the freshly solved `frame`.
+         */
+        Backward,
+        /**
+         * @brief The checkpoint at `frame` is no longer needed, its storage can be released.
+         *
+         * Every `Dump` is followed by a `Drop` of the same frame, the start state is never dropped.
+         */
+        Drop
+    };
+
+    class Action
+    {
+      public:
+        ActionType type;
+        SizeT      frame;
+    };
+
+    /**
+     * @param frame_count The number of frames to reverse.
+     * @param checkpoint_count The maximal number of checkpoints besides the start state.
+     */
+    CheckpointSchedule(SizeT frame_count, SizeT checkpoint_count);
+
+    span<const Action> actions() const noexcept;
+
+    SizeT frame_count() const noexcept;
+    SizeT checkpoint_count() const noexcept;
+
+    /**
+     * @brief The total number of `Advance` actions, including the forward sweep.
+     */
+    SizeT advance_count() const noexcept;
+
+    /**
+     * @brief The maximal number of checkpoints (besides the start state) alive at the same time.
+     */
+    SizeT peak_checkpoint_count() const noexcept;
+
+  private:
+    class Builder;
+
+    SizeT          m_frame_count           = 0;
+    SizeT          m_checkpoint_count      = 0;
+    SizeT          m_advance_count         = 0;
+    SizeT          m_peak_checkpoint_count = 0;
+    vector<Action> m_actions;
+};
+}  // namespace uipc::diff_sim
@@ -0,0 +1,61 @@
+#pragma once
+#include <uipc/core/world.h>
+#include <uipc/diff_sim/checkpoint_schedule.h>
+#include <functional>
+
+namespace uipc::diff_sim
+{
+/**
+ * @brief Run the adjoint of a multi-frame simulation with bounded memory.
+ *
+ * The forward sweep and the reverse sweep follow a CheckpointSchedule: the states at the checkpoints
+ * are dumped through `World::dump()`, and the frames in between are recomputed from the nearest
+ * checkpoint through `World::recover()` and `World::advance()` when the reverse sweep needs them.
+ * The files of a checkpoint are removed from the workspace once the schedule drops it, the start
+ * state is kept, so the world can be recovered to it afterwards.
+ *
+ * Requires `diff_sim/enable` and `diff_sim/checkpoint/enable` in the scene config. The latter lets
+ * the backend keep only the Hessian and dG/dP blocks of the frame being reversed, instead of all
+ * the frames since the start. The number of checkpoints is `diff_sim/checkpoint/count`.
+ *
+ * ```cpp
+ * CheckpointedAdjoint adjoint{world, 300};
+ * adjoint.run([&](SizeT frame)
+ * {
+ *     // the world is at `frame`, freshly solved and retrieved, `backward()` is already called
+ *     // consume the H and dG/dP of this frame here
+ * });
+ * ```
+ */
+class UIPC_CORE_API CheckpointedAdjoint
+{
+  public:
+    /**
+     * @brief Called after `World::backward()` of each frame, in reverse order.
+     */
+    using BackwardCallback = std::function<void(SizeT frame)>;
+
+    /**
+     * @param world The world to run, the current frame is the start state.
+     * @param frame_count The number of frames to simulate and reverse.
+     */
+    CheckpointedAdjoint(core::World& world, SizeT frame_count);
+
+    /**
+     * @brief Run the forward sweep and the reverse sweep.
+     */
+    void run(const BackwardCallback& on_backward);
+
+    const CheckpointSchedule& schedule() const noexcept;
+
+  private:
+    core::World&       m_world;
+    CheckpointSchedule m_schedule;
+};
+
+class UIPC_CORE_API CheckpointedAdjointError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::diff_sim
@@ -0,0 +1,76 @@
+#pragma once
+#include <uipc/diff_sim/sparse_coo_view.h>
+#include <uipc/common/vector.h>
+
+namespace uipc::diff_sim
+{
+/**
+ * @brief The compressed row (CSR) pattern of a SparseCOOView.
+ *
+ * `build()` sorts and merges the COO entries once (rows in parallel) and remembers where each
+ * COO entry goes. `fill()` then only scatters the values, so a matrix whose pattern doesn't change
+ * between frames is converted without sorting again.
+ *
+ * With `transpose = true` the pattern is the CSR of the transposed matrix, which is also the
+ * compressed column (CSC) layout of the matrix itself.
+ */
+class UIPC_CORE_API CSRPattern
+{
+  public:
+    CSRPattern() = default;
+
+    /**
+     * @brief Analyze the pattern of the COO matrix, duplicated entries are merged.
+     */
+    void build(const SparseCOOView& coo, bool transpose = false);
+
+    /**
+     * @brief Check if the COO matrix has exactly the same entries (same order) as the one `build()` analyzed.
+     *
+     * If so, `fill()` can be called directly.
+     */
+    bool matches(const SparseCOOView& coo, bool transpose = false) const noexcept;
+
+    /**
+     * @brief Check if two patterns have the same compressed structure.
+     */
+    bool same_structure(const CSRPattern& other) const noexcept;
+
+    /**
+     * @brief Scatter the values of the COO matrix into the compressed layout (rows in parallel).
+     *
+     * @param coo A COO matrix that `matches()` this pattern
+     * @param values The output values, size = `non_zeros()`
+     */
+    void fill(const SparseCOOView& coo, span<Float> values) const;
+
+    /**
+     * @brief Build the CSR matrix directly.
+     */
+    Eigen::SparseMatrix<Float, Eigen::RowMajor> to_csr(const SparseCOOView& coo) const;
+
+    span<const IndexT> row_offsets() const noexcept;
+    span<const IndexT> col_indices() const noexcept;
+
+    SizeT    non_zeros() const noexcept;
+    Vector2i shape() const noexcept;
+    bool     transposed() const noexcept;
+
+  private:
+    Vector2i m_shape      = Vector2i::Zero();
+    bool     m_transposed = false;
+
+    // compressed structure
+    vector<IndexT> m_row_offsets;
+    vector<IndexT> m_col_indices;
+
+    // COO entries ordered by (row, col), with the compressed slot of each
+    vector<IndexT> m_entry_offsets;  // per row, into m_entries
+    vector<IndexT> m_entries;        // COO entry index
+    vector<IndexT> m_entry_slots;    // compressed slot of m_entries[i]
+
+    // the analyzed COO indices, to detect an unchanged pattern
+    vector<IndexT> m_coo_rows;
+    vector<IndexT> m_coo_cols;
+};
+}  // namespace uipc::diff_sim
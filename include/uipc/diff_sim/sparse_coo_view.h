@@ -22,6 +22,12 @@ class UIPC_CORE_API SparseCOOView
 
     Matrix<Float, Eigen::Dynamic, Eigen::Dynamic> to_dense() const;
     Eigen::SparseMatrix<Float>                    to_sparse() const;
+    /**
+     * @brief Build the compressed row matrix, rows are sorted in parallel, duplicated entries are summed.
+     *
+     * To convert the same pattern repeatedly, keep a CSRPattern instead.
+     */
+    Eigen::SparseMatrix<Float, Eigen::RowMajor> to_csr() const;
 
   private:
     span<const IndexT> m_row_indices;
@@ -39,6 +39,11 @@ class UIPC_CORE_API IAttribute
      */
     [[nodiscard]] std::string_view type_name() const noexcept;
 
+    /**
+     * @brief Get the host memory held by the attribute values in bytes, the reserved capacity is included.
+     */
+    [[nodiscard]] SizeT memory_bytes() const noexcept;
+
   private:
     friend class AttributeCollection;
     friend class IAttributeSlot;
@@ -58,6 +63,7 @@ class UIPC_CORE_API IAttribute
     virtual SizeT               get_size() const                  = 0;
     virtual backend::BufferView get_backend_view() const noexcept = 0;
     virtual std::string_view    get_type_name() const noexcept    = 0;
+    virtual SizeT               get_memory_bytes() const noexcept = 0;
 
     virtual void          do_resize(SizeT N)                       = 0;
     virtual void          do_clear()                               = 0;
@@ -105,6 +111,7 @@ class Attribute : public IAttribute
     virtual SizeT               get_size() const override;
     virtual backend::BufferView get_backend_view() const noexcept override;
     virtual std::string_view    get_type_name() const noexcept override;
+    virtual SizeT               get_memory_bytes() const noexcept override;
 
     virtual void          do_resize(SizeT N) override;
     virtual void          do_clear() override;
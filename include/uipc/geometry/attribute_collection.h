@@ -7,6 +7,8 @@
 #include <uipc/geometry/attribute_slot.h>
 #include <uipc/geometry/attribute_copy.h>
 #include <uipc/geometry/attribute_friend.h>
+#include <uipc/geometry/attribute_key.h>
+#include <uipc/common/vector.h>
 
 namespace uipc::geometry
 {
@@ -101,6 +103,29 @@ class UIPC_CORE_API AttributeCollection
     template <typename T>
     [[nodiscard]] S<const AttributeSlot<T>> find(std::string_view name) const;
 
+    /**
+     * @brief Find the attribute slot with the given key, by a binary search over the key ids of this collection.
+     * 
+     * @return nullptr if the attribute slot with the given key does not exist.
+     */
+    [[nodiscard]] S<IAttributeSlot> find(const AttributeKey& key) noexcept;
+    /**
+     * @brief const version of find by key.
+     */
+    [[nodiscard]] S<const IAttributeSlot> find(const AttributeKey& key) const noexcept;
+
+    /**
+     * @brief Template version of find by key.
+     */
+    template <typename T>
+    [[nodiscard]] S<AttributeSlot<T>> find(const AttributeKey& key);
+
+    /**
+     * @brief Template const version of find by key.
+     */
+    template <typename T>
+    [[nodiscard]] S<const AttributeSlot<T>> find(const AttributeKey& key) const;
+
     /**
      * @brief Resize all attribute slots to the given size.
      * 
@@ -162,8 +187,23 @@ class UIPC_CORE_API AttributeCollection
     Json to_json() const;
 
   private:
-    SizeT                                    m_size = 0;
-    unordered_map<string, S<IAttributeSlot>> m_attributes;
+    // allows finding by std::string_view without creating a temporary string
+    struct NameHash
+    {
+        using is_transparent = void;
+        SizeT operator()(std::string_view name) const noexcept
+        {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    SizeT m_size = 0;
+    unordered_map<string, S<IAttributeSlot>, NameHash, std::equal_to<>> m_attributes;
+    // the slots sorted by the id of their interned name, only the ids of this collection are stored
+    using KeyEntry = std::pair<IndexT, S<IAttributeSlot>>;
+    vector<KeyEntry> m_key_index;
+
+    void insert_slot(std::string_view name, S<IAttributeSlot> slot);
 };
 
 class UIPC_CORE_API GeometryAttributeError : public Exception
@@ -0,0 +1,55 @@
+#pragma once
+#include <string_view>
+#include <uipc/common/dllexport.h>
+#include <uipc/common/type_define.h>
+
+namespace uipc::builtin::detail
+{
+struct AttributeKeyMaker;
+}
+
+namespace uipc::geometry
+{
+/**
+ * @brief An interned attribute name.
+ *
+ * All keys with the same name share the same id, so an AttributeCollection can find the attribute slot
+ * of a key by its id, without hashing or allocating a string. The lookup is a binary search over the ids of
+ * the attributes in the collection, which are only a handful.
+ *
+ * The keys of the builtin attribute names are compile-time constants, see `uipc::builtin::key`.
+ */
+class UIPC_CORE_API AttributeKey
+{
+  public:
+    /**
+     * @brief Intern the name, the same name always gets the same id.
+     */
+    explicit AttributeKey(std::string_view name);
+
+    [[nodiscard]] constexpr IndexT           id() const noexcept { return m_id; }
+    [[nodiscard]] constexpr std::string_view name() const noexcept { return m_name; }
+
+    constexpr bool operator==(const AttributeKey& other) const noexcept
+    {
+        return m_id == other.m_id;
+    }
+
+    /**
+     * @brief The number of interned names, including the builtin ones.
+     */
+    [[nodiscard]] static SizeT interned_count() noexcept;
+
+  private:
+    friend struct builtin::detail::AttributeKeyMaker;
+
+    constexpr AttributeKey(IndexT id, std::string_view name) noexcept
+        : m_id(id)
+        , m_name(name)
+    {
+    }
+
+    IndexT           m_id = -1;
+    std::string_view m_name;
+};
+}  // namespace uipc::geometry
@@ -43,6 +43,20 @@ std::string_view Attribute<T>::get_type_name() const noexcept
     return type_name;
 }
 
+template <typename T>
+SizeT Attribute<T>::get_memory_bytes() const noexcept
+{
+    SizeT bytes = m_values.capacity() * sizeof(T);
+    if constexpr(std::is_same_v<T, std::string>)
+    {
+        // long strings live on the heap
+        for(auto& str : m_values)
+            if(str.capacity() > std::string{}.capacity())
+                bytes += str.capacity() + 1;
+    }
+    return bytes;
+}
+
 template <typename T>
 void Attribute<T>::do_resize(SizeT N)
 {
@@ -11,6 +11,7 @@ S<geometry::GeometrySlotT<GeometryT>> GeometryCollection::emplace(const Geometry
     auto slot = uipc::make_shared<geometry::GeometrySlotT<GeometryT>>(id, geometry);
     slot->state(geometry::GeometrySlotState::Normal);
     m_geometries.emplace(id, slot);
+    index_insert(*slot);
 
     return slot;
 }
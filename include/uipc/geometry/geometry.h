@@ -118,6 +118,15 @@ class UIPC_CORE_API Geometry : public IGeometry
             return m_attributes.template find<T>(name);
         }
 
+        /**
+         * @brief Find an attribute by type and interned key, if the attribute does not exist, return nullptr.
+         */
+        template <typename T>
+        [[nodiscard]] auto find(const AttributeKey& key) &&
+        {
+            return m_attributes.template find<T>(key);
+        }
+
         /**
          * @brief Create an attribute with the given name.
          */
@@ -227,6 +236,15 @@ class UIPC_CORE_API Geometry : public IGeometry
             return m_attributes.template find<T>(name);
         }
 
+        /**
+         * @brief Find an attribute by type and interned key, if the attribute does not exist, return nullptr.
+         */
+        template <typename T>
+        [[nodiscard]] auto find(const AttributeKey& key) &&
+        {
+            return m_attributes.template find<T>(key);
+        }
+
         /**
          * @brief Create an attribute with the given name.
          */
@@ -27,6 +27,47 @@ class UIPC_CORE_API IGeometryCollection
     virtual IndexT get_next_id() const noexcept    = 0;
 };
 
+/**
+ * @brief A compact description of what `GeometryCollection::solve_pending()` changes.
+ *
+ * Slot indices refer to the position of a slot in `geometry_slots()`, which is sorted by id.
+ * A backend can use `slot_remap()` to patch its per-geometry buffers instead of rebuilding them,
+ * the cuda backend doesn't yet and ignores the geometries created or destroyed after init.
+ */
+class UIPC_CORE_API GeometryChangeSet
+{
+    friend class GeometryCollection;
+
+  public:
+    /**
+     * @brief Ids of the geometries created by this change, sorted ascending.
+     */
+    span<const IndexT> created_ids() const noexcept;
+    /**
+     * @brief Ids of the geometries destroyed by this change, sorted ascending.
+     */
+    span<const IndexT> destroyed_ids() const noexcept;
+    /**
+     * @brief Map from the old slot index to the new slot index, -1 if the slot is destroyed.
+     */
+    span<const IndexT> slot_remap() const noexcept;
+    /**
+     * @brief New slot indices of the created geometries, matching `created_ids()`.
+     */
+    span<const IndexT> created_slots() const noexcept;
+
+    SizeT old_size() const noexcept;
+    SizeT new_size() const noexcept;
+    bool  empty() const noexcept;
+
+  private:
+    vector<IndexT> m_created_ids;
+    vector<IndexT> m_destroyed_ids;
+    vector<IndexT> m_slot_remap;
+    vector<IndexT> m_created_slots;
+    SizeT          m_new_size = 0;
+};
+
 class UIPC_CORE_API GeometryCollection : public IGeometryCollection
 {
     friend class core::SceneFactory;
@@ -56,10 +97,39 @@ class UIPC_CORE_API GeometryCollection : public IGeometryCollection
 
     void solve_pending() noexcept;
 
+    /**
+     * @brief The change set that `solve_pending()` would apply now.
+     */
+    GeometryChangeSet pending_change_set() const;
+    /**
+     * @brief The change set applied by the last `solve_pending()`.
+     */
+    const GeometryChangeSet& last_change_set() const noexcept;
+
     span<S<geometry::GeometrySlot>> geometry_slots() const noexcept;
     span<S<geometry::GeometrySlot>> pending_create_slots() const noexcept;
     span<IndexT>                    pending_destroy_ids() const noexcept;
 
+    /**
+     * @brief Ids of the geometries with the given constitution uid, sorted ascending.
+     *
+     * The uid of a geometry is indexed when it enters the collection, pending geometries join
+     * when they are solved. A constitution applied to a geometry already in the collection is
+     * seen after `update_constitution_index()`.
+     *
+     * The returned span is invalidated by the next create, destroy, `solve_pending()` or
+     * `update_constitution_index()`.
+     */
+    span<const IndexT> find_ids_by_constitution(U64 uid) const noexcept;
+    /**
+     * @brief Index the uid of geometry `id` again, call it after the constitution of the geometry is changed.
+     */
+    void update_constitution_index(IndexT id);
+    /**
+     * @brief Index the uids of all the geometries again.
+     */
+    void update_constitution_index();
+
   protected:
     virtual void   do_reserve(SizeT size) noexcept override;
     virtual void   do_clear() noexcept override;
@@ -71,8 +141,17 @@ class UIPC_CORE_API GeometryCollection : public IGeometryCollection
     unordered_map<IndexT, S<geometry::GeometrySlot>> m_pending_create;
     set<IndexT>                                      m_pending_destroy;
 
+    // secondary index: constitution uid -> sorted geometry ids
+    unordered_map<U64, vector<IndexT>> m_constitution_to_ids;
+    unordered_map<IndexT, U64>         m_id_to_constitution;
+
+    void index_insert(const GeometrySlot& slot);
+    void index_erase(IndexT id);
+
     IndexT m_next_id = 0;
 
+    GeometryChangeSet m_last_change_set;
+
     mutable bool m_dirty = true;
 
     mutable vector<S<geometry::GeometrySlot>> m_geometry_slots;
@@ -3,6 +3,7 @@
 #include <uipc/geometry/attribute_collection.h>
 #include <uipc/common/json.h>
 #include <uipc/geometry/attribute_friend.h>
+#include <uipc/builtin/attribute_key.h>
 namespace uipc::geometry
 {
 template <bool IsConst, IndexT N>
@@ -44,13 +45,13 @@ class SimplicialComplexAttributes
     [[nodiscard]] AttributeSlot<TopoValueT>& topo()
         requires(!IsConst && N > 0)
     {
-        return *m_attributes.template find<TopoValueT>("topo");
+        return *m_attributes.template find<TopoValueT>(builtin::key::topo);
     }
 
     [[nodiscard]] const AttributeSlot<TopoValueT>& topo() const
         requires(N > 0)
     {
-        return *m_attributes.template find<TopoValueT>("topo");
+        return *m_attributes.template find<TopoValueT>(builtin::key::topo);
     }
 
     /**
@@ -110,6 +111,25 @@ class SimplicialComplexAttributes
         return std::as_const(m_attributes).template find<T>(name);
     }
 
+    /**
+     * @brief Find an attribute by type and interned key, if the attribute does not exist, return nullptr.
+     */
+    template <typename T>
+    [[nodiscard]] decltype(auto) find(const AttributeKey& key)
+        requires(!IsConst)
+    {
+        return m_attributes.template find<T>(key);
+    }
+
+    /**
+     * @brief Find an attribute by type and interned key, if the attribute does not exist, return nullptr.
+     */
+    template <typename T>
+    [[nodiscard]] decltype(auto) find(const AttributeKey& key) const
+    {
+        return std::as_const(m_attributes).template find<T>(key);
+    }
+
     template <typename T>
     decltype(auto) create(std::string_view name, const T& default_value = {}, bool allow_destroy = true)
         requires(!IsConst)
@@ -1,6 +1,7 @@
 #pragma once
 #include <uipc/geometry/utils/factory.h>
 #include <uipc/geometry/utils/apply_transform.h>
+#include <uipc/geometry/utils/clone.h>
 #include <uipc/geometry/utils/closure.h>
 #include <uipc/geometry/utils/label_surface.h>
 #include <uipc/geometry/utils/label_triangle_orient.h>
@@ -14,3 +15,5 @@
 #include <uipc/geometry/utils/tetrahedralize.h>
 #include <uipc/geometry/utils/compute_instance_volume.h>
 #include <uipc/geometry/utils/optimal_transform.h>
+#include <uipc/geometry/utils/implicit_geometry_distance.h>
+#include <uipc/geometry/utils/bake_sdf.h>
@@ -0,0 +1,82 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/common/dllexport.h>
+#include <uipc/common/smart_pointer.h>
+#include <uipc/geometry/simplicial_complex.h>
+
+namespace uipc::geometry::affine_body
+{
+/**
+ * @brief The volume integrals of an affine body with unit mass density.
+ *
+ * All the mass properties (for any mass density) and the body force (for any body force density)
+ * are linear in these integrals.
+ */
+class UIPC_GEOMETRY_API MassProperties
+{
+  public:
+    //tex: $$ \int_V 1 \, dV $$
+    Float volume = 0.0;
+    //tex: $$ \int_V \mathbf{x} \, dV $$
+    Vector3 first_moment = Vector3::Zero();
+    //tex: $$ \int_V \mathbf{x} \mathbf{x}^T \, dV $$
+    Matrix3x3 second_moment = Matrix3x3::Zero();
+
+    /**
+     * @brief The dyadic mass of the body with mass density `rho`, see `compute_dyadic_mass()`.
+     */
+    void dyadic_mass(Float rho, Float& m, Vector3& m_x_bar, Matrix3x3& m_x_bar_x_bar) const noexcept;
+
+    /**
+     * @brief The body force of the body, see `compute_body_force()`.
+     */
+    Vector12 body_force(const Vector3& body_force_density) const noexcept;
+};
+
+/**
+ * @brief Cache of the mass properties keyed by the content hash of the geometry (positions and topology).
+ *
+ * Instanced bodies (copies of the same mesh) are integrated only once.
+ *
+ * @note Not thread-safe, don't share one cache between concurrent `compute_mass_properties()` calls.
+ */
+class UIPC_GEOMETRY_API MassPropertiesCache
+{
+  public:
+    MassPropertiesCache();
+    ~MassPropertiesCache();
+
+    SizeT size() const noexcept;
+    SizeT hit_count() const noexcept;
+    SizeT miss_count() const noexcept;
+    void  clear();
+
+  private:
+    friend UIPC_GEOMETRY_API vector<MassProperties> compute_mass_properties(
+        span<const SimplicialComplex* const> bodies, MassPropertiesCache* cache);
+
+    class Impl;
+    U<Impl> m_impl;
+};
+
+/**
+ * @brief Compute the mass properties of a tetmesh or a closed trimesh, see `compute_dyadic_mass()`.
+ *
+ * The elements are integrated in parallel blocks with compensated summation, the result doesn't depend
+ * on the thread count.
+ */
+UIPC_GEOMETRY_API MassProperties compute_mass_properties(const SimplicialComplex& sc);
+
+/**
+ * @brief Compute the mass properties of many bodies at once.
+ *
+ * The work is balanced over all the elements of all the bodies, so a few big bodies and many small ones
+ * are processed equally well.
+ *
+ * @param bodies The bodies, tetmeshes or closed trimeshes.
+ * @param cache If not null, bodies with the same content are integrated only once, across calls.
+ * @return The mass properties of each body, in order.
+ */
+UIPC_GEOMETRY_API vector<MassProperties> compute_mass_properties(span<const SimplicialComplex* const> bodies,
+                                                                 MassPropertiesCache* cache = nullptr);
+}  // namespace uipc::geometry::affine_body
@@ -0,0 +1,25 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/geometry/implicit_geometry.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief Bake a closed triangle mesh into a narrow-band signed distance field (a SDFGrid implicit geometry).
+ *
+ * The grid covers the bounding box of the mesh, padded by the narrow band. Grid points within the narrow band
+ * get the exact distance to the mesh, the sign comes from the angle-weighted pseudo-normal of the closest feature.
+ * The other grid points are clamped to `-narrow_band` (inside) or `narrow_band` (outside).
+ * Only the bricks of grid points touching the narrow band are baked and stored, the rows of bricks are baked in parallel.
+ *
+ * The mesh is baked in its local frame, the transform of its first instance goes to the SDFGrid instance.
+ *
+ * @param trimesh A closed, outward oriented triangle mesh
+ * @param spacing The distance between two neighbor grid points
+ * @param narrow_band The width of the band with exact distances, 0 means `3 * spacing`, at least `spacing`
+ * @return ImplicitGeometry The SDFGrid
+ */
+UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry bake_sdf(const SimplicialComplex& trimesh,
+                                                          Float spacing,
+                                                          Float narrow_band = 0.0);
+}  // namespace uipc::geometry
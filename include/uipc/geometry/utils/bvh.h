@@ -33,6 +33,8 @@ class UIPC_GEOMETRY_API BVH
      * @param aabbs AABBs
      * @param QF f:void(IndexT, IndexT), where the two indices are the indices of the two AABBs that intersect,
      * the first index is from the input list, and the second index is from the BVH tree's AABBs.
+     * 
+     * @note The query doesn't modify the tree, so it can be called from multiple threads at the same time.
      */
     void query(span<const AABB> aabbs, std::function<void(IndexT, IndexT)>&& QF) const;
     
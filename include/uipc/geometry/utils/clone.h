@@ -0,0 +1,58 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief Create `transforms.size()` clones of the prototype in one call.
+ *
+ * 1) All the attributes of the clones are shared with the prototype (copy-on-write).
+ * 2) The instance transform of the i-th clone is set to `transforms[i]`.
+ * 3) The vertex attributes listed in `owned_vertex_attributes` are made owned,
+ *    so the clones can edit them without triggering a copy later.
+ *
+ * @param prototype A simplicial complex with exactly one instance.
+ */
+UIPC_GEOMETRY_API [[nodiscard]] vector<SimplicialComplex> clone(
+    const SimplicialComplex& prototype,
+    span<const Matrix4x4>    transforms,
+    span<const std::string>  owned_vertex_attributes = {});
+
+/**
+ * @brief Instance the prototype `transforms.size()` times into one simplicial complex.
+ *
+ * The vertex and primitive attributes are stored once and shared with the prototype.
+ * The instance attributes of the prototype are broadcast to all instances,
+ * and the transform of the i-th instance is set to `transforms[i]`.
+ *
+ * @param prototype A simplicial complex with exactly one instance.
+ */
+UIPC_GEOMETRY_API [[nodiscard]] SimplicialComplex instantiate(const SimplicialComplex& prototype,
+                                                              span<const Matrix4x4> transforms);
+
+/**
+ * @brief Override an instance attribute per clone, `values[i]` goes to the (only) instance of `clones[i]`.
+ *
+ * The attribute is created if it does not exist. Only the overridden attribute is made owned.
+ */
+template <typename T>
+void override_instance_attribute(span<SimplicialComplex> clones,
+                                 std::string_view        name,
+                                 span<const T>           values)
+{
+    UIPC_ASSERT(clones.size() == values.size(),
+                "Clone count ({}) mismatches value count ({}).",
+                clones.size(),
+                values.size());
+
+    for(SizeT i = 0; i < clones.size(); ++i)
+    {
+        auto& sc   = clones[i];
+        auto  slot = sc.instances().find<T>(name);
+        if(!slot)
+            slot = sc.instances().create<T>(name, values[i]);
+        auto v = view(*slot);
+        std::ranges::fill(v, values[i]);
+    }
+}
+}  // namespace uipc::geometry
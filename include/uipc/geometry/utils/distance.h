@@ -17,6 +17,34 @@ Float UIPC_GEOMETRY_API halfplane_vertex_signed_distance(const Vector3& P,
                                                          const Vector3& V,
                                                          Float V_thickness = 0.0);
 
+/**
+ * @brief Compute the signed distance between a sphere (P, radius) and a vertex V (with thickness V_thickness).
+ */
+Float UIPC_GEOMETRY_API sphere_vertex_signed_distance(const Vector3& P,
+                                                      Float          radius,
+                                                      const Vector3& V,
+                                                      Float V_thickness = 0.0);
+
+/**
+ * @brief Compute the signed distance between a capsule (P0, P1, radius) and a vertex V (with thickness V_thickness).
+ */
+Float UIPC_GEOMETRY_API capsule_vertex_signed_distance(const Vector3& P0,
+                                                       const Vector3& P1,
+                                                       Float          radius,
+                                                       const Vector3& V,
+                                                       Float V_thickness = 0.0);
+
+/**
+ * @brief Compute the signed distance between an oriented box and a vertex V (with thickness V_thickness).
+ * 
+ * @param T The rigid transform of the box.
+ * @param half_extent The half size of the box along its local axes.
+ */
+Float UIPC_GEOMETRY_API box_vertex_signed_distance(const Matrix4x4& T,
+                                                   const Vector3&   half_extent,
+                                                   const Vector3&   V,
+                                                   Float V_thickness = 0.0);
+
 Float UIPC_GEOMETRY_API point_point_squared_distance(const Vector3& P0, const Vector3& P1);
 
 Float UIPC_GEOMETRY_API point_edge_squared_distance(const Vector3& P,
@@ -55,4 +55,58 @@ UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry halfplane(
  */
 UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry ground(Float height = 0.0,
                                                         const Vector3& N = Vector3::UnitY());
+
+// The sphere, capsule, box and SDF grid are host-only for now: the sanity checker and
+// `implicit_geometry_signed_distance()` handle them, the cuda backend rejects them at init.
+
+/**
+ * @brief Create a sphere.
+ * 
+ * @param P The center of the sphere
+ * @param radius The radius of the sphere
+ */
+UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry sphere(const Vector3& P = Vector3::Zero(),
+                                                        Float radius = 1.0);
+
+/**
+ * @brief Create a capsule, the set of points within `radius` of the segment (P0, P1).
+ * 
+ * @param P0 The first end point of the segment
+ * @param P1 The second end point of the segment
+ * @param radius The radius of the capsule
+ */
+UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry capsule(const Vector3& P0,
+                                                         const Vector3& P1,
+                                                         Float radius = 1.0);
+
+/**
+ * @brief Create an oriented box.
+ * 
+ * @param half_extent The half size of the box along its local axes
+ * @param transform The rigid transform of the box, stored in `builtin::transform` of the instance
+ */
+UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry box(const Vector3& half_extent = Vector3::Ones(),
+                                                     const Matrix4x4& transform = Matrix4x4::Identity());
+
+/**
+ * @brief Create a narrow-band signed distance field on a regular grid.
+ * 
+ * The value of grid point (i, j, k) is `values[i + resolution[0] * (j + resolution[1] * k)]`,
+ * located at `origin + spacing * (i, j, k)`. The values are negative inside and are clamped to `[-narrow_band, narrow_band]`.
+ * Only the bricks of grid points touching the narrow band are stored, see the SDFGrid specification.
+ * Use `bake_sdf()` to create one from a closed triangle mesh.
+ * 
+ * @param origin The position of grid point (0, 0, 0)
+ * @param spacing The distance between two neighbor grid points
+ * @param resolution The number of grid points along each axis, at least 1
+ * @param values The signed distance of each grid point
+ * @param narrow_band The width of the band where the values are exact
+ * @param transform The rigid transform of the grid, stored in `builtin::transform` of the instance
+ */
+UIPC_GEOMETRY_API [[nodiscard]] ImplicitGeometry sdf_grid(const Vector3&    origin,
+                                                          Float             spacing,
+                                                          const Vector3i&   resolution,
+                                                          span<const Float> values,
+                                                          Float             narrow_band,
+                                                          const Matrix4x4&  transform = Matrix4x4::Identity());
 }  // namespace uipc::geometry
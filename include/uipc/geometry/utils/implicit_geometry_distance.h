@@ -0,0 +1,32 @@
+#pragma once
+#include <uipc/common/span.h>
+#include <uipc/geometry/implicit_geometry.h>
+
+namespace uipc::geometry
+{
+/**
+ * @brief Check if `implicit_geometry_signed_distance()` supports the implicit geometry.
+ *
+ * Supported: HalfPlane, Sphere, Capsule, Box and SDFGrid.
+ */
+UIPC_GEOMETRY_API bool is_implicit_geometry_distance_supported(const ImplicitGeometry& ig);
+
+/**
+ * @brief Compute the signed distance (and its gradient) of a batch of vertices to one instance of an implicit geometry.
+ *
+ * The vertices are processed in parallel. The distance is negative inside the implicit geometry.
+ * For a SDFGrid, the distance is trilinearly interpolated and only exact inside the narrow band,
+ * outside the grid it's extrapolated by the distance to the grid bounding box.
+ *
+ * @param ig The implicit geometry
+ * @param instance_id The instance of the implicit geometry to query
+ * @param Vs The vertex positions
+ * @param distances The output signed distances, size = `Vs.size()`
+ * @param gradients The output gradients of the signed distances (optional), size = `Vs.size()` or 0
+ */
+UIPC_GEOMETRY_API void implicit_geometry_signed_distance(const ImplicitGeometry& ig,
+                                                         IndexT instance_id,
+                                                         span<const Vector3> Vs,
+                                                         span<Float>         distances,
+                                                         span<Vector3> gradients = {});
+}  // namespace uipc::geometry
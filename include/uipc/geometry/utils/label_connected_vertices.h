@@ -6,6 +6,9 @@ namespace uipc::geometry
 /**
  * @brief Label the connected vertices of a simplicial complex (by edges).
  * 
+ * If the complex has no edges, the vertices are connected by its tetrahedra or triangles instead.
+ * Regions are numbered in the order of their smallest vertex index.
+ * 
  * - Create a `region` <IndexT> attribute on `vertices` to tell which region a vertex is belong to.
  * - Create a `region_count` <IndexT> attribute on `meta` to tell how many regions are there.
  * 
@@ -2,3 +2,4 @@
 #include <uipc/io/simplicial_complex_io.h>
 #include <uipc/io/spread_sheet_io.h>
 #include <uipc/io/scene_io.h>
+#include <uipc/io/geometry_asset_cache.h>
@@ -0,0 +1,110 @@
+#pragma once
+#include <uipc/common/exception.h>
+#include <uipc/common/json.h>
+#include <uipc/geometry/simplicial_complex.h>
+#include <functional>
+
+namespace uipc::geometry
+{
+/**
+ * @brief An on-disk cache of processed assets.
+ *
+ * An asset is a mesh read from a source file (through SimplicialComplexIO) and then processed,
+ * e.g. tetrahedralized and labeled. The processed SimplicialComplex is stored as a binary file
+ * in the cache directory, keyed by a hash of:
+ *
+ * - the content of the source file (not its path or timestamp)
+ * - the pre-transform
+ * - the processing parameters
+ * - the cache format version
+ *
+ * The content hash of a source is stored next to the entries with the size and last write time
+ * of the file, and only recomputed when one of them changes. An edit keeping both the size and
+ * the last write time is not detected, call `clear()` in that case.
+ *
+ * So a later run with the same source and parameters loads the result without reading the source
+ * mesh or running the processing again. Entries are written to a temporary file and renamed, so
+ * concurrent runs sharing one cache directory never see a partial entry.
+ *
+ * ```cpp
+ * GeometryAssetCache cache{"asset_cache/"};
+ * Json params = Json::object();
+ * params["tetrahedralize"] = Json::object();
+ * auto mesh = cache.read("bunny.obj", params,
+ *     [](const SimplicialComplex& input, const Json& params)
+ *     {
+ *         auto tet = tetrahedralize(input, params["tetrahedralize"]);
+ *         label_surface(tet);
+ *         return tet;
+ *     });
+ * ```
+ */
+class UIPC_IO_API GeometryAssetCache
+{
+  public:
+    /**
+     * @brief Turn the raw mesh into the asset, the result must only depend on the input and the parameters.
+     */
+    using Processor = std::function<SimplicialComplex(const SimplicialComplex& input, const Json& params)>;
+
+    explicit GeometryAssetCache(std::string_view cache_dir);
+    GeometryAssetCache(std::string_view cache_dir, const Matrix4x4& pre_transform);
+    GeometryAssetCache(std::string_view cache_dir, const Transform& pre_transform);
+
+    /**
+     * @brief Read the processed asset, from the cache if possible.
+     *
+     * On a miss (or a corrupted entry) the source file is read, processed and the result is stored.
+     *
+     * @param file_name The source mesh, any format supported by SimplicialComplexIO::read()
+     * @param params The processing parameters, part of the cache key
+     * @param process The processing, only called on a miss. If empty, the raw mesh is cached.
+     */
+    [[nodiscard]] SimplicialComplex read(std::string_view file_name,
+                                         const Json&      params  = Json::object(),
+                                         const Processor& process = {});
+
+    /**
+     * @brief The cache key of an asset, a hex string of the content hash.
+     */
+    [[nodiscard]] std::string key(std::string_view file_name,
+                                  const Json&      params = Json::object()) const;
+
+    /**
+     * @brief Check if the asset is in the cache.
+     */
+    [[nodiscard]] bool contains(std::string_view file_name,
+                                const Json&      params = Json::object()) const;
+
+    /**
+     * @brief Remove all entries from the cache directory.
+     */
+    void clear();
+
+    std::string_view cache_dir() const noexcept;
+
+    /**
+     * @brief The number of `read()` calls served from the cache.
+     */
+    SizeT hit_count() const noexcept;
+
+    /**
+     * @brief The number of `read()` calls that needed to process the source.
+     */
+    SizeT miss_count() const noexcept;
+
+  private:
+    std::string m_cache_dir;
+    Matrix4x4   m_pre_transform = Matrix4x4::Identity();
+    SizeT       m_hit_count     = 0;
+    SizeT       m_miss_count    = 0;
+
+    std::string entry_path(std::string_view key) const;
+};
+
+class UIPC_IO_API GeometryAssetCacheError : public Exception
+{
+  public:
+    using Exception::Exception;
+};
+}  // namespace uipc::geometry
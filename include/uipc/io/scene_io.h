@@ -12,6 +12,9 @@ class UIPC_IO_API SceneIO
 
     /**
      * @brief Write the surface of the scene to a file.
+     * 
+     * The surfaces are streamed to the file geometry by geometry, the merged surface is never built.
+     * 
      * Supported formats:
      * - .obj
      */
@@ -24,29 +27,75 @@ class UIPC_IO_API SceneIO
      * -  1: line mesh
      * -  2: triangle mesh
      * - -1: all dimensions
+     * 
+     * The surfaces of tetrahedral meshes are extracted in parallel and cached per geometry.
+     * Later calls only refresh the vertex attributes and the instances if the topology is unchanged.
+     * 
      * \param dim
      * \return 
      */
     geometry::SimplicialComplex simplicial_surface(IndexT dim = -1) const;
 
+    /**
+     * @brief Drop the cached surfaces to release their memory.
+     * 
+     * Not needed for correctness, the cache detects any change of the topology (or `is_surf` labels)
+     * by their content.
+     */
+    void clear_surface_cache() const;
+
     /**
      * @brief Load a scene from a file.
      * 
      * Supported formats:
      * - .json
      * - .bson
+     * - .uipcs (chunked, objects are streamed)
      * 
      * @param filename
      * @return 
      */
     static S<Scene> load(std::string_view filename);
 
+    class LoadOptions
+    {
+      public:
+        /**
+         * @brief Ids of the objects to load.
+         * 
+         * If both `object_ids` and `object_names` are empty, all objects are loaded.
+         */
+        vector<IndexT> object_ids;
+        /**
+         * @brief Names of the objects to load, all objects with the name are loaded.
+         */
+        vector<std::string> object_names;
+        /**
+         * @brief The max number of object chunks being decoded at the same time, 0 for the TaskScheduler thread count.
+         */
+        SizeT max_workers = 0;
+    };
+
+    /**
+     * @brief Load a subset of the objects from a chunked scene file (.uipcs).
+     * 
+     * The object chunks are read one by one, and decoded on worker threads while the next chunks are read,
+     * the whole file is never held in memory.
+     * 
+     * @param filename
+     * @param options
+     * @return 
+     */
+    static S<Scene> load(std::string_view filename, const LoadOptions& options);
+
     /**
      * @brief Save the scene to a file.
      * 
      * Supported formats:
      * - .json
      * - .bson
+     * - .uipcs (chunked, one chunk per object, attribute buffers shared between objects
+     *   are stored in each of them and are no longer shared after loading)
      * 
      * @param scene
      * @param filename
@@ -59,14 +108,18 @@ class UIPC_IO_API SceneIO
      * Supported formats:
      * - .json
      * - .bson
+     * - .uipcs (chunked, one chunk per object, see `save(const Scene&, std::string_view)`)
      * 
      * @param filename
      */
     void save(std::string_view filename) const;
 
   private:
-    Scene& m_scene;
-    void   write_surface_obj(std::string_view filename);
+    class SurfaceCache;
+
+    Scene&          m_scene;
+    S<SurfaceCache> m_surface_cache;
+    void            write_surface_obj(std::string_view filename);
 };
 
 class UIPC_IO_API SceneIOError : public Exception
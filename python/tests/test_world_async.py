@@ -0,0 +1,64 @@
+import pytest
+import numpy as np
+from uipc import Logger
+from uipc import Matrix4x4
+from uipc import Engine, World, Scene
+from uipc.geometry import SimplicialComplexIO
+from uipc.geometry import label_surface, label_triangle_orient, flip_inward_triangles
+from uipc.geometry import ground, view
+from uipc.constitution import AffineBodyConstitution
+from asset import AssetDir
+
+@pytest.mark.example
+def test_world_async():
+    Logger.set_level(Logger.Level.Warn)
+    workspace = AssetDir.output_path(__file__)
+    engine = Engine("cuda", workspace)
+    world = World(engine)
+    scene = Scene(Scene.default_config())
+
+    abd = AffineBodyConstitution()
+    scene.constitution_tabular().insert(abd)
+    scene.contact_tabular().default_model(0.5, 1e9)
+
+    pre_trans = Matrix4x4.Identity()
+    pre_trans[0:3, 0:3] *= 0.2
+    io = SimplicialComplexIO(pre_trans)
+    cube = io.read(f'{AssetDir.tetmesh_path()}/cube.msh')
+    label_surface(cube)
+    label_triangle_orient(cube)
+    cube = flip_inward_triangles(cube)
+    abd.apply_to(cube, 1e8)
+
+    object = scene.objects().create("object")
+    trans = Matrix4x4.Identity()
+    trans[0:3, 3] = np.array([0, 0.5, 0])
+    view(cube.transforms())[0] = trans
+    object.geometries().create(cube)
+    object.geometries().create(ground(0.0))
+
+    world.init(scene)
+
+    # frame N is post-processed while frame N+1 is simulated
+    prev = world.advance_async()
+    prev.wait()
+    for i in range(10):
+        curr = world.advance_async()
+        geos = prev.geometries()
+        assert len(geos) == 2
+        curr.wait()
+        assert curr.frame() == prev.frame() + 1
+        prev = curr
+
+    # the world and the scene are refused while an async advance is pending
+    curr = world.advance_async()
+    with pytest.raises(RuntimeError):
+        world.advance()
+    with pytest.raises(RuntimeError):
+        world.advance_async()
+    with pytest.raises(RuntimeError):
+        scene.objects().create("late")
+    curr.wait()
+    curr.wait()
+    assert curr.frame() == prev.frame() + 1
+    world.advance()
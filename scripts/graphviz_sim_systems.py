@@ -30,10 +30,23 @@ dot.attr(fontsize='40')
 # circular layout
 dot.attr(rankdir='LR')
 
+def short_name(name):
+    return name.replace('class uipc::backend::cuda::', '').replace('uipc::backend::cuda::', '')
+
+# independent systems (same level in the dependency graph) share the same rank
+levels = {}
+for system in systems['sim_systems']:
+    levels.setdefault(system.get('level', 0), []).append(short_name(system['name']))
+
+for level, names in sorted(levels.items()):
+    with dot.subgraph() as s:
+        s.attr(rank='same')
+        for name in names:
+            s.node(name)
+
 for system in systems['sim_systems']:
-    name = system['name'].replace('class uipc::backend::cuda::', '')
-    deps = [dep.replace('class uipc::backend::cuda::', '') for dep in system['deps']]
-    dot.node(name)
+    name = short_name(system['name'])
+    deps = [short_name(dep) for dep in system['deps']]
     for dep in deps:
         dot.edge(name, dep)
     
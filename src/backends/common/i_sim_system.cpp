@@ -52,6 +52,11 @@ Json ISimSystem::to_json() const
     return do_to_json();
 }
 
+void ISimSystem::report_memory(MemoryReportInfo& info) const
+{
+    do_report_memory(info);
+}
+
 bool ISimSystem::dump(DumpInfo& info)
 {
     return do_dump(info);
@@ -72,6 +77,8 @@ void ISimSystem::clear_recover(RecoverInfo& info)
     do_clear_recover(info);
 }
 
+void ISimSystem::do_report_memory(MemoryReportInfo&) const {}
+
 bool ISimSystem::do_dump(DumpInfo&)
 {
     return true;
@@ -86,6 +93,24 @@ void ISimSystem::do_apply_recover(RecoverInfo&) {}
 
 void ISimSystem::do_clear_recover(RecoverInfo&) {}
 
+void ISimSystem::MemoryReportInfo::add(std::string_view buffer_name, SizeT bytes)
+{
+    // a buffer reported twice accumulates
+    auto& entry = m_buffers[std::string{buffer_name}];
+    entry       = entry.is_null() ? bytes : entry.get<SizeT>() + bytes;
+    m_bytes += bytes;
+}
+
+SizeT ISimSystem::MemoryReportInfo::bytes() const noexcept
+{
+    return m_bytes;
+}
+
+const Json& ISimSystem::MemoryReportInfo::buffers() const noexcept
+{
+    return m_buffers;
+}
+
 ISimSystem::BaseInfo::BaseInfo(SizeT frame, std::string_view workspace, const Json& config) noexcept
     : m_frame(frame)
     , m_config(config)
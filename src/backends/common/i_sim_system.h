@@ -45,6 +45,41 @@ class ISimSystem
         using BaseInfo::BaseInfo;
     };
 
+    class MemoryReportInfo
+    {
+      public:
+        /**
+         * @brief Report a buffer of the system in bytes.
+         */
+        void add(std::string_view buffer_name, SizeT bytes);
+
+        /**
+         * @brief Report a buffer with `capacity()`, e.g. muda::DeviceBuffer<T> or vector<T>.
+         */
+        template <typename Buffer>
+            requires requires(const Buffer& b) {
+                b.capacity();
+                b.data();
+            }
+        void add(std::string_view buffer_name, const Buffer& buffer)
+        {
+            using T = std::remove_pointer_t<decltype(buffer.data())>;
+            add(buffer_name, buffer.capacity() * sizeof(T));
+        }
+
+        SizeT       bytes() const noexcept;
+        const Json& buffers() const noexcept;
+
+      private:
+        SizeT m_bytes   = 0;
+        Json  m_buffers = Json::object();
+    };
+
+    /**
+     * @brief Report the buffers held by the system
+     */
+    void report_memory(MemoryReportInfo&) const;
+
     /**
      * @brief Dump the simulation data to files
      * 
@@ -79,6 +114,7 @@ class ISimSystem
   protected:
     virtual void             do_build()       = 0;
     virtual std::string_view get_name() const = 0;
+    virtual void             do_report_memory(MemoryReportInfo&) const;
     virtual bool             do_dump(DumpInfo&);
     virtual bool             do_try_recover(RecoverInfo&);
     virtual void             do_apply_recover(RecoverInfo&);
@@ -11,6 +11,17 @@ namespace uipc::backend
 SimEngine::SimEngine(EngineCreateInfo* info)
     : m_workspace(info->workspace)
 {
+    // the config may come from an old default config file without `telemetry`
+    auto& config   = info->config;
+    SizeT capacity = 1024;
+    bool  enable   = true;
+    if(auto it = config.find("telemetry"); it != config.end())
+    {
+        capacity = it->value("capacity", capacity);
+        enable   = it->value("enable", enable);
+    }
+    m_telemetry = uipc::make_unique<core::TelemetryStream>(capacity);
+    m_telemetry->enable(enable);
 }
 
 Json SimEngine::do_to_json() const
@@ -21,6 +32,36 @@ Json SimEngine::do_to_json() const
     return j;
 }
 
+Json SimEngine::do_memory_report() const
+{
+    using MemoryReportInfo = ISimSystem::MemoryReportInfo;
+
+    Json  j;
+    SizeT total_bytes = 0;
+    Json  systems     = Json::array();
+    if(m_system_collection.is_built())
+    {
+        for(auto* s : m_system_collection.systems())
+        {
+            MemoryReportInfo info;
+            s->report_memory(info);
+            if(info.buffers().empty())
+                continue;
+
+            Json sj;
+            sj["name"]    = s->name();
+            sj["bytes"]   = info.bytes();
+            sj["buffers"] = info.buffers();
+            systems.push_back(std::move(sj));
+            total_bytes += info.bytes();
+        }
+    }
+
+    j["sim_systems"] = std::move(systems);
+    j["total_bytes"] = total_bytes;
+    return j;
+}
+
 WorldVisitor& SimEngine::world() noexcept
 {
     UIPC_ASSERT(m_world_visitor, "WorldVisitor is not initialized.");
@@ -52,6 +93,13 @@ void SimEngine::dump_system_info() const
         ofs << to_json().dump(4);
     }
     spdlog::info("System info dumped to {}", p.string());
+
+    fs::path dot = fs::absolute(fs::path{workspace()} / "systems.dot");
+    {
+        std::ofstream ofs(dot);
+        ofs << m_system_collection.to_dot();
+    }
+    spdlog::info("System dependency graph dumped to {}", dot.string());
 }
 
 std::string SimEngine::dump_path(std::string_view _file_) const noexcept
@@ -80,6 +128,11 @@ const core::FeatureCollection& SimEngine::get_features() const
     return m_features;
 }
 
+core::TelemetryStream& SimEngine::get_telemetry()
+{
+    return *m_telemetry;
+}
+
 ISimSystem* SimEngine::find_system(ISimSystem* ptr)
 {
     if(ptr)
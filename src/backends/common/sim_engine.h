@@ -23,17 +23,23 @@ class SimEngine : public core::IEngine
 
   protected:
     virtual Json do_to_json() const override;
+    /**
+     * @brief Collect the buffers reported by each SimSystem.
+     */
+    virtual Json do_memory_report() const override;
 
     /**
      * @brief Build the SimSystems in the engine.
      * 
      * This function will check the dependencies of each SimSystem and check the validity of the SimSystems.
-     * If some SimSystems are invalid, any SimSystems that depend on them will also be invalidated.
+     * A SimSystem is built after the SimSystems it requires or finds, so if some SimSystems are invalid,
+     * any SimSystems that depend on them will also be invalidated.
      */
     void build_systems();
 
     /**
-     * @brief Dump the system information to "systems.json" in engine working directory.
+     * @brief Dump the system information to "systems.json" and the dependency graph to "systems.dot"
+     * in engine working directory.
      */
     virtual void dump_system_info() const;
 
@@ -109,12 +115,14 @@ class SimEngine : public core::IEngine
     ISimSystem*  require_system(ISimSystem* ptr);
     virtual core::EngineStatusCollection&  get_status() final override;
     virtual const core::FeatureCollection& get_features() const final override;
+    virtual core::TelemetryStream&         get_telemetry() final override;
 
     U<WorldVisitor>              m_world_visitor;
     SimSystemCollection          m_system_collection;
     std::string                  m_workspace;
     core::EngineStatusCollection m_status;
     core::FeatureCollection      m_features;
+    U<core::TelemetryStream>     m_telemetry;
 };
 
 class SimEngineException : public Exception
@@ -70,6 +70,9 @@ SimSystem* SimSystem::find_system(SimSystem* ptr)
 {
     if(ptr)
     {
+        // build the dependency first, so that its validity is final
+        collection().build_system(ptr);
+
         if(!ptr->is_valid())
         {
             ptr = nullptr;
@@ -86,6 +89,9 @@ SimSystem* SimSystem::require_system(SimSystem* ptr)
 {
     if(ptr)
     {
+        // build the dependency first, so that its validity is final
+        collection().build_system(ptr);
+
         if(!ptr->is_valid())
         {
             set_invalid();
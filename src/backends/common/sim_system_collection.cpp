@@ -1,5 +1,7 @@
 #include <backends/common/sim_system_collection.h>
 #include <typeinfo>
+#include <algorithm>
+#include <iterator>
 #include <uipc/common/log.h>
 #include <uipc/common/set.h>
 #include <uipc/common/enumerate.h>
@@ -23,17 +25,58 @@ void SimSystemCollection::create(U<ISimSystem> system)
 Json SimSystemCollection::to_json() const
 {
     Json j = Json::array();
-    for(const auto& [key, value] : m_sim_system_map)
-        j.push_back(value->to_json());
+    if(!built)
+    {
+        for(const auto& [key, value] : m_sim_system_map)
+            j.push_back(value->to_json());
+        return j;
+    }
+
+    for(auto* s : m_valid_systems)
+    {
+        Json sj     = s->to_json();
+        sj["level"] = m_system_levels.at(s);
+        j.push_back(std::move(sj));
+    }
     return j;
 }
 
+bool SimSystemCollection::is_built() const noexcept
+{
+    return built;
+}
+
 span<ISimSystem* const> SimSystemCollection::systems() const
 {
     UIPC_ASSERT(built, "SimSystemCollection is not built yet! Call build_systems() first!");
     return m_valid_systems;
 }
 
+std::string SimSystemCollection::to_dot() const
+{
+    UIPC_ASSERT(built, "SimSystemCollection is not built yet! Call build_systems() first!");
+
+    std::string dot = "digraph SimSystems {\n    rankdir=LR;\n";
+    for(auto&& [i, level] : enumerate(m_levels))
+    {
+        // independent systems share the same rank
+        dot += fmt::format("    {{ rank=same; // level {}\n", i);
+        for(auto* s : level)
+            dot += fmt::format("        \"{}\";\n", s->name());
+        dot += "    }\n";
+    }
+    for(auto* s : m_valid_systems)
+    {
+        for(auto* dep : s->dependencies())
+        {
+            if(dep->is_valid())
+                dot += fmt::format("    \"{}\" -> \"{}\";\n", s->name(), dep->name());
+        }
+    }
+    dot += "}\n";
+    return dot;
+}
+
 void SimSystemCollection::cleanup_invalid_systems()
 {
     // remove invalid systems
@@ -49,34 +92,83 @@ void SimSystemCollection::cleanup_invalid_systems()
     }
 }
 
-void SimSystemCollection::build_systems()
+void SimSystemCollection::build_system(ISimSystem* s)
 {
-    for(auto&& [k, s] : m_sim_system_map)
-        s->set_building(true);
+    auto& state = m_build_states[s];
+    if(state == BuildState::Built)
+        return;
 
-    for(auto&& [k, s] : m_sim_system_map)
+    if(state == BuildState::Building)
     {
-        try
-        {
-            s->build();
-        }
-        catch(SimSystemException& e)
+        // the system is one of the requirers, keep the old behavior and let it finish its own build
+        spdlog::debug("[{}] is in a dependency cycle", s->name());
+        return;
+    }
+
+    state = BuildState::Building;
+    try
+    {
+        // the dependencies are built inside, when `require<>()` or `find<>()` is called
+        s->build();
+    }
+    catch(SimSystemException& e)
+    {
+        s->set_invalid();
+        spdlog::debug("[{}] shutdown, reason: {}", s->name(), e.what());
+    }
+    m_build_states[s] = BuildState::Built;
+    m_build_order.push_back(s);
+}
+
+void SimSystemCollection::compute_levels()
+{
+    // m_valid_systems is in topological order, so the levels of dependencies are already known
+    for(auto* s : m_valid_systems)
+    {
+        SizeT level = 0;
+        for(auto* dep : s->dependencies())
         {
-            s->set_invalid();
-            spdlog::debug("[{}] shutdown, reason: {}", s->name(), e.what());
+            auto it = m_system_levels.find(dep);
+            if(it != m_system_levels.end())
+                level = std::max(level, it->second + 1);
         }
+        m_system_levels[s] = level;
+        if(m_levels.size() <= level)
+            m_levels.resize(level + 1);
+        m_levels[level].push_back(s);
     }
+}
+
+void SimSystemCollection::build_systems()
+{
+    for(auto&& [k, s] : m_sim_system_map)
+        s->set_building(true);
+
+    // start from a fixed order, so that the build order doesn't depend on the hash of the types
+    vector<ISimSystem*> roots;
+    roots.reserve(m_sim_system_map.size());
+    for(auto&& [k, s] : m_sim_system_map)
+        roots.push_back(s.get());
+    std::ranges::sort(roots, [](ISimSystem* a, ISimSystem* b)
+                      { return a->name() < b->name(); });
+
+    for(auto* s : roots)
+        build_system(s);
 
     cleanup_invalid_systems();
 
-    m_valid_systems.resize(m_sim_system_map.size());
-    std::ranges::transform(m_sim_system_map,
-                           m_valid_systems.begin(),
-                           [](auto& p) { return p.second.get(); });
+    m_valid_systems.clear();
+    m_valid_systems.reserve(m_sim_system_map.size());
+    std::ranges::copy_if(m_build_order,
+                         std::back_inserter(m_valid_systems),
+                         [](ISimSystem* s) { return s->is_valid(); });
 
     for(auto&& s : m_valid_systems)
         s->set_building(false);
 
+    compute_levels();
+    m_build_states.clear();
+
     built = true;
 }
 }  // namespace uipc::backend
@@ -87,8 +179,8 @@ appender formatter<uipc::backend::SimSystemCollection>::format(
     const uipc::backend::SimSystemCollection& s, format_context& ctx) const
 {
     int i = 0;
-    int n = s.m_sim_system_map.size();
-    for(const auto& [key, value] : s.m_sim_system_map)
+    int n = s.m_valid_systems.size();
+    for(const auto* value : s.m_valid_systems)
     {
         fmt::format_to(ctx.out(),
                        "{} {}{}",
@@ -12,11 +12,21 @@ namespace uipc::backend
 class SimSystemCollection
 {
     friend struct fmt::formatter<SimSystemCollection>;
+    friend class SimSystem;
 
   public:
     Json                    to_json() const;
+    bool                    is_built() const noexcept;
     span<ISimSystem* const> systems() const;
 
+    /**
+     * @brief The dependency graph of the valid systems in graphviz dot format.
+     * 
+     * Systems of the same depth (level) share a rank. Level 0 systems have no dependency,
+     * level i systems only depend on systems of level < i.
+     */
+    std::string to_dot() const;
+
     void create(U<ISimSystem> system);
     void build_systems();
 
@@ -35,11 +45,27 @@ class SimSystemCollection
     T* find(const QueryOptions& options = {.exact = true});
 
   private:
+    enum class BuildState
+    {
+        None,
+        Building,
+        Built
+    };
+
     mutable bool                           built = false;
     unordered_map<uint64_t, U<ISimSystem>> m_sim_system_map;
+    // valid systems in topological order, dependencies come first
     vector<ISimSystem*>                    m_valid_systems;
     list<U<ISimSystem>>                    m_invalid_systems;
+    unordered_map<ISimSystem*, BuildState> m_build_states;
+    vector<ISimSystem*>                    m_build_order;
+    // valid systems grouped by their depth in the dependency graph, only for the dumps
+    vector<vector<ISimSystem*>>            m_levels;
+    unordered_map<ISimSystem*, SizeT>      m_system_levels;
 
+    // build the system after all the systems it requires/finds, called recursively
+    void build_system(ISimSystem* system);
+    void compute_levels();
     void cleanup_invalid_systems();
 };
 }  // namespace uipc::backend
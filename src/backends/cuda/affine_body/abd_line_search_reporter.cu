@@ -15,6 +15,9 @@ void ABDLineSearchReporter::do_build(LineSearchReporter::BuildInfo& info)
     auto aba                    = find<AffineBodyAnimator>();
     if(aba)
         m_impl.affine_body_animator = *aba;
+
+    // kinetic, shape (OrthoPotential, ARAP) and animator energies are all non-negative
+    info.non_negative_energy(true);
 }
 
 void ABDLineSearchReporter::do_record_start_point(LineSearcher::RecordInfo& info)
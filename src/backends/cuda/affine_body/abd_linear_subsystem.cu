@@ -5,6 +5,7 @@
 #include <utils/matrix_assembler.h>
 #include <utils/matrix_unpacker.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 
 namespace uipc::backend::cuda
 {
@@ -42,9 +43,9 @@ void ABDLinearSubsystem::Impl::receive_init_dof_info(WorldVisitor& w,
         [&](const AffineBodyDynamics::ForEachInfo& foreach_info, geometry::SimplicialComplex& sc)
         {
             auto I          = foreach_info.global_index();
-            auto dof_offset = sc.meta().find<IndexT>(builtin::dof_offset);
+            auto dof_offset = sc.meta().find<IndexT>(builtin::key::dof_offset);
             UIPC_ASSERT(dof_offset, "dof_offset not found on ABD mesh why can it happen?");
-            auto dof_count = sc.meta().find<IndexT>(builtin::dof_count);
+            auto dof_count = sc.meta().find<IndexT>(builtin::key::dof_count);
             UIPC_ASSERT(dof_count, "dof_count not found on ABD mesh why can it happen?");
 
             IndexT this_dof_count = 12 * sc.instances().size();
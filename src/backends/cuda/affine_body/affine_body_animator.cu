@@ -1,6 +1,7 @@
 #include <affine_body/affine_body_animator.h>
 #include <affine_body/affine_body_constraint.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <muda/cub/device/device_reduce.h>
 
 namespace uipc::backend::cuda
@@ -64,7 +65,7 @@ void AffineBodyAnimator::Impl::init(backend::WorldVisitor& world)
     {
         auto  geo_slot = geo_slots[info.geo_slot_index];
         auto& geo      = geo_slot->geometry();
-        auto  uid      = geo.meta().find<U64>(builtin::constraint_uid);
+        auto  uid      = geo.meta().find<U64>(builtin::key::constraint_uid);
         if(uid)
         {
             auto uid_value = uid->view().front();
@@ -90,7 +91,7 @@ void AffineBodyAnimator::Impl::init(backend::WorldVisitor& world)
     {
         auto  geo_slot = geo_slots[info.geo_slot_index];
         auto& geo      = geo_slot->geometry();
-        auto  uid      = geo.meta().find<U64>(builtin::constraint_uid);
+        auto  uid      = geo.meta().find<U64>(builtin::key::constraint_uid);
         if(uid)
         {
             auto uid_value = uid->view().front();
@@ -19,6 +19,7 @@ class AffineBodyConstitution : public SimSystem
     virtual U64  get_uid() const                                     = 0;
     virtual void do_build(BuildInfo& info)                           = 0;
     virtual void do_init(AffineBodyDynamics::FilteredInfo& info) = 0;
+    // the shape energy must be non-negative, ABDLineSearchReporter declares it for the line search early exit
     virtual void do_compute_energy(AffineBodyDynamics::ComputeEnergyInfo& info) = 0;
     virtual void do_compute_gradient_hessian(AffineBodyDynamics::ComputeGradientHessianInfo& info) = 0;
 
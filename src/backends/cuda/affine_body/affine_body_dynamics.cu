@@ -9,6 +9,7 @@
 #include <uipc/common/enumerate.h>
 #include <uipc/common/range.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/common/algorithm/run_length_encode.h>
 #include <uipc/geometry/simplicial_complex.h>
 #include <uipc/common/zip.h>
@@ -17,8 +18,7 @@
 #include <muda/ext/eigen/log_proxy.h>
 #include <sim_engine.h>
 #include <uipc/builtin/constitution_type.h>
-#include <uipc/geometry/utils/affine_body/compute_dyadic_mass.h>
-#include <uipc/geometry/utils/affine_body/compute_body_force.h>
+#include <uipc/geometry/utils/affine_body/compute_mass_properties.h>
 #include <muda/ext/eigen/inverse.h>
 #include <uipc/builtin/attribute_name.h>
 
@@ -64,6 +64,31 @@ void AffineBodyDynamics::do_build()
     on_write_scene([this] { m_impl.write_scene(world()); });
 }
 
+void AffineBodyDynamics::do_report_memory(MemoryReportInfo& info) const
+{
+    info.add("vertex_id_to_J", m_impl.vertex_id_to_J);
+    info.add("vertex_id_to_body_id", m_impl.vertex_id_to_body_id);
+    info.add("body_id_to_dim", m_impl.body_id_to_dim);
+    info.add("body_id_to_abd_mass", m_impl.body_id_to_abd_mass);
+    info.add("body_id_to_abd_mass_inv", m_impl.body_id_to_abd_mass_inv);
+    info.add("body_id_to_volume", m_impl.body_id_to_volume);
+    info.add("body_id_to_q", m_impl.body_id_to_q);
+    info.add("body_id_to_q_temp", m_impl.body_id_to_q_temp);
+    info.add("body_id_to_q_tilde", m_impl.body_id_to_q_tilde);
+    info.add("body_id_to_q_prev", m_impl.body_id_to_q_prev);
+    info.add("body_id_to_q_v", m_impl.body_id_to_q_v);
+    info.add("body_id_to_dq", m_impl.body_id_to_dq);
+    info.add("body_id_to_abd_force", m_impl.body_id_to_abd_force);
+    info.add("body_id_to_abd_gravity", m_impl.body_id_to_abd_gravity);
+    info.add("body_id_to_is_fixed", m_impl.body_id_to_is_fixed);
+    info.add("body_id_to_is_dynamic", m_impl.body_id_to_is_dynamic);
+    info.add("body_id_to_kinetic_energy", m_impl.body_id_to_kinetic_energy);
+    info.add("body_id_to_shape_energy", m_impl.body_id_to_shape_energy);
+    info.add("body_id_to_body_hessian", m_impl.body_id_to_body_hessian);
+    info.add("body_id_to_body_gradient", m_impl.body_id_to_body_gradient);
+    info.add("diag_hessian", m_impl.diag_hessian);
+}
+
 bool AffineBodyDynamics::do_dump(DumpInfo& info)
 {
     return m_impl.dump(info);
@@ -166,7 +191,7 @@ void AffineBodyDynamics::Impl::_build_constitutions(WorldVisitor& world)
     for(auto&& [i, geo_slot] : enumerate(geo_slots))
     {
         auto& geo  = geo_slot->geometry();
-        auto  cuid = geo.meta().find<U64>(builtin::constitution_uid);
+        auto  cuid = geo.meta().find<U64>(builtin::key::constitution_uid);
         if(cuid)  // if has constitution uid
         {
             auto uid            = cuid->view()[0];
@@ -293,7 +318,7 @@ void AffineBodyDynamics::Impl::_setup_geometry_attributes(WorldVisitor& world)
                  auto geoI = I.global_index();
 
                  auto abd_body_offset =
-                     sc.meta().find<IndexT>(builtin::backend_abd_body_offset);
+                     sc.meta().find<IndexT>(builtin::key::backend_abd_body_offset);
                  if(!abd_body_offset)
                      abd_body_offset =
                          sc.meta().create<IndexT>(builtin::backend_abd_body_offset);
@@ -332,7 +357,7 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
             geo_slots,
             [](geometry::SimplicialComplex& sc)
             {
-                auto vel = sc.instances().find<Matrix4x4>(builtin::velocity);
+                auto vel = sc.instances().find<Matrix4x4>(builtin::key::velocity);
                 return vel ? vel->view() : span<const Matrix4x4>{};
             },
             [&](const ForEachInfo& I, const Matrix4x4& velocity)
@@ -398,10 +423,10 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
                 auto vert_offset = geo_infos[geoI].vertex_offset;
 
                 auto vert_contact_element_id =
-                    sc.vertices().find<IndexT>(builtin::contact_element_id);
+                    sc.vertices().find<IndexT>(builtin::key::contact_element_id);
 
                 auto contact_element_id =
-                    sc.meta().find<IndexT>(builtin::contact_element_id);
+                    sc.meta().find<IndexT>(builtin::key::contact_element_id);
 
                 for(auto i : range(body_count))
                 {
@@ -442,7 +467,20 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
             });
     }
 
-    // 4) Setup:
+    // 4) Compute the mass properties of all the geometries in one batch,
+    // copies of the same mesh (e.g. debris pieces) are integrated only once
+    vector<geometry::affine_body::MassProperties> geo_mass_props;
+    {
+        vector<const geometry::SimplicialComplex*> geos(geo_infos.size());
+        for_each(geo_slots,
+                 [&](const ForEachInfo& I, geometry::SimplicialComplex& sc)
+                 { geos[I.global_index()] = &sc; });
+
+        geometry::affine_body::MassPropertiesCache cache;
+        geo_mass_props = geometry::affine_body::compute_mass_properties(geos, &cache);
+    }
+
+    // 5) Setup:
     // - `body_abd_mass`
     // - `body_id_to_volume`
     // - `body_id_to_dim`
@@ -467,7 +505,7 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
 
                      ABDJacobiDyadicMass geo_mass;
                      {
-                         auto rho = sc.meta().find<Float>(builtin::mass_density);
+                         auto rho = sc.meta().find<Float>(builtin::key::mass_density);
                          UIPC_ASSERT(rho, "The `mass_density` attribute is not found in the affine body geometry, why can it happen?");
 
                          auto rho_view = rho->view();
@@ -476,15 +514,14 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
                          Vector3   m_x_bar;
                          Matrix3x3 m_x_bar_x_bar;
 
-                         uipc::geometry::affine_body::compute_dyadic_mass(
-                             sc, rho_view[0], m, m_x_bar, m_x_bar_x_bar);
+                         geo_mass_props[geoI].dyadic_mass(rho_view[0], m, m_x_bar, m_x_bar_x_bar);
                          geo_mass = ABDJacobiDyadicMass::from_dyadic_mass(m, m_x_bar, m_x_bar_x_bar);
 
                          //std::cout << "mass: \n"
                          //          << geo_mass.to_mat() << std::endl;
                      }
 
-                     auto volume = sc.instances().find<Float>(builtin::volume);
+                     auto volume = sc.instances().find<Float>(builtin::key::volume);
                      UIPC_ASSERT(volume, "The `volume` attribute is not found in the affine body instance, why can it happen?");
 
                      auto volume_view = volume->view();
@@ -504,14 +541,14 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
     }
 
 
-    // 5) Compute the inverse of the mass matrix
+    // 6) Compute the inverse of the mass matrix
     h_body_id_to_abd_mass_inv.resize(abd_body_count);
     std::ranges::transform(h_body_id_to_abd_mass,
                            h_body_id_to_abd_mass_inv.begin(),
                            [](const ABDJacobiDyadicMass& mass) -> Matrix12x12
                            { return muda::eigen::inverse(mass.to_mat()); });
 
-    // 6) Setup the affine body gravity
+    // 7) Setup the affine body gravity
     {
         span Js = h_vertex_id_to_J;
 
@@ -531,11 +568,11 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
                      // auto sub_mass = vertex_mass.subspan(vert_offset, vert_count);
 
 
-                     auto gravity_attr = sc.instances().find<Vector3>(builtin::gravity);
+                     auto gravity_attr = sc.instances().find<Vector3>(builtin::key::gravity);
                      auto gravity_view = gravity_attr ? gravity_attr->view() :
                                                         span<const Vector3>{};
 
-                     auto rho = sc.meta().find<Float>(builtin::mass_density);
+                     auto rho = sc.meta().find<Float>(builtin::key::mass_density);
                      UIPC_ASSERT(rho, "The `mass_density` attribute is not found in the affine body geometry, why can it happen?");
                      auto rho_view = rho->view();
 
@@ -546,8 +583,7 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
 
                          Vector3 force_density = local_gravity * rho_view[0];
 
-                         Vector12 G =
-                             uipc::geometry::affine_body::compute_body_force(sc, force_density);
+                         Vector12 G = geo_mass_props[geoI].body_force(force_density);
 
                          // std::cout << "force: " << G.transpose() << std::endl;
 
@@ -565,7 +601,7 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
     }
 
 
-    // 7) Setup the boundary type
+    // 8) Setup the boundary type
     {
         h_body_id_to_is_fixed.resize(abd_body_count, 0);
         h_body_id_to_is_dynamic.resize(abd_body_count, 1);
@@ -573,8 +609,8 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
             geo_slots,
             [](geometry::SimplicialComplex& sc)
             {
-                auto is_fixed = sc.instances().find<IndexT>(builtin::is_fixed);
-                auto is_dynamic = sc.instances().find<IndexT>(builtin::is_dynamic);
+                auto is_fixed = sc.instances().find<IndexT>(builtin::key::is_fixed);
+                auto is_dynamic = sc.instances().find<IndexT>(builtin::key::is_dynamic);
 
                 UIPC_ASSERT(is_fixed, "The is_fixed attribute is not found in the affine body geometry, why can it happen?");
                 UIPC_ASSERT(is_dynamic, "The is_dynamic attribute is not found in the affine body geometry, why can it happen?");
@@ -593,7 +629,7 @@ void AffineBodyDynamics::Impl::_build_geometry_on_host(WorldVisitor& world)
     }
 
 
-    // 8) Energy per constitution
+    // 9) Energy per constitution
     h_constitution_shape_energy.resize(constitution_view.size(), 0.0);
 }
 
@@ -169,6 +169,7 @@ class AffineBodyDynamics : public SimSystem
 
   protected:
     virtual void do_build() override;
+    virtual void do_report_memory(MemoryReportInfo& info) const override;
 
     virtual bool do_dump(DumpInfo& info) override;
     virtual bool do_try_recover(RecoverInfo& info) override;
@@ -1,5 +1,6 @@
 #include <affine_body/affine_body_surface_reporter.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <global_geometry/global_vertex_manager.h>
 #include <uipc/common/range.h>
 
@@ -47,7 +48,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
                 auto body_count = sc.instances().size();
 
                 {  // vertex
-                    auto is_surf = sc.vertices().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.vertices().find<IndexT>(builtin::key::is_surf);
 
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
 
@@ -58,7 +59,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
                 }
 
                 {  // edge
-                    auto is_surf = sc.edges().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.edges().find<IndexT>(builtin::key::is_surf);
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
                     auto count = std::ranges::count_if(is_surf_view,
                                                        [](const IndexT& is_surf)
@@ -67,7 +68,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
                 }
 
                 {  // triangle
-                    auto is_surf = sc.triangles().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.triangles().find<IndexT>(builtin::key::is_surf);
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
                     auto count = std::ranges::count_if(is_surf_view,
                                                        [](const IndexT& is_surf)
@@ -131,7 +132,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
 
                     surf_vertex_cache.clear();
                     surf_vertex_cache.reserve(body_surf_vertex_count);
-                    auto is_surf = sc.vertices().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.vertices().find<IndexT>(builtin::key::is_surf);
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
 
                     for(auto&& [i, is_surf] : enumerate(is_surf_view))
@@ -176,7 +177,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
                     surf_edge_cache.clear();
                     surf_edge_cache.reserve(body_surf_edge_count);
 
-                    auto is_surf = sc.edges().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.edges().find<IndexT>(builtin::key::is_surf);
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
 
                     for(auto&& [i, is_surf] : enumerate(is_surf_view))
@@ -225,7 +226,7 @@ void AffinebodySurfaceReporter::Impl::init_surface(backend::WorldVisitor& world)
                     surf_triangle_cache.clear();
                     surf_triangle_cache.reserve(body_surf_triangle_count);
 
-                    auto is_surf = sc.triangles().find<IndexT>(builtin::is_surf);
+                    auto is_surf = sc.triangles().find<IndexT>(builtin::key::is_surf);
                     auto is_surf_view = is_surf ? is_surf->view() : span<const IndexT>{};
 
                     for(auto&& [i, is_surf] : enumerate(is_surf_view))
@@ -1,6 +1,7 @@
 #include <affine_body/affine_body_constraint.h>
 #include <affine_body/utils.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <kernel_cout.h>
 #include <animator/utils.h>
 
@@ -59,11 +60,11 @@ class SoftTransformConstraint final : public AffineBodyConstraint
             geo_slots,
             [&](geometry::SimplicialComplex& sc)
             {
-                auto body_offset = sc.meta().find<IndexT>(builtin::backend_abd_body_offset);
+                auto body_offset = sc.meta().find<IndexT>(builtin::key::backend_abd_body_offset);
                 current_body_offset = body_offset->view().front();
 
-                auto is_constrained = sc.instances().find<IndexT>(builtin::is_constrained);
-                auto aim_transform = sc.instances().find<Matrix4x4>(builtin::aim_transform);
+                auto is_constrained = sc.instances().find<IndexT>(builtin::key::is_constrained);
+                auto aim_transform = sc.instances().find<Matrix4x4>(builtin::key::aim_transform);
                 auto strength_ratio = sc.instances().find<Vector2>("strength_ratio");
 
                 return zip(is_constrained->view(),
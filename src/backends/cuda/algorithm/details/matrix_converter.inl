@@ -16,8 +16,18 @@ void MatrixConverter<T, N>::convert(const muda::DeviceTripletMatrix<T, N>& from,
                                     muda::DeviceBCOOMatrix<T, N>&          to)
 {
     to.reshape(from.rows(), from.cols());
-    to.resize_triplets(from.triplet_count());
 
+    m_last_pattern_reuse = false;
+
+    if(m_reuse_pattern && _pattern_unchanged(from))
+    {
+        Timer timer{"Reuse Hessian Pattern"};
+        _apply_pattern(from, to);
+        m_last_pattern_reuse = true;
+        return;
+    }
+
+    to.resize_triplets(from.triplet_count());
 
     if(to.triplet_count() == 0)
         return;
@@ -26,6 +36,95 @@ void MatrixConverter<T, N>::convert(const muda::DeviceTripletMatrix<T, N>& from,
 
     _make_unique_indices(from, to);
     _make_unique_block_warp_reduction(from, to);
+
+    if(m_reuse_pattern)
+        _record_pattern();
+}
+
+template <typename T, int N>
+bool MatrixConverter<T, N>::_pattern_unchanged(const muda::DeviceTripletMatrix<T, N>& from)
+{
+    using namespace muda;
+
+    if(!m_pattern_valid || from.triplet_count() == 0
+       || from.triplet_count() != pattern_ij_hash.size())
+        return false;
+
+    pattern_mismatch = 0;
+
+    ParallelFor(256)
+        .file_line(__FILE__, __LINE__)
+        .apply(from.triplet_count(),
+               [row_indices = from.row_indices().cviewer().name("row_indices"),
+                col_indices = from.col_indices().cviewer().name("col_indices"),
+                ij_hash     = pattern_ij_hash.cviewer().name("ij_hash"),
+                mismatch = pattern_mismatch.viewer().name("mismatch")] __device__(int i) mutable
+               {
+                   auto hash =
+                       (uint64_t{row_indices(i)} << 32) + uint64_t{col_indices(i)};
+                   // all writers write the same value, so the race is benign
+                   if(hash != ij_hash(i))
+                       mismatch = 1;
+               });
+
+    int h_mismatch = pattern_mismatch;
+    return h_mismatch == 0;
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::_record_pattern()
+{
+    loose_resize(pattern_ij_hash, ij_hash_input.size());
+    loose_resize(pattern_sort_index, sort_index.size());
+    loose_resize(pattern_partition, sorted_partition_output.size());
+    loose_resize(pattern_unique_ij_pairs, unique_ij_pairs.size());
+
+    pattern_ij_hash.view().copy_from(ij_hash_input.view());
+    pattern_sort_index.view().copy_from(sort_index.view());
+    pattern_partition.view().copy_from(sorted_partition_output.view());
+    pattern_unique_ij_pairs.view().copy_from(unique_ij_pairs.view());
+
+    m_pattern_valid = true;
+}
+
+template <typename T, int N>
+void MatrixConverter<T, N>::_apply_pattern(const muda::DeviceTripletMatrix<T, N>& from,
+                                           muda::DeviceBCOOMatrix<T, N>& to)
+{
+    using namespace muda;
+
+    auto src_blocks = from.values();
+
+    // 1. sort the block values with the recorded permutation
+    loose_resize(blocks_sorted, src_blocks.size());
+    ParallelFor(256)
+        .file_line(__FILE__, __LINE__)
+        .apply(src_blocks.size(),
+               [src_blocks = src_blocks.cviewer().name("blocks"),
+                sort_index = pattern_sort_index.cviewer().name("sort_index"),
+                dst_blocks = blocks_sorted.viewer().name("values")] __device__(int i) mutable
+               { dst_blocks(i) = src_blocks(sort_index(i)); });
+
+    // 2. set the recorded unique indices
+    to.resize_triplets(pattern_unique_ij_pairs.size());
+    ParallelFor(256)
+        .file_line(__FILE__, __LINE__)
+        .apply(pattern_unique_ij_pairs.size(),
+               [unique_ij_pairs = pattern_unique_ij_pairs.cviewer().name("unique_ij_pairs"),
+                row_indices = to.row_indices().viewer().name("row_indices"),
+                col_indices = to.col_indices().viewer().name("col_indices")] __device__(int i) mutable
+               {
+                   row_indices(i) = unique_ij_pairs(i).x;
+                   col_indices(i) = unique_ij_pairs(i).y;
+               });
+
+    // 3. reduce the blocks with the recorded partition
+    auto blocks = to.values();
+    FastSegmentalReduce<>()
+        .file_line(__FILE__, __LINE__)
+        .reduce(std::as_const(pattern_partition).view(),
+                std::as_const(blocks_sorted).view(),
+                blocks);
 }
 
 template <typename T, int N>
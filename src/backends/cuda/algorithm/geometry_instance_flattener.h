@@ -77,7 +77,7 @@ class GeometryInstanceFlattener
      *  flattener.flatten(
      *      [&](geometry::Geometry* geo)
      *      {
-     *          auto transform = geo->instances().find<Matrix4x4>(builtin::transform);
+     *          auto transform = geo->instances().find<Matrix4x4>(builtin::key::transform);
      *          return std::make_tuple(transform->view());
      *      },
      *      [&](const Matrix4x4& transform)
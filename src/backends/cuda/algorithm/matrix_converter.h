@@ -40,10 +40,37 @@ class MatrixConverter
     muda::DeviceBuffer<int> sorted_partition_input;
     muda::DeviceBuffer<int> sorted_partition_output;
 
+    // Triplet pattern of the last full conversion,
+    // the buffers above are aliased by other conversions, so we keep our own copy
+    bool                         m_reuse_pattern      = false;
+    bool                         m_pattern_valid      = false;
+    bool                         m_last_pattern_reuse = false;
+    muda::DeviceBuffer<uint64_t> pattern_ij_hash;
+    muda::DeviceBuffer<int>      pattern_sort_index;
+    muda::DeviceBuffer<int>      pattern_partition;
+    muda::DeviceBuffer<int2>     pattern_unique_ij_pairs;
+    muda::DeviceVar<int>         pattern_mismatch;
+
   public:
     void  reserve_ratio(Float ratio) { m_reserve_ratio = ratio; }
     Float reserve_ratio() const { return m_reserve_ratio; }
 
+    /**
+     * @brief Reuse the sorting permutation and the unique pattern of the last Triplet -> BCOO
+     * conversion, if the (row, col) pattern of the input triplets is unchanged.
+     */
+    void reuse_pattern(bool enable)
+    {
+        m_reuse_pattern = enable;
+        m_pattern_valid = false;
+    }
+    bool reuse_pattern() const { return m_reuse_pattern; }
+
+    /**
+     * @brief Whether the last Triplet -> BCOO conversion reused the pattern.
+     */
+    bool last_pattern_reused() const { return m_last_pattern_reuse; }
+
 
     // Triplet -> BCOO
     void convert(const muda::DeviceTripletMatrix<T, N>& from,
@@ -60,6 +87,13 @@ class MatrixConverter
     void _make_unique_block_warp_reduction(const muda::DeviceTripletMatrix<T, N>& from,
                                            muda::DeviceBCOOMatrix<T, N>& to);
 
+    bool _pattern_unchanged(const muda::DeviceTripletMatrix<T, N>& from);
+
+    void _record_pattern();
+
+    void _apply_pattern(const muda::DeviceTripletMatrix<T, N>& from,
+                        muda::DeviceBCOOMatrix<T, N>&          to);
+
     // BCOO -> BSR
     void convert(const muda::DeviceBCOOMatrix<T, N>& from,
                  muda::DeviceBSRMatrix<T, N>&        to);
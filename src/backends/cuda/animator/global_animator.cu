@@ -33,6 +33,17 @@ Float GlobalAnimator::substep_ratio() noexcept
     return m_substep_ratio;
 }
 
+Float GlobalAnimator::time_ratio() const noexcept
+{
+    return m_time_ratio;
+}
+
+void GlobalAnimator::time_ratio(Float ratio)
+{
+    UIPC_ASSERT(ratio > 0.0 && ratio <= 1.0, "time ratio must be in (0, 1], yours {}", ratio);
+    m_time_ratio = ratio;
+}
+
 void GlobalAnimator::init()
 {
     // init frontend animator
@@ -66,7 +77,8 @@ void GlobalAnimator::compute_substep_ratio(SizeT newton_iter)
     SizeT substep = world().animator().substep();
     Float t       = Float{newton_iter + 1} / substep;
     UIPC_ASSERT(substep > 0, "substep must be greater than 0");
-    m_substep_ratio = std::min(t, 1.0);  // clamp t to [0, 1]
+    // a time step only moves the animation by its share of the remaining frame time
+    m_substep_ratio = std::min(t, 1.0) * m_time_ratio;  // clamp t to [0, time_ratio]
 }
 
 void GlobalAnimator::register_animator(Animator* animator)
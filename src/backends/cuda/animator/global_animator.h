@@ -12,12 +12,20 @@ class GlobalAnimator final : public SimSystem
      * @brief aim_pos_this_iter = aim_position * alpha + prev_position * (1 - alpha)
      */
     Float substep_ratio() noexcept;
+    /**
+     * @brief The ratio of the current time step to the remaining time of the frame.
+     *
+     * Without adaptive time stepping, it is always 1.0.
+     * The animation reaches its target when `substep_ratio() >= time_ratio()`.
+     */
+    Float time_ratio() const noexcept;
 
   private:
     friend class SimEngine;
     void init();  // only be called by SimEngine
     void step();  // only be called by SimEngine
     void compute_substep_ratio(SizeT newton_iter);  // only be called by SimEngine
+    void time_ratio(Float ratio);  // only be called by SimEngine
     friend class Animator;
     void register_animator(Animator* animator);  // only be called by Animator
 
@@ -27,5 +35,6 @@ class GlobalAnimator final : public SimSystem
     SimSystemSlotCollection<Animator> m_animators;
 
     Float m_substep_ratio = 1.0;
+    Float m_time_ratio    = 1.0;
 };
 }  // namespace uipc::backend::cuda
@@ -8,6 +8,9 @@ void ContactLineSearchReporter::do_build(LineSearchReporter::BuildInfo& info)
 {
     m_impl.global_contact_manager = &require<GlobalContactManager>();
 
+    // barrier and friction potentials are non-negative
+    info.non_negative_energy(true);
+
     on_init_scene([this] { m_impl.init(); });
 }
 
@@ -32,7 +35,7 @@ void ContactLineSearchReporter::Impl::do_compute_energy(LineSearcher::EnergyInfo
     contact_energies.view().copy_to(h_contact_energies.data());
 
     Float total_contact_energy =
-        std::accumulate(h_contact_energies.begin(), h_contact_energies.end(), 0.0f);
+        std::accumulate(h_contact_energies.begin(), h_contact_energies.end(), Float{0});
 
     info.energy(total_contact_energy);
 }
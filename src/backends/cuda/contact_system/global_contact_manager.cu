@@ -31,17 +31,40 @@ void GlobalContactManager::do_build()
 {
     const auto& info = world().scene().info();
 
+    m_impl.sim_engine               = &engine();
     m_impl.global_vertex_manager    = require<GlobalVertexManager>();
     m_impl.global_trajectory_filter = require<GlobalTrajectoryFilter>();
 
 
     m_impl.d_hat        = info["contact"]["d_hat"].get<Float>();
-    m_impl.dt           = info["dt"].get<Float>();
     m_impl.eps_velocity = info["contact"]["eps_velocity"].get<Float>();
     m_impl.cfl_enabled  = info["cfl"]["enable"].get<bool>();
     m_impl.kappa = world().scene().contact_tabular().default_model().resistance();
 }
 
+void GlobalContactManager::do_report_memory(MemoryReportInfo& info) const
+{
+    // the triplet and bcoo storage: one 3x3 block and its (row, col) per entry
+    constexpr SizeT triplet_bytes = sizeof(Matrix3x3) + 2 * sizeof(int);
+    constexpr SizeT doublet_bytes = sizeof(Vector3) + sizeof(int);
+
+    info.add("vert_is_active_contact", m_impl.vert_is_active_contact);
+    info.add("vert_disp_norms", m_impl.vert_disp_norms);
+    info.add("collected_contact_hessian",
+             m_impl.collected_contact_hessian.triplet_count() * triplet_bytes);
+    info.add("collected_contact_gradient",
+             m_impl.collected_contact_gradient.doublet_count() * doublet_bytes);
+    info.add("sorted_contact_hessian", m_impl.sorted_contact_hessian.triplet_count() * triplet_bytes);
+    info.add("sorted_contact_gradient",
+             m_impl.sorted_contact_gradient.doublet_count() * doublet_bytes);
+    info.add("selected_hessian", m_impl.selected_hessian);
+    info.add("selected_hessian_offsets", m_impl.selected_hessian_offsets);
+    for(auto& H : m_impl.classified_contact_hessians)
+        info.add("classified_contact_hessians", H.triplet_count() * triplet_bytes);
+    for(auto& G : m_impl.classified_contact_gradients)
+        info.add("classified_contact_gradients", G.doublet_count() * doublet_bytes);
+}
+
 muda::CBuffer2DView<IndexT> GlobalContactManager::contact_mask_tabular() const noexcept
 {
     return m_impl.contact_mask_tabular;
@@ -484,6 +507,10 @@ Float GlobalContactManager::eps_velocity() const
 {
     return m_impl.eps_velocity;
 }
+Float GlobalContactManager::dt() const
+{
+    return m_impl.sim_engine->dt();
+}
 bool GlobalContactManager::cfl_enabled() const
 {
     return m_impl.cfl_enabled;
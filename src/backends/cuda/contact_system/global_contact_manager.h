@@ -156,6 +156,7 @@ class GlobalContactManager final : public SimSystem
         void _convert_matrix();
         void _distribute();
 
+        SimEngine*                            sim_engine = nullptr;
         SimSystemSlot<GlobalVertexManager>    global_vertex_manager;
         SimSystemSlot<GlobalTrajectoryFilter> global_trajectory_filter;
 
@@ -169,7 +170,6 @@ class GlobalContactManager final : public SimSystem
 
         Float d_hat        = 0.0;
         Float kappa        = 0.0;
-        Float dt           = 0.0;
         Float eps_velocity = 0.0;
 
         /***********************************************************************
@@ -227,6 +227,10 @@ class GlobalContactManager final : public SimSystem
 
     Float d_hat() const;
     Float eps_velocity() const;
+    /**
+     * @brief The dt of the current time step, see SimEngine::dt().
+     */
+    Float dt() const;
     bool  cfl_enabled() const;
 
     void add_reporter(ContactReporter* reporter);
@@ -237,6 +241,7 @@ class GlobalContactManager final : public SimSystem
 
   protected:
     virtual void do_build() override;
+    virtual void do_report_memory(MemoryReportInfo& info) const override;
 
   private:
     friend class SimEngine;
@@ -20,7 +20,6 @@ void SimplexFrictionalContact::do_build()
     do_build(info);
 
     m_impl.global_contact_manager->add_reporter(this);
-    m_impl.dt = world().scene().info()["dt"].get<Float>();
 
     on_init_scene(
         [this]
@@ -183,7 +182,7 @@ Float SimplexFrictionalContact::BaseInfo::d_hat() const
 
 Float SimplexFrictionalContact::BaseInfo::dt() const
 {
-    return m_impl->dt;
+    return m_impl->global_contact_manager->dt();
 }
 
 Float SimplexFrictionalContact::BaseInfo::eps_velocity() const
@@ -149,7 +149,6 @@ class SimplexFrictionalContact : public ContactReporter
         SizeT EE_count = 0;
         SizeT PE_count = 0;
         SizeT PP_count = 0;
-        Float dt       = 0;
 
         muda::DeviceBuffer<Vector4i>    PT_EE_indices;
         muda::DeviceBuffer<Matrix12x12> PT_EE_hessians;
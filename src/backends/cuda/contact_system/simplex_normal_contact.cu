@@ -16,7 +16,6 @@ void SimplexNormalContact::do_build()
     do_build(info);
 
     m_impl.global_contact_manager->add_reporter(this);
-    m_impl.dt = world().scene().info()["dt"].get<Float>();
 
     on_init_scene(
         [this]
@@ -190,7 +189,7 @@ Float SimplexNormalContact::BaseInfo::d_hat() const
 
 Float SimplexNormalContact::BaseInfo::dt() const
 {
-    return m_impl->dt;
+    return m_impl->global_contact_manager->dt();
 }
 
 Float SimplexNormalContact::BaseInfo::eps_velocity() const
@@ -157,7 +157,6 @@ class SimplexNormalContact : public ContactReporter
         SizeT PE_count = 0;
         SizeT PP_count = 0;
 
-        Float                   dt = 0;
         muda::DeviceVar<IndexT> selected_count;
 
         //muda::DeviceBuffer<SimplexContactConstraint> temp_PP_constraints;
@@ -18,7 +18,6 @@ void VertexHalfPlaneFrictionalContact::do_build()
     m_impl.global_contact_manager   = require<GlobalContactManager>();
     m_impl.global_vertex_manager    = require<GlobalVertexManager>();
 
-    m_impl.dt = world().scene().info()["dt"].get<Float>();
 
     BuildInfo info;
     do_build(info);
@@ -168,7 +167,7 @@ Float VertexHalfPlaneFrictionalContact::BaseInfo::d_hat() const
 
 Float VertexHalfPlaneFrictionalContact::BaseInfo::dt() const
 {
-    return m_impl->dt;
+    return m_impl->global_contact_manager->dt();
 }
 
 Float VertexHalfPlaneFrictionalContact::BaseInfo::eps_velocity() const
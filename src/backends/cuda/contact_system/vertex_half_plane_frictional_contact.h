@@ -89,7 +89,6 @@ class VertexHalfPlaneFrictionalContact : public ContactReporter
         SimSystemSlot<VertexHalfPlaneTrajectoryFilter> veretx_half_plane_trajectory_filter;
 
         SizeT PH_count = 0;
-        Float dt;
 
         muda::DeviceBuffer<Float>     energies;
         muda::DeviceBuffer<Vector3>   gradients;
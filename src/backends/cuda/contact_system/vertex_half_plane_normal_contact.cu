@@ -15,7 +15,6 @@ void VertexHalfPlaneNormalContact::do_build()
     do_build(info);
 
     m_impl.global_contact_manager->add_reporter(this);
-    m_impl.dt = world().scene().info()["dt"].get<Float>();
 
     on_init_scene(
         [this]
@@ -160,7 +159,7 @@ Float VertexHalfPlaneNormalContact::BaseInfo::d_hat() const
 
 Float VertexHalfPlaneNormalContact::BaseInfo::dt() const
 {
-    return m_impl->dt;
+    return m_impl->global_contact_manager->dt();
 }
 
 Float VertexHalfPlaneNormalContact::BaseInfo::eps_velocity() const
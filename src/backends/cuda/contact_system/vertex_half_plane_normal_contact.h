@@ -90,7 +90,6 @@ class VertexHalfPlaneNormalContact : public ContactReporter
         SimSystemSlot<VertexHalfPlaneTrajectoryFilter> veretx_half_plane_trajectory_filter;
 
         SizeT PH_count = 0;
-        Float dt;
 
         muda::DeviceBuffer<Float>     energies;
         muda::DeviceBuffer<Vector3>   gradients;
@@ -122,6 +122,10 @@ void GlobalDiffSimManager::Impl::init(WorldVisitor& world)
     auto& diff_sim   = world.scene().diff_sim();
     auto  parm_view  = diff_sim.parameters().view();
     total_parm_count = parm_view.size();
+
+    auto& diff_sim_config = world.scene().info()["diff_sim"];
+    checkpoint            = diff_sim_config.contains("checkpoint")
+                 && diff_sim_config["checkpoint"].value("enable", false);
     dof_offsets.reserve(1024);
     dof_counts.reserve(1024);
     total_coo_pGpP.reshape(0, 0);
@@ -162,9 +166,31 @@ void GlobalDiffSimManager::Impl::update()
 
 void GlobalDiffSimManager::Impl::assemble()
 {
+    // the previous assembled frame is already consumed by the adjoint
+    if(checkpoint)
+        clear_history();
+
     // Waiting for later version merging
 }
 
+void GlobalDiffSimManager::Impl::clear_history()
+{
+    dof_offsets.clear();
+    dof_counts.clear();
+    total_frame_dof_count = 0;
+
+    // release the device memory, not only the size
+    total_triplet_pGpP = {};
+    total_coo_pGpP     = {};
+    total_triplet_H    = {};
+    total_coo_H        = {};
+    total_coo_pGpP.reshape(0, 0);
+    total_coo_H.reshape(0, 0);
+
+    host_coo_pGpP = {};
+    host_coo_H    = {};
+}
+
 void GlobalDiffSimManager::Impl::write_scene(WorldVisitor& world)
 {
     // Waiting for later version merging
@@ -36,6 +36,8 @@ class GlobalDiffSimManager final : public SimSystem
         void update();
         void assemble();
         void write_scene(WorldVisitor& world);
+        // drop the H and dG/dP blocks of the previous frames (checkpointed adjoint)
+        void clear_history();
 
         GlobalLinearSystem* global_linear_system = nullptr;
         SimEngine*          sim_engine           = nullptr;
@@ -51,6 +53,11 @@ class GlobalDiffSimManager final : public SimSystem
 
         SizeT total_parm_count = 0;
 
+        // diff_sim/checkpoint/enable:
+        // the frames are reversed one by one (recomputed from checkpoints), so only
+        // the current frame is assembled and memory doesn't grow with the trajectory
+        bool checkpoint = false;
+
         muda::DeviceBuffer<Float> parameters;
 
         // NOTE:
@@ -1,4 +1,5 @@
 #include <dof_predictor.h>
+#include <sim_engine.h>
 
 namespace uipc::backend::cuda
 {
@@ -6,8 +7,6 @@ REGISTER_SIM_SYSTEM(DofPredictor);
 
 void DofPredictor::do_build()
 {
-    auto scene = world().scene();
-    m_dt       = scene.info()["dt"];
     on_init_scene([this]() { init(); });
 }
 
@@ -33,7 +32,7 @@ void DofPredictor::predict()
     for(auto& action : m_on_predict.view())
     {
         PredictInfo info;
-        info.m_dt = m_dt;
+        info.m_dt = engine().dt();
         action(info);
     }
 }
@@ -42,7 +41,7 @@ void DofPredictor::compute_velocity()
     for(auto& action : m_on_compute_velocity.view())
     {
         ComputeVelocityInfo info;
-        info.m_dt = m_dt;
+        info.m_dt = engine().dt();
         action(info);
     }
 }
@@ -36,7 +36,5 @@ class DofPredictor : public SimSystem
 
     SimActionCollection<void(PredictInfo&)>         m_on_predict;
     SimActionCollection<void(ComputeVelocityInfo&)> m_on_compute_velocity;
-
-    Float m_dt;
 };
 }  // namespace uipc::backend::cuda
@@ -0,0 +1,88 @@
+#include <engine/adaptive_time_stepper.h>
+#include <uipc/common/log.h>
+#include <algorithm>
+#include <cmath>
+
+namespace uipc::backend::cuda
+{
+AdaptiveTimeStepper::AdaptiveTimeStepper(const Json& config, Float frame_dt, Float d_hat)
+    : m_frame_dt(frame_dt)
+    , m_dt(frame_dt)
+    , m_d_hat(d_hat)
+{
+    m_max_substeps       = config["max_substeps"];
+    m_target_newton_iter = config["target_newton_iter"];
+    m_ccd_alpha_tol      = config["ccd_alpha_tol"];
+    m_shrink             = config["shrink"];
+    m_grow               = config["grow"];
+    m_calm_substeps      = config["calm_substeps"];
+    m_cfl_number         = config["cfl_number"];
+
+    UIPC_ASSERT(m_frame_dt > 0.0, "dt must be positive, yours {}", m_frame_dt);
+    UIPC_ASSERT(m_max_substeps > 0, "adaptive_dt/max_substeps must be positive");
+    UIPC_ASSERT(m_shrink > 0.0 && m_shrink < 1.0,
+                "adaptive_dt/shrink must be in (0, 1), yours {}",
+                m_shrink);
+    UIPC_ASSERT(m_grow > 1.0, "adaptive_dt/grow must be greater than 1, yours {}", m_grow);
+    UIPC_ASSERT(m_cfl_number >= 0.0,
+                "adaptive_dt/cfl_number must be non-negative, yours {}",
+                m_cfl_number);
+}
+
+Float AdaptiveTimeStepper::next_dt(Float remaining) const noexcept
+{
+    // split the remaining time evenly, so that the last substep is not a tiny one
+    auto count = std::ceil(remaining / m_dt);
+    // guard against the rounding error of the accumulated frame time
+    if(count <= 1.0 || remaining <= min_dt())
+        return remaining;
+    return remaining / count;
+}
+
+void AdaptiveTimeStepper::update(SizeT newton_iter, Float min_ccd_alpha, Float max_velocity) noexcept
+{
+    // CFL condition, 0 disables it
+    Float cfl_dt = m_frame_dt;
+    if(m_cfl_number > 0.0 && max_velocity > 0.0)
+        cfl_dt = std::min(m_cfl_number * m_d_hat / max_velocity, m_frame_dt);
+
+    bool hard = newton_iter > m_target_newton_iter || min_ccd_alpha < m_ccd_alpha_tol;
+
+    if(hard)
+    {
+        m_dt         = std::max(std::min(m_dt * m_shrink, cfl_dt), min_dt());
+        m_calm_count = 0;
+        return;
+    }
+
+    if(m_dt > cfl_dt)  // too fast for the current dt
+    {
+        m_dt         = std::max(cfl_dt, min_dt());
+        m_calm_count = 0;
+        return;
+    }
+
+    bool calm = newton_iter * 2 <= m_target_newton_iter && min_ccd_alpha >= 1.0;
+    m_calm_count = calm ? m_calm_count + 1 : 0;
+
+    if(m_calm_count >= m_calm_substeps)
+    {
+        m_dt         = std::max(std::min(m_dt * m_grow, cfl_dt), min_dt());
+        m_calm_count = 0;
+    }
+}
+
+Json AdaptiveTimeStepper::to_json() const
+{
+    Json j;
+    j["dt"]         = m_dt;
+    j["calm_count"] = m_calm_count;
+    return j;
+}
+
+void AdaptiveTimeStepper::from_json(const Json& j)
+{
+    m_dt         = std::clamp(j["dt"].get<Float>(), min_dt(), m_frame_dt);
+    m_calm_count = j["calm_count"];
+}
+}  // namespace uipc::backend::cuda
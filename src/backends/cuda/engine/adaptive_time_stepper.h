@@ -0,0 +1,59 @@
+#pragma once
+#include <type_define.h>
+#include <uipc/common/json.h>
+
+namespace uipc::backend::cuda
+{
+/**
+ * @brief Controls the substep dt of a frame.
+ *
+ * A frame of `dt` is split into substeps. The substep dt shrinks when the last substep
+ * is hard (too many newton iterations or a small ccd step size) and grows back
+ * after several calm substeps in a row, it never exceeds the frame dt.
+ *
+ * The CFL condition also caps the substep dt: at the max vertex velocity of the last substep,
+ * a vertex moves at most `cfl_number * d_hat` in one substep.
+ */
+class AdaptiveTimeStepper
+{
+  public:
+    AdaptiveTimeStepper(const Json& config, Float frame_dt, Float d_hat);
+
+    /**
+     * @brief The dt of the next substep, the remaining time of the frame is split evenly.
+     *
+     * @param remaining the remaining time of the frame
+     */
+    Float next_dt(Float remaining) const noexcept;
+
+    /**
+     * @brief Report the result of the last substep.
+     *
+     * @param newton_iter the newton iteration count of the substep
+     * @param min_ccd_alpha the min ccd step size in the substep
+     * @param max_velocity the max vertex velocity at the end of the substep
+     */
+    void update(SizeT newton_iter, Float min_ccd_alpha, Float max_velocity) noexcept;
+
+    Float dt() const noexcept { return m_dt; }
+    Float min_dt() const noexcept { return m_frame_dt / m_max_substeps; }
+
+    Json to_json() const;
+    void from_json(const Json& j);
+
+  private:
+    Float m_frame_dt;
+    Float m_dt;
+
+    SizeT m_max_substeps;
+    SizeT m_target_newton_iter;
+    Float m_ccd_alpha_tol;
+    Float m_shrink;
+    Float m_grow;
+    SizeT m_calm_substeps;
+    Float m_cfl_number;
+    Float m_d_hat;
+
+    SizeT m_calm_count = 0;
+};
+}  // namespace uipc::backend::cuda
@@ -6,6 +6,7 @@
 #include <backends/common/module.h>
 #include <global_geometry/global_vertex_manager.h>
 #include <global_geometry/global_simplicial_surface_manager.h>
+#include <engine/adaptive_time_stepper.h>
 #include <fstream>
 #include <uipc/common/timer.h>
 #include <backends/common/backend_path_tool.h>
@@ -84,6 +85,11 @@ SimEngineState SimEngine::state() const noexcept
     return m_state;
 }
 
+Float SimEngine::dt() const noexcept
+{
+    return m_dt;
+}
+
 void SimEngine::event_init_scene()
 {
     for(auto& action : m_on_init_scene.view())
@@ -102,6 +108,21 @@ void SimEngine::event_write_scene()
         action();
 }
 
+Json SimEngine::do_memory_report() const
+{
+    Json j = backend::SimEngine::do_memory_report();
+
+    // the systems only know their own buffers, the device numbers include
+    // the temporary storage of the algorithms and the CUDA context
+    size_t free_bytes  = 0;
+    size_t total_bytes = 0;
+    checkCudaErrors(cudaMemGetInfo(&free_bytes, &total_bytes));
+    j["device"]["free_bytes"]  = free_bytes;
+    j["device"]["total_bytes"] = total_bytes;
+    j["device"]["used_bytes"]  = total_bytes - free_bytes;
+    return j;
+}
+
 void SimEngine::dump_global_surface(std::string_view name)
 {
     BackendPathTool tool{workspace()};
@@ -147,15 +168,29 @@ void SimEngine::dump_global_surface(std::string_view name)
 // Dump & Recover:
 namespace uipc::backend::cuda
 {
-bool SimEngine::do_dump(DumpInfo&)
+bool SimEngine::do_dump(DumpInfo& info)
 {
-    // Now just do nothing
+    if(m_adaptive_time_stepper)
+    {
+        auto path = fmt::format("{}adaptive_dt.{}.json", info.dump_path(__FILE__), info.frame());
+        std::ofstream file(path);
+        if(!file)
+            return false;
+        file << m_adaptive_time_stepper->to_json().dump(4);
+    }
     return true;
 }
 
-bool SimEngine::do_try_recover(RecoverInfo&)
+bool SimEngine::do_try_recover(RecoverInfo& info)
 {
-    // Now just do nothing
+    if(m_adaptive_time_stepper)
+    {
+        auto path = fmt::format("{}adaptive_dt.{}.json", info.dump_path(__FILE__), info.frame());
+        std::ifstream file(path);
+        if(!file)
+            return false;
+        m_recovered_adaptive_dt = Json::parse(file);
+    }
     return true;
 }
 
@@ -163,11 +198,18 @@ void SimEngine::do_apply_recover(RecoverInfo& info)
 {
     // If success, set the current frame to the recovered frame
     m_current_frame = info.frame();
+    // positions may be changed, the candidates can't be reused
+    m_dcd_candidates_fresh = false;
+
+    if(m_adaptive_time_stepper)
+        m_adaptive_time_stepper->from_json(m_recovered_adaptive_dt);
+    m_recovered_adaptive_dt = Json{};
 }
 
 void SimEngine::do_clear_recover(RecoverInfo& info)
 {
     // If failed, do nothing
+    m_recovered_adaptive_dt = Json{};
 }
 
 SizeT SimEngine::get_frame() const
@@ -5,19 +5,29 @@
 #include <global_geometry/global_simplicial_surface_manager.h>
 #include <contact_system/global_contact_manager.h>
 #include <collision_detection/global_trajectory_filter.h>
+#include <collision_detection/simplex_trajectory_filter.h>
+#include <collision_detection/vertex_half_plane_trajectory_filter.h>
 #include <line_search/line_searcher.h>
 #include <gradient_hessian_computer.h>
 #include <linear_system/global_linear_system.h>
 #include <animator/global_animator.h>
 #include <diff_sim/global_diff_sim_manager.h>
+#include <engine/adaptive_time_stepper.h>
+#include <fmt/ranges.h>
+#include <chrono>
 
 namespace uipc::backend::cuda
 {
 void SimEngine::do_advance()
 {
-    Float alpha     = 1.0;
-    Float ccd_alpha = 1.0;
-    Float cfl_alpha = 1.0;
+    Float alpha         = 1.0;
+    Float ccd_alpha     = 1.0;
+    Float cfl_alpha     = 1.0;
+    Float min_ccd_alpha = 1.0;  // min ccd alpha in a substep, for adaptive time stepping
+    Float max_velocity  = 0.0;  // max vertex velocity after a substep, for adaptive time stepping
+
+    // the solver statistics of this frame, pushed to the telemetry stream at the end of the frame
+    core::FrameTelemetry telemetry_record;
 
     bool dump_surface =
         world().scene().info()["extras"]["debug"]["dump_surface"].get<bool>();
@@ -33,6 +43,23 @@ void SimEngine::do_advance()
             Timer timer{"Detect DCD Candidates"};
             m_global_trajectory_filter->detect(0.0);
             m_global_trajectory_filter->filter_active();
+            // the candidates are detected at the current positions
+            m_dcd_candidates_fresh = true;
+        }
+    };
+
+    auto warm_start_dcd_candidates = [this, detect_dcd_candidates]
+    {
+        // If the positions are not changed since the last detection (the last frame converged
+        // right after a detection), the candidates are still complete, only revalidate the active ones.
+        if(m_warm_start && m_dcd_candidates_fresh && m_global_trajectory_filter)
+        {
+            Timer timer{"Revalidate DCD Candidates"};
+            m_global_trajectory_filter->filter_active();
+        }
+        else
+        {
+            detect_dcd_candidates();
         }
     };
 
@@ -62,6 +89,31 @@ void SimEngine::do_advance()
         }
     };
 
+    auto record_contact_candidates = [this, &telemetry_record]
+    {
+        if(!m_global_trajectory_filter)
+            return;
+
+        auto peak = [&](std::string_view type, SizeT count)
+        {
+            auto& c = telemetry_record.contact_candidates[std::string{type}];
+            c       = std::max(c, count);
+        };
+
+        if(auto simplex = m_global_trajectory_filter->find<SimplexTrajectoryFilter>())
+        {
+            peak("PT", simplex->PTs().size());
+            peak("EE", simplex->EEs().size());
+            peak("PE", simplex->PEs().size());
+            peak("PP", simplex->PPs().size());
+        }
+
+        if(auto half_plane = m_global_trajectory_filter->find<VertexHalfPlaneTrajectoryFilter>())
+        {
+            peak("PH", half_plane->PHs().size());
+        }
+    };
+
     auto compute_adaptive_kappa = [this]
     {
         // TODO: now no effect
@@ -109,17 +161,18 @@ void SimEngine::do_advance()
         return alpha;
     };
 
-    auto compute_energy = [this, filter_dcd_candidates](Float alpha) -> Float
+    auto compute_energy = [this, filter_dcd_candidates](Float alpha, Float E0) -> Float
     {
         // Step Forward => x = x_0 + alpha * dx
         m_global_vertex_manager->step_forward(alpha);
         m_line_searcher->step_forward(alpha);
+        m_dcd_candidates_fresh = false;
 
         // Update the collision pairs
         filter_dcd_candidates();
 
-        // Compute New Energy => E
-        return m_line_searcher->compute_energy(false);
+        // Compute New Energy => E, may exit early if E > E0 is already proved
+        return m_line_searcher->compute_energy(false, E0);
     };
 
     auto step_animation = [this]()
@@ -146,7 +199,7 @@ void SimEngine::do_advance()
     {
         if(m_global_animator)
         {
-            return m_global_animator->substep_ratio() >= 1.0;
+            return m_global_animator->substep_ratio() >= m_global_animator->time_ratio();
         }
         return true;
     };
@@ -167,219 +220,306 @@ void SimEngine::do_advance()
     // Abort on exception if the runtime check is enabled for debugging
     constexpr bool AbortOnException = uipc::RUNTIME_CHECK;
 
-    auto pipeline = [&]() noexcept(AbortOnException)
+    // Simulate one time step with the current dt, return the newton iteration count
+    auto simulate_step = [&](bool is_first_substep) -> SizeT
     {
-        Timer timer{"Pipeline"};
+        // 1. Adaptive Parameter Calculation
+        AABB vertex_bounding_box =
+            m_global_vertex_manager->compute_vertex_bounding_box();
+        warm_start_dcd_candidates();
+        record_contact_candidates();
+        compute_adaptive_kappa();
+
+        // 2. Record Friction Candidates at the beginning of the frame
+        record_friction_candidates();
+
+        // 3. Predict Motion => x_tilde = x + v * dt
+        m_state = SimEngineState::PredictMotion;
+        m_dof_predictor->predict();
+        // the frontend animation is updated once per frame
+        if(is_first_substep)
+            step_animation();
 
-        ++m_current_frame;
+        // 4. Nonlinear-Newton Iteration
+        Float box_size = vertex_bounding_box.diagonal().norm();
+        Float tol      = m_newton_scene_tol * box_size;
+        Float res0     = 0.0;
 
-        spdlog::info(R"(>>> Begin Frame: {})", m_current_frame);
-
-        // Rebuild Scene
+        SizeT newton_iter = 0;
+        for(; newton_iter < m_newton_max_iter; ++newton_iter)
         {
-            Timer timer{"Rebuild Scene"};
-            // Trigger the rebuild_scene event, systems register their actions will be called here
-            m_state = SimEngineState::RebuildScene;
-            {
-                event_rebuild_scene();
+            Timer timer{"Newton Iteration"};
 
-                // TODO: rebuild the vertex and surface info
-                // m_global_vertex_manager->rebuild_vertex_info();
-                // m_global_surface_manager->rebuild_surface_info();
-            }
+            // 1) Compute animation substep ratio
+            compute_animation_substep_ratio(newton_iter);
 
-            // After the rebuild_scene event, the pending creation or deletion can be solved
-            world().scene().solve_pending();
+            // 2) Build Collision Pairs
+            if(newton_iter > 0)
+            {
+                detect_dcd_candidates();
+                record_contact_candidates();
+            }
 
-            // Update the diff parms
-            update_diff_parm();
-        }
+            // 3) Compute Contact Gradient and Hessian => G:Vector3, H:Matrix3x3
+            m_state = SimEngineState::ComputeContact;
+            compute_contact();
 
-        // Simulation:
-        {
-            Timer timer{"Simulation"};
-            // 1. Adaptive Parameter Calculation
-            AABB vertex_bounding_box =
-                m_global_vertex_manager->compute_vertex_bounding_box();
-            detect_dcd_candidates();
-            compute_adaptive_kappa();
+            // 4) Compute System Gradient and Hessian
+            m_state = SimEngineState::ComputeGradientHessian;
+            {
+                Timer timer{"Compute Gradient Hessian"};
+                m_gradient_hessian_computer->compute_gradient_hessian();
+            }
 
-            // 2. Record Friction Candidates at the beginning of the frame
-            record_friction_candidates();
+            // 5) Solve Global Linear System => dx = A^-1 * b
+            m_state = SimEngineState::SolveGlobalLinearSystem;
+            {
+                Timer timer{"Solve Global Linear System"};
+                // the first iteration can be warm started from the last frame
+                m_global_linear_system->solve(newton_iter == 0);
+                telemetry_record.linear_solver_iterations.push_back(
+                    m_global_linear_system->last_iter_count());
+            }
 
-            // 3. Predict Motion => x_tilde = x + v * dt
-            m_state = SimEngineState::PredictMotion;
-            m_dof_predictor->predict();
-            step_animation();
 
-            // 4. Nonlinear-Newton Iteration
-            Float box_size = vertex_bounding_box.diagonal().norm();
-            Float tol      = m_newton_scene_tol * box_size;
-            Float res0     = 0.0;
+            // 6) Get Max Movement => dx_max = max(|dx|), if dx_max < tol, break
+            m_global_vertex_manager->collect_vertex_displacements();
+            Float res = m_global_vertex_manager->compute_axis_max_displacement();
 
-            SizeT newton_iter = 0;
-            for(; newton_iter < m_newton_max_iter; ++newton_iter)
+            // 7) Check Termination Condition
+            // TODO: Maybe we can implement a class for termination condition in the future
+            bool converged = false;
             {
-                Timer timer{"Newton Iteration"};
+                if(newton_iter == 0)
+                    res0 = res;  // record the initial residual
 
-                // 1) Compute animation substep ratio
-                compute_animation_substep_ratio(newton_iter);
+                Float rel_tol = res == 0.0 ? 0.0 : res / res0;
 
-                // 2) Build Collision Pairs
-                if(newton_iter > 0)
-                    detect_dcd_candidates();
+                spdlog::info(">> Frame {} Newton Iteration {} => Residual/AbsTol/CCDToi: {}/{}/{}",
+                             m_current_frame,
+                             newton_iter,
+                             res,
+                             m_abs_tol,
+                             ccd_alpha);
 
-                // 3) Compute Contact Gradient and Hessian => G:Vector3, H:Matrix3x3
-                m_state = SimEngineState::ComputeContact;
-                compute_contact();
+                converged = res <= m_abs_tol || rel_tol <= 0.001;
 
-                // 4) Compute System Gradient and Hessian
-                m_state = SimEngineState::ComputeGradientHessian;
+                if(dump_surface)
                 {
-                    Timer timer{"Compute Gradient Hessian"};
-                    m_gradient_hessian_computer->compute_gradient_hessian();
+                    dump_global_surface(fmt::format(
+                        "dump_surface.{}.{}", m_current_frame, newton_iter));
                 }
 
-                // 5) Solve Global Linear System => dx = A^-1 * b
-                m_state = SimEngineState::SolveGlobalLinearSystem;
-                {
-                    Timer timer{"Solve Global Linear System"};
-                    m_global_linear_system->solve();
-                }
+                if(newton_iter > 0 && converged && ccd_alpha >= m_ccd_tol
+                   && animation_reach_target())
+                    break;
+            }
 
 
-                // 6) Get Max Movement => dx_max = max(|dx|), if dx_max < tol, break
-                m_global_vertex_manager->collect_vertex_displacements();
-                Float res = m_global_vertex_manager->compute_axis_max_displacement();
+            // 8) Begin Line Search
+            m_state = SimEngineState::LineSearch;
+            {
+                Timer timer{"Line Search"};
 
-                // 7) Check Termination Condition
-                // TODO: Maybe we can implement a class for termination condition in the future
-                bool converged = false;
-                {
-                    if(newton_iter == 0)
-                        res0 = res;  // record the initial residual
+                // Reset Alpha
+                alpha = 1.0;
 
-                    Float rel_tol = res == 0.0 ? 0.0 : res / res0;
+                // Record Current State x to x_0
+                m_line_searcher->record_start_point();
+                m_global_vertex_manager->record_start_point();
+                detect_trajectory_candidates(alpha);
 
-                    spdlog::info(">> Frame {} Newton Iteration {} => Residual/AbsTol/CCDToi: {}/{}/{}",
-                                 m_current_frame,
-                                 newton_iter,
-                                 res,
-                                 m_abs_tol,
-                                 ccd_alpha);
+                // Compute Current Energy => E_0
+                Float E0 = m_line_searcher->compute_energy(true);  // initial energy
+                // spdlog::info("Initial Energy: {}", E0);
 
-                    converged = res <= m_abs_tol || rel_tol <= 0.001;
+                // CCD filter
+                alpha         = filter_toi(alpha);
+                min_ccd_alpha = std::min(min_ccd_alpha, ccd_alpha);
 
-                    if(dump_surface)
-                    {
-                        dump_global_surface(fmt::format(
-                            "dump_surface.{}.{}", m_current_frame, newton_iter));
-                    }
+                // CFL Condition
+                alpha = cfl_condition(alpha);
 
-                    if(newton_iter > 0 && converged && ccd_alpha >= m_ccd_tol
-                       && animation_reach_target())
-                        break;
-                }
+                telemetry_record.min_ccd_alpha = std::min(telemetry_record.min_ccd_alpha, ccd_alpha);
+                telemetry_record.min_cfl_alpha = std::min(telemetry_record.min_cfl_alpha, cfl_alpha);
 
+                // Compute Test Energy => E
+                Float E  = compute_energy(alpha, E0);
+                Float E1 = E;
 
-                // 8) Begin Line Search
-                m_state = SimEngineState::LineSearch;
+                if(!converged)
                 {
-                    Timer timer{"Line Search"};
+                    SizeT line_search_iter = 0;
+                    while(line_search_iter < m_line_searcher->max_iter())
+                    {
+                        Timer timer{"Line Search Iteration"};
 
-                    // Reset Alpha
-                    alpha = 1.0;
+                        bool energy_decrease = E <= E0;  // Check Energy Decrease
 
-                    // Record Current State x to x_0
-                    m_line_searcher->record_start_point();
-                    m_global_vertex_manager->record_start_point();
-                    detect_trajectory_candidates(alpha);
+                        // TODO: Inversion Check (Not Implemented Yet)
+                        bool no_inversion = true;
 
-                    // Compute Current Energy => E_0
-                    Float E0 = m_line_searcher->compute_energy(true);  // initial energy
-                    // spdlog::info("Initial Energy: {}", E0);
+                        bool success = energy_decrease && no_inversion;
+                        if(success)
+                            break;
 
-                    // CCD filter
-                    alpha = filter_toi(alpha);
+                        // If not success, then shrink alpha
+                        alpha /= 2;
+                        E = compute_energy(alpha, E0);
 
-                    // CFL Condition
-                    alpha = cfl_condition(alpha);
+                        line_search_iter++;
+                    }
 
-                    // Compute Test Energy => E
-                    Float E  = compute_energy(alpha);
-                    Float E1 = E;
+                    telemetry_record.line_search_steps += line_search_iter;
 
-                    if(!converged)
+                    if(line_search_iter > m_line_searcher->max_iter())
                     {
-                        SizeT line_search_iter = 0;
-                        while(line_search_iter < m_line_searcher->max_iter())
+                        //m_global_linear_system->dump_linear_system(
+                        //    fmt::format("{}.{}.{}", workspace(), frame(), newton_iter));
+
+                        spdlog::warn(
+                            "Line Search Exits with Max Iteration: {} (Frame={}, Newton={})\n"
+                            "E/E0: {}, E1/E0: {}, E0:{}",
+                            m_line_searcher->max_iter(),
+                            m_current_frame,
+                            newton_iter,
+                            E / E0,
+                            E1 / E0,
+                            E0);
+
+                        if(m_strict_mode)
                         {
-                            Timer timer{"Line Search Iteration"};
+                            throw SimEngineException("StrictMode: Line Search Exits with Max Iteration");
+                        }
+                    }
+                }
 
-                            bool energy_decrease = E <= E0;  // Check Energy Decrease
+                // keep the terms of the last evaluation
+                for(auto& term : m_line_searcher->energy_report().terms)
+                {
+                    if(term.evaluated)
+                        telemetry_record.energies[std::string{term.name}] = term.value;
+                }
+            }
+        }
 
-                            // TODO: Inversion Check (Not Implemented Yet)
-                            bool no_inversion = true;
+        // 5. Update Velocity => v = (x - x_0) / dt
+        m_state = SimEngineState::UpdateVelocity;
+        {
+            Timer timer{"Update Velocity"};
+            m_dof_predictor->compute_velocity();
+            if(m_adaptive_time_stepper)
+                max_velocity = m_global_vertex_manager->compute_max_velocity(m_dt);
+            m_global_vertex_manager->record_prev_positions();
+        }
 
-                            bool success = energy_decrease && no_inversion;
-                            if(success)
-                                break;
+        if(newton_iter > m_newton_max_iter)
+        {
+            spdlog::warn("Newton Iteration Exits with Max Iteration: {} (Frame={})",
+                         m_newton_max_iter,
+                         m_current_frame);
 
-                            // If not success, then shrink alpha
-                            alpha /= 2;
-                            E = compute_energy(alpha);
+            if(m_strict_mode)
+            {
+                throw SimEngineException("StrictMode: Newton Iteration Exits with Max Iteration");
+            }
+        }
 
-                            line_search_iter++;
-                        }
+        return newton_iter;
+    };
 
-                        if(line_search_iter > m_line_searcher->max_iter())
-                        {
-                            //m_global_linear_system->dump_linear_system(
-                            //    fmt::format("{}.{}.{}", workspace(), frame(), newton_iter));
-
-                            spdlog::warn(
-                                "Line Search Exits with Max Iteration: {} (Frame={}, Newton={})\n"
-                                "E/E0: {}, E1/E0: {}, E0:{}",
-                                m_line_searcher->max_iter(),
-                                m_current_frame,
-                                newton_iter,
-                                E / E0,
-                                E1 / E0,
-                                E0);
-
-                            if(m_strict_mode)
-                            {
-                                throw SimEngineException("StrictMode: Line Search Exits with Max Iteration");
-                            }
-                        }
-                    }
-                }
-            }
+    auto pipeline = [&]() noexcept(AbortOnException)
+    {
+        Timer timer{"Pipeline"};
+
+        ++m_current_frame;
+
+        auto frame_begin       = std::chrono::steady_clock::now();
+        telemetry_record.frame = m_current_frame;
+
+        spdlog::info(R"(>>> Begin Frame: {})", m_current_frame);
 
-            // 5. Update Velocity => v = (x - x_0) / dt
-            m_state = SimEngineState::UpdateVelocity;
+        // Rebuild Scene
+        {
+            Timer timer{"Rebuild Scene"};
+            m_state = SimEngineState::RebuildScene;
+
+            auto scene      = world().scene();
+            auto change_set = scene.pending_change_set();
+
+            if(!change_set.empty())
             {
-                Timer timer{"Update Velocity"};
-                m_dof_predictor->compute_velocity();
-                m_global_vertex_manager->record_prev_positions();
+                // No system patches its buffers from the change set yet, so the created geometries
+                // are not simulated and the destroyed ones keep being simulated
+                spdlog::warn("Rebuild Scene: {} geometries created and {} geometries destroyed after init, "
+                             "they are ignored by this backend.",
+                             change_set.created_ids().size(),
+                             change_set.destroyed_ids().size());
             }
 
-            if(newton_iter > m_newton_max_iter)
+            // Trigger the rebuild_scene event, systems register their actions will be called here
+            event_rebuild_scene();
+
+            // After the rebuild_scene event, the pending creation or deletion can be solved
+            scene.solve_pending();
+
+            // Update the diff parms
+            update_diff_parm();
+        }
+
+        // Simulation:
+        {
+            Timer timer{"Simulation"};
+
+            // Advance the frame with one or more substeps,
+            // without adaptive time stepping, there is only one substep of `dt`
+            Float frame_dt   = m_frame_dt;
+            Float frame_time = 0.0;
+            m_frame_substep_dts.clear();
+
+            for(SizeT substep = 0;; ++substep)
             {
-                spdlog::warn("Newton Iteration Exits with Max Iteration: {} (Frame={})",
-                             m_newton_max_iter,
-                             m_current_frame);
+                Float remaining = frame_dt - frame_time;
+                m_dt = m_adaptive_time_stepper ? m_adaptive_time_stepper->next_dt(remaining) :
+                                                 remaining;
+                // the newton tolerance depends on the velocity tolerance and the current dt
+                m_abs_tol = m_newton_velocity_tol * m_dt;
 
-                if(m_strict_mode)
-                {
-                    throw SimEngineException("StrictMode: Newton Iteration Exits with Max Iteration");
-                }
+                // the animation aims at the target at the end of the frame
+                if(m_global_animator)
+                    m_global_animator->time_ratio(m_dt / remaining);
+
+                min_ccd_alpha     = 1.0;
+                SizeT newton_iter = simulate_step(substep == 0);
+                telemetry_record.newton_iterations += newton_iter;
+
+                frame_time += m_dt;
+                m_frame_substep_dts.push_back(m_dt);
+
+                if(m_adaptive_time_stepper)
+                    m_adaptive_time_stepper->update(newton_iter, min_ccd_alpha, max_velocity);
+
+                if(m_dt >= remaining)
+                    break;
             }
+
+            if(m_adaptive_time_stepper)
+                spdlog::info("Frame {} Substep dt: [{}]",
+                             m_current_frame,
+                             fmt::join(m_frame_substep_dts, ", "));
         }
 
         // NOTE: Don't change any state after this point
         // 1) SimEngine::do_backward() may be called later, please keep the state consistent
 
+        telemetry_record.dt            = m_frame_dt;
+        telemetry_record.substep_count = m_frame_substep_dts.size();
+        telemetry_record.substep_dts   = m_frame_substep_dts;
+        telemetry_record.wall_time =
+            std::chrono::duration<Float>(std::chrono::steady_clock::now() - frame_begin).count();
+        // never blocks, dropped if the user doesn't read the stream
+        telemetry().push(std::move(telemetry_record));
+
         spdlog::info("<<< End Frame: {}", m_current_frame);
     };
 
@@ -393,5 +533,8 @@ void SimEngine::do_advance()
         spdlog::error("Engine Advance Error: {}", e.what());
         status().push_back(core::EngineStatus::error(e.what()));
     }
+
+    // the timers of this frame become one sample of the per-frame statistics
+    Timer::end_frame(m_current_frame);
 }
 }  // namespace uipc::backend::cuda
@@ -10,6 +10,7 @@
 #include <line_search/line_searcher.h>
 #include <linear_system/global_linear_system.h>
 #include <sim_engine.h>
+#include <engine/adaptive_time_stepper.h>
 #include <uipc/common/log.h>
 #include <affine_body/affine_body_dynamics.h>
 #include <finite_element/finite_element_method.h>
@@ -49,10 +50,22 @@ void SimEngine::init_scene()
     m_ccd_tol             = info["newton"]["ccd_tol"];
     m_friction_enabled    = info["contact"]["friction"]["enable"];
     m_strict_mode         = info["extras"]["strict_mode"]["enable"];
+    m_warm_start          = info["newton"]["warm_start"]["enable"];
     Vector3 gravity       = info["gravity"];
     Float   dt            = info["dt"];
 
-    m_abs_tol = m_newton_velocity_tol * dt;
+    m_frame_dt = dt;
+    m_dt       = dt;
+    m_abs_tol  = m_newton_velocity_tol * dt;
+
+    if(info["adaptive_dt"]["enable"].get<bool>())
+    {
+        // the backward pass replays the frames with the scene dt
+        if(info["diff_sim"]["enable"].get<bool>())
+            throw SimEngineException("Adaptive time stepping is not supported with diff_sim");
+        m_adaptive_time_stepper = uipc::make_unique<AdaptiveTimeStepper>(
+            info["adaptive_dt"], dt, info["contact"]["d_hat"].get<Float>());
+    }
 
     // 1. Before Common Scene Initialization
     if(m_affine_body_dynamics)
@@ -1,5 +1,6 @@
 #include <finite_element/finite_element_extra_constitution.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <finite_element/constitutions/discrete_shell_bending_function.h>
 #include <numbers>
 #include <utils/matrix_assembly_utils.h>
@@ -75,7 +76,7 @@ class DiscreteShellBending final : public FiniteElementExtraConstitution
                 unordered_map<Vector2i, InitInfo> stencil_map;  // Edge -> opposite vertices
 
                 auto vertex_offset =
-                    sc.meta().find<IndexT>(builtin::backend_fem_vertex_offset);
+                    sc.meta().find<IndexT>(builtin::key::backend_fem_vertex_offset);
                 UIPC_ASSERT(vertex_offset, "Vertex offset not found, why?");
                 auto vertex_offset_v = vertex_offset->view().front();
 
@@ -1,5 +1,6 @@
 #include <finite_element/finite_element_extra_constitution.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <finite_element/constitutions/kirchhoff_rod_bending_function.h>
 #include <numbers>
 #include <utils/matrix_assembly_utils.h>
@@ -40,7 +41,7 @@ class KirchhoffRodBending final : public FiniteElementExtraConstitution
                 unordered_map<IndexT, set<IndexT>> hinge_map;  // Vertex -> Connected Vertices
 
                 auto vertex_offset =
-                    sc.meta().find<IndexT>(builtin::backend_fem_vertex_offset);
+                    sc.meta().find<IndexT>(builtin::key::backend_fem_vertex_offset);
                 UIPC_ASSERT(vertex_offset, "Vertex offset not found, why?");
                 auto vertex_offset_v = vertex_offset->view().front();
 
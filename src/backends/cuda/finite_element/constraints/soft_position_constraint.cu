@@ -1,5 +1,6 @@
 #include <finite_element/finite_element_constraint.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 
 namespace uipc::backend::cuda
 {
@@ -54,11 +55,11 @@ class SoftPositionConstraint final : public FiniteElementConstraint
             [&](geometry::SimplicialComplex& sc)
             {
                 auto vertex_offset =
-                    sc.meta().find<IndexT>(builtin::backend_fem_vertex_offset);
+                    sc.meta().find<IndexT>(builtin::key::backend_fem_vertex_offset);
                 current_vertex_offset = vertex_offset->view().front();
 
-                auto is_constrained = sc.vertices().find<IndexT>(builtin::is_constrained);
-                auto aim_pos = sc.vertices().find<Vector3>(builtin::aim_position);
+                auto is_constrained = sc.vertices().find<IndexT>(builtin::key::is_constrained);
+                auto aim_pos = sc.vertices().find<Vector3>(builtin::key::aim_position);
                 auto strength_ratio = sc.vertices().find<Float>("strength_ratio");
 
                 return zip(is_constrained->view(),
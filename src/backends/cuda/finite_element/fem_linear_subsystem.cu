@@ -8,6 +8,7 @@
 #include <finite_element/finite_element_extra_constitution.h>
 #include <sim_engine.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 
 namespace uipc::backend::cuda
 {
@@ -18,7 +19,6 @@ void FEMLinearSubsystem::do_build(DiagLinearSubsystem::BuildInfo&)
     m_impl.finite_element_method = require<FiniteElementMethod>();
     m_impl.finite_element_vertex_reporter = require<FiniteElementVertexReporter>();
     m_impl.sim_engine = &engine();
-    m_impl.dt         = world().scene().info()["dt"];
 
     auto contact = find<FEMContactReceiver>();
     if(contact)
@@ -48,9 +48,9 @@ void FEMLinearSubsystem::Impl::receive_init_dof_info(WorldVisitor& w,
         [&](const FiniteElementMethod::ForEachInfo& foreach_info, geometry::SimplicialComplex& sc)
         {
             auto I          = foreach_info.global_index();
-            auto dof_offset = sc.meta().find<IndexT>(builtin::dof_offset);
+            auto dof_offset = sc.meta().find<IndexT>(builtin::key::dof_offset);
             UIPC_ASSERT(dof_offset, "dof_offset not found on FEM mesh why can it happen?");
-            auto dof_count = sc.meta().find<IndexT>(builtin::dof_count);
+            auto dof_count = sc.meta().find<IndexT>(builtin::key::dof_count);
             UIPC_ASSERT(dof_count, "dof_count not found on FEM mesh why can it happen?");
 
             IndexT this_dof_count = 3 * sc.vertices().size();
@@ -147,7 +147,7 @@ void FEMLinearSubsystem::Impl::_assemble_producers(GlobalLinearSystem::DiagInfo&
     FiniteElementEnergyProducer::AssemblyInfo assembly_info;
     assembly_info.hessians = info.hessian().subview(energy_producer_hessian_offset,
                                                     energy_producer_hessian_count);
-    assembly_info.dt = dt;
+    assembly_info.dt = sim_engine->dt();
 
     for(auto& producer : fem().energy_producers)
     {
@@ -224,7 +224,8 @@ void FEMLinearSubsystem::Impl::_assemble_animation(GlobalLinearSystem::DiagInfo&
     if(finite_element_animator)
     {
         auto hessians = info.hessian().subview(animator_hessian_offset, animator_hessian_count);
-        FiniteElementAnimator::AssembleInfo this_info{info.gradient(), hessians, dt};
+        FiniteElementAnimator::AssembleInfo this_info{
+            info.gradient(), hessians, sim_engine->dt()};
         finite_element_animator->assemble(this_info);
     }
 }
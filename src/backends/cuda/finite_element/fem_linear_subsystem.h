@@ -55,8 +55,6 @@ class FEMLinearSubsystem final : public DiagLinearSubsystem
         SizeT animator_hessian_offset = 0;
         SizeT animator_hessian_count  = 0;
 
-        Float dt = 0.0;
-
         Float reserve_ratio = 1.5;
 
         MatrixConverter<Float, 3>           converter;
@@ -1,6 +1,7 @@
 #include <finite_element/finite_element_animator.h>
 #include <finite_element/finite_element_constraint.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/common/enumerate.h>
 #include <muda/cub/device/device_reduce.h>
 
@@ -72,7 +73,7 @@ void FiniteElementAnimator::Impl::init(backend::WorldVisitor& world)
     {
         auto  geo_slot = geo_slots[info.geo_slot_index];
         auto& geo      = geo_slot->geometry();
-        auto  uid      = geo.meta().find<U64>(builtin::constraint_uid);
+        auto  uid      = geo.meta().find<U64>(builtin::key::constraint_uid);
         if(uid)
         {
             auto uid_value = uid->view().front();
@@ -98,7 +99,7 @@ void FiniteElementAnimator::Impl::init(backend::WorldVisitor& world)
     {
         auto  geo_slot = geo_slots[info.geo_slot_index];
         auto& geo      = geo_slot->geometry();
-        auto  uid      = geo.meta().find<U64>(builtin::constraint_uid);
+        auto  uid      = geo.meta().find<U64>(builtin::key::constraint_uid);
         if(uid)
         {
             auto uid_value = uid->view().front();
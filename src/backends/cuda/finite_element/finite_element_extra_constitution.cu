@@ -1,5 +1,6 @@
 #include <finite_element/finite_element_extra_constitution.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 
 namespace uipc::backend::cuda
 {
@@ -69,7 +70,7 @@ void FiniteElementExtraConstitution::Impl::init(U64 uid, backend::WorldVisitor&
         [&](const ForEachInfo& I, geometry::SimplicialComplex& sc)
         {
             auto geoI = I.global_index();
-            auto uids = sc.meta().find<VectorXu64>(builtin::extra_constitution_uids);
+            auto uids = sc.meta().find<VectorXu64>(builtin::key::extra_constitution_uids);
             if(uids)
             {
                 auto extra_uids = uids->view().front();
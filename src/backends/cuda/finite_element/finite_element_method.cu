@@ -4,6 +4,7 @@
 #include <finite_element/finite_element_extra_constitution.h>
 #include <finite_element/finite_element_constitution.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/geometry/simplicial_complex.h>
 #include <uipc/common/map.h>
 #include <uipc/common/zip.h>
@@ -121,6 +122,31 @@ void FiniteElementMethod::init()
     m_impl.init(world());
 }
 
+void FiniteElementMethod::do_report_memory(MemoryReportInfo& info) const
+{
+    info.add("codim_0ds", m_impl.codim_0ds);
+    info.add("codim_1ds", m_impl.codim_1ds);
+    info.add("rest_lengths", m_impl.rest_lengths);
+    info.add("codim_2ds", m_impl.codim_2ds);
+    info.add("rest_areas", m_impl.rest_areas);
+    info.add("tets", m_impl.tets);
+    info.add("rest_volumes", m_impl.rest_volumes);
+    info.add("is_fixed", m_impl.is_fixed);
+    info.add("is_dynamic", m_impl.is_dynamic);
+    info.add("gravities", m_impl.gravities);
+    info.add("x_bars", m_impl.x_bars);
+    info.add("xs", m_impl.xs);
+    info.add("dxs", m_impl.dxs);
+    info.add("x_temps", m_impl.x_temps);
+    info.add("vs", m_impl.vs);
+    info.add("x_tildes", m_impl.x_tildes);
+    info.add("x_prevs", m_impl.x_prevs);
+    info.add("masses", m_impl.masses);
+    info.add("thicknesses", m_impl.thicknesses);
+    info.add("Dm3x3_invs", m_impl.Dm3x3_invs);
+    info.add("energy_producer_energies", m_impl.energy_producer_energies);
+}
+
 bool FiniteElementMethod::do_dump(DumpInfo& info)
 {
     return m_impl.dump(info);
@@ -286,7 +312,7 @@ void FiniteElementMethod::Impl::_build_geo_infos(WorldVisitor& world)
     for(auto&& [i, geo_slot] : enumerate(geo_slots))
     {
         auto& geo  = geo_slot->geometry();
-        auto  cuid = geo.meta().find<U64>(builtin::constitution_uid);
+        auto  cuid = geo.meta().find<U64>(builtin::key::constitution_uid);
         if(cuid)
         {
             auto uid = cuid->view()[0];
@@ -636,7 +662,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
         }
 
         {  // 2) fill backend_fem_vertex_offset in geometry
-            auto vertex_offset = sc->meta().find<IndexT>(builtin::backend_fem_vertex_offset);
+            auto vertex_offset = sc->meta().find<IndexT>(builtin::key::backend_fem_vertex_offset);
             if(!vertex_offset)
                 vertex_offset =
                     sc->meta().create<IndexT>(builtin::backend_fem_vertex_offset, -1);
@@ -658,7 +684,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
                         "rest position size mismatching");
             std::ranges::copy(rest_pos_view, dst_rest_pos_span.begin());
 
-            auto vel = sc->vertices().find<Vector3>(builtin::velocity);
+            auto vel = sc->vertices().find<Vector3>(builtin::key::velocity);
             if(vel)  // if user set the velocity
             {
                 auto vel_view = vel->view();
@@ -671,11 +697,11 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
         }
 
         {  // 4) setup mass
-            auto volume      = rest_sc->vertices().find<Float>(builtin::volume);
+            auto volume      = rest_sc->vertices().find<Float>(builtin::key::volume);
             auto volume_view = volume->view();
 
-            auto meta_mass_density = sc->meta().find<Float>(builtin::mass_density);
-            auto vertex_mass_density = sc->vertices().find<Float>(builtin::mass_density);
+            auto meta_mass_density = sc->meta().find<Float>(builtin::key::mass_density);
+            auto vertex_mass_density = sc->vertices().find<Float>(builtin::key::mass_density);
             UIPC_ASSERT(meta_mass_density || vertex_mass_density,
                         "mass density is not found in the geometry");
             auto mass_density_view = vertex_mass_density ?
@@ -696,7 +722,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
         }
 
         {  // 5) setup thickness
-            auto thickness = sc->vertices().find<Float>(builtin::thickness);
+            auto thickness = sc->vertices().find<Float>(builtin::key::thickness);
             auto dst_thickness_span =
                 span{h_thicknesses}.subspan(info.vertex_offset, info.vertex_count);
 
@@ -715,7 +741,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
                 span{h_vertex_contact_element_ids}.subspan(info.vertex_offset,
                                                            info.vertex_count);
 
-            auto vert_ceid = sc->vertices().find<IndexT>(builtin::contact_element_id);
+            auto vert_ceid = sc->vertices().find<IndexT>(builtin::key::contact_element_id);
             if(vert_ceid)
             {
                 auto ceid_view = vert_ceid->view();
@@ -726,7 +752,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
             }
             else
             {
-                auto ceid = sc->meta().find<IndexT>(builtin::contact_element_id);
+                auto ceid = sc->meta().find<IndexT>(builtin::key::contact_element_id);
 
                 if(ceid)
                 {
@@ -738,8 +764,8 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
 
         {  // 7) setup vertex is_fixed
 
-            auto is_fixed = sc->vertices().find<IndexT>(builtin::is_fixed);
-            auto constraint_uid = sc->meta().find<U64>(builtin::constraint_uid);
+            auto is_fixed = sc->vertices().find<IndexT>(builtin::key::is_fixed);
+            auto constraint_uid = sc->meta().find<U64>(builtin::key::constraint_uid);
 
             auto dst_is_fixed_span =
                 span{h_vertex_is_fixed}.subspan(info.vertex_offset, info.vertex_count);
@@ -760,7 +786,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
         }
 
         {  // 9) setup vertex is_dynamic
-            auto is_dynamic = sc->vertices().find<IndexT>(builtin::is_dynamic);
+            auto is_dynamic = sc->vertices().find<IndexT>(builtin::key::is_dynamic);
             auto dst_is_dynamic =
                 span{h_vertex_is_dynamic}.subspan(info.vertex_offset, info.vertex_count);
 
@@ -775,7 +801,7 @@ void FiniteElementMethod::Impl::_build_on_host(WorldVisitor& world)
 
         {  // 10) setup vertex gravities
 
-            auto gravity_attr = sc->vertices().find<Vector3>(builtin::gravity);
+            auto gravity_attr = sc->vertices().find<Vector3>(builtin::key::gravity);
             auto dst_gravties =
                 span{h_gravities}.subspan(info.vertex_offset, info.vertex_count);
 
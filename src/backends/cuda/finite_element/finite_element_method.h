@@ -483,6 +483,7 @@ class FiniteElementMethod final : public SimSystem
                           ForEachGeometry&&               for_each);
 
     virtual void do_build() override;
+    virtual void do_report_memory(MemoryReportInfo& info) const override;
 
     virtual bool do_dump(DumpInfo& info) override;
     virtual bool do_try_recover(RecoverInfo& info) override;
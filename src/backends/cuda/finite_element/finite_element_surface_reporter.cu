@@ -1,5 +1,6 @@
 #include <finite_element/finite_element_surface_reporter.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 
 namespace uipc::backend::cuda
 {
@@ -44,7 +45,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
 
         UIPC_ASSERT(sc != nullptr, "Geometry is not a simplicial complex, why?");
 
-        auto vert_is_surf = sc->vertices().find<IndexT>(builtin::is_surf);
+        auto vert_is_surf = sc->vertices().find<IndexT>(builtin::key::is_surf);
         if(vert_is_surf)
         {
             auto view = vert_is_surf->view();
@@ -55,7 +56,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
             geo_surf_vertex_counts[i] = count;
         }
 
-        auto edge_is_surf = sc->edges().find<IndexT>(builtin::is_surf);
+        auto edge_is_surf = sc->edges().find<IndexT>(builtin::key::is_surf);
         if(edge_is_surf)
         {
             auto view = edge_is_surf->view();
@@ -66,7 +67,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
             geo_surf_edge_counts[i] = count;
         }
 
-        auto tri_is_surf = sc->triangles().find<IndexT>(builtin::is_surf);
+        auto tri_is_surf = sc->triangles().find<IndexT>(builtin::key::is_surf);
         if(tri_is_surf)
         {
             auto view = tri_is_surf->view();
@@ -120,7 +121,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
         auto sc = geo_slot->geometry().as<geometry::SimplicialComplex>();
 
 
-        auto vert_is_surf = sc->vertices().find<IndexT>(builtin::is_surf);
+        auto vert_is_surf = sc->vertices().find<IndexT>(builtin::key::is_surf);
         if(vert_is_surf)
         {
             auto is_surf = vert_is_surf->view();
@@ -133,7 +134,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
                               { dst_e = i + global_vertex_offset; });
         }
 
-        auto edge_is_surf = sc->edges().find<IndexT>(builtin::is_surf);
+        auto edge_is_surf = sc->edges().find<IndexT>(builtin::key::is_surf);
         if(edge_is_surf)
         {
             auto is_surf = edge_is_surf->view();
@@ -150,7 +151,7 @@ void FiniteElementSurfaceReporter::Impl::init_surface(backend::WorldVisitor& wor
                               });
         };
 
-        auto tri_is_surf = sc->triangles().find<IndexT>(builtin::is_surf);
+        auto tri_is_surf = sc->triangles().find<IndexT>(builtin::key::is_surf);
         if(tri_is_surf)
         {
             auto is_surf = tri_is_surf->view();
@@ -40,6 +40,15 @@ void GlobalSimpicialSurfaceManager::do_build()
     m_impl.global_vertex_manager = find<GlobalVertexManager>();
 }
 
+void GlobalSimpicialSurfaceManager::do_report_memory(MemoryReportInfo& info) const
+{
+    info.add("codim_vertices", m_impl.codim_vertices);
+    info.add("surf_vertices", m_impl.surf_vertices);
+    info.add("codim_vertex_flags", m_impl.codim_vertex_flags);
+    info.add("surf_edges", m_impl.surf_edges);
+    info.add("surf_triangles", m_impl.surf_triangles);
+}
+
 void GlobalSimpicialSurfaceManager::Impl::init()
 {
     // 1) build the core invariant data structure: reporter_infos
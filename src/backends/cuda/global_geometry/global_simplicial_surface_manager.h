@@ -94,6 +94,7 @@ class GlobalSimpicialSurfaceManager : public SimSystem
 
   protected:
     virtual void do_build() override;
+    virtual void do_report_memory(MemoryReportInfo& info) const override;
 
   private:
     friend class SimEngine;
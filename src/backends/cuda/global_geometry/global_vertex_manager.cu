@@ -127,6 +127,24 @@ Float GlobalVertexManager::Impl::compute_axis_max_displacement()
     return axis_max_disp;
 }
 
+Float GlobalVertexManager::Impl::compute_max_velocity(Float dt)
+{
+    using namespace muda;
+
+    ParallelFor()
+        .file_line(__FILE__, __LINE__)
+        .apply(positions.size(),
+               [xs         = positions.cviewer().name("positions"),
+                x_prevs    = prev_positions.cviewer().name("prev_positions"),
+                disp_norms = displacement_norms.viewer().name("displacement_norms")] __device__(int i) mutable
+               { disp_norms(i) = (xs(i) - x_prevs(i)).norm(); });
+
+    DeviceReduce().Max(displacement_norms.data(), max_disp_norm.data(), displacement_norms.size());
+
+    Float h_max_disp_norm = max_disp_norm;
+    return h_max_disp_norm / dt;
+}
+
 AABB GlobalVertexManager::Impl::compute_vertex_bounding_box()
 {
     Float max_float = std::numeric_limits<Float>::max();
@@ -261,6 +279,20 @@ muda::CBufferView<IndexT> GlobalVertexManager::VertexDisplacementInfo::coindices
 
 void GlobalVertexManager::do_build() {}
 
+void GlobalVertexManager::do_report_memory(MemoryReportInfo& info) const
+{
+    info.add("coindices", m_impl.coindices);
+    info.add("dimensions", m_impl.dimensions);
+    info.add("positions", m_impl.positions);
+    info.add("prev_positions", m_impl.prev_positions);
+    info.add("rest_positions", m_impl.rest_positions);
+    info.add("safe_positions", m_impl.safe_positions);
+    info.add("thicknesses", m_impl.thicknesses);
+    info.add("contact_element_ids", m_impl.contact_element_ids);
+    info.add("displacements", m_impl.displacements);
+    info.add("displacement_norms", m_impl.displacement_norms);
+}
+
 bool GlobalVertexManager::do_dump(DumpInfo& info)
 {
     return m_impl.dump(info);
@@ -346,6 +378,11 @@ Float GlobalVertexManager::compute_axis_max_displacement()
     return m_impl.compute_axis_max_displacement();
 }
 
+Float GlobalVertexManager::compute_max_velocity(Float dt)
+{
+    return m_impl.compute_max_velocity(dt);
+}
+
 AABB GlobalVertexManager::compute_vertex_bounding_box()
 {
     return m_impl.compute_vertex_bounding_box();
@@ -139,6 +139,7 @@ class GlobalVertexManager : public SimSystem
         void collect_vertex_displacements();
 
         Float compute_axis_max_displacement();
+        Float compute_max_velocity(Float dt);
         AABB  compute_vertex_bounding_box();
 
         template <typename T>
@@ -179,6 +180,7 @@ class GlobalVertexManager : public SimSystem
 
   protected:
     virtual void do_build() override;
+    virtual void do_report_memory(MemoryReportInfo& info) const override;
     virtual bool do_dump(DumpInfo& info) override;
     virtual bool do_try_recover(RecoverInfo& info) override;
     virtual void do_apply_recover(RecoverInfo& info) override;
@@ -192,6 +194,8 @@ class GlobalVertexManager : public SimSystem
     void  record_prev_positions();
     void  collect_vertex_displacements();
     Float compute_axis_max_displacement();
+    // max |x - x_prev| / dt, call it before record_prev_positions()
+    Float compute_max_velocity(Float dt);
 
     AABB compute_vertex_bounding_box();
     void step_forward(Float alpha);
@@ -1,4 +1,5 @@
 #include <gradient_hessian_computer.h>
+#include <sim_engine.h>
 
 namespace uipc::backend::cuda
 {
@@ -18,14 +19,14 @@ void GradientHessianComputer::on_compute_gradient_hessian(
 
 void GradientHessianComputer::init()
 {
-    auto scene = world().scene();
-    m_dt       = scene.info()["dt"];
-
     [[maybe_unuse]] m_on_compute_gradient_hessian.view();
 }
 
 void GradientHessianComputer::compute_gradient_hessian()
 {
+    // the dt may change between time steps with adaptive time stepping
+    m_dt = engine().dt();
+
     ComputeInfo compute_info{this};
     for(auto& action : m_on_compute_gradient_hessian.view())
     {
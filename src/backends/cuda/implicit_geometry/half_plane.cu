@@ -1,6 +1,7 @@
 #include <implicit_geometry/half_plane.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/builtin/implicit_geometry_uid_collection.h>
 #include <uipc/common/range.h>
 #include <uipc/common/enumerate.h>
@@ -36,14 +37,25 @@ void HalfPlane::Impl::_find_geometry(WorldVisitor& world)
         auto ig = geo->as<geometry::ImplicitGeometry>();
         UIPC_ASSERT(ig, "ImplicitGeometry is expected here");
 
-        auto uid = ig->meta().find<U64>(builtin::implicit_geometry_uid);
+        auto uid = ig->meta().find<U64>(builtin::key::implicit_geometry_uid);
         if(!uid)
             continue;
 
-        if(uid->view()[0] == HalfPlane::ImplicitGeometryUID)
+        auto uid_value = uid->view()[0];
+        if(uid_value == HalfPlane::ImplicitGeometryUID)
         {
             geo_buffer.push_back(ig);
         }
+        else
+        {
+            // the contact pipeline only knows half planes, other shapes would be ignored silently
+            auto& uids = builtin::ImplicitGeometryUIDCollection::instance();
+            throw SimSystemException(fmt::format(
+                "Implicit geometry UID={} ({}) is host-only, the cuda backend only simulates HalfPlane (UID={}).",
+                uid_value,
+                uids.exists(uid_value) ? uids.find(uid_value).name : "unknown",
+                HalfPlane::ImplicitGeometryUID));
+        }
     }
 
     geos.resize(geo_buffer.size());
@@ -77,7 +89,7 @@ void HalfPlane::Impl::_build_geometry()
 
     for(auto&& [i, g] : enumerate(geos))
     {
-        auto cid = g->meta().find<IndexT>(builtin::contact_element_id);
+        auto cid = g->meta().find<IndexT>(builtin::key::contact_element_id);
         geo_to_contact_id[i] = cid ? cid->view()[0] : 0;
     }
 
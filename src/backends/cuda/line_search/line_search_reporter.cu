@@ -10,9 +10,27 @@ void LineSearchReporter::do_build()
 
     BuildInfo info;
     do_build(info);
+    m_non_negative_energy = info.m_non_negative_energy;
+    m_concurrent_safe     = info.m_concurrent_safe;
 
     line_searcher.add_reporter(this);
 }
+void LineSearchReporter::BuildInfo::non_negative_energy(bool v) noexcept
+{
+    m_non_negative_energy = v;
+}
+void LineSearchReporter::BuildInfo::concurrent_safe(bool v) noexcept
+{
+    m_concurrent_safe = v;
+}
+bool LineSearchReporter::is_non_negative_energy() const noexcept
+{
+    return m_non_negative_energy;
+}
+bool LineSearchReporter::is_concurrent_safe() const noexcept
+{
+    return m_concurrent_safe;
+}
 void LineSearchReporter::record_start_point(LineSearcher::RecordInfo& info)
 {
     do_record_start_point(info);
@@ -12,8 +12,30 @@ class LineSearchReporter : public SimSystem
     class BuildInfo
     {
       public:
+        /**
+         * @brief Declare that the reported energy is never negative.
+         *
+         * Only then can a partial sum that already exceeds the bound prove the line search failure,
+         * so the energy early exit skips the remaining terms only when all of them are non-negative.
+         */
+        void non_negative_energy(bool v) noexcept;
+        /**
+         * @brief Declare that `compute_energy()` can run concurrently with the other reporters.
+         *
+         * Only declare it if the reporter touches no shared device scratch memory and doesn't depend on
+         * the launch order of the other reporters on the default stream.
+         */
+        void concurrent_safe(bool v) noexcept;
+
+      private:
+        friend class LineSearchReporter;
+        bool m_non_negative_energy = false;
+        bool m_concurrent_safe     = false;
     };
 
+    bool is_non_negative_energy() const noexcept;
+    bool is_concurrent_safe() const noexcept;
+
   protected:
     virtual void do_record_start_point(LineSearcher::RecordInfo& info) = 0;
     virtual void do_step_forward(LineSearcher::StepInfo& info)         = 0;
@@ -28,7 +50,9 @@ class LineSearchReporter : public SimSystem
     void         record_start_point(LineSearcher::RecordInfo& info);
     void         step_forward(LineSearcher::StepInfo& info);
     void         compute_energy(LineSearcher::EnergyInfo& info);
-    SizeT        m_index = ~0ull;
+    SizeT        m_index               = ~0ull;
+    bool         m_non_negative_energy = false;
+    bool         m_concurrent_safe     = false;
 };
 
 }  // namespace uipc::backend::cuda
@@ -1,7 +1,13 @@
 #include <line_search/line_searcher.h>
 #include <uipc/common/enumerate.h>
 #include <uipc/common/zip.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/task_scheduler.h>
 #include <line_search/line_search_reporter.h>
+#include <sim_engine.h>
+#include <atomic>
+#include <numeric>
+#include <mutex>
 
 namespace uipc::backend::cuda
 {
@@ -16,15 +22,58 @@ void LineSearcher::init()
 {
     auto scene = world().scene();
 
-    m_energy_values.resize(m_reporters.view().size() + m_energy_reporters.view().size(), 0);
+    auto reporter_count = m_reporters.view().size();
+    auto energy_count   = reporter_count + m_energy_reporters.view().size();
+
+    m_energy_values.resize(energy_count, 0);
+    m_energy_evaluated.resize(energy_count, 0);
 
     for(auto&& [i, R] : enumerate(m_reporters.view()))
         R->m_index = i;
 
+    m_energy_names.reserve(energy_count);
+    for(auto&& R : m_reporters.view())
+        m_energy_names.push_back(std::string{R->name()});
+    for(auto&& name : m_energy_reporter_names)
+        m_energy_names.push_back(name);
+
+    // the reporters declare if their energy is non-negative and if they can run concurrently,
+    // the energy lambdas declare nothing, so they are treated as possibly negative and not concurrent safe
+    m_energy_non_negative.resize(energy_count, 0);
+    vector<IndexT> concurrent_safe(energy_count, 0);
+    for(auto&& [i, R] : enumerate(m_reporters.view()))
+    {
+        m_energy_non_negative[i] = R->is_non_negative_energy();
+        concurrent_safe[i]       = R->is_concurrent_safe();
+    }
+
+    // evaluate the possibly negative terms first, the early exit is only valid
+    // once all of them are evaluated
+    vector<IndexT> order(energy_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_partition(order,
+                                  [&](IndexT i) { return !m_energy_non_negative[i]; });
+    m_signed_energy_count = std::ranges::count(m_energy_non_negative, 0);
 
-    m_report_energy = scene.info()["line_search"]["report_energy"];
-    m_max_iter      = scene.info()["line_search"]["max_iter"];
-    m_dt            = scene.info()["dt"];
+    m_serial_terms.clear();
+    m_concurrent_terms.clear();
+    for(auto i : order)
+    {
+        if(concurrent_safe[i])
+            m_concurrent_terms.push_back(i);
+        else
+            m_serial_terms.push_back(i);
+    }
+
+    m_energy_report.terms.resize(energy_count);
+    for(auto&& [term, name] : zip(m_energy_report.terms, m_energy_names))
+        term.name = name;
+
+    auto& line_search   = scene.info()["line_search"];
+    m_report_energy     = line_search["report_energy"];
+    m_concurrent_energy = line_search["concurrent_energy"];
+    m_energy_early_exit = line_search["energy_early_exit"];
+    m_max_iter          = line_search["max_iter"];
 }
 
 void LineSearcher::record_start_point()
@@ -48,64 +97,155 @@ void LineSearcher::step_forward(Float alpha)
 
 Float LineSearcher::compute_energy(bool is_initial)
 {
-    auto reporter_energyes = span{m_energy_values}.subspan(0, m_reporters.view().size());
+    return compute_energy(is_initial, std::numeric_limits<Float>::infinity());
+}
 
-    for(auto&& [E, R] : zip(reporter_energyes, m_reporters.view()))
-    {
-        EnergyInfo info{this};
-        info.m_is_initial = is_initial;
-        R->compute_energy(info);
-        UIPC_ASSERT(info.m_energy.has_value(),
-                    "Energy[{}] not set by reporter, did you forget to call energy()?",
-                    R->name());
-        E = info.m_energy.value();
-        UIPC_ASSERT(!std::isnan(E) && std::isfinite(E), "Energy [{}] is {}", R->name(), E);
-    }
+Float LineSearcher::compute_energy(bool is_initial, Float energy_bound)
+{
+    // the concurrent early exit depends on which worker finishes first,
+    // in deterministic mode always evaluate all the terms
+    if(!m_energy_early_exit || (m_concurrent_energy && is_deterministic()))
+        energy_bound = std::numeric_limits<Float>::infinity();
 
-    auto energy_reporter_energyes =
-        span{m_energy_values}.subspan(m_reporters.view().size());
+    // the dt may change between time steps with adaptive time stepping
+    m_dt = engine().dt();
 
-    for(auto&& [E, ER, name] :
-        zip(energy_reporter_energyes, m_energy_reporters.view(), m_energy_reporter_names))
+    std::ranges::fill(m_energy_evaluated, 0);
+
+    Float partial_energy = m_concurrent_energy ?
+                               evaluate_concurrent(is_initial, energy_bound) :
+                               evaluate_serial(is_initial, energy_bound);
+
+    // sum up in a fixed order, so the result doesn't depend on the evaluation order
+    Float total_energy = 0.0;
+    bool  is_complete  = true;
+    for(auto&& [E, evaluated] : zip(m_energy_values, m_energy_evaluated))
     {
-        EnergyInfo info{this};
-        info.m_is_initial = is_initial;
-        ER(info);
-        UIPC_ASSERT(info.m_energy.has_value(),
-                    "Energy[{}] not set by reporter, did you forget to call energy()?",
-                    name);
-        E = info.m_energy.value();
-        UIPC_ASSERT(!std::isnan(E) && std::isfinite(E), "Energy [{}] is {}", name, E);
+        if(evaluated)
+            total_energy += E;
+        else
+            is_complete = false;
     }
 
-    Float total_energy =
-        std::accumulate(m_energy_values.begin(), m_energy_values.end(), 0.0);
+    m_energy_report.is_initial  = is_initial;
+    m_energy_report.is_complete = is_complete;
+    m_energy_report.total       = total_energy;
+    for(auto&& [term, E, evaluated] :
+        zip(m_energy_report.terms, m_energy_values, m_energy_evaluated))
+    {
+        term.value     = evaluated ? E : 0.0;
+        term.evaluated = evaluated;
+    }
 
     if(m_report_energy)
+        spdlog::info("Line Search Energy: {}", m_energy_report.to_json().dump());
+
+    // if exits early, return the partial sum that proves the failure
+    return is_complete ? total_energy : partial_energy;
+}
+
+void LineSearcher::compute_energy_term(SizeT i, bool is_initial)
+{
+    auto reporter_count = m_reporters.view().size();
+
+    EnergyInfo info{this};
+    info.m_is_initial = is_initial;
+
+    if(i < reporter_count)
+        m_reporters.view()[i]->compute_energy(info);
+    else
+        m_energy_reporters.view()[i - reporter_count](info);
+
+    const auto& name = m_energy_names[i];
+
+    UIPC_ASSERT(info.m_energy.has_value(),
+                "Energy[{}] not set by reporter, did you forget to call energy()?",
+                name);
+    Float E = info.m_energy.value();
+    UIPC_ASSERT(!std::isnan(E) && std::isfinite(E), "Energy [{}] is {}", name, E);
+
+    m_energy_values[i]    = E;
+    m_energy_evaluated[i] = 1;
+}
+
+Float LineSearcher::evaluate_serial(bool is_initial, Float energy_bound)
+{
+    Float partial_energy = 0.0;
+    SizeT signed_left    = m_signed_energy_count;
+
+    auto evaluate = [&](IndexT i)
     {
-        m_report_stream << R"(
--------------------------------------------------------------------------------
-*                             Compute Energy                                  *
--------------------------------------------------------------------------------
-)";
-        m_report_stream << "Total:" << total_energy << "\n";
-        for(auto&& [R, value] : zip(m_reporters.view(), reporter_energyes))
-        {
-            m_report_stream << "  > " << R->name() << "=" << value << "\n";
-        }
+        compute_energy_term(i, is_initial);
+        partial_energy += m_energy_values[i];
+        if(!m_energy_non_negative[i])
+            --signed_left;
+        // the remaining terms are non-negative, so the partial sum already proves the failure
+        return signed_left == 0 && partial_energy > energy_bound;
+    };
+
+    for(auto i : m_serial_terms)
+        if(evaluate(i))
+            return partial_energy;
+    for(auto i : m_concurrent_terms)
+        if(evaluate(i))
+            return partial_energy;
+
+    return partial_energy;
+}
+
+Float LineSearcher::evaluate_concurrent(bool is_initial, Float energy_bound)
+{
+    // The reporters share the default stream and may share device scratch memory,
+    // so only the terms declared concurrent safe (LineSearchReporter::BuildInfo::concurrent_safe)
+    // run on the workers. The others run one by one on the calling thread before them.
+    std::atomic<SizeT> next_term = 0;
+    std::atomic<bool>  exceeded  = false;
+    std::mutex         partial_mutex;
+    Float              partial_energy = 0.0;
+    SizeT              signed_left    = m_signed_energy_count;
+
+    auto evaluate = [&](IndexT i)
+    {
+        compute_energy_term(i, is_initial);
+
+        std::lock_guard lock{partial_mutex};
+        partial_energy += m_energy_values[i];
+        if(!m_energy_non_negative[i])
+            --signed_left;
+        // the remaining terms are non-negative, so the partial sum already proves the failure
+        if(signed_left == 0 && partial_energy > energy_bound)
+            exceeded = true;
+    };
+
+    for(auto i : m_serial_terms)
+    {
+        if(exceeded)
+            return partial_energy;
+        evaluate(i);
+    }
 
-        for(auto&& [ER, value, name] :
-            zip(m_energy_reporters.view(), energy_reporter_energyes, m_energy_reporter_names))
+    auto worker = [&]
+    {
+        while(!exceeded.load(std::memory_order_relaxed))
         {
-            m_report_stream << "  * " << name << "=" << value << "\n";
+            SizeT k = next_term.fetch_add(1, std::memory_order_relaxed);
+            if(k >= m_concurrent_terms.size())
+                break;
+            evaluate(m_concurrent_terms[k]);
         }
+    };
 
-        m_report_stream << "-------------------------------------------------------------------------------";
-        spdlog::info(m_report_stream.str());
-        m_report_stream.str("");
-    }
+    SizeT worker_count = std::min(m_concurrent_terms.size(), parallel_thread_count());
 
-    return total_energy;
+    // the calling thread also takes terms while waiting for the group
+    TaskGroup group;
+    for(SizeT i = 0; i < worker_count; ++i)
+        group.run(worker);
+
+    // rethrow the exception from the workers, if any
+    group.wait();
+
+    return partial_energy;
 }
 
 void LineSearcher::add_reporter(LineSearchReporter* reporter)
@@ -149,4 +289,27 @@ SizeT LineSearcher::max_iter() const noexcept
     return m_max_iter;
 }
 
+auto LineSearcher::energy_report() const noexcept -> const EnergyReport&
+{
+    return m_energy_report;
+}
+
+Json LineSearcher::EnergyReport::to_json() const
+{
+    Json j;
+    j["is_initial"]  = is_initial;
+    j["is_complete"] = is_complete;
+    j["total"]       = total;
+    auto& j_terms    = j["terms"];
+    j_terms          = Json::array();
+    for(auto&& term : terms)
+    {
+        Json& t        = j_terms.emplace_back();
+        t["name"]      = std::string{term.name};
+        t["value"]     = term.value;
+        t["evaluated"] = term.evaluated;
+    }
+    return j;
+}
+
 }  // namespace uipc::backend::cuda
@@ -1,6 +1,7 @@
 #pragma once
 #include <sim_system.h>
 #include <optional>
+#include <uipc/common/json.h>
 
 namespace uipc::backend::cuda
 {
@@ -37,6 +38,31 @@ class LineSearcher : public SimSystem
         bool                 m_is_initial = false;
     };
 
+    class EnergyTerm
+    {
+      public:
+        std::string_view name;
+        Float            value     = 0.0;
+        bool             evaluated = false;
+    };
+
+    /**
+     * @brief The structured result of the last energy evaluation.
+     * 
+     * If the evaluation exited early, `is_complete` is false and `total` only contains
+     * the terms that have been evaluated.
+     */
+    class EnergyReport
+    {
+      public:
+        bool               is_initial  = false;
+        bool               is_complete = true;
+        Float              total       = 0.0;
+        vector<EnergyTerm> terms;
+
+        Json to_json() const;
+    };
+
     void add_reporter(LineSearchReporter* reporter);
     void add_reporter(SimSystem&                        system,
                       std::string_view                  energy_name,
@@ -44,6 +70,8 @@ class LineSearcher : public SimSystem
 
     SizeT max_iter() const noexcept;
 
+    const EnergyReport& energy_report() const noexcept;
+
   protected:
     void do_build() override;
 
@@ -52,16 +80,43 @@ class LineSearcher : public SimSystem
     void  init();
     void  record_start_point();       // only be called by SimEngine
     void  step_forward(Float alpha);  // only be called by SimEngine
-    Float compute_energy(bool is_initial);           // only be called by SimEngine
+    Float compute_energy(bool is_initial);  // only be called by SimEngine
+
+    /**
+     * @brief Compute the energy, stop evaluating once the partial sum exceeds `energy_bound`
+     * 
+     * Only enabled when `line_search/energy_early_exit` is on, otherwise it's the same as `compute_energy(is_initial)`.
+     * With `line_search/concurrent_energy` in deterministic mode (see `uipc::set_deterministic()`), all terms are evaluated.
+     * The terms that may be negative are always evaluated first. Once only terms declared non-negative
+     * (see `LineSearchReporter::BuildInfo::non_negative_energy()`) are left, a partial sum greater than the bound
+     * proves `E > energy_bound`.
+     * 
+     * @return The total energy if all terms are evaluated, otherwise a partial sum greater than `energy_bound`
+     */
+    Float compute_energy(bool is_initial, Float energy_bound);  // only be called by SimEngine
+
+    void  compute_energy_term(SizeT i, bool is_initial);
+    Float evaluate_serial(bool is_initial, Float energy_bound);
+    Float evaluate_concurrent(bool is_initial, Float energy_bound);
 
     SimSystemSlotCollection<LineSearchReporter> m_reporters;
     SimActionCollection<void(EnergyInfo)>       m_energy_reporters;
     list<std::string>                           m_energy_reporter_names;
 
-    vector<Float>     m_energy_values;
-    bool              m_report_energy = false;
-    std::stringstream m_report_stream;
-    Float             m_dt       = 0.0;
-    SizeT             m_max_iter = 64;
+    vector<std::string> m_energy_names;
+    vector<Float>       m_energy_values;
+    vector<IndexT>      m_energy_evaluated;
+    vector<IndexT>      m_energy_non_negative;
+    SizeT               m_signed_energy_count = 0;
+    // evaluation order, the possibly negative terms first
+    vector<IndexT> m_serial_terms;
+    vector<IndexT> m_concurrent_terms;
+    EnergyReport        m_energy_report;
+
+    bool  m_report_energy     = false;
+    bool  m_concurrent_energy = false;
+    bool  m_energy_early_exit = false;
+    Float m_dt                = 0.0;
+    SizeT m_max_iter          = 64;
 };
 }  // namespace uipc::backend::cuda
@@ -69,16 +69,34 @@ SizeT GlobalLinearSystem::dof_count() const
 
 void GlobalLinearSystem::do_build() {}
 
-void GlobalLinearSystem::solve()
+void GlobalLinearSystem::do_report_memory(MemoryReportInfo& info) const
 {
+    // one 3x3 block and its (row, col) per entry
+    constexpr SizeT triplet_bytes = sizeof(Matrix3x3) + 2 * sizeof(int);
+
+    info.add("x", m_impl.x.size() * sizeof(Float));
+    info.add("b", m_impl.b.size() * sizeof(Float));
+    info.add("warm_x", m_impl.warm_x.size() * sizeof(Float));
+    info.add("triplet_A", m_impl.triplet_A.triplet_count() * triplet_bytes);
+    info.add("bcoo_A", m_impl.bcoo_A.triplet_count() * triplet_bytes);
+}
+
+void GlobalLinearSystem::solve(bool first_iteration)
+{
+    m_impl.last_iter_count = 0;
     m_impl.build_linear_system();
     // if the system is empty, skip the following steps
     if(m_impl.empty_system) [[unlikely]]
         return;
-    m_impl.solve_linear_system();
+    m_impl.solve_linear_system(first_iteration);
     m_impl.distribute_solution();
 }
 
+SizeT GlobalLinearSystem::last_iter_count() const noexcept
+{
+    return m_impl.last_iter_count;
+}
+
 void GlobalLinearSystem::prepare_hessian()
 {
     Timer timer{"Build Linear System"};
@@ -372,16 +390,29 @@ void GlobalLinearSystem::Impl::_assemble_preconditioner()
     }
 }
 
-void GlobalLinearSystem::Impl::solve_linear_system()
+void GlobalLinearSystem::Impl::solve_linear_system(bool first_iteration)
 {
     Timer timer{"Solve Linear System"};
     if(iterative_solver)
     {
+        // take the last frame's first solution as the initial guess,
+        // only if the dof layout is unchanged
+        bool use_warm_x = warm_start && first_iteration && warm_x.size() == x.size();
+        if(use_warm_x)
+            x.buffer_view().copy_from(warm_x.buffer_view());
+
         SolvingInfo info{this};
-        info.m_b = b.cview();
-        info.m_x = x.view();
+        info.m_b                 = b.cview();
+        info.m_x                 = x.view();
+        info.m_has_initial_guess = use_warm_x;
         iterative_solver->solve(info);
-        spdlog::info("Iterative linear solver iteration count: {}", info.m_iter_count);
+        last_iter_count = info.m_iter_count;
+        spdlog::info("Iterative linear solver iteration count: {} (warm start: {})",
+                     info.m_iter_count,
+                     use_warm_x);
+
+        if(warm_start && first_iteration)
+            warm_x = x;
     }
 }
 
@@ -539,6 +570,8 @@ void GlobalLinearSystem::add_preconditioner(GlobalPreconditioner* preconditioner
 
 void GlobalLinearSystem::init()
 {
+    m_impl.warm_start = world().scene().info()["newton"]["warm_start"]["enable"];
+    m_impl.converter.reuse_pattern(m_impl.warm_start);
     m_impl.init();
 }
 }  // namespace uipc::backend::cuda
\ No newline at end of file
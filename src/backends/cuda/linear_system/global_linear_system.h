@@ -210,13 +210,18 @@ class GlobalLinearSystem : public SimSystem
         DenseVectorView  x() { return m_x; }
         CDenseVectorView b() { return m_b; }
         void iter_count(SizeT iter_count) { m_iter_count = iter_count; }
+        /**
+         * @brief If true, x() holds an initial guess (warm start), the solver shouldn't clear it.
+         */
+        bool has_initial_guess() const { return m_has_initial_guess; }
 
       private:
         friend class Impl;
         DenseVectorView  m_x;
         CDenseVectorView m_b;
-        SizeT            m_iter_count = 0;
-        Impl*            m_impl       = nullptr;
+        SizeT            m_iter_count        = 0;
+        bool             m_has_initial_guess = false;
+        Impl*            m_impl              = nullptr;
     };
 
     class SolutionInfo
@@ -255,10 +260,11 @@ class GlobalLinearSystem : public SimSystem
         bool _update_subsystem_extent();
         void _assemble_linear_system();
         void _assemble_preconditioner();
-        void solve_linear_system();
+        void solve_linear_system(bool first_iteration);
         void distribute_solution();
 
         Float reserve_ratio = 1.1;
+        bool  warm_start    = false;
 
         vector<LinearSubsytemInfo> subsystem_infos;
 
@@ -286,6 +292,10 @@ class GlobalLinearSystem : public SimSystem
         muda::DeviceTripletMatrix<Float, 3> triplet_A;
         muda::DeviceBCOOMatrix<Float, 3>    bcoo_A;
         muda::DeviceDenseMatrix<Float>      debug_A;  // dense A for debug
+        // solution of the first newton iteration in the last frame, used as the initial guess
+        muda::DeviceDenseVector<Float> warm_x;
+        // iteration count of the last solve, for telemetry
+        SizeT last_iter_count = 0;
 
         Spmv                      spmver;
         MatrixConverter<Float, 3> converter;
@@ -306,6 +316,7 @@ class GlobalLinearSystem : public SimSystem
 
   protected:
     void do_build() override;
+    void do_report_memory(MemoryReportInfo& info) const override;
 
   private:
     friend class SimEngine;
@@ -327,7 +338,11 @@ class GlobalLinearSystem : public SimSystem
     void init();
 
     // only be called by SimEngine::do_advance()
-    void solve();
+    // first_iteration: the first newton iteration of the frame, which can be warm started
+    void solve(bool first_iteration = false);
+
+    // only be called by SimEngine::do_advance(), the iteration count of the last solve()
+    SizeT last_iter_count() const noexcept;
 
     // only be called by SimEngine::do_backward()
     // we just build a full hessian matrix for diff simulation
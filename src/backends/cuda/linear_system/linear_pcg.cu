@@ -20,7 +20,8 @@ void LinearPCG::do_solve(GlobalLinearSystem::SolvingInfo& info)
     auto x = info.x();
     auto b = info.b();
 
-    x.buffer_view().fill(0);
+    if(!info.has_initial_guess())
+        x.buffer_view().fill(0);
 
     auto N = x.size();
     if(z.capacity() < N)
@@ -37,12 +38,15 @@ void LinearPCG::do_solve(GlobalLinearSystem::SolvingInfo& info)
     r.resize(N);
     Ap.resize(N);
 
-    auto iter = pcg(x, b, max_iter_ratio * b.size());
+    auto iter = pcg(x, b, max_iter_ratio * b.size(), info.has_initial_guess());
 
     info.iter_count(iter);
 }
 
-SizeT LinearPCG::pcg(muda::DenseVectorView<Float> x, muda::CDenseVectorView<Float> b, SizeT max_iter)
+SizeT LinearPCG::pcg(muda::DenseVectorView<Float>  x,
+                     muda::CDenseVectorView<Float> b,
+                     SizeT                         max_iter,
+                     bool                          has_initial_guess)
 {
     SizeT k = 0;
     // r = b - A * x
@@ -50,9 +54,19 @@ SizeT LinearPCG::pcg(muda::DenseVectorView<Float> x, muda::CDenseVectorView<Floa
         // r = b;
         r.buffer_view().copy_from(b.buffer_view());
 
-        // x == 0, so we don't need to do the following
-        // r = - A * x + r
-        //spmv(-1.0, x.as_const(), 1.0, r.view());
+        // if x == 0, we don't need to do the following
+        if(has_initial_guess)
+        {
+            // r = - A * x + r
+            spmv(-1.0, x.as_const(), 1.0, r.view());
+
+            // the initial guess is worse than zero, drop it
+            if(ctx().norm(r.cview()) > ctx().norm(b))
+            {
+                x.buffer_view().fill(0);
+                r.buffer_view().copy_from(b.buffer_view());
+            }
+        }
     }
 
     Float alpha, beta, rz, rz0;
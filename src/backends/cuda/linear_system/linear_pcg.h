@@ -18,7 +18,10 @@ class LinearPCG : public IterativeSolver
     using DeviceBCOOMatrix  = muda::DeviceBCOOMatrix<Float, 3>;
     using DeviceBSRMatrix   = muda::DeviceBSRMatrix<Float, 3>;
 
-    SizeT pcg(muda::DenseVectorView<Float> x, muda::CDenseVectorView<Float> b, SizeT max_iter);
+    SizeT pcg(muda::DenseVectorView<Float>  x,
+              muda::CDenseVectorView<Float> b,
+              SizeT                         max_iter,
+              bool                          has_initial_guess);
 
     DeviceDenseVector      z;   // preconditioned residual
     DeviceDenseVector      r;   // residual
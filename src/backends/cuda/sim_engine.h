@@ -20,6 +20,7 @@ class GlobalAnimator;
 class GlobalDiffSimManager;
 class AffineBodyDynamics;
 class FiniteElementMethod;
+class AdaptiveTimeStepper;
 
 class SimEngine final : public backend::SimEngine
 {
@@ -33,6 +34,12 @@ class SimEngine final : public backend::SimEngine
     SimEngine& operator=(const SimEngine&) = delete;
 
     SimEngineState state() const noexcept;
+    /**
+     * @brief The dt of the current time step.
+     *
+     * Equals to the scene `dt` unless adaptive time stepping splits the frame into substeps.
+     */
+    Float dt() const noexcept;
 
   private:
     virtual void  do_init(InitInfo& info) override;
@@ -42,6 +49,8 @@ class SimEngine final : public backend::SimEngine
     virtual void  do_backward() override;
     virtual SizeT get_frame() const override;
 
+    virtual Json do_memory_report() const override;
+
     virtual bool do_dump(DumpInfo&) override;
     virtual bool do_try_recover(RecoverInfo&) override;
     virtual void do_apply_recover(RecoverInfo&) override;
@@ -91,5 +100,17 @@ class SimEngine final : public backend::SimEngine
     SizeT m_last_solved_frame   = 0;
     bool  m_strict_mode         = false;
     Float m_ccd_tol             = 1;
+
+    // Warm Start
+    bool m_warm_start = false;
+    // the dcd candidates are detected at the current positions
+    bool m_dcd_candidates_fresh = false;
+
+    // Adaptive Time Stepping
+    Float                  m_frame_dt = 0.0;
+    Float                  m_dt       = 0.0;
+    U<AdaptiveTimeStepper> m_adaptive_time_stepper;
+    Json                   m_recovered_adaptive_dt;
+    vector<Float>          m_frame_substep_dts;
 };
 }  // namespace uipc::backend::cuda
\ No newline at end of file
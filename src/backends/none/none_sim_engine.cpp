@@ -30,6 +30,11 @@ void NoneSimEngine::do_advance()
 {
     m_frame++;
     spdlog::info("[NoneEngine] do_advance() called.");
+
+    // nothing is solved, but the frame is still reported
+    core::FrameTelemetry record;
+    record.frame = m_frame;
+    telemetry().push(std::move(record));
 }
 
 void NoneSimEngine::do_sync()
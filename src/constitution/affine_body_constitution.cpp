@@ -3,6 +3,7 @@
 #include <uipc/builtin/attribute_name.h>
 #include <uipc/builtin/constitution_type.h>
 #include <uipc/geometry/utils/compute_instance_volume.h>
+#include <uipc/common/parallel_for.h>
 
 namespace uipc::constitution
 {
@@ -110,6 +111,29 @@ void AffineBodyConstitution::apply_to(geometry::SimplicialComplex& sc, Float kap
         geometry::view(*meta_mass).front() = mass_density;
 }
 
+void AffineBodyConstitution::apply_to(geometry::SimplicialComplex& sc,
+                                      span<const Float>            kappa,
+                                      Float mass_density) const
+{
+    UIPC_ASSERT(kappa.size() == sc.instances().size(),
+                "Kappa size mismatch, expected {} (instance count), yours {}",
+                sc.instances().size(),
+                kappa.size());
+
+    apply_to(sc, kappa.empty() ? 0.0 : kappa.front(), mass_density);
+
+    auto kappa_attr = sc.instances().find<Float>("kappa");
+    std::ranges::copy(kappa, geometry::view(*kappa_attr).begin());
+}
+
+void AffineBodyConstitution::apply_to(span<geometry::SimplicialComplex* const> scs,
+                                      Float kappa,
+                                      Float mass_density) const
+{
+    // the simplicial complexes are independent, each task only touches its own attributes
+    parallel_for(scs.size(), [&](SizeT i) { apply_to(*scs[i], kappa, mass_density); });
+}
+
 Json AffineBodyConstitution::default_config() noexcept
 {
     Json j    = Json::object();
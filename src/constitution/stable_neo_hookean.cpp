@@ -4,6 +4,8 @@
 #include <uipc/builtin/constitution_type.h>
 #include <uipc/constitution/conversion.h>
 #include <uipc/common/log.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/parallel_for.h>
 
 namespace uipc::constitution
 {
@@ -44,6 +46,43 @@ void StableNeoHookean::apply_to(geometry::SimplicialComplex& sc,
     std::ranges::fill(geometry::view(*lambda_attr), lambda);
 }
 
+void StableNeoHookean::apply_to(geometry::SimplicialComplex& sc,
+                                span<const ElasticModuli>    moduli,
+                                Float                        mass_density) const
+{
+    UIPC_ASSERT(sc.dim() == 3, "StableNeoHookean only supports 3D simplicial complex");
+    UIPC_ASSERT(moduli.size() == sc.tetrahedra().size(),
+                "Moduli size mismatch, expected {} (tetrahedra count), yours {}",
+                sc.tetrahedra().size(),
+                moduli.size());
+
+    Base::apply_to(sc, mass_density);
+
+    auto mu_attr = sc.tetrahedra().find<Float>("mu");
+    if(!mu_attr)
+        mu_attr = sc.tetrahedra().create<Float>("mu", 0.0);
+
+    auto lambda_attr = sc.tetrahedra().find<Float>("lambda");
+    if(!lambda_attr)
+        lambda_attr = sc.tetrahedra().create<Float>("lambda", 0.0);
+
+    auto mu_view     = geometry::view(*mu_attr);
+    auto lambda_view = geometry::view(*lambda_attr);
+    for(auto&& [i, m] : enumerate(moduli))
+    {
+        mu_view[i]     = m.mu();
+        lambda_view[i] = m.lambda();
+    }
+}
+
+void StableNeoHookean::apply_to(span<geometry::SimplicialComplex* const> scs,
+                                const ElasticModuli&                     moduli,
+                                Float mass_density) const
+{
+    // the simplicial complexes are independent, each task only touches its own attributes
+    parallel_for(scs.size(), [&](SizeT i) { apply_to(*scs[i], moduli, mass_density); });
+}
+
 Json StableNeoHookean::default_config() noexcept
 {
     return Json::object();
@@ -24,4 +24,24 @@ core::DiffSim& DiffSimVisitor::ref()
 {
     return m_diff_sim;
 }
+
+diff_sim::SparseCOOView DiffSimVisitor::H() const
+{
+    return m_diff_sim._H();
+}
+
+diff_sim::SparseCOOView DiffSimVisitor::pGpP() const
+{
+    return m_diff_sim._pGpP();
+}
+
+void DiffSimVisitor::H(const diff_sim::SparseCOOView& H)
+{
+    m_diff_sim._H() = H;
+}
+
+void DiffSimVisitor::pGpP(const diff_sim::SparseCOOView& pGpP)
+{
+    m_diff_sim._pGpP() = pGpP;
+}
 }  // namespace uipc::backend
\ No newline at end of file
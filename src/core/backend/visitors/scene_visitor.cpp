@@ -24,6 +24,16 @@ bool SceneVisitor::is_pending() const noexcept
     return m_scene.is_pending();
 }
 
+void SceneVisitor::lock() noexcept
+{
+    m_scene.lock();
+}
+
+void SceneVisitor::unlock() noexcept
+{
+    m_scene.unlock();
+}
+
 span<S<geometry::GeometrySlot>> SceneVisitor::geometries() const noexcept
 {
     return m_scene.geometry_collection().geometry_slots();
@@ -59,6 +69,16 @@ span<IndexT> SceneVisitor::pending_destroy_ids() const noexcept
     return m_scene.geometry_collection().pending_destroy_ids();
 }
 
+geometry::GeometryChangeSet SceneVisitor::pending_change_set() const
+{
+    return m_scene.geometry_collection().pending_change_set();
+}
+
+const geometry::GeometryChangeSet& SceneVisitor::last_change_set() const noexcept
+{
+    return m_scene.geometry_collection().last_change_set();
+}
+
 const Json& SceneVisitor::info() const noexcept
 {
     return m_scene.info();
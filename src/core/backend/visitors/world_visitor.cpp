@@ -8,6 +8,11 @@ WorldVisitor::WorldVisitor(core::World& w) noexcept
 {
 }
 
+bool WorldVisitor::has_scene() const noexcept
+{
+    return m_world.m_scene != nullptr;
+}
+
 SceneVisitor WorldVisitor::scene() noexcept
 {
     return SceneVisitor{*m_world.m_scene};
@@ -22,4 +27,9 @@ core::World& WorldVisitor::ref() noexcept
 {
     return m_world;
 }
+
+core::Engine& WorldVisitor::engine() noexcept
+{
+    return *m_world.m_engine;
+}
 }  // namespace uipc::backend
@@ -0,0 +1,27 @@
+#include <uipc/common/parallel_for.h>
+#include <atomic>
+
+namespace uipc
+{
+static std::atomic<bool> g_deterministic = false;
+
+void set_parallel_thread_count(SizeT count)
+{
+    TaskScheduler::instance().set_thread_count(count);
+}
+
+SizeT parallel_thread_count() noexcept
+{
+    return TaskScheduler::instance().thread_count();
+}
+
+void set_deterministic(bool value) noexcept
+{
+    g_deterministic.store(value, std::memory_order_relaxed);
+}
+
+bool is_deterministic() noexcept
+{
+    return g_deterministic.load(std::memory_order_relaxed);
+}
+}  // namespace uipc
@@ -0,0 +1,505 @@
+#include <uipc/common/task_scheduler.h>
+#include <uipc/common/log.h>
+#include <uipc/common/enumerate.h>
+#include <uipc/common/format.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace uipc
+{
+namespace detail
+{
+    // the scheduler (and the worker index in it) of the current thread, nullptr for non-worker threads
+    static thread_local const void* tls_scheduler = nullptr;
+    static thread_local SizeT       tls_worker    = 0;
+
+    static SizeT resolve_thread_count(SizeT count)
+    {
+        if(count == 0)
+            count = std::thread::hardware_concurrency();
+        return std::max<SizeT>(count, 1);
+    }
+
+    // cpu < 0 removes the pinning
+    static bool pin_thread(std::thread& t, IndexT cpu)
+    {
+#if defined(_WIN32)
+        DWORD_PTR mask;
+        if(cpu >= 0)
+        {
+            mask = DWORD_PTR{1} << cpu;
+        }
+        else
+        {
+            DWORD_PTR system_mask;
+            if(!GetProcessAffinityMask(GetCurrentProcess(), &mask, &system_mask))
+                return false;
+        }
+        return SetThreadAffinityMask(t.native_handle(), mask) != 0;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if(cpu >= 0)
+        {
+            if(cpu >= CPU_SETSIZE)
+                return false;
+            CPU_SET(cpu, &set);
+        }
+        else
+        {
+            if(sched_getaffinity(0, sizeof(set), &set) != 0)
+                return false;
+        }
+        return pthread_setaffinity_np(t.native_handle(), sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+}  // namespace detail
+
+class TaskScheduler::Impl
+{
+    using Task = std::function<void()>;
+
+    class TaskQueue
+    {
+      public:
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+  public:
+    Impl() { start(detail::resolve_thread_count(0)); }
+
+    ~Impl() { stop(); }
+
+    bool is_worker() const noexcept { return detail::tls_scheduler == this; }
+
+    // the queue of the calling thread, the non-worker threads share the last one
+    SizeT self_index() const noexcept
+    {
+        return is_worker() ? detail::tls_worker : queues.size() - 1;
+    }
+
+    void push(Task&& task)
+    {
+        {
+            // a restart may replace the queues from another thread
+            std::shared_lock queues_lock{queues_mutex};
+            auto&            Q = *queues[self_index()];
+            std::lock_guard  lock{Q.mutex};
+            Q.tasks.push_back(std::move(task));
+            queued.fetch_add(1, std::memory_order_release);
+        }
+
+        // taking the lock prevents a lost wakeup of a worker between its check and its wait
+        {
+            std::lock_guard lock{sleep_mutex};
+        }
+        sleep_cv.notify_one();
+    }
+
+    std::optional<Task> pop()
+    {
+        if(queued.load(std::memory_order_acquire) == 0)
+            return std::nullopt;
+
+        std::shared_lock queues_lock{queues_mutex};
+
+        SizeT self  = self_index();
+        SizeT count = queues.size();
+
+        // own tasks newest first (they are hot in cache), the others' oldest first
+        for(SizeT k = 0; k < count; ++k)
+        {
+            SizeT q = (self + k) % count;
+            auto& Q = *queues[q];
+
+            std::lock_guard lock{Q.mutex};
+            if(Q.tasks.empty())
+                continue;
+
+            Task task;
+            if(k == 0 && is_worker())
+            {
+                task = std::move(Q.tasks.back());
+                Q.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(Q.tasks.front());
+                Q.tasks.pop_front();
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    void worker_loop(SizeT index)
+    {
+        detail::tls_scheduler = this;
+        detail::tls_worker    = index;
+
+        while(true)
+        {
+            if(auto task = pop())
+            {
+                (*task)();
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex};
+            sleep_cv.wait(lock,
+                          [&]
+                          {
+                              return stopping
+                                     || queued.load(std::memory_order_acquire) > 0;
+                          });
+            // drain the queues before exiting
+            if(stopping && queued.load(std::memory_order_acquire) == 0)
+                break;
+        }
+
+        detail::tls_scheduler = nullptr;
+    }
+
+    void start(SizeT count)
+    {
+        thread_count.store(count, std::memory_order_relaxed);
+
+        SizeT worker_count = count - 1;
+        {
+            std::unique_lock queues_lock{queues_mutex};
+
+            // the tasks pushed by the non-worker threads after the old workers stopped
+            std::deque<Task> leftovers;
+            for(auto& Q : queues)
+                std::ranges::move(Q->tasks, std::back_inserter(leftovers));
+
+            queues.clear();
+            // one queue per worker, the last one for the non-worker threads
+            for(SizeT i = 0; i < worker_count + 1; ++i)
+                queues.push_back(uipc::make_unique<TaskQueue>());
+            queues.back()->tasks = std::move(leftovers);
+        }
+
+        workers.reserve(worker_count);
+        for(SizeT i = 0; i < worker_count; ++i)
+            workers.emplace_back([this, i] { worker_loop(i); });
+
+        if(!affinity.empty())
+            apply_affinity();
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard lock{sleep_mutex};
+            stopping = true;
+        }
+        sleep_cv.notify_all();
+
+        for(auto& w : workers)
+            w.join();
+        workers.clear();
+
+        stopping = false;
+    }
+
+    // other non-worker threads may keep pushing and running tasks meanwhile, their tasks move to the new queues
+    void restart(SizeT count)
+    {
+        stop();
+        start(count);
+    }
+
+    void apply_affinity()
+    {
+        for(auto&& [i, w] : enumerate(workers))
+        {
+            IndexT cpu = affinity.empty() ? -1 : affinity[i % affinity.size()];
+            if(!detail::pin_thread(w, cpu))
+            {
+                spdlog::warn("TaskScheduler: failed to set the affinity of worker {} (cpu {}), ignored.", i, cpu);
+                return;
+            }
+        }
+    }
+
+    std::mutex              config_mutex;
+    std::atomic<SizeT>      thread_count = 1;
+    vector<IndexT>          affinity;
+    std::shared_mutex       queues_mutex;
+    vector<U<TaskQueue>>    queues;
+    vector<std::thread>     workers;
+    std::atomic<SizeT>      queued = 0;
+    std::mutex              sleep_mutex;
+    std::condition_variable sleep_cv;
+    bool                    stopping = false;
+};
+
+TaskScheduler& TaskScheduler::instance()
+{
+    // never destroyed: joining the workers during static destruction
+    // (e.g. when the shared library is unloaded on Windows) may deadlock
+    static TaskScheduler* scheduler = new TaskScheduler;
+    return *scheduler;
+}
+
+TaskScheduler::TaskScheduler()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+TaskScheduler::~TaskScheduler() {}
+
+SizeT TaskScheduler::thread_count() const noexcept
+{
+    return m_impl->thread_count.load(std::memory_order_relaxed);
+}
+
+void TaskScheduler::set_thread_count(SizeT count)
+{
+    UIPC_ASSERT(!is_worker_thread(), "TaskScheduler can't be reconfigured from its own task.");
+
+    std::lock_guard lock{m_impl->config_mutex};
+    count = detail::resolve_thread_count(count);
+    if(count == thread_count())
+        return;
+    m_impl->restart(count);
+}
+
+void TaskScheduler::set_affinity(span<const IndexT> cpus)
+{
+    UIPC_ASSERT(!is_worker_thread(), "TaskScheduler can't be reconfigured from its own task.");
+
+    std::lock_guard lock{m_impl->config_mutex};
+    m_impl->affinity.assign(cpus.begin(), cpus.end());
+    m_impl->apply_affinity();
+}
+
+vector<IndexT> TaskScheduler::affinity() const
+{
+    std::lock_guard lock{m_impl->config_mutex};
+    return m_impl->affinity;
+}
+
+bool TaskScheduler::is_worker_thread() const noexcept
+{
+    return m_impl->is_worker();
+}
+
+void TaskScheduler::submit(std::function<void()>&& task)
+{
+    m_impl->push(std::move(task));
+}
+
+bool TaskScheduler::try_run_one()
+{
+    if(auto task = m_impl->pop())
+    {
+        (*task)();
+        return true;
+    }
+    return false;
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler)
+    : m_scheduler{scheduler}
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait_all();
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    {
+        std::lock_guard lock{m_mutex};
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_scheduler.submit(
+        [this, task = std::move(task)]
+        {
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                std::lock_guard lock{m_mutex};
+                if(!m_exception)
+                    m_exception = std::current_exception();
+            }
+
+            // the group may be destroyed as soon as the waiter sees 0,
+            // so decrement under the lock and don't touch `this` after
+            std::lock_guard lock{m_mutex};
+            if(m_pending.fetch_sub(1, std::memory_order_release) == 1)
+                m_cv.notify_all();
+        });
+}
+
+void TaskGroup::wait()
+{
+    wait_all();
+
+    std::exception_ptr e;
+    {
+        std::lock_guard lock{m_mutex};
+        std::swap(e, m_exception);
+    }
+    if(e)
+        std::rethrow_exception(e);
+}
+
+void TaskGroup::wait_all() noexcept
+{
+    using namespace std::chrono_literals;
+
+    while(m_pending.load(std::memory_order_acquire) > 0)
+    {
+        // help instead of blocking, the pending tasks may be queued behind this thread
+        if(m_scheduler.try_run_one())
+            continue;
+
+        // the tasks are running on the other threads, nap until they are done or more work shows up
+        std::unique_lock lock{m_mutex};
+        m_cv.wait_for(lock, 50us, [&] { return m_pending.load() == 0; });
+    }
+
+    // synchronize with the last task, it releases the lock after its decrement
+    std::lock_guard lock{m_mutex};
+}
+
+class TaskGraph::Impl
+{
+  public:
+    vector<std::function<void()>> tasks;
+    vector<vector<TaskId>>        successors;
+    vector<SizeT>                 predecessor_counts;
+
+    void check_acyclic() const
+    {
+        // Kahn's algorithm, all the tasks are visited iff the graph is a DAG
+        vector<SizeT>  counts = predecessor_counts;
+        vector<TaskId> ready;
+        for(TaskId i = 0; i < tasks.size(); ++i)
+            if(counts[i] == 0)
+                ready.push_back(i);
+
+        SizeT visited = 0;
+        while(!ready.empty())
+        {
+            TaskId i = ready.back();
+            ready.pop_back();
+            ++visited;
+            for(TaskId s : successors[i])
+                if(--counts[s] == 0)
+                    ready.push_back(s);
+        }
+
+        if(visited != tasks.size())
+            throw TaskGraphException{fmt::format(
+                "TaskGraph has a cycle, {} of {} tasks can never start.", tasks.size() - visited, tasks.size())};
+    }
+};
+
+TaskGraph::TaskGraph()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+TaskGraph::~TaskGraph() {}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> task)
+{
+    m_impl->tasks.push_back(std::move(task));
+    m_impl->successors.emplace_back();
+    m_impl->predecessor_counts.push_back(0);
+    return m_impl->tasks.size() - 1;
+}
+
+void TaskGraph::precede(TaskId before, TaskId after)
+{
+    UIPC_ASSERT(before < size() && after < size(),
+                "TaskId out of range, before={}, after={}, task count={}",
+                before,
+                after,
+                size());
+    m_impl->successors[before].push_back(after);
+    m_impl->predecessor_counts[after] += 1;
+}
+
+SizeT TaskGraph::size() const noexcept
+{
+    return m_impl->tasks.size();
+}
+
+void TaskGraph::run(TaskScheduler& scheduler)
+{
+    m_impl->check_acyclic();
+
+    auto& tasks      = m_impl->tasks;
+    auto& successors = m_impl->successors;
+
+    std::vector<std::atomic<SizeT>> remaining(tasks.size());
+    for(TaskId i = 0; i < tasks.size(); ++i)
+        remaining[i] = m_impl->predecessor_counts[i];
+
+    std::atomic<bool> failed = false;
+    TaskGroup         group{scheduler};
+
+    std::function<void(TaskId)> launch = [&](TaskId i)
+    {
+        group.run(
+            [&, i]
+            {
+                // after a failure, the tasks not started yet are skipped
+                if(!failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        tasks[i]();
+                    }
+                    catch(...)
+                    {
+                        failed = true;
+                        throw;
+                    }
+                }
+
+                for(TaskId s : successors[i])
+                    if(remaining[s].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        launch(s);
+            });
+    };
+
+    for(TaskId i = 0; i < tasks.size(); ++i)
+        if(m_impl->predecessor_counts[i] == 0)
+            launch(i);
+
+    group.wait();
+}
+}  // namespace uipc
@@ -1,6 +1,9 @@
 #include <uipc/common/timer.h>
 #include <uipc/common/log.h>
 #include <fmt/ranges.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace uipc::details
 {
@@ -110,8 +113,143 @@ Timer::~Timer()
     if(!m_global_on && !m_force_on)
         return;
     sync();
-    auto& t = GlobalTimer::current()->pop_timer();
+    auto  gt = GlobalTimer::current();
+    auto& t  = gt->pop_timer();
     t.tock();
+    gt->m_frame_durations[t.full_name] += t.duration.count();
+}
+
+void Timer::end_frame(SizeT frame)
+{
+    GlobalTimer::current()->end_frame(frame);
+}
+
+Json Timer::report_frames_as_json()
+{
+    return GlobalTimer::current()->report_frames_as_json();
+}
+
+double FrameTimerStats::percentile(double p) const
+{
+    if(m_window.empty())
+        return 0.0;
+
+    vector<double> sorted;
+    sorted.reserve(m_window.size());
+    for(auto& sample : m_window)
+        sorted.push_back(sample.duration);
+    std::ranges::sort(sorted);
+
+    double rank = std::clamp(p, 0.0, 100.0) / 100.0 * (sorted.size() - 1);
+    SizeT  lo   = static_cast<SizeT>(std::floor(rank));
+    SizeT  hi   = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+double FrameTimerStats::histogram_percentile(double p) const
+{
+    if(m_frame_count == 0)
+        return 0.0;
+
+    // the nearest rank
+    SizeT rank = static_cast<SizeT>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * m_frame_count));
+    rank       = std::max<SizeT>(rank, 1);
+
+    SizeT count = 0;
+    for(SizeT bin = 0; bin < m_histogram.size(); ++bin)
+    {
+        count += m_histogram[bin];
+        if(count >= rank)
+            return std::min(histogram_bin_upper(bin), m_max);
+    }
+    return m_max;
+}
+
+double FrameTimerStats::histogram_bin_upper(SizeT bin)
+{
+    if(bin + 1 >= HistogramBinCount)
+        return std::numeric_limits<double>::infinity();
+    return HistogramMinDuration * std::exp2(static_cast<double>(bin) / HistogramBinsPerOctave);
+}
+
+double FrameTimerStats::mean() const noexcept
+{
+    return m_frame_count ? m_total / m_frame_count : 0.0;
+}
+
+bool FrameTimerStats::push(SizeT  frame,
+                           double duration,
+                           SizeT  window_size,
+                           double spike_ratio,
+                           SizeT  min_frames,
+                           double& median)
+{
+    // compare with the median of the frames before this one
+    bool is_spike = false;
+    median        = percentile(50.0);
+    if(m_window.size() >= std::max<SizeT>(min_frames, 1))
+        is_spike = duration > spike_ratio * median;
+
+    if(m_window.size() >= window_size)
+        m_window.erase(m_window.begin(), m_window.end() - (window_size - 1));
+    m_window.push_back(Sample{frame, duration, is_spike});
+
+    SizeT bin = 0;
+    if(duration >= HistogramMinDuration)
+    {
+        auto octaves = std::log2(duration / HistogramMinDuration);
+        bin          = static_cast<SizeT>(octaves * HistogramBinsPerOctave) + 1;
+        bin          = std::min(bin, HistogramBinCount - 1);
+    }
+    m_histogram[bin] += 1;
+
+    m_frame_count += 1;
+    m_spike_count += is_spike;
+    m_total += duration;
+    m_max = std::max(m_max, duration);
+
+    return is_spike;
+}
+
+Json FrameTimerStats::to_json() const
+{
+    Json j;
+    j["frame_count"] = m_frame_count;
+    j["spike_count"] = m_spike_count;
+    j["mean"]        = mean();
+    j["max"]         = m_max;
+
+    Json& w       = j["window"];
+    w["p50"]      = percentile(50.0);
+    w["p95"]      = percentile(95.0);
+    w["p99"]      = percentile(99.0);
+    w["frame"]    = Json::array();
+    w["duration"] = Json::array();
+    w["spike"]    = Json::array();
+    for(auto& sample : m_window)
+    {
+        w["frame"].push_back(sample.frame);
+        w["duration"].push_back(sample.duration);
+        w["spike"].push_back(sample.is_spike);
+    }
+
+    // only the non-empty bins
+    Json& h        = j["histogram"];
+    h["p50"]       = histogram_percentile(50.0);
+    h["p95"]       = histogram_percentile(95.0);
+    h["p99"]       = histogram_percentile(99.0);
+    h["bin_upper"] = Json::array();
+    h["count"]     = Json::array();
+    for(SizeT bin = 0; bin < m_histogram.size(); ++bin)
+    {
+        if(m_histogram[bin] == 0)
+            continue;
+        auto upper = histogram_bin_upper(bin);
+        // json has no infinity
+        h["bin_upper"].push_back(std::isinf(upper) ? Json{} : Json{upper});
+        h["count"].push_back(m_histogram[bin]);
+    }
+    return j;
 }
 
 GlobalTimer GlobalTimer::default_instance;
@@ -256,6 +394,75 @@ void GlobalTimer::clear()
     m_timer_stack.push(m_root);
 }
 
+void GlobalTimer::end_frame(SizeT frame)
+{
+    if(m_frame_durations.empty())
+        return;
+
+    for(auto&& [path, duration] : m_frame_durations)
+    {
+        auto&  stats = m_frame_stats[path];
+        double median;
+        if(stats.push(frame, duration, m_frame_window, m_spike_ratio, m_spike_min_frames, median))
+        {
+            Json spike;
+            spike["frame"]    = frame;
+            spike["timer"]    = path;
+            spike["duration"] = duration;
+            spike["median"]   = median;
+
+            m_spikes.push_back(std::move(spike));
+            if(m_spikes.size() > MaxSpikeCount)
+                m_spikes.pop_front();
+        }
+    }
+
+    m_frame_durations.clear();
+    ++m_frame_count;
+}
+
+void GlobalTimer::set_frame_window(SizeT frames)
+{
+    m_frame_window = std::max<SizeT>(frames, 1);
+}
+
+void GlobalTimer::set_spike_threshold(double ratio, SizeT min_frames)
+{
+    m_spike_ratio      = ratio;
+    m_spike_min_frames = min_frames;
+}
+
+const FrameTimerStats* GlobalTimer::frame_stats(std::string_view full_name) const
+{
+    auto it = m_frame_stats.find(string{full_name});
+    return it != m_frame_stats.end() ? &it->second : nullptr;
+}
+
+Json GlobalTimer::report_frames_as_json() const
+{
+    Json j;
+    j["frame_count"]  = m_frame_count;
+    j["frame_window"] = m_frame_window;
+    j["spike_ratio"]  = m_spike_ratio;
+
+    j["timers"] = Json::object();
+    for(auto&& [path, stats] : m_frame_stats)
+        j["timers"][path] = stats.to_json();
+
+    j["spikes"] = Json::array();
+    for(auto& spike : m_spikes)
+        j["spikes"].push_back(spike);
+    return j;
+}
+
+void GlobalTimer::clear_frames()
+{
+    m_frame_durations.clear();
+    m_frame_stats.clear();
+    m_spikes.clear();
+    m_frame_count = 0;
+}
+
 size_t GlobalTimer::max_full_name_length() const
 {
     auto elem =
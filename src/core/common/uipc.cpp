@@ -1,4 +1,6 @@
 #include <uipc/common/uipc.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/task_scheduler.h>
 #include <filesystem>
 
 namespace uipc
@@ -12,6 +14,12 @@ Json default_config()
     Json j = Json::object();
     // j["version"]    = "1.0.0";
     j["module_dir"] = "";
+    // threads of the shared TaskScheduler, 0 means the hardware concurrency
+    j["thread_count"] = 0;
+    // cpus to pin the worker threads to, empty means no pinning
+    j["thread_affinity"] = Json::array();
+    // reproducible host algorithms for any thread count, see `set_deterministic()`
+    j["deterministic"] = false;
     return j;
 }
 
@@ -36,5 +44,19 @@ void init(const Json& config)
             throw std::runtime_error("module_dir does not exist.");
         }
     }
+
+    auto& scheduler = TaskScheduler::instance();
+
+    if(auto it = m_config.find("thread_count"); it != m_config.end())
+        scheduler.set_thread_count(it->get<SizeT>());
+
+    if(auto it = m_config.find("thread_affinity"); it != m_config.end())
+    {
+        auto cpus = it->get<std::vector<IndexT>>();
+        scheduler.set_affinity(cpus);
+    }
+
+    if(auto it = m_config.find("deterministic"); it != m_config.end())
+        set_deterministic(it->get<bool>());
 }
 }  // namespace uipc
@@ -125,4 +125,14 @@ void DiffSim::init(backend::SceneVisitor& scene_visitor)
 {
     m_impl->init(scene_visitor);
 }
+
+diff_sim::SparseCOOView& DiffSim::_H() noexcept
+{
+    return m_impl->H;
+}
+
+diff_sim::SparseCOOView& DiffSim::_pGpP() noexcept
+{
+    return m_impl->pGpP;
+}
 }  // namespace uipc::core
@@ -162,6 +162,15 @@ class Engine::Impl
         return j;
     }
 
+    Json memory_report() const
+    {
+        LogPatternGuard guard{backend_name()};
+        Json            j;
+        // force copy
+        j = m_engine->memory_report();
+        return j;
+    }
+
     EngineStatusCollection& status()
     {
         LogPatternGuard guard{backend_name()};
@@ -174,6 +183,8 @@ class Engine::Impl
         return m_engine->features();
     }
 
+    TelemetryStream& telemetry() { return m_engine->telemetry(); }
+
     std::string_view workspace() const noexcept { return m_workspace; }
 
     ~Impl()
@@ -232,6 +243,8 @@ Json Engine::default_config()
     {
         j["gpu"]["device"]           = 0;
         j["extras"]["gui"]["enable"] = true;
+        j["telemetry"]["enable"]     = true;
+        j["telemetry"]["capacity"]   = 1024;
     }
     return j;
 }
@@ -256,6 +269,11 @@ const FeatureCollection& Engine::features()
     return m_impl->features();
 }
 
+TelemetryStream& Engine::telemetry()
+{
+    return m_impl->telemetry();
+}
+
 void Engine::init(backend::WorldVisitor v)
 {
     m_impl->init(v);
@@ -285,6 +303,11 @@ Json Engine::to_json() const
 {
     return m_impl->to_json();
 }
+
+Json Engine::memory_report() const
+{
+    return m_impl->memory_report();
+}
 bool Engine::dump()
 {
     return m_impl->do_dump();
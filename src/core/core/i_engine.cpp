@@ -33,6 +33,11 @@ Json IEngine::to_json() const
     return do_to_json();
 }
 
+Json IEngine::memory_report() const
+{
+    return do_memory_report();
+}
+
 bool IEngine::dump()
 {
     return do_dump();
@@ -58,11 +63,24 @@ const FeatureCollection& IEngine::features() const
     return get_features();
 }
 
+TelemetryStream& IEngine::telemetry()
+{
+    return get_telemetry();
+}
+
 Json IEngine::do_to_json() const
 {
     return Json{};
 }
 
+Json IEngine::do_memory_report() const
+{
+    Json j;
+    j["total_bytes"] = 0;
+    j["sim_systems"] = Json::array();
+    return j;
+}
+
 bool IEngine::do_dump()
 {
     return true;
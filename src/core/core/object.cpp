@@ -37,6 +37,21 @@ IndexT Object::get_id() const noexcept
     return m_id;
 }
 
+std::string_view Object::tag() const noexcept
+{
+    return m_tag;
+}
+
+void Object::tag(std::string_view tag)
+{
+    if(m_scene)
+    {
+        m_scene->check_unlocked("retag an object");
+        m_scene->object_collection().retag(*this, tag);
+    }
+    m_tag = tag;
+}
+
 geometry::GeometryCollection& Object::geometry_collection() noexcept
 {
     return m_scene->geometry_collection();
@@ -57,6 +72,11 @@ bool Object::scene_pending() const noexcept
     return m_scene->is_pending();
 }
 
+void Object::check_scene_unlocked(std::string_view op) const
+{
+    m_scene->check_unlocked(op);
+}
+
 void Object::scene(Scene& scene) noexcept
 {
     UIPC_ASSERT(m_scene == nullptr, "Object already belongs to a scene.");
@@ -99,6 +119,7 @@ void to_json(Json& j, const Object& object) noexcept
 {
     j["id"]         = object.id();
     j["name"]       = object.name();
+    j["tag"]        = object.tag();
     j["geometries"] = object.geometries().ids();
 }
 
@@ -106,6 +127,7 @@ void from_json(const Json& j, Object& object) noexcept
 {
     object.m_id           = j["id"].get<IndexT>();
     object.m_name         = j["name"].get<std::string_view>();
+    object.m_tag          = j.value("tag", "");
     object.m_geometry_ids = j["geometries"].get<vector<IndexT>>();
 }
 }  // namespace uipc::core
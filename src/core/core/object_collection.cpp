@@ -1,5 +1,6 @@
 #include <uipc/core/object_collection.h>
 #include <uipc/common/log.h>
+#include <algorithm>
 namespace uipc::core
 {
 template <typename T>
@@ -13,6 +14,8 @@ S<Object> ObjectCollection::emplace(Object&& object)
     IndexT id  = m_next_id++;
     auto   ptr = uipc::make_shared<Object>(std::move(object));
     m_objects.emplace(id, ptr);
+    index_insert(m_name_to_ids, ptr->name(), id);
+    index_insert(m_tag_to_ids, ptr->tag(), id);
     return ptr;
 }
 
@@ -31,31 +34,84 @@ S<const Object> ObjectCollection::find(IndexT id) const noexcept
 
 vector<S<Object>> ObjectCollection::find(std::string_view name) noexcept
 {
+    auto              ids = find_ids(name);
     vector<S<Object>> result;
-    for(auto& [id, object] : m_objects)
-    {
-        if(object->name() == name)
-            result.push_back(object);
-    }
+    result.reserve(ids.size());
+    for(auto id : ids)
+        result.push_back(m_objects.at(id));
     return result;
 }
 
 vector<S<const Object>> ObjectCollection::find(std::string_view name) const noexcept
 {
+    auto                    ids = find_ids(name);
     vector<S<const Object>> result;
-    for(auto& [id, object] : m_objects)
-    {
-        if(object->name() == name)
-            result.push_back(object);
-    }
+    result.reserve(ids.size());
+    for(auto id : ids)
+        result.push_back(m_objects.at(id));
     return result;
 }
 
+span<const IndexT> ObjectCollection::find_ids(std::string_view name) const noexcept
+{
+    return index_find(m_name_to_ids, name);
+}
+
+span<const IndexT> ObjectCollection::find_ids_by_tag(std::string_view tag) const noexcept
+{
+    return index_find(m_tag_to_ids, tag);
+}
+
+void ObjectCollection::index_insert(IdIndex& index, std::string_view key, IndexT id)
+{
+    auto it = index.find(key);
+    if(it == index.end())
+        it = index.emplace(string{key}, vector<IndexT>{}).first;
+
+    auto& ids = it->second;
+    ids.insert(std::upper_bound(ids.begin(), ids.end(), id), id);
+}
+
+void ObjectCollection::index_erase(IdIndex& index, std::string_view key, IndexT id)
+{
+    auto it = index.find(key);
+    if(it == index.end())
+        return;
+
+    auto& ids = it->second;
+    if(auto pos = std::lower_bound(ids.begin(), ids.end(), id); pos != ids.end() && *pos == id)
+        ids.erase(pos);
+
+    if(ids.empty())
+        index.erase(it);
+}
+
+span<const IndexT> ObjectCollection::index_find(const IdIndex& index, std::string_view key) noexcept
+{
+    if(auto it = index.find(key); it != index.end())
+        return it->second;
+    return {};
+}
+
+void ObjectCollection::retag(const Object& object, std::string_view new_tag)
+{
+    // objects not in this collection (e.g. being deserialized) have nothing to update
+    if(m_objects.find(object.id()) == m_objects.end())
+        return;
+
+    index_erase(m_tag_to_ids, object.tag(), object.id());
+    index_insert(m_tag_to_ids, new_tag, object.id());
+}
+
 void ObjectCollection::destroy(IndexT id) noexcept
 {
     auto it = m_objects.find(id);
     if(it != m_objects.end())
+    {
+        index_erase(m_name_to_ids, it->second->name(), id);
+        index_erase(m_tag_to_ids, it->second->tag(), id);
         m_objects.erase(it);
+    }
     else
         UIPC_WARN_WITH_LOCATION("Try to destroy object({}) that does not exist, ignored.", id);
 }
@@ -86,6 +142,8 @@ const unordered_map<IndexT, S<Object>>& ObjectCollection::objects() const
 void ObjectCollection::build_from(span<S<Object>> objects) noexcept
 {
     m_objects.clear();
+    m_name_to_ids.clear();
+    m_tag_to_ids.clear();
     m_next_id = 0;
     for(auto& object : objects)
     {
@@ -93,6 +151,8 @@ void ObjectCollection::build_from(span<S<Object>> objects) noexcept
         if(id >= m_next_id)
             m_next_id = id + 1;
         m_objects.emplace(id, object);
+        index_insert(m_name_to_ids, object->name(), id);
+        index_insert(m_tag_to_ids, object->tag(), id);
     }
 }
 }  // namespace uipc::core
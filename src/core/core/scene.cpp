@@ -2,9 +2,114 @@
 #include <uipc/common/unit.h>
 #include <uipc/backend/visitors/world_visitor.h>
 #include <uipc/core/world.h>
+#include <uipc/geometry/geometry_friend.h>
+#include <unordered_set>
+#include <atomic>
+#include <thread>
 
 namespace uipc::core
 {
+class Scene;
+}
+
+namespace uipc::geometry
+{
+template <>
+class AttributeFriend<core::Scene>
+{
+  public:
+    static const auto& attribute_slots(const AttributeCollection& ac)
+    {
+        return ac.m_attributes;
+    }
+
+    static const IAttribute& attribute(const IAttributeSlot& slot)
+    {
+        return slot.attribute();
+    }
+
+    static SizeT use_count(const IAttributeSlot& slot) { return slot.get_use_count(); }
+};
+
+template <>
+class GeometryFriend<core::Scene>
+{
+  public:
+    static void attribute_collections(Geometry&                     geometry,
+                                      vector<std::string>&          names,
+                                      vector<AttributeCollection*>& collections)
+    {
+        geometry.collect_attribute_collections(names, collections);
+    }
+};
+}  // namespace uipc::geometry
+
+namespace uipc::core
+{
+namespace detail
+{
+    // counts every underlying attribute once, no matter how many slots share it
+    class MemoryCounter
+    {
+      public:
+        Json report(const geometry::AttributeCollection& ac, SizeT& bytes)
+        {
+            using AF = geometry::AttributeFriend<Scene>;
+
+            Json j = Json::object();
+            for(auto& [name, slot] : AF::attribute_slots(ac))
+            {
+                auto& attr    = AF::attribute(*slot);
+                bool  counted = m_counted.insert(&attr).second;
+                SizeT b       = attr.memory_bytes();
+                if(counted)
+                    bytes += b;
+
+                Json aj;
+                aj["type"]      = attr.type_name();
+                aj["size"]      = attr.size();
+                aj["bytes"]     = b;
+                aj["use_count"] = AF::use_count(*slot);
+                aj["counted"]   = counted;
+                j[name]         = std::move(aj);
+            }
+            return j;
+        }
+
+        Json report(geometry::GeometrySlot& slot, SizeT& bytes)
+        {
+            using GF = geometry::GeometryFriend<Scene>;
+
+            vector<std::string>                    names;
+            vector<geometry::AttributeCollection*> collections;
+            GF::attribute_collections(slot.geometry(), names, collections);
+
+            Json  j             = Json::object();
+            SizeT geo_bytes     = 0;
+            Json  collections_j = Json::object();
+            for(SizeT i = 0; i < names.size(); ++i)
+            {
+                SizeT ac_bytes = 0;
+                Json  acj;
+                acj["attributes"]       = report(*collections[i], ac_bytes);
+                acj["bytes"]            = ac_bytes;
+                collections_j[names[i]] = std::move(acj);
+                geo_bytes += ac_bytes;
+            }
+
+            j["id"]                    = slot.id();
+            j["type"]                  = slot.geometry().type();
+            j["bytes"]                 = geo_bytes;
+            j["attribute_collections"] = std::move(collections_j);
+            bytes += geo_bytes;
+            return j;
+        }
+
+      private:
+        std::unordered_set<const geometry::IAttribute*> m_counted;
+    };
+}  // namespace detail
+
 class Scene::Impl
 {
   public:
@@ -24,6 +129,9 @@ class Scene::Impl
 
         dt = info["dt"].get<Float>();
 
+        // constitutions may be applied after the geometries are created
+        geometries.update_constitution_index();
+
         constitution_tabular.init(visitor);
 
         if(info["diff_sim"]["enable"].get<bool>())
@@ -56,7 +164,9 @@ class Scene::Impl
 
     bool   started = false;
     bool   pending = false;
-    Scene& scene;
+    // the thread allowed to change the scene, any thread if default constructed
+    std::atomic<std::thread::id> locked_by;
+    Scene&                       scene;
     World* world = nullptr;
     Float  dt    = 0.0;
 };
@@ -74,6 +184,24 @@ Json Scene::default_config() noexcept
 
     config["cfl"]["enable"] = false;
 
+    // split a frame of `dt` into substeps, the substep dt is controlled by the newton
+    // iteration count, the ccd step size and the max vertex velocity of the last substep
+    auto& adaptive_dt = config["adaptive_dt"];
+    {
+        adaptive_dt["enable"]       = false;
+        adaptive_dt["max_substeps"] = 16;
+        // shrink dt if the newton iteration count exceeds this value
+        adaptive_dt["target_newton_iter"] = 16;
+        // shrink dt if the min ccd step size is less than this value
+        adaptive_dt["ccd_alpha_tol"] = 0.5;
+        adaptive_dt["shrink"]        = 0.5;
+        adaptive_dt["grow"]          = 2.0;
+        // grow dt after this number of calm substeps in a row
+        adaptive_dt["calm_substeps"] = 2;
+        // CFL condition: dt <= cfl_number * d_hat / max vertex velocity, 0 disables it
+        adaptive_dt["cfl_number"] = 4.0;
+    }
+
     auto& newton = config["newton"];
     {
         newton["max_iter"] = 1024;
@@ -85,6 +213,9 @@ Json Scene::default_config() noexcept
         newton["velocity_tol"] = 0.05_m / 1.0_s;
         // 2) ccd_toi >= ccd_tol
         newton["ccd_tol"] = 1.0;
+
+        // reuse the contact candidates, the hessian pattern and the solution of the last frame
+        newton["warm_start"]["enable"] = false;
     }
 
     auto& linear_system = config["linear_system"];
@@ -97,6 +228,11 @@ Json Scene::default_config() noexcept
     {
         line_search["max_iter"]      = 8;
         line_search["report_energy"] = false;
+        // evaluate the energy of the reporters declared concurrent safe on worker threads
+        line_search["concurrent_energy"] = false;
+        // stop evaluating the energy once the partial sum of the evaluated terms
+        // and the remaining non-negative terms proves the failure
+        line_search["energy_early_exit"] = false;
     }
 
     auto& contact = config["contact"];
@@ -130,6 +266,15 @@ Json Scene::default_config() noexcept
     auto& diff_sim = config["diff_sim"] = Json::object();
     {
         diff_sim["enable"] = false;
+
+        // checkpointed adjoint (see diff_sim::CheckpointedAdjoint):
+        // only `count` state checkpoints are kept, the frames in between are
+        // recomputed during backward, fewer checkpoints -> more recomputation
+        auto& checkpoint = diff_sim["checkpoint"] = Json::object();
+        {
+            checkpoint["enable"] = false;
+            checkpoint["count"]  = 16;
+        }
     }
 
     // something that is unofficial
@@ -230,6 +375,73 @@ const SanityChecker& Scene::sanity_checker() const
     return m_impl->sanity_checker;
 }
 
+Json Scene::memory_report() const
+{
+    detail::MemoryCounter counter;
+
+    SizeT total_bytes = 0;
+    Json  j;
+
+    // geometries first, so a geometry shared with its rest geometry is counted by the geometry
+    unordered_map<IndexT, SizeT> geo_bytes;
+    auto report_geometries = [&](geometry::GeometryCollection& gc)
+    {
+        Json arr = Json::array();
+        for(auto& slot : gc.geometry_slots())
+        {
+            SizeT bytes = 0;
+            arr.push_back(counter.report(*slot, bytes));
+            geo_bytes[slot->id()] += bytes;
+            total_bytes += bytes;
+        }
+        return arr;
+    };
+
+    j["geometries"]      = report_geometries(geometry_collection());
+    j["rest_geometries"] = report_geometries(rest_geometry_collection());
+
+    // objects own the geometry and the rest geometry with the same id
+    auto&          object_map = object_collection().m_objects;
+    vector<IndexT> object_ids;
+    object_ids.reserve(object_map.size());
+    for(auto& [id, object] : object_map)
+        object_ids.push_back(id);
+    std::ranges::sort(object_ids);
+
+    Json objects = Json::array();
+    for(auto id : object_ids)
+    {
+        auto& object = object_map.at(id);
+        Json  oj;
+        SizeT bytes = 0;
+        auto  ids   = object->geometries().ids();
+        for(auto geo_id : ids)
+        {
+            auto it = geo_bytes.find(geo_id);
+            if(it != geo_bytes.end())
+                bytes += it->second;
+        }
+        oj["id"]         = id;
+        oj["name"]       = object->name();
+        oj["bytes"]      = bytes;
+        oj["geometries"] = vector<IndexT>(ids.begin(), ids.end());
+        objects.push_back(std::move(oj));
+    }
+    j["objects"] = std::move(objects);
+
+    {
+        SizeT bytes = 0;
+        Json  cj;
+        cj["attributes"] = counter.report(contact_tabular().internal_contact_models(), bytes);
+        cj["bytes"]          = bytes;
+        j["contact_tabular"] = std::move(cj);
+        total_bytes += bytes;
+    }
+
+    j["total_bytes"] = total_bytes;
+    return j;
+}
+
 void Scene::init(backend::WorldVisitor& world)
 {
     m_impl->init(world);
@@ -285,11 +497,36 @@ bool Scene::is_pending() const noexcept
     return m_impl->pending;
 }
 
+void Scene::lock() noexcept
+{
+    m_impl->locked_by = std::this_thread::get_id();
+}
+
+void Scene::unlock() noexcept
+{
+    m_impl->locked_by = std::thread::id{};
+}
+
+bool Scene::is_locked() const noexcept
+{
+    auto owner = m_impl->locked_by.load();
+    return owner != std::thread::id{} && owner != std::this_thread::get_id();
+}
+
+void Scene::check_unlocked(std::string_view op) const
+{
+    if(is_locked())
+        throw SceneException{fmt::format(
+            "Cannot {} while the scene is locked by another thread (e.g. an async advance is pending).",
+            op)};
+}
+
 // ----------------------------------------------------------------------------
 // Objects
 // ----------------------------------------------------------------------------
 S<Object> Scene::Objects::create(std::string_view name) &&
 {
+    m_scene.check_unlocked("create an object");
     auto id = m_scene.m_impl->objects.m_next_id;
     return m_scene.m_impl->objects.emplace(Object{m_scene, id, name});
 }
@@ -304,8 +541,19 @@ vector<S<Object>> Scene::Objects::find(std::string_view name) && noexcept
     return m_scene.m_impl->objects.find(name);
 }
 
+span<const IndexT> Scene::Objects::find_ids(std::string_view name) && noexcept
+{
+    return m_scene.m_impl->objects.find_ids(name);
+}
+
+span<const IndexT> Scene::Objects::find_ids_by_tag(std::string_view tag) && noexcept
+{
+    return m_scene.m_impl->objects.find_ids_by_tag(tag);
+}
+
 void Scene::Objects::destroy(IndexT id) &&
 {
+    m_scene.check_unlocked("destroy an object");
     auto obj = m_scene.m_impl->objects.find(id);
     if(!obj)
     {
@@ -351,6 +599,16 @@ vector<S<const Object>> Scene::CObjects::find(std::string_view name) && noexcept
     return std::as_const(m_scene.m_impl->objects).find(name);
 }
 
+span<const IndexT> Scene::CObjects::find_ids(std::string_view name) && noexcept
+{
+    return m_scene.m_impl->objects.find_ids(name);
+}
+
+span<const IndexT> Scene::CObjects::find_ids_by_tag(std::string_view tag) && noexcept
+{
+    return m_scene.m_impl->objects.find_ids_by_tag(tag);
+}
+
 SizeT Scene::CObjects::size() const noexcept
 {
     return m_scene.m_impl->objects.size();
@@ -393,6 +651,22 @@ ObjectGeometrySlots<const geometry::Geometry> Scene::CGeometries::find(IndexT id
 {
     return {m_scene.m_impl->geometries.find(id), m_scene.m_impl->rest_geometries.find(id)};
 }
+
+span<const IndexT> Scene::Geometries::find_ids_by_constitution(U64 uid) && noexcept
+{
+    return m_scene.m_impl->geometries.find_ids_by_constitution(uid);
+}
+
+void Scene::Geometries::update_constitution_index(IndexT id) &&
+{
+    m_scene.check_unlocked("update the constitution index");
+    m_scene.m_impl->geometries.update_constitution_index(id);
+}
+
+span<const IndexT> Scene::CGeometries::find_ids_by_constitution(U64 uid) && noexcept
+{
+    return m_scene.m_impl->geometries.find_ids_by_constitution(uid);
+}
 }  // namespace uipc::core
 
 
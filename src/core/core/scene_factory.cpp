@@ -34,6 +34,20 @@ namespace uipc::core
 //          }
 //     }
 //  }
+//
+// The chunked representation splits it into a header:
+//
+//  {
+//      __meta__: { type:"SceneHeader" },
+//      __data__: { config, contact_tabular, objects, geometry_atlas (contact models only) }
+//  }
+//
+// and one chunk per object, with its geometries and rest geometries:
+//
+//  {
+//      __meta__: { type:"SceneObject" },
+//      __data__: { object_id, geometry_slots, rest_geometry_slots, geometry_atlas }
+//  }
 
 class SceneFactory::Impl
 {
@@ -118,6 +132,201 @@ class SceneFactory::Impl
         return j;
     }
 
+    S<Scene> create_scene(const Json& data)
+    {
+        auto config = Scene::default_config();
+
+        // merge default config with the one in json
+        // if same key, json config will override default config
+        config.merge_patch(data["config"]);
+
+        return std::make_shared<Scene>(config);
+    }
+
+    void build_contact_tabular(Scene& scene, const Json& data, const GeometryAtlas& ga)
+    {
+        auto& contact_tabular = data["contact_tabular"];
+        vector<ContactElement> ce;
+        auto element_it = contact_tabular.find("contact_elements");
+        if(element_it != contact_tabular.end())
+        {
+            auto& elements = *element_it;
+            if(elements.is_array())
+            {
+                ce = elements.get<vector<ContactElement>>();
+            }
+            else
+            {
+                UIPC_WARN_WITH_LOCATION("contact_elements is not an array");
+            }
+        }
+        else
+        {
+            UIPC_WARN_WITH_LOCATION("Can not find `contact_elements` in contact_tabular");
+        }
+
+        auto contact_models = ga.find("contact_models");
+        if(contact_models && !ce.empty())
+        {
+            scene.contact_tabular().build_from(*contact_models, ce);
+        }
+    }
+
+    static vector<S<geometry::GeometrySlot>> build_slots(const Json& slots_json, const GeometryAtlas& ga)
+    {
+        vector<S<geometry::GeometrySlot>> slots;
+        slots.reserve(slots_json.size());
+        for(auto& slot_json : slots_json)
+        {
+            auto id            = slot_json["id"].get<IndexT>();
+            auto index         = slot_json["index"].get<IndexT>();
+            auto geometry_slot = ga.find(index);
+            UIPC_ASSERT(geometry_slot, "Geometry slot with id {} not found in geometry atlas", index);
+
+            auto this_geo_slot = geometry_slot->clone();
+            this_geo_slot->id(id);
+            slots.push_back(this_geo_slot);
+        }
+        return slots;
+    }
+
+    Json to_header_json(const Scene& scene)
+    {
+        Json          j;
+        GeometryAtlas ga;
+
+        j[builtin::__meta__]["type"] = "SceneHeader";
+
+        auto& data     = j[builtin::__data__];
+        data["config"] = scene.config();
+        data["contact_tabular"]["contact_elements"] = scene.contact_tabular().contact_elements();
+
+        auto& objects_json = data["objects"];
+        objects_json       = Json::array();
+        for(auto&& [id, object] : scene.object_collection().objects())
+            objects_json.push_back(*object);
+
+        ga.create("contact_models", scene.contact_tabular().internal_contact_models());
+        data["geometry_atlas"] = ga.to_json();
+
+        return j;
+    }
+
+    Json to_object_json(const Scene& scene, IndexT object_id)
+    {
+        auto object = scene.object_collection().find(object_id);
+        UIPC_ASSERT(object, "Object with id {} not found in the scene", object_id);
+
+        Json          j;
+        GeometryAtlas ga;
+
+        j[builtin::__meta__]["type"] = "SceneObject";
+
+        auto& data        = j[builtin::__data__];
+        data["object_id"] = object_id;
+
+        // the geometry and its rest geometry share attributes, keep them in the same atlas
+        auto setup = [&](Json& slots_json, geometry::GeometryCollection& gc)
+        {
+            slots_json = Json::array();
+            for(auto id : object->geometries().ids())
+            {
+                auto slot = gc.find(id);
+                if(!slot)
+                    continue;
+                Json slot_json     = Json::object();
+                slot_json["id"]    = id;
+                slot_json["index"] = ga.create(slot->geometry());
+                slots_json.push_back(slot_json);
+            }
+        };
+
+        setup(data["geometry_slots"], scene.geometry_collection());
+        setup(data["rest_geometry_slots"], scene.rest_geometry_collection());
+
+        data["geometry_atlas"] = ga.to_json();
+        return j;
+    }
+
+    static ObjectChunk decode_object(const Json& j)
+    {
+        ObjectChunk chunk;
+
+        auto meta_it = j.find(builtin::__meta__);
+        auto data_it = j.find(builtin::__data__);
+        if(meta_it == j.end() || data_it == j.end() || (*meta_it)["type"] != "SceneObject")
+        {
+            UIPC_WARN_WITH_LOCATION("Invalid object chunk, expected `SceneObject`");
+            return chunk;
+        }
+
+        auto& data = *data_it;
+
+        GeometryAtlas ga;
+        ga.from_json(data["geometry_atlas"]);
+
+        chunk.m_object_id       = data["object_id"].get<IndexT>();
+        chunk.m_geometries      = build_slots(data["geometry_slots"], ga);
+        chunk.m_rest_geometries = build_slots(data["rest_geometry_slots"], ga);
+        return chunk;
+    }
+
+    S<Scene> from_chunks(const Json& header, span<ObjectChunk> chunks)
+    {
+        auto meta_it = header.find(builtin::__meta__);
+        auto data_it = header.find(builtin::__data__);
+        if(meta_it == header.end() || data_it == header.end()
+           || (*meta_it)["type"] != "SceneHeader")
+        {
+            UIPC_WARN_WITH_LOCATION("Invalid scene header, expected `SceneHeader`");
+            return nullptr;
+        }
+
+        auto& data  = *data_it;
+        auto  scene = create_scene(data);
+
+        // contact tabular
+        {
+            GeometryAtlas ga;
+            ga.from_json(data["geometry_atlas"]);
+            build_contact_tabular(*scene, data, ga);
+        }
+
+        // objects
+        unordered_map<IndexT, const Json*> object_jsons;
+        for(auto& obj_json : data["objects"])
+            object_jsons[obj_json["id"].get<IndexT>()] = &obj_json;
+
+        vector<S<Object>>                 objects;
+        vector<S<geometry::GeometrySlot>> geo_slots;
+        vector<S<geometry::GeometrySlot>> rest_geo_slots;
+        objects.reserve(chunks.size());
+        for(auto& chunk : chunks)
+        {
+            auto it = object_jsons.find(chunk.m_object_id);
+            if(it == object_jsons.end())
+            {
+                UIPC_WARN_WITH_LOCATION("Object with id {} is not in the scene header, skip it",
+                                        chunk.m_object_id);
+                continue;
+            }
+
+            S<Object> object = std::make_shared<Object>();
+            object->scene(*scene);
+            uipc::core::from_json(*it->second, *object);
+            objects.push_back(object);
+
+            std::ranges::move(chunk.m_geometries, std::back_inserter(geo_slots));
+            std::ranges::move(chunk.m_rest_geometries, std::back_inserter(rest_geo_slots));
+        }
+
+        scene->object_collection().build_from(objects);
+        scene->geometry_collection().build_from(geo_slots);
+        scene->rest_geometry_collection().build_from(rest_geo_slots);
+
+        return scene;
+    }
+
     S<Scene> from_json(const Json& j)
     {
         S<Scene> scene = nullptr;
@@ -151,15 +360,7 @@ class SceneFactory::Impl
             }
 
             // 1) Create scene
-            {
-                auto config = Scene::default_config();
-
-                // merge default config with the one in json
-                // if same key, json config will override default config
-                config.merge_patch(data["config"]);
-
-                scene = std::make_shared<Scene>(config);
-            }
+            scene = create_scene(data);
 
             // 2) Build geometry atlas
             GeometryAtlas ga;
@@ -191,65 +392,20 @@ class SceneFactory::Impl
             }
 
             // 2) Retrieve contact tabular
-            {
-                auto& contact_tabular = data["contact_tabular"];
-                vector<ContactElement> ce;
-                auto element_it = contact_tabular.find("contact_elements");
-                if(element_it != contact_tabular.end())
-                {
-                    auto& elements = *element_it;
-                    if(elements.is_array())
-                    {
-                        ce = elements.get<vector<ContactElement>>();
-                    }
-                    else
-                    {
-                        UIPC_WARN_WITH_LOCATION("contact_elements is not an array");
-                    }
-                }
-                else
-                {
-                    UIPC_WARN_WITH_LOCATION("Can not find `contact_elements` in contact_tabular");
-                }
-
-                auto contact_models = ga.find("contact_models");
-                if(contact_models && !ce.empty())
-                {
-                    scene->contact_tabular().build_from(*contact_models, ce);
-                }
-            }
+            build_contact_tabular(*scene, data, ga);
 
             // 3) Recover geometry slots & rest geometry slots
             {
                 auto& geometry_slots_json      = data["geometry_slots"];
                 auto& rest_geometry_slots_json = data["rest_geometry_slots"];
 
-                auto build_from_geo_slots =
-                    [&ga](const Json& slots_json, geometry::GeometryCollection& gc)
-                {
-                    vector<S<geometry::GeometrySlot>> slots;
-                    slots.reserve(slots_json.size());
-                    for(auto& slot_json : slots_json)
-                    {
-                        auto id            = slot_json["id"].get<IndexT>();
-                        auto index         = slot_json["index"].get<IndexT>();
-                        auto geometry_slot = ga.find(index);
-                        UIPC_ASSERT(geometry_slot,
-                                    "Geometry slot with id {} not found in geometry atlas",
-                                    index);
-
-                        auto this_geo_slot = geometry_slot->clone();
-                        this_geo_slot->id(id);
-                        slots.push_back(this_geo_slot);
-                    }
-                    gc.build_from(slots);
-                };
-
                 auto& geometry_collection = scene->geometry_collection();
                 auto& rest_geometry_collection = scene->rest_geometry_collection();
 
-                build_from_geo_slots(geometry_slots_json, geometry_collection);
-                build_from_geo_slots(rest_geometry_slots_json, rest_geometry_collection);
+                auto geo_slots      = build_slots(geometry_slots_json, ga);
+                auto rest_geo_slots = build_slots(rest_geometry_slots_json, ga);
+                geometry_collection.build_from(geo_slots);
+                rest_geometry_collection.build_from(rest_geo_slots);
             }
 
         } while(0);
@@ -279,4 +435,29 @@ Json SceneFactory::to_json(const Scene& scene)
 {
     return m_impl->to_json(scene);
 }
+
+Json SceneFactory::to_header_json(const Scene& scene)
+{
+    return m_impl->to_header_json(scene);
+}
+
+Json SceneFactory::to_object_json(const Scene& scene, IndexT object_id)
+{
+    return m_impl->to_object_json(scene, object_id);
+}
+
+auto SceneFactory::decode_object(const Json& j) -> ObjectChunk
+{
+    return Impl::decode_object(j);
+}
+
+S<Scene> SceneFactory::from_chunks(const Json& header, span<ObjectChunk> objects)
+{
+    return m_impl->from_chunks(header, objects);
+}
+
+IndexT SceneFactory::ObjectChunk::object_id() const noexcept
+{
+    return m_object_id;
+}
 }  // namespace uipc::core
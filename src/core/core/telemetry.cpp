@@ -0,0 +1,198 @@
+#include <uipc/core/telemetry.h>
+#include <uipc/common/spsc_ring_buffer.h>
+#include <uipc/common/set.h>
+#include <uipc/common/format.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+
+namespace uipc::core
+{
+Json FrameTelemetry::to_json() const
+{
+    Json j;
+    j["frame"]             = frame;
+    j["dt"]                = dt;
+    j["substep_count"]     = substep_count;
+    j["substep_dts"] = std::vector<Float>(substep_dts.begin(), substep_dts.end());
+    j["newton_iterations"] = newton_iterations;
+    j["linear_solver_iterations"] =
+        std::vector<SizeT>(linear_solver_iterations.begin(), linear_solver_iterations.end());
+    j["line_search_steps"] = line_search_steps;
+    j["min_ccd_alpha"]     = min_ccd_alpha;
+    j["min_cfl_alpha"]     = min_cfl_alpha;
+
+    j["contact_candidates"] = Json::object();
+    for(auto& [name, count] : contact_candidates)
+        j["contact_candidates"][name] = count;
+
+    j["energies"] = Json::object();
+    for(auto& [name, value] : energies)
+        j["energies"][name] = value;
+
+    j["wall_time"] = wall_time;
+    return j;
+}
+
+class TelemetryStream::Impl
+{
+  public:
+    Impl(SizeT capacity)
+        : ring(capacity)
+    {
+    }
+
+    SPSCRingBuffer<FrameTelemetry> ring;
+    std::atomic<bool>              enabled = true;
+    std::atomic<SizeT>             dropped = 0;
+    // serializes the readers, the engine (producer) never takes it
+    std::mutex pop_mutex;
+};
+
+TelemetryStream::TelemetryStream(SizeT capacity)
+    : m_impl{uipc::make_unique<Impl>(capacity)}
+{
+}
+
+TelemetryStream::~TelemetryStream() {}
+
+bool TelemetryStream::push(FrameTelemetry&& record)
+{
+    if(!m_impl->enabled.load(std::memory_order_relaxed))
+        return false;
+
+    if(!m_impl->ring.try_push(std::move(record)))
+    {
+        m_impl->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+std::optional<FrameTelemetry> TelemetryStream::pop()
+{
+    std::lock_guard lock{m_impl->pop_mutex};
+    return m_impl->ring.try_pop();
+}
+
+vector<FrameTelemetry> TelemetryStream::pop_all()
+{
+    std::lock_guard        lock{m_impl->pop_mutex};
+    vector<FrameTelemetry> records;
+    records.reserve(m_impl->ring.size());
+    while(auto record = m_impl->ring.try_pop())
+        records.push_back(std::move(*record));
+    return records;
+}
+
+void TelemetryStream::enable(bool value) noexcept
+{
+    m_impl->enabled.store(value, std::memory_order_relaxed);
+}
+
+bool TelemetryStream::is_enabled() const noexcept
+{
+    return m_impl->enabled.load(std::memory_order_relaxed);
+}
+
+SizeT TelemetryStream::size() const noexcept
+{
+    return m_impl->ring.size();
+}
+
+SizeT TelemetryStream::capacity() const noexcept
+{
+    return m_impl->ring.capacity();
+}
+
+SizeT TelemetryStream::dropped_count() const noexcept
+{
+    return m_impl->dropped.load(std::memory_order_relaxed);
+}
+
+static std::ofstream open_output(std::string_view file)
+{
+    namespace fs = std::filesystem;
+    fs::path path{file};
+    if(path.has_parent_path())
+        fs::create_directories(path.parent_path());
+
+    std::ofstream ofs{path};
+    if(!ofs)
+        throw TelemetryStreamException{fmt::format("Can't open file [{}] for writing.", file)};
+    return ofs;
+}
+
+void TelemetryStream::write_csv(std::string_view file, span<const FrameTelemetry> records)
+{
+    // the union of the variable columns
+    set<std::string> contact_names;
+    set<std::string> energy_names;
+    for(auto& r : records)
+    {
+        for(auto& [name, count] : r.contact_candidates)
+            contact_names.insert(name);
+        for(auto& [name, value] : r.energies)
+            energy_names.insert(name);
+    }
+
+    auto ofs = open_output(file);
+
+    ofs << "frame,dt,substep_count,min_substep_dt,newton_iterations,linear_solves,"
+           "linear_solver_iterations_total,linear_solver_iterations_max,"
+           "line_search_steps,min_ccd_alpha,min_cfl_alpha,wall_time";
+    for(auto& name : contact_names)
+        ofs << ",contact/" << name;
+    for(auto& name : energy_names)
+        ofs << ",energy/" << name;
+    ofs << '\n';
+
+    for(auto& r : records)
+    {
+        auto& its = r.linear_solver_iterations;
+
+        SizeT total = std::accumulate(its.begin(), its.end(), SizeT{0});
+        SizeT max   = its.empty() ? 0 : *std::max_element(its.begin(), its.end());
+
+        auto& dts = r.substep_dts;
+        Float min_dt = dts.empty() ? r.dt : *std::min_element(dts.begin(), dts.end());
+
+        ofs << fmt::format("{},{},{},{},{},{},{},{},{},{},{},{}",
+                           r.frame,
+                           r.dt,
+                           r.substep_count,
+                           min_dt,
+                           r.newton_iterations,
+                           its.size(),
+                           total,
+                           max,
+                           r.line_search_steps,
+                           r.min_ccd_alpha,
+                           r.min_cfl_alpha,
+                           r.wall_time);
+
+        for(auto& name : contact_names)
+        {
+            ofs << ',';
+            if(auto it = r.contact_candidates.find(name); it != r.contact_candidates.end())
+                ofs << it->second;
+        }
+        for(auto& name : energy_names)
+        {
+            ofs << ',';
+            if(auto it = r.energies.find(name); it != r.energies.end())
+                ofs << fmt::format("{}", it->second);
+        }
+        ofs << '\n';
+    }
+}
+
+void TelemetryStream::write_json_lines(std::string_view file, span<const FrameTelemetry> records)
+{
+    auto ofs = open_output(file);
+    for(auto& r : records)
+        ofs << r.to_json().dump() << '\n';
+}
+}  // namespace uipc::core
@@ -0,0 +1,191 @@
+#include <uipc/diff_sim/adjoint_solver.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/format.h>
+#include <uipc/common/log.h>
+#include <Eigen/SparseLU>
+#include <Eigen/SparseCholesky>
+
+namespace uipc::diff_sim
+{
+class AdjointSolver::Impl
+{
+  public:
+    using SparseMatrix = Eigen::SparseMatrix<Float, Eigen::ColMajor, IndexT>;
+
+    Impl(Method method)
+        : method(method)
+    {
+    }
+
+    void factorize(const SparseCOOView& H)
+    {
+        auto shape = H.shape();
+        if(shape(0) != shape(1))
+            throw AdjointSolverError{fmt::format(
+                "H must be square, but its shape is ({}, {})", shape(0), shape(1))};
+
+        // The CSR of H is the CSC of H^T, which is what Eigen factorizes.
+        bool need_analyze = !analyzed;
+        if(!H_pattern.matches(H))
+        {
+            CSRPattern pattern;
+            pattern.build(H);
+            need_analyze |= !pattern.same_structure(H_pattern);
+            H_pattern = std::move(pattern);
+        }
+
+        if(need_analyze)
+        {
+            HT.resize(shape(1), shape(0));
+            HT.resizeNonZeros(H_pattern.non_zeros());
+            std::ranges::copy(H_pattern.row_offsets(), HT.outerIndexPtr());
+            std::ranges::copy(H_pattern.col_indices(), HT.innerIndexPtr());
+        }
+        H_pattern.fill(H, span<Float>{HT.valuePtr(), H_pattern.non_zeros()});
+
+        if(need_analyze)
+        {
+            if(method == Method::LU)
+                lu.analyzePattern(HT);
+            else
+                ldlt.analyzePattern(HT);
+            analyzed = true;
+            ++analyze_count;
+        }
+
+        bool success = false;
+        if(method == Method::LU)
+        {
+            lu.factorize(HT);
+            success = lu.info() == Eigen::Success;
+        }
+        else
+        {
+            ldlt.factorize(HT);
+            success = ldlt.info() == Eigen::Success;
+        }
+        ++factorize_count;
+
+        if(!success)
+        {
+            factorized = false;
+            throw AdjointSolverError{
+                method == Method::LU ?
+                    "LU factorization of H^T failed, is H singular?" :
+                    "LDLT factorization of H^T failed, is H singular or not symmetric?"};
+        }
+        factorized = true;
+    }
+
+    DenseMatrix solve(const DenseMatrix& dLdX) const
+    {
+        if(!factorized)
+            throw AdjointSolverError{"Call `factorize()` before `solve()`."};
+        if(dLdX.rows() != HT.rows())
+            throw AdjointSolverError{fmt::format(
+                "dLdX must have {} rows, but it has {}", HT.rows(), dLdX.rows())};
+
+        DenseMatrix lambda(dLdX.rows(), dLdX.cols());
+
+        // the factorizations are read-only during solve, so the losses are solved in parallel
+        parallel_for(dLdX.cols(),
+                     [&](SizeT k)
+                     {
+                         if(method == Method::LU)
+                             lambda.col(k) = lu.solve(dLdX.col(k));
+                         else
+                             lambda.col(k) = ldlt.solve(dLdX.col(k));
+                     });
+        return lambda;
+    }
+
+    DenseMatrix compute_dLdP(const SparseCOOView& pGpP, const DenseMatrix& lambda)
+    {
+        if(lambda.rows() != pGpP.shape()(0))
+            throw AdjointSolverError{fmt::format(
+                "lambda must have {} rows, but it has {}", pGpP.shape()(0), lambda.rows())};
+
+        // CSR of pGpP^T: a row per parameter, so the parameters are computed in parallel
+        if(!pGpP_pattern.matches(pGpP, true))
+            pGpP_pattern.build(pGpP, true);
+
+        pGpP_values.resize(pGpP_pattern.non_zeros());
+        pGpP_pattern.fill(pGpP, pGpP_values);
+
+        auto offsets = pGpP_pattern.row_offsets();
+        auto cols    = pGpP_pattern.col_indices();
+
+        DenseMatrix dLdP(pGpP_pattern.shape()(0), lambda.cols());
+        parallel_for(
+            dLdP.rows(),
+            [&](SizeT p)
+            {
+                dLdP.row(p).setZero();
+                for(IndexT s = offsets[p]; s < offsets[p + 1]; ++s)
+                    dLdP.row(p) -= pGpP_values[s] * lambda.row(cols[s]);
+            },
+            64);
+        return dLdP;
+    }
+
+    Method method;
+
+    CSRPattern   H_pattern;
+    SparseMatrix HT;
+    bool         analyzed   = false;
+    bool         factorized = false;
+
+    Eigen::SparseLU<SparseMatrix, Eigen::COLAMDOrdering<IndexT>> lu;
+    Eigen::SimplicialLDLT<SparseMatrix>                          ldlt;
+
+    CSRPattern    pGpP_pattern;
+    vector<Float> pGpP_values;
+
+    SizeT analyze_count   = 0;
+    SizeT factorize_count = 0;
+};
+
+AdjointSolver::AdjointSolver(Method method)
+    : m_impl{uipc::make_unique<Impl>(method)}
+{
+}
+
+AdjointSolver::~AdjointSolver() {}
+
+void AdjointSolver::factorize(const SparseCOOView& H)
+{
+    m_impl->factorize(H);
+}
+
+AdjointSolver::DenseMatrix AdjointSolver::solve(const DenseMatrix& dLdX) const
+{
+    return m_impl->solve(dLdX);
+}
+
+AdjointSolver::DenseMatrix AdjointSolver::compute_dLdP(const SparseCOOView& pGpP,
+                                                       const DenseMatrix& lambda)
+{
+    return m_impl->compute_dLdP(pGpP, lambda);
+}
+
+AdjointSolver::DenseMatrix AdjointSolver::solve_dLdP(const SparseCOOView& pGpP,
+                                                     const DenseMatrix& dLdX)
+{
+    return m_impl->compute_dLdP(pGpP, m_impl->solve(dLdX));
+}
+
+AdjointSolver::Method AdjointSolver::method() const noexcept
+{
+    return m_impl->method;
+}
+
+SizeT AdjointSolver::analyze_count() const noexcept
+{
+    return m_impl->analyze_count;
+}
+
+SizeT AdjointSolver::factorize_count() const noexcept
+{
+    return m_impl->factorize_count;
+}
+}  // namespace uipc::diff_sim
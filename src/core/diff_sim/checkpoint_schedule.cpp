@@ -0,0 +1,164 @@
+#include <uipc/diff_sim/checkpoint_schedule.h>
+#include <uipc/common/log.h>
+#include <algorithm>
+
+namespace uipc::diff_sim
+{
+class CheckpointSchedule::Builder
+{
+  public:
+    Builder(CheckpointSchedule& schedule)
+        : m_schedule(schedule)
+    {
+    }
+
+    void build()
+    {
+        auto N = m_schedule.m_frame_count;
+        auto C = m_schedule.m_checkpoint_count;
+        if(N == 0)
+            return;
+        m_current = 0;
+        reverse(0, N, C + 1);
+    }
+
+  private:
+    CheckpointSchedule& m_schedule;
+    SizeT               m_current = 0;
+    SizeT               m_alive   = 0;
+
+    // the max number of frames that can be reversed with s snapshots (including the one
+    // holding the state we start from) and r recomputation sweeps: C(s + r, s)
+    static SizeT beta(SizeT s, SizeT r)
+    {
+        SizeT b = 1;
+        for(SizeT i = 1; i <= s; ++i)
+            b = b * (r + i) / i;  // exact, b * (r + i) is divisible by i
+        return b;
+    }
+
+    void push(ActionType type, SizeT frame)
+    {
+        m_schedule.m_actions.push_back(Action{type, frame});
+    }
+
+    void go_to(SizeT frame)
+    {
+        if(m_current != frame)
+        {
+            push(ActionType::Recover, frame);
+            m_current = frame;
+        }
+    }
+
+    void advance_to(SizeT frame)
+    {
+        UIPC_ASSERT(frame >= m_current, "Can't advance backward, from {} to {}", m_current, frame);
+        for(SizeT f = m_current + 1; f <= frame; ++f)
+        {
+            push(ActionType::Advance, f);
+            ++m_schedule.m_advance_count;
+        }
+        m_current = frame;
+    }
+
+    void backward()
+    {
+        push(ActionType::Backward, m_current);
+    }
+
+    // the state `start` is a checkpoint (or the start state), reverse the frames (start, end]
+    // with `snaps` snapshots, including the one at `start`
+    void reverse(SizeT start, SizeT end, SizeT snaps)
+    {
+        if(end <= start)
+            return;
+
+        SizeT t = end - start;
+
+        if(t == 1 || snaps == 1)
+        {
+            // no free checkpoint, recompute from `start` for every frame
+            for(SizeT f = end; f > start; --f)
+            {
+                go_to(start);
+                advance_to(f);
+                backward();
+            }
+            return;
+        }
+
+        // the smallest r such that t frames can be reversed in r sweeps
+        SizeT r = 0;
+        while(beta(snaps, r) < t)
+            ++r;
+
+        // the optimal position of the next checkpoint, following Griewank & Walther's revolve:
+        // the right part is reversed with one snapshot less, the left part with one sweep less
+        SizeT range = beta(snaps, r);
+        SizeT bino1 = beta(snaps, r - 1);
+        SizeT bino2 = beta(snaps - 1, r - 1);
+        SizeT bino3 = snaps > 2 ? beta(snaps - 2, r - 1) : (snaps == 2 ? 1 : 0);
+        SizeT bino4 = r > 1 ? beta(snaps, r - 2) : 0;
+        SizeT bino5 = snaps > 2 ? beta(snaps - 3, r) : 0;
+
+        SizeT l;
+        if(t <= bino1 + bino3)
+            l = bino4;
+        else if(t >= range - bino5)
+            l = bino1;
+        else
+            l = t - bino2 - bino3;
+        l = std::clamp<SizeT>(l, 1, t - 1);
+
+        SizeT m = start + l;
+
+        go_to(start);
+        advance_to(m);
+        push(ActionType::Dump, m);
+        ++m_alive;
+        m_schedule.m_peak_checkpoint_count =
+            std::max(m_schedule.m_peak_checkpoint_count, m_alive);
+
+        reverse(m, end, snaps - 1);
+
+        // the checkpoint at m is no longer needed
+        push(ActionType::Drop, m);
+        --m_alive;
+
+        reverse(start, m, snaps);
+    }
+};
+
+CheckpointSchedule::CheckpointSchedule(SizeT frame_count, SizeT checkpoint_count)
+    : m_frame_count(frame_count)
+    , m_checkpoint_count(checkpoint_count)
+{
+    Builder{*this}.build();
+}
+
+span<const CheckpointSchedule::Action> CheckpointSchedule::actions() const noexcept
+{
+    return m_actions;
+}
+
+SizeT CheckpointSchedule::frame_count() const noexcept
+{
+    return m_frame_count;
+}
+
+SizeT CheckpointSchedule::checkpoint_count() const noexcept
+{
+    return m_checkpoint_count;
+}
+
+SizeT CheckpointSchedule::advance_count() const noexcept
+{
+    return m_advance_count;
+}
+
+SizeT CheckpointSchedule::peak_checkpoint_count() const noexcept
+{
+    return m_peak_checkpoint_count;
+}
+}  // namespace uipc::diff_sim
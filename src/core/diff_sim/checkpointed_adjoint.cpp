@@ -0,0 +1,131 @@
+#include <uipc/diff_sim/checkpointed_adjoint.h>
+#include <uipc/backend/visitors/world_visitor.h>
+#include <uipc/core/engine.h>
+#include <uipc/common/log.h>
+#include <uipc/common/format.h>
+#include <filesystem>
+
+namespace uipc::diff_sim
+{
+static SizeT checkpoint_count(core::World& world)
+{
+    backend::WorldVisitor wv{world};
+    auto&                 info     = wv.scene().info();
+    auto&                 diff_sim = info["diff_sim"];
+
+    if(!diff_sim["enable"].get<bool>())
+        throw CheckpointedAdjointError{
+            "CheckpointedAdjoint requires `diff_sim/enable` in the scene config."};
+
+    if(!diff_sim.contains("checkpoint") || !diff_sim["checkpoint"].value("enable", false))
+        throw CheckpointedAdjointError{
+            "CheckpointedAdjoint requires `diff_sim/checkpoint/enable` in the scene config."};
+
+    return diff_sim["checkpoint"].value("count", SizeT{16});
+}
+
+// remove the files of the checkpoint at `frame`. The backends dump their state under `<workspace>/dump/`,
+// one file per buffer named `<name>.<frame>` or `<name>.<frame>.json`
+static void drop_checkpoint(core::World& world, SizeT frame)
+{
+    namespace fs = std::filesystem;
+
+    backend::WorldVisitor wv{world};
+    fs::path              dump_dir = fs::path{wv.engine().workspace()} / "dump";
+
+    std::error_code ec;
+    if(!fs::is_directory(dump_dir, ec))
+        return;
+
+    auto suffix = fmt::format(".{}", frame);
+
+    vector<fs::path> files;
+    for(auto& entry : fs::recursive_directory_iterator{dump_dir, ec})
+    {
+        if(!entry.is_regular_file())
+            continue;
+        auto name = entry.path().filename().string();
+        if(name.ends_with(".json"))
+            name.resize(name.size() - 5);
+        if(name.ends_with(suffix))
+            files.push_back(entry.path());
+    }
+
+    for(auto& file : files)
+    {
+        if(!fs::remove(file, ec))
+            spdlog::warn("Failed to remove the checkpoint file {} of frame {}.", file.string(), frame);
+    }
+}
+
+CheckpointedAdjoint::CheckpointedAdjoint(core::World& world, SizeT frame_count)
+    : m_world(world)
+    , m_schedule(frame_count, checkpoint_count(world))
+{
+}
+
+void CheckpointedAdjoint::run(const BackwardCallback& on_backward)
+{
+    auto check = [this](std::string_view what, SizeT frame)
+    {
+        if(!m_world.is_valid())
+            throw CheckpointedAdjointError{fmt::format(
+                "World becomes invalid after {} at frame {}, abort the adjoint.", what, frame)};
+    };
+
+    SizeT start = m_world.frame();
+
+    // the start state is always a checkpoint
+    if(!m_world.dump())
+        throw CheckpointedAdjointError{
+            fmt::format("Failed to dump the start state at frame {}.", start)};
+
+    for(auto&& action : m_schedule.actions())
+    {
+        SizeT frame = start + action.frame;
+        switch(action.type)
+        {
+            case CheckpointSchedule::ActionType::Advance: {
+                m_world.advance();
+                check("advance", frame);
+            }
+            break;
+            case CheckpointSchedule::ActionType::Dump: {
+                if(!m_world.dump())
+                    throw CheckpointedAdjointError{
+                        fmt::format("Failed to dump the checkpoint at frame {}.", frame)};
+            }
+            break;
+            case CheckpointSchedule::ActionType::Recover: {
+                if(!m_world.recover(frame))
+                    throw CheckpointedAdjointError{
+                        fmt::format("Failed to recover the checkpoint at frame {}.", frame)};
+            }
+            break;
+            case CheckpointSchedule::ActionType::Backward: {
+                m_world.retrieve();
+                m_world.backward();
+                check("backward", frame);
+                if(on_backward)
+                    on_backward(frame);
+            }
+            break;
+            case CheckpointSchedule::ActionType::Drop: {
+                drop_checkpoint(m_world, frame);
+            }
+            break;
+        }
+    }
+
+    spdlog::info("Checkpointed adjoint: {} frames, {} checkpoints, {} advances ({} recomputed).",
+                 m_schedule.frame_count(),
+                 m_schedule.peak_checkpoint_count(),
+                 m_schedule.advance_count(),
+                 m_schedule.advance_count() - m_schedule.frame_count());
+}
+
+const CheckpointSchedule& CheckpointedAdjoint::schedule() const noexcept
+{
+    return m_schedule;
+}
+}  // namespace uipc::diff_sim
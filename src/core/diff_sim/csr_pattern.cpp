@@ -0,0 +1,163 @@
+#include <uipc/diff_sim/csr_pattern.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/log.h>
+#include <algorithm>
+#include <numeric>
+
+namespace uipc::diff_sim
+{
+// rows shorter than this are not worth a thread
+static constexpr SizeT RowGrainSize = 256;
+
+void CSRPattern::build(const SparseCOOView& coo, bool transpose)
+{
+    auto rows = transpose ? coo.col_indices() : coo.row_indices();
+    auto cols = transpose ? coo.row_indices() : coo.col_indices();
+
+    UIPC_ASSERT(rows.size() == cols.size() && rows.size() == coo.values().size(),
+                "COO size mismatch, rows={}, cols={}, values={}",
+                rows.size(),
+                cols.size(),
+                coo.values().size());
+
+    m_transposed = transpose;
+    m_shape      = transpose ? Vector2i{coo.shape()(1), coo.shape()(0)} : coo.shape();
+
+    SizeT M   = m_shape(0);
+    SizeT nnz = rows.size();
+
+    m_coo_rows.assign(coo.row_indices().begin(), coo.row_indices().end());
+    m_coo_cols.assign(coo.col_indices().begin(), coo.col_indices().end());
+
+    // 1) bucket the entries by row (counting sort, stable)
+    m_entry_offsets.assign(M + 1, 0);
+    for(auto r : rows)
+    {
+        UIPC_ASSERT(r >= 0 && r < m_shape(0), "Row index {} out of range [0, {})", r, m_shape(0));
+        m_entry_offsets[r + 1]++;
+    }
+    std::inclusive_scan(m_entry_offsets.begin(), m_entry_offsets.end(), m_entry_offsets.begin());
+
+    m_entries.resize(nnz);
+    {
+        vector<IndexT> cursor(m_entry_offsets.begin(), m_entry_offsets.end() - 1);
+        for(SizeT e = 0; e < nnz; ++e)
+            m_entries[cursor[rows[e]]++] = static_cast<IndexT>(e);
+    }
+
+    // 2) sort each row by column and merge the duplicates
+    m_entry_slots.resize(nnz);
+    vector<IndexT> unique_counts(M + 1, 0);
+    parallel_for(
+        M,
+        [&](SizeT r)
+        {
+            auto begin = m_entries.begin() + m_entry_offsets[r];
+            auto end   = m_entries.begin() + m_entry_offsets[r + 1];
+            std::stable_sort(begin, end, [&](IndexT a, IndexT b) { return cols[a] < cols[b]; });
+
+            IndexT unique = 0;
+            for(auto it = begin; it != end; ++it)
+            {
+                if(it == begin || cols[*it] != cols[*(it - 1)])
+                    ++unique;
+                // local slot for now, made global below
+                m_entry_slots[it - m_entries.begin()] = unique - 1;
+            }
+            unique_counts[r + 1] = unique;
+        },
+        RowGrainSize);
+
+    // 3) compress
+    m_row_offsets.resize(M + 1);
+    std::inclusive_scan(unique_counts.begin(), unique_counts.end(), m_row_offsets.begin());
+    m_col_indices.resize(m_row_offsets.back());
+
+    parallel_for(
+        M,
+        [&](SizeT r)
+        {
+            IndexT row_offset = m_row_offsets[r];
+            for(IndexT i = m_entry_offsets[r]; i < m_entry_offsets[r + 1]; ++i)
+            {
+                IndexT slot         = row_offset + m_entry_slots[i];
+                m_entry_slots[i]    = slot;
+                m_col_indices[slot] = cols[m_entries[i]];
+            }
+        },
+        RowGrainSize);
+}
+
+bool CSRPattern::matches(const SparseCOOView& coo, bool transpose) const noexcept
+{
+    auto shape = transpose ? Vector2i{coo.shape()(1), coo.shape()(0)} : coo.shape();
+    return m_transposed == transpose && m_shape == shape
+           && std::ranges::equal(m_coo_rows, coo.row_indices())
+           && std::ranges::equal(m_coo_cols, coo.col_indices());
+}
+
+bool CSRPattern::same_structure(const CSRPattern& other) const noexcept
+{
+    return m_shape == other.m_shape && m_row_offsets == other.m_row_offsets
+           && m_col_indices == other.m_col_indices;
+}
+
+void CSRPattern::fill(const SparseCOOView& coo, span<Float> values) const
+{
+    UIPC_ASSERT(values.size() == non_zeros(),
+                "Values size mismatch, expected {}, but got {}",
+                non_zeros(),
+                values.size());
+    UIPC_ASSERT(coo.values().size() == m_entries.size(),
+                "The COO matrix doesn't match the pattern, expected {} entries, but got {}",
+                m_entries.size(),
+                coo.values().size());
+
+    auto coo_values = coo.values();
+    parallel_for(
+        m_shape(0),
+        [&](SizeT r)
+        {
+            for(IndexT s = m_row_offsets[r]; s < m_row_offsets[r + 1]; ++s)
+                values[s] = 0;
+            for(IndexT i = m_entry_offsets[r]; i < m_entry_offsets[r + 1]; ++i)
+                values[m_entry_slots[i]] += coo_values[m_entries[i]];
+        },
+        RowGrainSize);
+}
+
+Eigen::SparseMatrix<Float, Eigen::RowMajor> CSRPattern::to_csr(const SparseCOOView& coo) const
+{
+    Eigen::SparseMatrix<Float, Eigen::RowMajor> csr(m_shape(0), m_shape(1));
+    csr.resizeNonZeros(non_zeros());
+    std::ranges::copy(m_row_offsets, csr.outerIndexPtr());
+    std::ranges::copy(m_col_indices, csr.innerIndexPtr());
+    fill(coo, span<Float>{csr.valuePtr(), non_zeros()});
+    return csr;
+}
+
+span<const IndexT> CSRPattern::row_offsets() const noexcept
+{
+    return m_row_offsets;
+}
+
+span<const IndexT> CSRPattern::col_indices() const noexcept
+{
+    return m_col_indices;
+}
+
+SizeT CSRPattern::non_zeros() const noexcept
+{
+    return m_col_indices.size();
+}
+
+Vector2i CSRPattern::shape() const noexcept
+{
+    return m_shape;
+}
+
+bool CSRPattern::transposed() const noexcept
+{
+    return m_transposed;
+}
+}  // namespace uipc::diff_sim
@@ -1,4 +1,5 @@
 #include <uipc/diff_sim/sparse_coo_view.h>
+#include <uipc/diff_sim/csr_pattern.h>
 #include <uipc/common/zip.h>
 #include <iostream>
 namespace uipc::diff_sim
@@ -40,21 +41,29 @@ Matrix<Float, Eigen::Dynamic, Eigen::Dynamic> SparseCOOView::to_dense() const
     DenseMatrix dense = DenseMatrix::Zero(m_shape(0), m_shape(1));
     for(auto&& [i, j, v] : zip(m_row_indices, m_col_indices, m_values))
     {
-        dense(i, j) = v;
+        dense(i, j) += v;  // duplicated entries are summed, like to_sparse()
     }
     return dense;
 }
 
 Eigen::SparseMatrix<Float> SparseCOOView::to_sparse() const
 {
-    std::vector<Eigen::Triplet<Float>> triplets;
-    triplets.reserve(m_row_indices.size());
-    for(auto&& [i, j, v] : zip(m_row_indices, m_col_indices, m_values))
-    {
-        triplets.emplace_back(i, j, v);
-    }
+    // CSR of the transpose == CSC of the matrix, no re-sorting through Eigen triplets
+    CSRPattern pattern;
+    pattern.build(*this, true);
+
     Eigen::SparseMatrix<Float> sparse(m_shape(0), m_shape(1));
-    sparse.setFromTriplets(triplets.begin(), triplets.end());
+    sparse.resizeNonZeros(pattern.non_zeros());
+    std::ranges::copy(pattern.row_offsets(), sparse.outerIndexPtr());
+    std::ranges::copy(pattern.col_indices(), sparse.innerIndexPtr());
+    pattern.fill(*this, span<Float>{sparse.valuePtr(), pattern.non_zeros()});
     return sparse;
 }
+
+Eigen::SparseMatrix<Float, Eigen::RowMajor> SparseCOOView::to_csr() const
+{
+    CSRPattern pattern;
+    pattern.build(*this);
+    return pattern.to_csr(*this);
+}
 }  // namespace uipc::diff_sim
\ No newline at end of file
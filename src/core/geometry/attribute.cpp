@@ -28,6 +28,11 @@ std::string_view IAttribute::type_name() const noexcept
     return get_type_name();
 }
 
+SizeT IAttribute::memory_bytes() const noexcept
+{
+    return get_memory_bytes();
+}
+
 void IAttribute::resize(SizeT N)
 {
     do_resize(N);
@@ -4,14 +4,14 @@
 #include <uipc/common/list.h>
 #include <uipc/common/range.h>
 #include <iostream>
+#include <algorithm>
 namespace uipc::geometry
 {
 S<IAttributeSlot> AttributeCollection::share(std::string_view      name,
                                              const IAttributeSlot& slot,
                                              bool allow_destroy)
 {
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    auto it = m_attributes.find(name);
 
     if(size() != slot.size())
         throw GeometryAttributeError{
@@ -23,12 +23,15 @@ S<IAttributeSlot> AttributeCollection::share(std::string_view      name,
     if(it != m_attributes.end())
         throw GeometryAttributeError{
             fmt::format("Attribute with name [{}] already exist!", name)};
-    return m_attributes[n] = slot.clone(name, allow_destroy);
+
+    auto S = slot.clone(name, allow_destroy);
+    insert_slot(name, S);
+    return S;
 }
 
 void AttributeCollection::destroy(std::string_view name)
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(name);
     if(it == m_attributes.end())
     {
         UIPC_WARN_WITH_LOCATION("Destroying non-existing attribute [{}]", name);
@@ -38,22 +41,50 @@ void AttributeCollection::destroy(std::string_view name)
     if(!it->second->allow_destroy())
         throw GeometryAttributeError{fmt::format("Attribute [{}] don't allow destroy!", name)};
 
+    // destroying is rare, find the key entry by its slot instead of interning the name
+    auto key_it = std::ranges::find(m_key_index, it->second, &KeyEntry::second);
+    UIPC_ASSERT(key_it != m_key_index.end(), "Attribute [{}] is not indexed, why can it happen?", name);
+    m_key_index.erase(key_it);
     m_attributes.erase(it);
 }
 
 S<IAttributeSlot> AttributeCollection::find(std::string_view name)
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(name);
     return it != m_attributes.end() ? it->second : nullptr;
 }
 
 
 S<const IAttributeSlot> AttributeCollection::find(std::string_view name) const
 {
-    auto it = m_attributes.find(string{name});
+    auto it = m_attributes.find(name);
     return it != m_attributes.end() ? it->second : nullptr;
 }
 
+S<IAttributeSlot> AttributeCollection::find(const AttributeKey& key) noexcept
+{
+    auto it = std::ranges::lower_bound(m_key_index, key.id(), std::less<>{}, &KeyEntry::first);
+    return it != m_key_index.end() && it->first == key.id() ? it->second : nullptr;
+}
+
+S<const IAttributeSlot> AttributeCollection::find(const AttributeKey& key) const noexcept
+{
+    auto it = std::ranges::lower_bound(m_key_index, key.id(), std::less<>{}, &KeyEntry::first);
+    return it != m_key_index.end() && it->first == key.id() ? it->second : nullptr;
+}
+
+void AttributeCollection::insert_slot(std::string_view name, S<IAttributeSlot> slot)
+{
+    // every slot is also indexed by the id of its interned name
+    AttributeKey key{name};
+    auto it = std::ranges::lower_bound(m_key_index, key.id(), std::less<>{}, &KeyEntry::first);
+    if(it != m_key_index.end() && it->first == key.id())
+        it->second = slot;
+    else
+        m_key_index.insert(it, KeyEntry{key.id(), slot});
+    m_attributes.insert_or_assign(string{name}, std::move(slot));
+}
+
 void AttributeCollection::resize(SizeT N)
 {
     for(auto& [name, slot] : m_attributes)
@@ -84,6 +115,8 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
 
     if(_include_names.empty())
         include_names = other.names();
+    else
+        include_names.assign(_include_names.begin(), _include_names.end());
 
     filtered_names.reserve(include_names.size());
 
@@ -118,8 +151,7 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
                         this->size(),
                         other.size());
 
-            m_attributes[name] =
-                other_slot->clone(other_slot->name(), other_slot->allow_destroy());
+            insert_slot(name, other_slot->clone(other_slot->name(), other_slot->allow_destroy()));
 
             continue;
         }
@@ -129,7 +161,7 @@ void AttributeCollection::copy_from(const AttributeCollection& other,
         {
             auto c             = other_slot->do_clone_empty(other_slot->name(),
                                                 other_slot->allow_destroy());
-            m_attributes[name] = c;
+            insert_slot(name, c);
             UIPC_ASSERT(c->is_shared() == false, "The attribute is shared, why can it happen?");
             c->attribute().resize(size());
             c->attribute().copy_from(other_slot->attribute(), copy);
@@ -197,7 +229,7 @@ AttributeCollection::AttributeCollection(const AttributeCollection& o)
 {
     for(auto& [name, attr] : o.m_attributes)
     {
-        m_attributes[name] = attr->clone(attr->name(), attr->allow_destroy());
+        insert_slot(name, attr->clone(attr->name(), attr->allow_destroy()));
     }
     m_size = o.m_size;
 }
@@ -208,7 +240,7 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
         return *this;
     for(auto& [name, attr] : o.m_attributes)
     {
-        m_attributes[name] = attr->clone(attr->name(), attr->allow_destroy());
+        insert_slot(name, attr->clone(attr->name(), attr->allow_destroy()));
     }
     m_size = o.m_size;
     return *this;
@@ -216,6 +248,7 @@ AttributeCollection& AttributeCollection::operator=(const AttributeCollection& o
 
 AttributeCollection::AttributeCollection(AttributeCollection&& o) noexcept
     : m_attributes(std::move(o.m_attributes))
+    , m_key_index(std::move(o.m_key_index))
     , m_size(o.m_size)
 {
     o.m_size = 0;
@@ -226,6 +259,7 @@ AttributeCollection& AttributeCollection::operator=(AttributeCollection&& o) noe
     if(std::addressof(o) == this)
         return *this;
     m_attributes = std::move(o.m_attributes);
+    m_key_index  = std::move(o.m_key_index);
     m_size       = o.m_size;
     o.m_size     = 0;
     return *this;
@@ -239,8 +273,7 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
                                                 const T&         default_value,
                                                 bool             allow_destroy)
 {
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    auto it = m_attributes.find(name);
     if(it != m_attributes.end())
     {
         throw GeometryAttributeError{
@@ -249,7 +282,7 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
     auto A = uipc::make_shared<Attribute<T>>(default_value);
     A->resize(m_size);
     auto S = uipc::make_shared<AttributeSlot<T>>(name, A, allow_destroy);
-    m_attributes[n] = S;
+    insert_slot(name, S);
     return S;
 }
 
@@ -0,0 +1,101 @@
+#include <uipc/geometry/attribute_key.h>
+#include <uipc/builtin/attribute_key.h>
+#include <uipc/common/log.h>
+#include <uipc/common/string.h>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+namespace uipc::geometry
+{
+namespace
+{
+    class AttributeKeyTable
+    {
+      public:
+        static AttributeKeyTable& instance()
+        {
+            static AttributeKeyTable table;
+            return table;
+        }
+
+        IndexT intern(std::string_view name)
+        {
+            {
+                std::shared_lock lock{m_mutex};
+                auto             it = m_ids.find(name);
+                if(it != m_ids.end())
+                    return it->second;
+            }
+
+            std::unique_lock lock{m_mutex};
+            return intern_unlocked(name);
+        }
+
+        std::string_view name(IndexT id) const
+        {
+            std::shared_lock lock{m_mutex};
+            return m_names[id];
+        }
+
+        SizeT size() const
+        {
+            std::shared_lock lock{m_mutex};
+            return m_names.size();
+        }
+
+      private:
+        AttributeKeyTable()
+        {
+            // the builtin keys take the first ids in the order of declaration
+#define UIPC_BUILTIN_ATTRIBUTE(name) intern_builtin(builtin::key::name)
+#include <uipc/builtin/details/attribute_name.h>
+#undef UIPC_BUILTIN_ATTRIBUTE
+
+            UIPC_ASSERT(m_names.size() == builtin::detail::builtin_attribute_key_count,
+                        "Builtin attribute key count mismatch, expected {}, yours {}",
+                        builtin::detail::builtin_attribute_key_count,
+                        m_names.size());
+        }
+
+        void intern_builtin(const AttributeKey& key)
+        {
+            [[maybe_unused]] auto id = intern_unlocked(key.name());
+            UIPC_ASSERT(id == key.id(),
+                        "Builtin attribute key [{}] id mismatch, expected {}, yours {}",
+                        key.name(),
+                        key.id(),
+                        id);
+        }
+
+        IndexT intern_unlocked(std::string_view name)
+        {
+            auto it = m_ids.find(name);
+            if(it != m_ids.end())
+                return it->second;
+
+            // deque never moves its elements, so the string_views stay valid
+            auto& stored = m_names.emplace_back(name);
+            auto  id     = static_cast<IndexT>(m_names.size() - 1);
+            m_ids.emplace(std::string_view{stored}, id);
+            return id;
+        }
+
+        mutable std::shared_mutex                 m_mutex;
+        std::deque<string>                        m_names;
+        std::unordered_map<std::string_view, IndexT> m_ids;
+    };
+}  // namespace
+
+AttributeKey::AttributeKey(std::string_view name)
+{
+    auto& table = AttributeKeyTable::instance();
+    m_id        = table.intern(name);
+    m_name      = table.name(m_id);
+}
+
+SizeT AttributeKey::interned_count() noexcept
+{
+    return AttributeKeyTable::instance().size();
+}
+}  // namespace uipc::geometry
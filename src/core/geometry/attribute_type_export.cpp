@@ -9,8 +9,7 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
                                                 const T&         default_value,
                                                 bool             allow_destory)
 {
-    auto n  = string{name};
-    auto it = m_attributes.find(n);
+    auto it = m_attributes.find(name);
     if(it != m_attributes.end())
     {
         throw GeometryAttributeError{
@@ -19,7 +18,7 @@ S<AttributeSlot<T>> AttributeCollection::create(std::string_view name,
     auto A = uipc::make_shared<Attribute<T>>(default_value);
     A->resize(m_size);
     auto S = uipc::make_shared<AttributeSlot<T>>(name, A, allow_destory);
-    m_attributes[n] = S;
+    insert_slot(name, S);
     return S;
 }
 
@@ -1,5 +1,8 @@
 #include <uipc/geometry/geometry_collection.h>
 #include <uipc/common/enumerate.h>
+#include <uipc/builtin/attribute_key.h>
+#include <algorithm>
+#include <optional>
 
 namespace uipc::geometry
 {
@@ -23,6 +26,41 @@ IndexT IGeometryCollection::next_id() const noexcept
     return get_next_id();
 }
 
+span<const IndexT> GeometryChangeSet::created_ids() const noexcept
+{
+    return m_created_ids;
+}
+
+span<const IndexT> GeometryChangeSet::destroyed_ids() const noexcept
+{
+    return m_destroyed_ids;
+}
+
+span<const IndexT> GeometryChangeSet::slot_remap() const noexcept
+{
+    return m_slot_remap;
+}
+
+span<const IndexT> GeometryChangeSet::created_slots() const noexcept
+{
+    return m_created_slots;
+}
+
+SizeT GeometryChangeSet::old_size() const noexcept
+{
+    return m_slot_remap.size();
+}
+
+SizeT GeometryChangeSet::new_size() const noexcept
+{
+    return m_new_size;
+}
+
+bool GeometryChangeSet::empty() const noexcept
+{
+    return m_created_ids.empty() && m_destroyed_ids.empty();
+}
+
 void GeometryCollection::destroy(IndexT id) noexcept
 {
     m_dirty = true;
@@ -30,6 +68,7 @@ void GeometryCollection::destroy(IndexT id) noexcept
     auto it = m_geometries.find(id);
     if(it != m_geometries.end())
     {
+        index_erase(id);
         m_geometries.erase(it);
     }
     else
@@ -60,8 +99,65 @@ void GeometryCollection::pending_destroy(IndexT id) noexcept
     }
 }
 
+GeometryChangeSet GeometryCollection::pending_change_set() const
+{
+    flush();
+
+    GeometryChangeSet change_set;
+
+    // pending create slots are already sorted by id
+    change_set.m_created_ids.reserve(m_pending_create_slots.size());
+    for(auto& slot : m_pending_create_slots)
+        change_set.m_created_ids.push_back(slot->id());
+
+    // set<IndexT> keeps the pending destroy ids sorted
+    change_set.m_destroyed_ids.assign(m_pending_destroy.begin(), m_pending_destroy.end());
+
+    // new ids = (old ids - destroyed ids) U created ids, all sorted
+    vector<IndexT> new_ids;
+    new_ids.reserve(m_geometry_slots.size() + change_set.m_created_ids.size());
+    for(auto& slot : m_geometry_slots)
+    {
+        if(!m_pending_destroy.contains(slot->id()))
+            new_ids.push_back(slot->id());
+    }
+    auto mid = new_ids.size();
+    new_ids.insert(new_ids.end(),
+                   change_set.m_created_ids.begin(),
+                   change_set.m_created_ids.end());
+    std::inplace_merge(new_ids.begin(), new_ids.begin() + mid, new_ids.end());
+
+    auto new_slot_of = [&](IndexT id) -> IndexT
+    {
+        auto it = std::lower_bound(new_ids.begin(), new_ids.end(), id);
+        return static_cast<IndexT>(std::distance(new_ids.begin(), it));
+    };
+
+    change_set.m_slot_remap.resize(m_geometry_slots.size());
+    for(auto&& [I, slot] : enumerate(m_geometry_slots))
+    {
+        auto id = slot->id();
+        change_set.m_slot_remap[I] = m_pending_destroy.contains(id) ? -1 : new_slot_of(id);
+    }
+
+    change_set.m_created_slots.reserve(change_set.m_created_ids.size());
+    for(auto id : change_set.m_created_ids)
+        change_set.m_created_slots.push_back(new_slot_of(id));
+
+    change_set.m_new_size = new_ids.size();
+
+    return change_set;
+}
+
+const GeometryChangeSet& GeometryCollection::last_change_set() const noexcept
+{
+    return m_last_change_set;
+}
+
 void GeometryCollection::solve_pending() noexcept
 {
+    m_last_change_set = pending_change_set();
+
     m_dirty = true;
 
     // put the pending create into the geometries
@@ -77,6 +173,7 @@ void GeometryCollection::solve_pending() noexcept
 
         geo->state(GeometrySlotState::Normal);
         m_geometries.emplace(id, geo);
+        index_insert(*geo);
     }
     m_pending_create.clear();
 
@@ -90,6 +187,7 @@ void GeometryCollection::solve_pending() noexcept
         UIPC_ASSERT(it->second->state() == GeometrySlotState::PendingDestroy,
                     "GeometrySlot ({}) is not in PendingDestroy state. Why can this happen?",
                     id);
+        index_erase(id);
         m_geometries.erase(it);
     }
     m_pending_destroy.clear();
@@ -118,9 +216,67 @@ void GeometryCollection::do_reserve(SizeT size) noexcept
     m_geometries.reserve(size);
 }
 
+span<const IndexT> GeometryCollection::find_ids_by_constitution(U64 uid) const noexcept
+{
+    if(auto it = m_constitution_to_ids.find(uid); it != m_constitution_to_ids.end())
+        return it->second;
+    return {};
+}
+
+void GeometryCollection::update_constitution_index(IndexT id)
+{
+    index_erase(id);
+    if(auto it = m_geometries.find(id); it != m_geometries.end())
+        index_insert(*it->second);
+}
+
+void GeometryCollection::update_constitution_index()
+{
+    m_constitution_to_ids.clear();
+    m_id_to_constitution.clear();
+    for(auto& [id, slot] : m_geometries)
+        index_insert(*slot);
+}
+
+static std::optional<U64> constitution_uid_of(const GeometrySlot& slot)
+{
+    auto uid = slot.geometry().meta().find<U64>(builtin::key::constitution_uid);
+    if(!uid)
+        return std::nullopt;
+    return uid->view().front();
+}
+
+void GeometryCollection::index_insert(const GeometrySlot& slot)
+{
+    auto value = constitution_uid_of(slot);
+    if(!value)
+        return;
+
+    auto& ids = m_constitution_to_ids[*value];
+    ids.insert(std::upper_bound(ids.begin(), ids.end(), slot.id()), slot.id());
+    m_id_to_constitution[slot.id()] = *value;
+}
+
+void GeometryCollection::index_erase(IndexT id)
+{
+    auto it = m_id_to_constitution.find(id);
+    if(it == m_id_to_constitution.end())
+        return;
+
+    auto& ids = m_constitution_to_ids[it->second];
+    if(auto pos = std::lower_bound(ids.begin(), ids.end(), id); pos != ids.end() && *pos == id)
+        ids.erase(pos);
+    if(ids.empty())
+        m_constitution_to_ids.erase(it->second);
+
+    m_id_to_constitution.erase(it);
+}
+
 void GeometryCollection::do_clear() noexcept
 {
     m_geometries.clear();
+    m_constitution_to_ids.clear();
+    m_id_to_constitution.clear();
 }
 
 SizeT GeometryCollection::get_size() const noexcept
@@ -173,6 +329,9 @@ void GeometryCollection::build_from(span<S<geometry::GeometrySlot>> slots) noexc
     m_geometries.clear();
     m_pending_create.clear();
     m_pending_destroy.clear();
+    m_constitution_to_ids.clear();
+    m_id_to_constitution.clear();
+    m_last_change_set = {};
 
     {
         m_geometry_slots.clear();
@@ -186,6 +345,7 @@ void GeometryCollection::build_from(span<S<geometry::GeometrySlot>> slots) noexc
     {
         auto my_slot = slot->clone();
         m_geometries.insert({my_slot->id(), my_slot});
+        index_insert(*my_slot);
         m_next_id = std::max(m_next_id, my_slot->id() + 1);
     }
 
@@ -2,6 +2,7 @@
 #include <uipc/common/log.h>
 #include <Eigen/Geometry>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/common/zip.h>
 
@@ -31,12 +32,12 @@ const AttributeSlot<Matrix4x4>& SimplicialComplex::transforms() const
 
 AttributeSlot<Vector3>& SimplicialComplex::positions() noexcept
 {
-    return *m_vertex_attributes.find<Vector3>(builtin::position);
+    return *m_vertex_attributes.find<Vector3>(builtin::key::position);
 }
 
 const AttributeSlot<Vector3>& SimplicialComplex::positions() const noexcept
 {
-    return *m_vertex_attributes.find<Vector3>(builtin::position);
+    return *m_vertex_attributes.find<Vector3>(builtin::key::position);
 }
 
 auto SimplicialComplex::vertices() noexcept -> VertexAttributes
@@ -0,0 +1,439 @@
+#include <uipc/geometry/utils/affine_body/compute_mass_properties.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/compensated_sum.h>
+#include <uipc/common/content_hash.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/unordered_map.h>
+#include <uipc/common/log.h>
+#include <Eigen/Dense>
+
+namespace uipc::geometry::affine_body
+{
+// ref: libuipc/scripts/symbol_calculation/affine_body_quantity.ipynb
+
+namespace detail
+{
+    // elements per parallel work item, the partial sums of the blocks are merged in order,
+    // so the result doesn't depend on the thread count
+    constexpr SizeT ElementBlockSize = 4096;
+
+    class PartialMassProperties
+    {
+      public:
+        CompensatedSum<Float>     volume;
+        CompensatedSum<Vector3>   first_moment;
+        CompensatedSum<Matrix3x3> second_moment;
+
+        PartialMassProperties& operator+=(const PartialMassProperties& other) noexcept
+        {
+            volume += other.volume;
+            first_moment += other.first_moment;
+            second_moment += other.second_moment;
+            return *this;
+        }
+
+        MassProperties value() const noexcept
+        {
+            MassProperties props;
+            props.volume        = volume.value();
+            props.first_moment  = first_moment.value();
+            props.second_moment = second_moment.value();
+            return props;
+        }
+    };
+
+    // the geometry of a body needed by the integration
+    class BodyView
+    {
+      public:
+        IndexT                 dim = 0;
+        span<const Vector3>    positions;
+        span<const Vector4i>   tets;
+        span<const Vector3i>   tris;
+        span<const IndexT>     orients;
+
+        SizeT element_count() const noexcept
+        {
+            return dim == 3 ? tets.size() : tris.size();
+        }
+    };
+
+    static BodyView body_view(const SimplicialComplex& sc)
+    {
+        BodyView B;
+        B.dim = sc.dim();
+        UIPC_ASSERT(B.dim == 2 || B.dim == 3,
+                    "Only tetmesh and closed trimesh are supported, yours dim={}.",
+                    B.dim);
+
+        B.positions = sc.positions().view();
+        if(B.dim == 3)
+        {
+            B.tets = sc.tetrahedra().topo().view();
+        }
+        else
+        {
+            B.tris      = sc.triangles().topo().view();
+            auto orient = sc.triangles().find<IndexT>(builtin::orient);
+            if(orient)
+                B.orients = orient->view();
+        }
+        return B;
+    }
+
+    static U64 content_hash(const BodyView& B) noexcept
+    {
+        ContentHash hash;
+        hash.update(B.dim);
+        hash.update(B.positions);
+        hash.update(B.tets);
+        hash.update(B.tris);
+        hash.update(B.orients);
+        return hash.value();
+    }
+
+    // Integrate over the volume of the tetrahedra
+    static void integrate_tet(const Vector3&         p0,
+                              const Vector3&         p1,
+                              const Vector3&         p2,
+                              const Vector3&         p3,
+                              PartialMassProperties& P)
+    {
+        Vector3 e1 = p1 - p0;
+        Vector3 e2 = p2 - p0;
+        Vector3 e3 = p3 - p0;
+
+        Float D = e1.dot(e2.cross(e3));
+
+        P.volume += D / 6.0;
+
+        Vector3 S;
+        for(IndexT a = 0; a < 3; a++)
+        {
+            Float V = 0.0;
+
+            V += p0(a) / 24;
+            V += p1(a) / 24;
+            V += p2(a) / 24;
+            V += p3(a) / 24;
+
+            S(a) = D * V;
+        }
+        P.first_moment += S;
+
+        Matrix3x3 M;
+        for(IndexT a = 0; a < 3; a++)
+            for(IndexT b = 0; b < 3; b++)
+            {
+                Float V = 0.0;
+
+                V += p0(a) * p0(b) / 60;
+                V += p0(a) * p1(b) / 120;
+                V += p0(a) * p2(b) / 120;
+                V += p0(a) * p3(b) / 120;
+
+                V += p0(b) * p1(a) / 120;
+                V += p0(b) * p2(a) / 120;
+                V += p0(b) * p3(a) / 120;
+                V += p1(a) * p1(b) / 60;
+
+                V += p1(a) * p2(b) / 120;
+                V += p1(a) * p3(b) / 120;
+                V += p1(b) * p2(a) / 120;
+                V += p1(b) * p3(a) / 120;
+
+                V += p2(a) * p2(b) / 60;
+                V += p2(a) * p3(b) / 120;
+                V += p2(b) * p3(a) / 120;
+                V += p3(a) * p3(b) / 60;
+
+                M(a, b) = D * V;
+            }
+        P.second_moment += M;
+    }
+
+    // Using Divergence theorem to integrate on the surface of the trimesh
+    static void integrate_tri(const Vector3&         p0,
+                              const Vector3&         p1,
+                              const Vector3&         p2,
+                              bool                   flip,
+                              PartialMassProperties& P)
+    {
+        Vector3 e1 = p1 - p0;
+        Vector3 e2 = p2 - p0;
+
+        Vector3 N = e1.cross(e2);
+        if(flip)
+            N = -N;
+
+        P.volume += p0.dot(N) / 6.0;
+
+        Vector3 S;
+        for(IndexT a = 0; a < 3; a++)
+        {
+            Float V = 0.0;
+
+            V += p0(a) * p0(a) / 12;
+            V += p0(a) * p1(a) / 12;
+            V += p0(a) * p2(a) / 12;
+
+            V += p1(a) * p1(a) / 12;
+            V += p1(a) * p2(a) / 12;
+            V += p2(a) * p2(a) / 12;
+
+            S(a) = 1.0 / 2 * N(a) * V;
+        }
+        P.first_moment += S;
+
+        Matrix3x3 M;
+        for(IndexT a = 0; a < 3; a++)  // diagonal
+        {
+            Float V = 0.0;
+
+            Float p0a_2 = p0(a) * p0(a);
+            Float p1a_2 = p1(a) * p1(a);
+            Float p2a_2 = p2(a) * p2(a);
+
+            Float p0a_3 = p0a_2 * p0(a);
+            Float p1a_3 = p1a_2 * p1(a);
+            Float p2a_3 = p2a_2 * p2(a);
+
+            V += p0a_3 / 20;
+            V += p0a_2 * p1(a) / 20;
+            V += p0a_2 * p2(a) / 20;
+
+            V += p0(a) * p1a_2 / 20;
+            V += p0(a) * p1(a) * p2(a) / 20;
+            V += p0(a) * p2a_2 / 20;
+
+            V += p1a_3 / 20;
+            V += p1a_2 * p2(a) / 20;
+            V += p1(a) * p2a_2 / 20;
+
+            V += p2a_3 / 20;
+
+            M(a, a) = 1.0 / 3 * N(a) * V;
+        }
+
+        auto Q = [&](IndexT a, IndexT b)
+        {
+            Float V = 0.0;
+
+            Float p0a_2 = p0(a) * p0(a);
+            Float p1a_2 = p1(a) * p1(a);
+            Float p2a_2 = p2(a) * p2(a);
+
+            V += p0a_2 * p0(b) / 20;
+            V += p0a_2 * p1(b) / 60;
+            V += p0a_2 * p2(b) / 60;
+            V += p0(a) * p0(b) * p1(a) / 30;
+
+            V += p0(a) * p0(b) * p2(a) / 30;
+            V += p0(a) * p1(a) * p1(b) / 30;
+            V += p0(a) * p1(a) * p2(b) / 60;
+            V += p0(a) * p1(b) * p2(a) / 60;
+
+            V += p0(a) * p2(a) * p2(b) / 30;
+            V += p0(b) * p1a_2 / 60;
+            V += p0(b) * p1(a) * p2(a) / 60;
+            V += p0(b) * p2a_2 / 60;
+
+            V += p1a_2 * p1(b) / 20;
+            V += p1a_2 * p2(b) / 60;
+            V += p1(a) * p1(b) * p2(a) / 30;
+            V += p1(a) * p2(a) * p2(b) / 30;
+
+            V += p1(b) * p2a_2 / 60;
+            V += p2a_2 * p2(b) / 20;
+
+            return 1.0 / 2 * N(a) * V;
+        };
+
+        M(0, 1) = M(1, 0) = Q(0, 1);
+        M(0, 2) = M(2, 0) = Q(0, 2);
+        M(1, 2) = M(2, 1) = Q(1, 2);
+        P.second_moment += M;
+    }
+
+    static void integrate(const BodyView& B, SizeT begin, SizeT end, PartialMassProperties& P)
+    {
+        const auto& pos = B.positions;
+        if(B.dim == 3)
+        {
+            for(SizeT I = begin; I < end; ++I)
+            {
+                const auto& T = B.tets[I];
+                integrate_tet(pos[T[0]], pos[T[1]], pos[T[2]], pos[T[3]], P);
+            }
+        }
+        else
+        {
+            for(SizeT I = begin; I < end; ++I)
+            {
+                const auto& F    = B.tris[I];
+                bool        flip = !B.orients.empty() && B.orients[I] < 0;
+                integrate_tri(pos[F[0]], pos[F[1]], pos[F[2]], flip, P);
+            }
+        }
+    }
+
+    // a block of elements of one body
+    class ElementBlock
+    {
+      public:
+        SizeT body;
+        SizeT begin;
+        SizeT end;
+    };
+
+    static vector<MassProperties> integrate_bodies(span<const BodyView> Bs)
+    {
+        // split all the bodies into blocks, the blocks of a body are contiguous
+        vector<ElementBlock> blocks;
+        vector<SizeT>        body_block_offsets(Bs.size() + 1, 0);
+        for(SizeT b = 0; b < Bs.size(); ++b)
+        {
+            SizeT N = Bs[b].element_count();
+            for(SizeT begin = 0; begin < N; begin += ElementBlockSize)
+                blocks.push_back({b, begin, std::min(begin + ElementBlockSize, N)});
+            body_block_offsets[b + 1] = blocks.size();
+        }
+
+        vector<PartialMassProperties> partials(blocks.size());
+        parallel_for(blocks.size(),
+                     [&](SizeT i)
+                     {
+                         auto& blk = blocks[i];
+                         integrate(Bs[blk.body], blk.begin, blk.end, partials[i]);
+                     });
+
+        vector<MassProperties> props(Bs.size());
+        parallel_for(
+            Bs.size(),
+            [&](SizeT b)
+            {
+                PartialMassProperties P;
+                for(SizeT i = body_block_offsets[b]; i < body_block_offsets[b + 1]; ++i)
+                    P += partials[i];
+                props[b] = P.value();
+            },
+            256);
+
+        return props;
+    }
+}  // namespace detail
+
+void MassProperties::dyadic_mass(Float rho, Float& m, Vector3& m_x_bar, Matrix3x3& m_x_bar_x_bar) const noexcept
+{
+    m             = rho * volume;
+    m_x_bar       = rho * first_moment;
+    m_x_bar_x_bar = rho * second_moment;
+}
+
+Vector12 MassProperties::body_force(const Vector3& body_force_density) const noexcept
+{
+    const auto& f = body_force_density;
+
+    Vector12 body_force;
+    body_force.segment<3>(0) = f * volume;
+    body_force.segment<3>(3) = f.x() * first_moment;
+    body_force.segment<3>(6) = f.y() * first_moment;
+    body_force.segment<3>(9) = f.z() * first_moment;
+    return body_force;
+}
+
+class MassPropertiesCache::Impl
+{
+  public:
+    unordered_map<U64, MassProperties> entries;
+    SizeT                              hit_count  = 0;
+    SizeT                              miss_count = 0;
+};
+
+MassPropertiesCache::MassPropertiesCache()
+    : m_impl{uipc::make_unique<Impl>()}
+{
+}
+
+MassPropertiesCache::~MassPropertiesCache() {}
+
+SizeT MassPropertiesCache::size() const noexcept
+{
+    return m_impl->entries.size();
+}
+
+SizeT MassPropertiesCache::hit_count() const noexcept
+{
+    return m_impl->hit_count;
+}
+
+SizeT MassPropertiesCache::miss_count() const noexcept
+{
+    return m_impl->miss_count;
+}
+
+void MassPropertiesCache::clear()
+{
+    m_impl->entries.clear();
+    m_impl->hit_count  = 0;
+    m_impl->miss_count = 0;
+}
+
+MassProperties compute_mass_properties(const SimplicialComplex& sc)
+{
+    const SimplicialComplex* bodies[] = {&sc};
+    return compute_mass_properties(bodies).front();
+}
+
+vector<MassProperties> compute_mass_properties(span<const SimplicialComplex* const> bodies,
+                                               MassPropertiesCache* cache)
+{
+    vector<detail::BodyView> Bs(bodies.size());
+    for(SizeT b = 0; b < bodies.size(); ++b)
+    {
+        UIPC_ASSERT(bodies[b], "Body[{}] is null.", b);
+        Bs[b] = detail::body_view(*bodies[b]);
+    }
+
+    if(!cache)
+        return detail::integrate_bodies(Bs);
+
+    auto& cache_impl = *cache->m_impl;
+
+    vector<U64> keys(Bs.size());
+    parallel_for(
+        Bs.size(), [&](SizeT b) { keys[b] = detail::content_hash(Bs[b]); }, 256);
+
+    // integrate each missing content only once, even if it appears many times in this batch
+    vector<detail::BodyView>   missing_bodies;
+    unordered_map<U64, SizeT> missing_index;
+    for(SizeT b = 0; b < Bs.size(); ++b)
+    {
+        if(cache_impl.entries.contains(keys[b]))
+        {
+            ++cache_impl.hit_count;
+            continue;
+        }
+
+        auto [it, inserted] = missing_index.try_emplace(keys[b], missing_bodies.size());
+        if(inserted)
+        {
+            missing_bodies.push_back(Bs[b]);
+            ++cache_impl.miss_count;
+        }
+        else
+        {
+            ++cache_impl.hit_count;
+        }
+    }
+
+    auto missing_props = detail::integrate_bodies(missing_bodies);
+    for(auto& [key, i] : missing_index)
+        cache_impl.entries.emplace(key, missing_props[i]);
+
+    vector<MassProperties> props(Bs.size());
+    for(SizeT b = 0; b < Bs.size(); ++b)
+        props[b] = cache_impl.entries.at(keys[b]);
+    return props;
+}
+}  // namespace uipc::geometry::affine_body
@@ -0,0 +1,326 @@
+#include <uipc/geometry/utils/bake_sdf.h>
+#include <uipc/geometry/utils/factory.h>
+#include <uipc/geometry/utils/bvh.h>
+#include <uipc/geometry/utils/is_trimesh_closed.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/unordered_map.h>
+#include <uipc/common/log.h>
+#include <sdf_grid_bricks.h>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+
+namespace uipc::geometry
+{
+namespace detail
+{
+    // the feature of a triangle that a closest point lies on
+    enum class TriangleFeature
+    {
+        Face,
+        V0,
+        V1,
+        V2,
+        E01,
+        E12,
+        E20
+    };
+
+    // Real-Time Collision Detection, Christer Ericson, 5.1.5
+    static Vector3 closest_point_on_triangle(const Vector3&   p,
+                                             const Vector3&   a,
+                                             const Vector3&   b,
+                                             const Vector3&   c,
+                                             TriangleFeature& feature)
+    {
+        Vector3 ab = b - a;
+        Vector3 ac = c - a;
+        Vector3 ap = p - a;
+        Float   d1 = ab.dot(ap);
+        Float   d2 = ac.dot(ap);
+        if(d1 <= 0 && d2 <= 0)
+        {
+            feature = TriangleFeature::V0;
+            return a;
+        }
+
+        Vector3 bp = p - b;
+        Float   d3 = ab.dot(bp);
+        Float   d4 = ac.dot(bp);
+        if(d3 >= 0 && d4 <= d3)
+        {
+            feature = TriangleFeature::V1;
+            return b;
+        }
+
+        Float vc = d1 * d4 - d3 * d2;
+        if(vc <= 0 && d1 >= 0 && d3 <= 0)
+        {
+            feature = TriangleFeature::E01;
+            return a + d1 / (d1 - d3) * ab;
+        }
+
+        Vector3 cp = p - c;
+        Float   d5 = ab.dot(cp);
+        Float   d6 = ac.dot(cp);
+        if(d6 >= 0 && d5 <= d6)
+        {
+            feature = TriangleFeature::V2;
+            return c;
+        }
+
+        Float vb = d5 * d2 - d1 * d6;
+        if(vb <= 0 && d2 >= 0 && d6 <= 0)
+        {
+            feature = TriangleFeature::E20;
+            return a + d2 / (d2 - d6) * ac;
+        }
+
+        Float va = d3 * d6 - d5 * d4;
+        if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+        {
+            feature = TriangleFeature::E12;
+            return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+        }
+
+        Float denom = 1 / (va + vb + vc);
+        feature     = TriangleFeature::Face;
+        return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+    // angle-weighted pseudo-normals (Baerentzen and Aanaes 2005), the sign of the distance
+    // is the side of the closest feature's pseudo-normal, which is robust on edges and vertices
+    class PseudoNormals
+    {
+      public:
+        PseudoNormals(span<const Vector3> Vs, span<const Vector3i> Fs)
+        {
+            face_normals.resize(Fs.size());
+            vertex_normals.assign(Vs.size(), Vector3::Zero());
+            face_edges.resize(Fs.size());
+
+            unordered_map<U64, IndexT> edge_ids;
+            auto edge_key = [](IndexT a, IndexT b) -> U64
+            {
+                if(a > b)
+                    std::swap(a, b);
+                return (static_cast<U64>(a) << 32) | static_cast<U64>(b);
+            };
+
+            for(SizeT f = 0; f < Fs.size(); ++f)
+            {
+                const Vector3i& F = Fs[f];
+                Vector3         N = (Vs[F[1]] - Vs[F[0]]).cross(Vs[F[2]] - Vs[F[0]]);
+                Float           n = N.norm();
+                face_normals[f]   = n > 0 ? Vector3{N / n} : Vector3::Zero();
+
+                for(IndexT k = 0; k < 3; ++k)
+                {
+                    IndexT  v  = F[k];
+                    Vector3 e0 = Vs[F[(k + 1) % 3]] - Vs[v];
+                    Vector3 e1 = Vs[F[(k + 2) % 3]] - Vs[v];
+                    Float   angle =
+                        std::atan2(e0.cross(e1).norm(), e0.dot(e1));  // robust for thin triangles
+                    vertex_normals[v] += angle * face_normals[f];
+
+                    auto [it, inserted] = edge_ids.try_emplace(
+                        edge_key(F[k], F[(k + 1) % 3]), static_cast<IndexT>(edge_normals.size()));
+                    if(inserted)
+                        edge_normals.push_back(Vector3::Zero());
+                    edge_normals[it->second] += face_normals[f];
+                    face_edges[f][k] = it->second;
+                }
+            }
+        }
+
+        const Vector3& normal(const Vector3i& F, IndexT f, TriangleFeature feature) const
+        {
+            switch(feature)
+            {
+                case TriangleFeature::V0:
+                    return vertex_normals[F[0]];
+                case TriangleFeature::V1:
+                    return vertex_normals[F[1]];
+                case TriangleFeature::V2:
+                    return vertex_normals[F[2]];
+                case TriangleFeature::E01:
+                    return edge_normals[face_edges[f][0]];
+                case TriangleFeature::E12:
+                    return edge_normals[face_edges[f][1]];
+                case TriangleFeature::E20:
+                    return edge_normals[face_edges[f][2]];
+                default:
+                    return face_normals[f];
+            }
+        }
+
+      private:
+        vector<Vector3>  face_normals;
+        vector<Vector3>  vertex_normals;
+        vector<Vector3>  edge_normals;
+        vector<Vector3i> face_edges;
+    };
+}  // namespace detail
+
+ImplicitGeometry bake_sdf(const SimplicialComplex& trimesh, Float spacing, Float narrow_band)
+{
+    UIPC_ASSERT(trimesh.dim() == 2,
+                "bake_sdf() only supports triangle mesh, yours dim={}",
+                trimesh.dim());
+    UIPC_ASSERT(is_trimesh_closed(trimesh), "bake_sdf() requires a closed triangle mesh");
+    UIPC_ASSERT(spacing > 0, "Spacing must be positive, yours {}", spacing);
+
+    if(narrow_band <= 0)
+        narrow_band = 3 * spacing;
+    // a grid row can't cross the surface without a grid point in the band, see the sign sweep below
+    narrow_band = std::max(narrow_band, spacing);
+
+    auto Vs = trimesh.positions().view();
+    auto Fs = trimesh.triangles().topo().view();
+
+    // 1) grid covering the mesh, padded by the band
+    Eigen::AlignedBox<Float, 3> bbox;
+    for(auto& V : Vs)
+        bbox.extend(V);
+
+    Float    pad = narrow_band + spacing;
+    Vector3  origin = bbox.min() - Vector3::Constant(pad);
+    Vector3  extent = bbox.max() + Vector3::Constant(pad) - origin;
+    Vector3i resolution;
+    for(IndexT a = 0; a < 3; ++a)
+        resolution[a] = static_cast<IndexT>(std::ceil(extent[a] / spacing)) + 1;
+
+    // 2) BVH of the triangles
+    vector<BVH::AABB> tri_aabbs(Fs.size());
+    for(SizeT f = 0; f < Fs.size(); ++f)
+    {
+        tri_aabbs[f].setEmpty();
+        for(IndexT k = 0; k < 3; ++k)
+            tri_aabbs[f].extend(Vs[Fs[f][k]]);
+    }
+    BVH bvh;
+    bvh.build(tri_aabbs);
+
+    detail::PseudoNormals pseudo_normals{Vs, Fs};
+
+    // 3) bake the bricks touching the narrow band, the others are entirely inside or outside.
+    //    Each brick row is independent: its bricks are swept along x, so a point out of the band
+    //    takes the sign of the previous point in its grid row.
+    detail::SDFGridBricks layout{resolution, detail::SDFGridBricks::DefaultBrickSize};
+    const auto&           BR = layout.brick_resolution();
+    IndexT                B  = layout.brick_size();
+    SizeT                 BV = layout.brick_volume();
+
+    VectorXi                bricks(layout.brick_count());
+    vector<SizeT>           row_brick_counts(BR[1] * BR[2], 0);
+    vector<vector<Float>>   row_values(BR[1] * BR[2]);
+    Vector3                 brick_extent = Vector3::Constant(spacing * (B - 1));
+    Vector3                 band         = Vector3::Constant(narrow_band);
+
+    parallel_for(
+        row_values.size(),
+        [&](SizeT row)
+        {
+            IndexT bj = static_cast<IndexT>(row % BR[1]);
+            IndexT bk = static_cast<IndexT>(row / BR[1]);
+
+            // the sign of the last point of each grid row passing through this brick row,
+            // the first point is on the padding, so it's outside
+            vector<Float> prev_sign(B * B, 1.0);
+
+            vector<BVH::AABB> point_aabbs(BV);
+            vector<Vector3>   points(BV);
+            vector<Float>     dist2(BV);
+            vector<Float>     sign(BV);
+            auto&             values = row_values[row];
+
+            for(IndexT bi = 0; bi < BR[0]; ++bi)
+            {
+                auto    brick = layout.brick_index(bi, bj, bk);
+                Vector3 lo = origin + spacing * Vector3{Float(bi * B), Float(bj * B), Float(bk * B)};
+
+                // no triangle near the brick: all its points are on the side of the previous point
+                BVH::AABB brick_aabb{lo - band, lo + brick_extent + band};
+                bool      near_surface = false;
+                bvh.query(span{&brick_aabb, 1}, [&](IndexT, IndexT) { near_surface = true; });
+                if(!near_surface)
+                {
+                    bricks[brick] = prev_sign[0] > 0 ? detail::SDFGridBricks::OutsideBrick :
+                                                       detail::SDFGridBricks::InsideBrick;
+                    continue;
+                }
+
+                for(IndexT kk = 0; kk < B; ++kk)
+                    for(IndexT jj = 0; jj < B; ++jj)
+                        for(IndexT ii = 0; ii < B; ++ii)
+                        {
+                            SizeT p   = ii + B * (jj + B * kk);
+                            points[p] = lo + spacing * Vector3{Float(ii), Float(jj), Float(kk)};
+                            point_aabbs[p] = BVH::AABB{points[p] - band, points[p] + band};
+                        }
+
+                std::ranges::fill(dist2, std::numeric_limits<Float>::max());
+                std::ranges::fill(sign, 1.0);
+                bvh.query(point_aabbs,
+                          [&](IndexT p, IndexT f)
+                          {
+                              const Vector3i&         F = Fs[f];
+                              detail::TriangleFeature feature;
+                              Vector3 C = detail::closest_point_on_triangle(
+                                  points[p], Vs[F[0]], Vs[F[1]], Vs[F[2]], feature);
+                              Vector3 D  = points[p] - C;
+                              Float   D2 = D.squaredNorm();
+                              if(D2 < dist2[p])
+                              {
+                                  dist2[p] = D2;
+                                  sign[p] = D.dot(pseudo_normals.normal(F, f, feature)) < 0 ? -1.0 : 1.0;
+                              }
+                          });
+
+                bricks[brick] = static_cast<IndexT>(row_brick_counts[row]++);
+                SizeT base    = values.size();
+                values.resize(base + BV);
+                for(IndexT kk = 0; kk < B; ++kk)
+                    for(IndexT jj = 0; jj < B; ++jj)
+                    {
+                        Float& row_sign = prev_sign[jj + B * kk];
+                        for(IndexT ii = 0; ii < B; ++ii)
+                        {
+                            SizeT p = ii + B * (jj + B * kk);
+                            Float d = std::sqrt(dist2[p]);
+                            if(d <= narrow_band)
+                                row_sign = sign[p];
+                            else
+                                d = narrow_band;
+                            values[base + p] = row_sign * d;
+                        }
+                    }
+            }
+        });
+
+    // gather the stored bricks in brick row order, the result doesn't depend on the thread count
+    vector<SizeT> row_offsets(row_values.size(), 0);
+    for(SizeT row = 1; row < row_values.size(); ++row)
+        row_offsets[row] = row_offsets[row - 1] + row_brick_counts[row - 1];
+
+    SizeT   stored_count = row_values.empty() ? 0 : row_offsets.back() + row_brick_counts.back();
+    VectorX values(stored_count * BV);
+    for(SizeT row = 0; row < row_values.size(); ++row)
+    {
+        std::ranges::copy(row_values[row], values.begin() + row_offsets[row] * BV);
+        IndexT bj = static_cast<IndexT>(row % BR[1]);
+        IndexT bk = static_cast<IndexT>(row / BR[1]);
+        for(IndexT bi = 0; bi < BR[0]; ++bi)
+        {
+            auto& slot = bricks[layout.brick_index(bi, bj, bk)];
+            if(slot >= 0)
+                slot += static_cast<IndexT>(row_offsets[row]);
+        }
+    }
+
+    Matrix4x4 transform = trimesh.instances().size() ? trimesh.transforms().view()[0] :
+                                                       Matrix4x4::Identity();
+
+    return detail::create_sdf_grid(origin, spacing, resolution, narrow_band, B, bricks, values, transform);
+}
+}  // namespace uipc::geometry
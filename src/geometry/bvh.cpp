@@ -13,21 +13,19 @@ class BVH::Impl
     {
         if(aabbs.empty() || m_impl.boxes().empty())
             return;
-        m_indices.reserve(aabbs.size());
+        vector<unsigned int> indices;
         for(auto&& [i, aabb] : enumerate(aabbs))
         {
-            m_indices.clear();
-            m_impl.intersect(aabb, m_indices);
+            m_impl.intersect(aabb, indices);
 
-            for(const auto& index : m_indices)
+            for(const auto& index : indices)
             {
                 QF(i, index);
             }
         }
     }
 
-    SimpleBVH::BVH               m_impl;
-    mutable vector<unsigned int> m_indices;
+    SimpleBVH::BVH m_impl;
 };
 
 BVH::BVH()
@@ -12,13 +12,13 @@ void BVH::clear()
 
 void BVH::intersect(const AABB& box, vector<unsigned int>& list) const
 {
-    m_tmp.clear();
+    // search into the output directly, so that concurrent queries don't share any buffer
+    list.clear();
     assert(n_corners >= 0);
-    box_search_recursive(box, m_tmp, 1, 0, n_corners);
+    box_search_recursive(box, list, 1, 0, n_corners);
 
-    list.resize(m_tmp.size());
-    for(int i = 0; i < m_tmp.size(); ++i)
-        list[i] = new2old[m_tmp[i]];
+    for(auto& i : list)
+        i = new2old[i];
 }
 
 void BVH::init_boxes_recursive(span<const AABB> cornerlist, int node_index, int b, int e)
@@ -100,7 +100,6 @@ void BVH::init(span<const AABB> cornerlist)
     }
 
     n_corners = cornerlist.size();
-    m_tmp.resize(n_corners);
 
     Eigen::MatrixXd box_centers(n_corners, 3);
     for(int i = 0; i < n_corners; ++i)
@@ -49,6 +49,5 @@ class BVH
     vector<AABB>                 boxlist;
     vector<int>                  new2old;
     size_t                       n_corners = -1;
-    mutable vector<unsigned int> m_tmp;
 };
 }  // namespace SimpleBVH
@@ -0,0 +1,57 @@
+#include <uipc/geometry/utils/clone.h>
+#include <uipc/common/enumerate.h>
+
+namespace uipc::geometry
+{
+vector<SimplicialComplex> clone(const SimplicialComplex& prototype,
+                                span<const Matrix4x4>    transforms,
+                                span<const std::string>  owned_vertex_attributes)
+{
+    UIPC_ASSERT(prototype.instances().size() == 1,
+                "The prototype should have exactly one instance, yours={}.",
+                prototype.instances().size());
+
+    // here we share all the attributes
+    vector<SimplicialComplex> Rs(transforms.size(), prototype);
+
+    vector<string> owned_names{owned_vertex_attributes.begin(),
+                               owned_vertex_attributes.end()};
+
+    for(auto&& [i, R] : enumerate(Rs))
+    {
+        // only the single transform is copied
+        view(R.transforms())[0] = transforms[i];
+
+        if(!owned_names.empty())
+        {
+            // copying into an existing slot makes it owned
+            R.vertices().copy_from(prototype.vertices(),
+                                   AttributeCopy::range(0, 0, prototype.vertices().size()),
+                                   owned_names);
+        }
+    }
+
+    return Rs;
+}
+
+SimplicialComplex instantiate(const SimplicialComplex& prototype, span<const Matrix4x4> transforms)
+{
+    UIPC_ASSERT(prototype.instances().size() == 1,
+                "The prototype should have exactly one instance, yours={}.",
+                prototype.instances().size());
+
+    // here we share all the attributes
+    SimplicialComplex R = prototype;
+
+    R.instances().resize(transforms.size());
+
+    // broadcast the instance attributes of the prototype
+    vector<SizeT> mapping(transforms.size(), 0);
+    R.instances().copy_from(prototype.instances(), AttributeCopy::pull(mapping));
+
+    auto Ts = view(R.transforms());
+    std::ranges::copy(transforms, Ts.begin());
+
+    return R;
+}
+}  // namespace uipc::geometry
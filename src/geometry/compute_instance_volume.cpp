@@ -3,6 +3,7 @@
 #include <uipc/common/enumerate.h>
 #include <uipc/builtin/attribute_name.h>
 #include <uipc/geometry/utils/is_trimesh_closed.h>
+#include <uipc/common/parallel_reduce.h>
 
 namespace uipc::geometry
 {
@@ -11,34 +12,32 @@ static Float compute_tetmesh_volume(const SimplicialComplex& R)
     auto pos_view = R.positions().view();
     auto tet_view = R.tetrahedra().topo().view();
 
-    Float volume = 0.0;
-
-    for(auto&& [I, t] : enumerate(tet_view))
-    {
-        auto [p0, p1, p2, p3] =
-            std::tuple{pos_view[t[0]], pos_view[t[1]], pos_view[t[2]], pos_view[t[3]]};
-
-        Matrix<Float, 3, 3> A;
-        A.col(0) = p1 - p0;
-        A.col(1) = p2 - p0;
-        A.col(2) = p3 - p0;
-        auto D   = A.determinant();
-        if(D < 0.0)
-        {
-            UIPC_WARN_WITH_LOCATION(
-                "The determinant of the tetrahedron {} ({},{},{},{}) is non-positive ({}), "
-                "which means the tetrahedron is inverted.",
-                I,
-                t[0],
-                t[1],
-                t[2],
-                t[3],
-                D);
-        }
-        volume += D / 6.0;
-    }
-
-    return volume;
+    return parallel_sum<Float>(tet_view.size(),
+                              [&](SizeT I)
+                              {
+                                  const auto& t = tet_view[I];
+                                  auto [p0, p1, p2, p3] = std::tuple{
+                                      pos_view[t[0]], pos_view[t[1]], pos_view[t[2]], pos_view[t[3]]};
+
+                                  Matrix<Float, 3, 3> A;
+                                  A.col(0) = p1 - p0;
+                                  A.col(1) = p2 - p0;
+                                  A.col(2) = p3 - p0;
+                                  auto D   = A.determinant();
+                                  if(D < 0.0)
+                                  {
+                                      UIPC_WARN_WITH_LOCATION(
+                                          "The determinant of the tetrahedron {} ({},{},{},{}) is non-positive ({}), "
+                                          "which means the tetrahedron is inverted.",
+                                          I,
+                                          t[0],
+                                          t[1],
+                                          t[2],
+                                          t[3],
+                                          D);
+                                  }
+                                  return D / 6.0;
+                              });
 }
 
 static Float compute_trimesh_volume(const SimplicialComplex& R)
@@ -48,20 +47,19 @@ static Float compute_trimesh_volume(const SimplicialComplex& R)
     auto orient      = R.triangles().find<IndexT>(builtin::orient);
     auto orient_view = orient ? orient->view() : span<IndexT>{};
 
-    Float volume = 0.0;
-
-    for(auto&& [I, t] : enumerate(tri_view))
-    {
-        auto [p0, p1, p2] = std::tuple{pos_view[t[0]], pos_view[t[1]], pos_view[t[2]]};
+    return parallel_sum<Float>(tri_view.size(),
+                              [&](SizeT I)
+                              {
+                                  const auto& t = tri_view[I];
+                                  auto [p0, p1, p2] =
+                                      std::tuple{pos_view[t[0]], pos_view[t[1]], pos_view[t[2]]};
 
-        Float orient_factor = 1.0;
-        if(orient_view.size())
-            orient_factor = orient_view[I];
-
-        volume += orient_factor * p0.cross(p1).dot(p2) / 6.0;
-    }
+                                  Float orient_factor = 1.0;
+                                  if(orient_view.size())
+                                      orient_factor = orient_view[I];
 
-    return volume;
+                                  return orient_factor * p0.cross(p1).dot(p2) / 6.0;
+                              });
 }
 
 
@@ -1,11 +1,124 @@
 #include <uipc/geometry/utils/compute_vertex_volume.h>
 #include <uipc/common/enumerate.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/common/parallel_for.h>
 #include <Eigen/Dense>
+#include <algorithm>
+#include <atomic>
 #include <numbers>
 
 namespace uipc::geometry
 {
+namespace detail
+{
+    // simplices/vertices per thread at least, the work per item is tiny
+    constexpr SizeT VolumeGrainSize = 4096;
+    // tets per SoA batch, the batches don't depend on the thread count
+    constexpr SizeT TetBatchSize = 256;
+
+    /**
+     * @brief Compute the signed volumes of the tets.
+     *
+     * Each batch gathers the edge vectors into SoA arrays first, so the determinant loop
+     * runs without indirection and can be vectorized.
+     */
+    static void tet_volumes(span<const Vector3> Vs, span<const Vector4i> Ts, span<Float> volumes)
+    {
+        SizeT batch_count = (Ts.size() + TetBatchSize - 1) / TetBatchSize;
+
+        parallel_for(batch_count,
+                     [&](SizeT b)
+                     {
+                         SizeT begin = b * TetBatchSize;
+                         SizeT N     = std::min(TetBatchSize, Ts.size() - begin);
+
+                         // e[3 * j + c][i]: the c-th component of the j-th edge of the i-th tet
+                         Float e[9][TetBatchSize];
+
+                         for(SizeT i = 0; i < N; ++i)
+                         {
+                             const auto& t  = Ts[begin + i];
+                             const auto& p0 = Vs[t[0]];
+                             for(IndexT j = 0; j < 3; ++j)
+                             {
+                                 const auto& p = Vs[t[j + 1]];
+                                 for(IndexT c = 0; c < 3; ++c)
+                                     e[3 * j + c][i] = p[c] - p0[c];
+                             }
+                         }
+
+                         Float* D = volumes.data() + begin;
+                         for(SizeT i = 0; i < N; ++i)
+                         {
+                             // e1 . (e2 x e3)
+                             Float d = e[0][i] * (e[4][i] * e[8][i] - e[5][i] * e[7][i])
+                                       - e[1][i] * (e[3][i] * e[8][i] - e[5][i] * e[6][i])
+                                       + e[2][i] * (e[3][i] * e[7][i] - e[4][i] * e[6][i]);
+                             D[i] = d / 6.0;
+                         }
+                     });
+    }
+
+    /**
+     * @brief Distribute the simplex volumes evenly to their vertices.
+     *
+     * Each vertex gathers from its incident simplices (a CSR incidence), in the order of the simplex index,
+     * so there is no write conflict and the sums don't depend on the thread count.
+     */
+    template <int K>
+    static void scatter_to_vertices(span<const Eigen::Vector<IndexT, K>> simplices,
+                                    span<const Float>                    simplex_volumes,
+                                    span<Float>                          vertex_volumes)
+    {
+        SizeT N = vertex_volumes.size();
+
+        // 1) count the incident simplices of each vertex
+        vector<IndexT> offsets(N + 1, 0);
+        parallel_for(
+            simplices.size(),
+            [&](SizeT i)
+            {
+                for(IndexT v : simplices[i])
+                    std::atomic_ref<IndexT>{offsets[v + 1]}.fetch_add(1, std::memory_order_relaxed);
+            },
+            VolumeGrainSize);
+
+        for(SizeT v = 0; v < N; ++v)
+            offsets[v + 1] += offsets[v];
+
+        // 2) fill the incidence, the order within a vertex depends on the threads
+        vector<IndexT> cursors(offsets.begin(), offsets.end() - 1);
+        vector<IndexT> incidence(offsets.back());
+        parallel_for(
+            simplices.size(),
+            [&](SizeT i)
+            {
+                for(IndexT v : simplices[i])
+                {
+                    auto slot = std::atomic_ref<IndexT>{cursors[v]}.fetch_add(1, std::memory_order_relaxed);
+                    incidence[slot] = static_cast<IndexT>(i);
+                }
+            },
+            VolumeGrainSize);
+
+        // 3) reduce in the simplex order
+        parallel_for(
+            N,
+            [&](SizeT v)
+            {
+                auto begin = incidence.begin() + offsets[v];
+                auto end   = incidence.begin() + offsets[v + 1];
+                std::sort(begin, end);
+
+                Float volume = 0.0;
+                for(auto it = begin; it != end; ++it)
+                    volume += simplex_volumes[*it] / K;
+                vertex_volumes[v] = volume;
+            },
+            VolumeGrainSize);
+    }
+}  // namespace detail
+
 static S<AttributeSlot<Float>> compute_vertex_volume_from_tet(SimplicialComplex& R)
 {
     vector<Float> tet_volume;
@@ -14,24 +127,18 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tet(SimplicialComplex&
     auto Vs = R.positions().view();
     auto Ts = R.tetrahedra().topo().view();
 
-    std::ranges::transform(Ts,
-                           tet_volume.begin(),
-                           [&](const Vector4i& t) -> Float
-                           {
-                               auto [p0, p1, p2, p3] =
-                                   std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]], Vs[t[3]]};
-
-                               Matrix<Float, 3, 3> A;
-                               A.col(0) = p1 - p0;
-                               A.col(1) = p2 - p0;
-                               A.col(2) = p3 - p0;
-                               auto D   = A.determinant();
-                               UIPC_ASSERT(D > 0.0,
-                                           "The determinant of the tetrahedron is non-positive ({}), which means the tetrahedron is inverted.",
-                                           D);
-                               auto volume = D / 6.0;
-                               return volume;
-                           });
+    detail::tet_volumes(Vs, Ts, tet_volume);
+
+    parallel_for(
+        tet_volume.size(),
+        [&](SizeT i)
+        {
+            UIPC_ASSERT(tet_volume[i] > 0.0,
+                        "The determinant of the tetrahedron[{}] is non-positive ({}), which means the tetrahedron is inverted.",
+                        i,
+                        tet_volume[i] * 6.0);
+        },
+        detail::VolumeGrainSize);
 
     auto volume = R.vertices().find<Float>(builtin::volume);
 
@@ -40,15 +147,7 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tet(SimplicialComplex&
 
     auto volume_view = view(*volume);
 
-    std::ranges::fill(volume_view, 0.0);
-
-    for(auto&& [i, t] : enumerate(Ts))
-    {
-        for(auto&& v : t)
-        {
-            volume_view[v] += tet_volume[i] / 4.0;
-        }
-    }
+    detail::scatter_to_vertices<4>(Ts, tet_volume, volume_view);
 
     return volume;
 }
@@ -63,43 +162,46 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tri(SimplicialComplex&
     auto Vs = R.positions().view();
     auto Ts = R.triangles().topo().view();
 
-    std::ranges::transform(
-        Ts,
-        tri_volume.begin(),
-        [&](const Vector3i& t) -> Float
-        {
-            auto [p0, p1, p2] = std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]]};
+    auto thickness_view = thickness ? thickness->view() : span<const Float>{};
 
-            auto n    = (p1 - p0).cross(p2 - p0);
-            auto area = 0.5 * n.norm();
-            if(thickness)
-            {
-                auto thickness_view = thickness->view();
-                // check if all vertices have the same thickness
-                UIPC_ASSERT(thickness_view[t[0]] == thickness_view[t[1]]
-                                && thickness_view[t[1]] == thickness_view[t[2]],
-                            "The thickness of the triangle ({},{},{}) is not consistent, thickness = ({}, {}, {})",
-                            t[0],
-                            t[1],
-                            t[2],
-                            thickness_view[t[0]],
-                            thickness_view[t[1]],
-                            thickness_view[t[2]]);
-
-                auto r = thickness_view[t[0]];
-
-                if(r == 0.0)  // if the thickness is zero, treat the density as surface density
-                    return area;
-
-                auto h = 2 * r;
-
-                return area * h;
-            }
-            else
-            {
+    auto tri_volume_of = [&](const Vector3i& t) -> Float
+    {
+        auto [p0, p1, p2] = std::tuple{Vs[t[0]], Vs[t[1]], Vs[t[2]]};
+
+        auto n    = (p1 - p0).cross(p2 - p0);
+        auto area = 0.5 * n.norm();
+        if(thickness)
+        {
+            // check if all vertices have the same thickness
+            UIPC_ASSERT(thickness_view[t[0]] == thickness_view[t[1]]
+                            && thickness_view[t[1]] == thickness_view[t[2]],
+                        "The thickness of the triangle ({},{},{}) is not consistent, thickness = ({}, {}, {})",
+                        t[0],
+                        t[1],
+                        t[2],
+                        thickness_view[t[0]],
+                        thickness_view[t[1]],
+                        thickness_view[t[2]]);
+
+            auto r = thickness_view[t[0]];
+
+            if(r == 0.0)  // if the thickness is zero, treat the density as surface density
                 return area;
-            }
-        });
+
+            auto h = 2 * r;
+
+            return area * h;
+        }
+        else
+        {
+            return area;
+        }
+    };
+
+    parallel_for(
+        Ts.size(),
+        [&](SizeT i) { tri_volume[i] = tri_volume_of(Ts[i]); },
+        detail::VolumeGrainSize);
 
 
     auto volume = R.vertices().find<Float>(builtin::volume);
@@ -109,15 +211,7 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_tri(SimplicialComplex&
 
     auto volume_view = view(*volume);
 
-    std::ranges::fill(volume_view, 0.0);
-
-    for(auto&& [i, t] : enumerate(Ts))
-    {
-        for(auto&& v : t)
-        {
-            volume_view[v] += tri_volume[i] / 3.0;
-        }
-    }
+    detail::scatter_to_vertices<3>(Ts, tri_volume, volume_view);
 
     return volume;
 }
@@ -132,37 +226,40 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_edge(SimplicialComplex
     auto Vs = R.positions().view();
     auto Es = R.edges().topo().view();
 
-    std::ranges::transform(
-        Es,
-        edge_volume.begin(),
-        [&](const Vector2i& e) -> Float
+    auto thickness_view = thickness ? thickness->view() : span<const Float>{};
+
+    auto edge_volume_of = [&](const Vector2i& e) -> Float
+    {
+        auto [p0, p1] = std::tuple{Vs[e[0]], Vs[e[1]]};
+
+        auto l = (p1 - p0).norm();
+
+        if(thickness)
         {
-            auto [p0, p1] = std::tuple{Vs[e[0]], Vs[e[1]]};
+            // check if all vertices have the same thickness
+            UIPC_ASSERT(thickness_view[e[0]] == thickness_view[e[1]],
+                        "The thickness of the edge ({},{}) is not consistent, thickness = ({}, {})",
+                        e[0],
+                        e[1],
+                        thickness_view[e[0]],
+                        thickness_view[e[1]]);
 
-            auto l = (p1 - p0).norm();
+            auto r = thickness_view[e[0]];
 
-            if(thickness)
-            {
-                auto thickness_view = thickness->view();
-                // check if all vertices have the same thickness
-                UIPC_ASSERT(thickness_view[e[0]] == thickness_view[e[1]],
-                            "The thickness of the edge ({},{}) is not consistent, thickness = ({}, {})",
-                            e[0],
-                            e[1],
-                            thickness_view[e[0]],
-                            thickness_view[e[1]]);
-
-                auto r = thickness_view[e[0]];
-
-                if(r == 0.0)  // if the thickness is zero, set length as volume
-                    return l;
-
-                auto area = r * r * std::numbers::pi;
-                return l * area;
-            }
-            else
+            if(r == 0.0)  // if the thickness is zero, set length as volume
                 return l;
-        });
+
+            auto area = r * r * std::numbers::pi;
+            return l * area;
+        }
+        else
+            return l;
+    };
+
+    parallel_for(
+        Es.size(),
+        [&](SizeT i) { edge_volume[i] = edge_volume_of(Es[i]); },
+        detail::VolumeGrainSize);
 
     auto volume = R.vertices().find<Float>(builtin::volume);
 
@@ -171,15 +268,7 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_edge(SimplicialComplex
 
     auto volume_view = view(*volume);
 
-    std::ranges::fill(volume_view, 0.0);
-
-    for(auto&& [i, e] : enumerate(Es))
-    {
-        for(auto&& v : e)
-        {
-            volume_view[v] += edge_volume[i] / 2.0;
-        }
-    }
+    detail::scatter_to_vertices<2>(Es, edge_volume, volume_view);
 
     return volume;
 }
@@ -199,20 +288,23 @@ static S<AttributeSlot<Float>> compute_vertex_volume_from_vertex(SimplicialCompl
     if(thickness)
     {
         auto thickness_view = thickness->view();
-        for(auto&& [i, v] : enumerate(Vs))
-        {
-            auto r = thickness_view[i];
-
-            if(r == 0.0)  // if the thickness is zero, set volume to 1
-            {
-                Vm_view[i] = 1.0;
-            }
-            else
+        parallel_for(
+            Vs.size(),
+            [&](SizeT i)
             {
-                auto V     = 4.0 / 3.0 * std::pow(r, 3) * std::numbers::pi;
-                Vm_view[i] = V;
-            }
-        }
+                auto r = thickness_view[i];
+
+                if(r == 0.0)  // if the thickness is zero, set volume to 1
+                {
+                    Vm_view[i] = 1.0;
+                }
+                else
+                {
+                    auto V     = 4.0 / 3.0 * std::pow(r, 3) * std::numbers::pi;
+                    Vm_view[i] = V;
+                }
+            },
+            detail::VolumeGrainSize);
     }
     else
     {
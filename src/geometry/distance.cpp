@@ -1,6 +1,7 @@
 #include <uipc/geometry/utils/distance.h>
 #include <uipc/common/log.h>
 #include <Eigen/Dense>
+#include <algorithm>
 
 namespace uipc::geometry
 {
@@ -554,6 +555,35 @@ Float halfplane_vertex_signed_distance(const Vector3& P, const Vector3& N, const
     return (V - P).dot(N) - V_thickness;
 }
 
+Float sphere_vertex_signed_distance(const Vector3& P, Float radius, const Vector3& V, Float V_thickness)
+{
+    return (V - P).norm() - radius - V_thickness;
+}
+
+Float capsule_vertex_signed_distance(
+    const Vector3& P0, const Vector3& P1, Float radius, const Vector3& V, Float V_thickness)
+{
+    Vector3 E  = P1 - P0;
+    Float   E2 = E.squaredNorm();
+    Float   t  = E2 > 0 ? std::clamp((V - P0).dot(E) / E2, 0.0, 1.0) : 0.0;
+    return (V - (P0 + t * E)).norm() - radius - V_thickness;
+}
+
+Float box_vertex_signed_distance(const Matrix4x4& T,
+                                 const Vector3&   half_extent,
+                                 const Vector3&   V,
+                                 Float            V_thickness)
+{
+    // rigid transform, the inverse rotation is the transpose
+    Matrix3x3 R = T.block<3, 3>(0, 0);
+    Vector3   q = R.transpose() * (V - T.block<3, 1>(0, 3));
+    Vector3   d = q.cwiseAbs() - half_extent;
+
+    Float outside = d.cwiseMax(0.0).norm();
+    Float inside  = std::min(d.maxCoeff(), 0.0);
+    return outside + inside - V_thickness;
+}
+
 Float point_point_squared_distance(const Vector3& a, const Vector3& b)
 {
     Float dist2;
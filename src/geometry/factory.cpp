@@ -1,6 +1,8 @@
 #include <uipc/geometry/utils/factory.h>
 #include <uipc/builtin/attribute_name.h>
 #include <uipc/geometry/utils/closure.h>
+#include <sdf_grid_bricks.h>
+#include <algorithm>
 namespace uipc::geometry
 {
 namespace detail
@@ -90,4 +92,162 @@ ImplicitGeometry ground(Float height, const Vector3& N)
     ImplicitGeometry hp = halfplane(Vector3::UnitY() * height, N);
     return hp;
 }
+
+ImplicitGeometry sphere(const Vector3& P, Float radius)
+{
+    UIPC_ASSERT(radius > 0, "Radius of a sphere must be positive, yours {}", radius);
+
+    ImplicitGeometry ig;
+    auto             uid = ig.meta().find<U64>(builtin::implicit_geometry_uid);
+
+    // By libuipc specification: sphere has UID 2
+    constexpr auto SphereUID = 2ull;
+    view(*uid)[0]            = SphereUID;
+
+    ig.instances().create<Vector3>("P", P);
+    ig.instances().create<Float>("radius", radius);
+    ig.instances().create<IndexT>(builtin::is_fixed, 1);
+
+    return ig;
+}
+
+ImplicitGeometry capsule(const Vector3& P0, const Vector3& P1, Float radius)
+{
+    UIPC_ASSERT(radius > 0, "Radius of a capsule must be positive, yours {}", radius);
+
+    ImplicitGeometry ig;
+    auto             uid = ig.meta().find<U64>(builtin::implicit_geometry_uid);
+
+    // By libuipc specification: capsule has UID 3
+    constexpr auto CapsuleUID = 3ull;
+    view(*uid)[0]             = CapsuleUID;
+
+    ig.instances().create<Vector3>("P0", P0);
+    ig.instances().create<Vector3>("P1", P1);
+    ig.instances().create<Float>("radius", radius);
+    ig.instances().create<IndexT>(builtin::is_fixed, 1);
+
+    return ig;
+}
+
+ImplicitGeometry box(const Vector3& half_extent, const Matrix4x4& transform)
+{
+    UIPC_ASSERT((half_extent.array() > 0).all(),
+                "Half extent of a box must be positive, yours [{} {} {}]",
+                half_extent.x(),
+                half_extent.y(),
+                half_extent.z());
+
+    ImplicitGeometry ig;
+    auto             uid = ig.meta().find<U64>(builtin::implicit_geometry_uid);
+
+    // By libuipc specification: box has UID 4
+    constexpr auto BoxUID = 4ull;
+    view(*uid)[0]         = BoxUID;
+
+    ig.instances().create<Vector3>("half_extent", half_extent);
+    ig.instances().create<Matrix4x4>(builtin::transform, transform);
+    ig.instances().create<IndexT>(builtin::is_fixed, 1);
+
+    return ig;
+}
+
+ImplicitGeometry sdf_grid(const Vector3&    origin,
+                          Float             spacing,
+                          const Vector3i&   resolution,
+                          span<const Float> values,
+                          Float             narrow_band,
+                          const Matrix4x4&  transform)
+{
+    UIPC_ASSERT(values.size() == resolution.cast<SizeT>().prod(),
+                "SDF grid value count mismatch, resolution [{} {} {}] needs {}, yours {}",
+                resolution.x(),
+                resolution.y(),
+                resolution.z(),
+                resolution.cast<SizeT>().prod(),
+                values.size());
+
+    // keep only the bricks touching the narrow band
+    detail::SDFGridBricks layout{resolution, detail::SDFGridBricks::DefaultBrickSize};
+    const auto&           BR = layout.brick_resolution();
+    IndexT                B  = layout.brick_size();
+
+    VectorXi      bricks(layout.brick_count());
+    vector<Float> stored;
+    vector<Float> brick_values(layout.brick_volume());
+    for(IndexT bk = 0; bk < BR[2]; ++bk)
+        for(IndexT bj = 0; bj < BR[1]; ++bj)
+            for(IndexT bi = 0; bi < BR[0]; ++bi)
+            {
+                bool all_outside = true;
+                bool all_inside  = true;
+                // the points past the end of the grid are never read, fill them with the band
+                std::ranges::fill(brick_values, narrow_band);
+                for(IndexT k = bk * B; k < std::min((bk + 1) * B, resolution[2]); ++k)
+                    for(IndexT j = bj * B; j < std::min((bj + 1) * B, resolution[1]); ++j)
+                        for(IndexT i = bi * B; i < std::min((bi + 1) * B, resolution[0]); ++i)
+                        {
+                            Float v = values[i + resolution[0] * (j + static_cast<SizeT>(resolution[1]) * k)];
+                            brick_values[layout.locate(i, j, k).second] = v;
+                            all_outside &= v >= narrow_band;
+                            all_inside &= v <= -narrow_band;
+                        }
+
+                auto brick = layout.brick_index(bi, bj, bk);
+                if(all_outside)
+                    bricks[brick] = detail::SDFGridBricks::OutsideBrick;
+                else if(all_inside)
+                    bricks[brick] = detail::SDFGridBricks::InsideBrick;
+                else
+                {
+                    bricks[brick] = static_cast<IndexT>(stored.size() / brick_values.size());
+                    stored.insert(stored.end(), brick_values.begin(), brick_values.end());
+                }
+            }
+
+    VectorX V = Eigen::Map<const VectorX>(stored.data(), stored.size());
+    return detail::create_sdf_grid(origin, spacing, resolution, narrow_band, B, bricks, V, transform);
+}
+
+namespace detail
+{
+    ImplicitGeometry create_sdf_grid(const Vector3&   origin,
+                                     Float            spacing,
+                                     const Vector3i&  resolution,
+                                     Float            narrow_band,
+                                     IndexT           brick_size,
+                                     const VectorXi&  bricks,
+                                     const VectorX&   values,
+                                     const Matrix4x4& transform)
+    {
+        UIPC_ASSERT(spacing > 0, "Spacing of a SDF grid must be positive, yours {}", spacing);
+        UIPC_ASSERT((resolution.array() >= 1).all(),
+                    "Resolution of a SDF grid must be at least 1 along each axis, yours [{} {} {}]",
+                    resolution.x(),
+                    resolution.y(),
+                    resolution.z());
+        UIPC_ASSERT(narrow_band > 0, "Narrow band of a SDF grid must be positive, yours {}", narrow_band);
+
+        ImplicitGeometry ig;
+        auto             uid = ig.meta().find<U64>(builtin::implicit_geometry_uid);
+
+        // By libuipc specification: SDF grid has UID 5
+        constexpr auto SDFGridUID = 5ull;
+        view(*uid)[0]             = SDFGridUID;
+
+        // the grid is shared by all the instances
+        ig.meta().create<Vector3>("origin", origin);
+        ig.meta().create<Float>("spacing", spacing);
+        ig.meta().create<Vector3i>("resolution", resolution);
+        ig.meta().create<Float>("narrow_band", narrow_band);
+        ig.meta().create<IndexT>("brick_size", brick_size);
+        ig.meta().create<VectorXi>("bricks", bricks);
+        ig.meta().create<VectorX>("values", values);
+
+        ig.instances().create<Matrix4x4>(builtin::transform, transform);
+        ig.instances().create<IndexT>(builtin::is_fixed, 1);
+
+        return ig;
+    }
+}  // namespace detail
 }  // namespace uipc::geometry
@@ -0,0 +1,320 @@
+#include <uipc/geometry/utils/implicit_geometry_distance.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/log.h>
+#include <sdf_grid_bricks.h>
+#include <Eigen/Dense>
+#include <algorithm>
+
+namespace uipc::geometry
+{
+namespace detail
+{
+    // By libuipc specification, see src/geometry/implicit_geometries
+    constexpr U64 HalfPlaneUID = 1;
+    constexpr U64 SphereUID    = 2;
+    constexpr U64 CapsuleUID   = 3;
+    constexpr U64 BoxUID       = 4;
+    constexpr U64 SDFGridUID   = 5;
+
+    // vertices are cheap to query, don't spawn a thread for a few of them
+    constexpr SizeT VertexGrainSize = 1024;
+
+    static U64 uid_of(const ImplicitGeometry& ig)
+    {
+        auto uid = ig.meta().find<U64>(builtin::implicit_geometry_uid);
+        UIPC_ASSERT(uid, "ImplicitGeometryUID not found, why can it happen?");
+        return uid->view()[0];
+    }
+
+    template <typename T>
+    static const T& instance_value(const ImplicitGeometry& ig, std::string_view name, IndexT I)
+    {
+        auto attr = ig.instances().find<T>(name);
+        UIPC_ASSERT(attr, "Attribute `{}` not found in {}", name, ig.name());
+        return attr->view()[I];
+    }
+
+    template <typename T>
+    static const T& meta_value(const ImplicitGeometry& ig, std::string_view name)
+    {
+        auto attr = ig.meta().find<T>(name);
+        UIPC_ASSERT(attr, "Attribute `{}` not found in {}", name, ig.name());
+        return attr->view()[0];
+    }
+
+    static Vector3 safe_normalized(const Vector3& v, const Vector3& fallback)
+    {
+        Float n = v.norm();
+        return n > 0 ? Vector3{v / n} : fallback;
+    }
+
+    // the signed distance to a box centered at the origin, in the local frame of the box
+    static Float box_local_distance(const Vector3& half_extent, const Vector3& q, Vector3& grad)
+    {
+        Vector3 d = q.cwiseAbs() - half_extent;
+        Vector3 s = q.cwiseSign();
+        s         = (s.array() == 0).select(1.0, s);  // on a symmetry plane, pick a side
+
+        Vector3 outside = d.cwiseMax(0.0);
+        Float   o       = outside.norm();
+        if(o > 0)
+        {
+            grad = outside.cwiseProduct(s) / o;
+            return o;
+        }
+
+        // inside: the closest face is the one with the largest d
+        IndexT axis;
+        Float  inside = d.maxCoeff(&axis);
+        grad          = Vector3::Zero();
+        grad[axis]    = s[axis];
+        return inside;
+    }
+
+    class SDFGridQuery
+    {
+      public:
+        SDFGridQuery(const ImplicitGeometry& ig, IndexT I)
+            : origin(meta_value<Vector3>(ig, "origin"))
+            , spacing(meta_value<Float>(ig, "spacing"))
+            , narrow_band(meta_value<Float>(ig, "narrow_band"))
+            , bricks(meta_value<VectorXi>(ig, "bricks"))
+            , values(meta_value<VectorX>(ig, "values"))
+            , layout(meta_value<Vector3i>(ig, "resolution"), meta_value<IndexT>(ig, "brick_size"))
+        {
+            UIPC_ASSERT(bricks.size() == layout.brick_count(),
+                        "SDF grid brick count mismatch, resolution [{} {} {}] needs {}, yours {}",
+                        layout.resolution().x(),
+                        layout.resolution().y(),
+                        layout.resolution().z(),
+                        layout.brick_count(),
+                        bricks.size());
+
+            const Matrix4x4& T = instance_value<Matrix4x4>(ig, builtin::transform, I);
+            A                  = T.block<3, 3>(0, 0);
+            t                  = T.block<3, 1>(0, 3);
+            A_inv              = A.inverse();
+        }
+
+        Float value(IndexT i, IndexT j, IndexT k) const
+        {
+            return layout.value(bricks, values, narrow_band, i, j, k);
+        }
+
+        Float distance(const Vector3& x, Vector3& grad) const
+        {
+            const Vector3i& resolution = layout.resolution();
+
+            Vector3 q = A_inv * (x - t);
+
+            Vector3 lo = origin;
+            Vector3 hi = origin + spacing * (resolution - Vector3i::Ones()).cast<Float>();
+            Vector3 c  = q.cwiseMax(lo).cwiseMin(hi);
+
+            // trilinear interpolation in the cell containing c,
+            // an axis with a single grid point is constant along it
+            Vector3  g = (c - origin) / spacing;
+            Vector3i i0;
+            Vector3i i1;
+            Vector3  f;
+            for(IndexT a = 0; a < 3; ++a)
+            {
+                i0[a] = std::clamp(static_cast<IndexT>(std::floor(g[a])), 0, std::max(resolution[a] - 2, 0));
+                i1[a] = std::min(i0[a] + 1, resolution[a] - 1);
+                f[a]  = i1[a] > i0[a] ? g[a] - i0[a] : 0.0;
+            }
+
+            Float v[2][2][2];
+            for(IndexT dk = 0; dk < 2; ++dk)
+                for(IndexT dj = 0; dj < 2; ++dj)
+                    for(IndexT di = 0; di < 2; ++di)
+                        v[di][dj][dk] = value(di ? i1[0] : i0[0], dj ? i1[1] : i0[1], dk ? i1[2] : i0[2]);
+
+            auto lerp = [](Float a, Float b, Float t) { return a + t * (b - a); };
+
+            Float v00 = lerp(v[0][0][0], v[1][0][0], f[0]);
+            Float v10 = lerp(v[0][1][0], v[1][1][0], f[0]);
+            Float v01 = lerp(v[0][0][1], v[1][0][1], f[0]);
+            Float v11 = lerp(v[0][1][1], v[1][1][1], f[0]);
+            Float v0  = lerp(v00, v10, f[1]);
+            Float v1  = lerp(v01, v11, f[1]);
+            Float d   = lerp(v0, v1, f[2]);
+
+            Vector3 local_grad;
+            local_grad[0] = lerp(lerp(v[1][0][0] - v[0][0][0], v[1][1][0] - v[0][1][0], f[1]),
+                                 lerp(v[1][0][1] - v[0][0][1], v[1][1][1] - v[0][1][1], f[1]),
+                                 f[2]);
+            local_grad[1] = lerp(v10 - v00, v11 - v01, f[2]);
+            local_grad[2] = v1 - v0;
+            local_grad /= spacing;
+
+            // outside of the grid, extrapolate with the distance to the grid
+            Vector3 outside = q - c;
+            Float   o       = outside.norm();
+            if(o > 0)
+            {
+                d += o;
+                local_grad = outside / o;
+            }
+
+            // the distance is measured in the grid frame, map it to the world with the
+            // stretch of the transform along the gradient (the scale for a uniform scaling)
+            Vector3 world_grad = A_inv.transpose() * local_grad;
+            Float   local_norm = local_grad.norm();
+            Float   world_norm = world_grad.norm();
+            if(local_norm > 0 && world_norm > 0)
+            {
+                d *= local_norm / world_norm;
+                grad = world_grad / world_norm;
+            }
+            else
+            {
+                // flat region, e.g. deep inside, only the scale of the transform is known
+                d *= std::cbrt(std::abs(A.determinant()));
+                grad = Vector3::UnitY();
+            }
+            return d;
+        }
+
+      private:
+        const Vector3&  origin;
+        Float           spacing;
+        Float           narrow_band;
+        const VectorXi& bricks;
+        const VectorX&  values;
+        SDFGridBricks   layout;
+        Matrix3x3       A;
+        Matrix3x3       A_inv;
+        Vector3         t;
+    };
+
+    template <typename F>
+    static void for_each_vertex(span<const Vector3> Vs,
+                                span<Float>         distances,
+                                span<Vector3>       gradients,
+                                F&&                 f)
+    {
+        parallel_for(
+            Vs.size(),
+            [&](SizeT i)
+            {
+                Vector3 grad;
+                distances[i] = f(Vs[i], grad);
+                if(!gradients.empty())
+                    gradients[i] = grad;
+            },
+            VertexGrainSize);
+    }
+}  // namespace detail
+
+bool is_implicit_geometry_distance_supported(const ImplicitGeometry& ig)
+{
+    auto uid = detail::uid_of(ig);
+    return uid >= detail::HalfPlaneUID && uid <= detail::SDFGridUID;
+}
+
+void implicit_geometry_signed_distance(const ImplicitGeometry& ig,
+                                       IndexT                  instance_id,
+                                       span<const Vector3>     Vs,
+                                       span<Float>             distances,
+                                       span<Vector3>           gradients)
+{
+    using namespace detail;
+
+    UIPC_ASSERT(instance_id >= 0 && instance_id < ig.instances().size(),
+                "Instance id {} out of range [0, {})",
+                instance_id,
+                ig.instances().size());
+    UIPC_ASSERT(distances.size() == Vs.size(),
+                "Distance count mismatch, expected {}, yours {}",
+                Vs.size(),
+                distances.size());
+    UIPC_ASSERT(gradients.empty() || gradients.size() == Vs.size(),
+                "Gradient count mismatch, expected {} or 0, yours {}",
+                Vs.size(),
+                gradients.size());
+
+    auto I = instance_id;
+
+    switch(uid_of(ig))
+    {
+        case HalfPlaneUID: {
+            const Vector3& P = instance_value<Vector3>(ig, "P", I);
+            const Vector3& N = instance_value<Vector3>(ig, "N", I);
+            for_each_vertex(Vs,
+                            distances,
+                            gradients,
+                            [&](const Vector3& V, Vector3& grad)
+                            {
+                                grad = N;
+                                return (V - P).dot(N);
+                            });
+        }
+        break;
+        case SphereUID: {
+            const Vector3& P = instance_value<Vector3>(ig, "P", I);
+            Float          R = instance_value<Float>(ig, "radius", I);
+            for_each_vertex(Vs,
+                            distances,
+                            gradients,
+                            [&](const Vector3& V, Vector3& grad)
+                            {
+                                grad = safe_normalized(V - P, Vector3::UnitY());
+                                return (V - P).norm() - R;
+                            });
+        }
+        break;
+        case CapsuleUID: {
+            const Vector3& P0 = instance_value<Vector3>(ig, "P0", I);
+            const Vector3& P1 = instance_value<Vector3>(ig, "P1", I);
+            Float          R  = instance_value<Float>(ig, "radius", I);
+            Vector3        E  = P1 - P0;
+            Float          E2 = E.squaredNorm();
+            for_each_vertex(Vs,
+                            distances,
+                            gradients,
+                            [&](const Vector3& V, Vector3& grad)
+                            {
+                                Float t = E2 > 0 ? std::clamp((V - P0).dot(E) / E2, 0.0, 1.0) : 0.0;
+                                Vector3 D = V - (P0 + t * E);
+                                grad = safe_normalized(D, Vector3::UnitY());
+                                return D.norm() - R;
+                            });
+        }
+        break;
+        case BoxUID: {
+            const Vector3&   H = instance_value<Vector3>(ig, "half_extent", I);
+            const Matrix4x4& T = instance_value<Matrix4x4>(ig, builtin::transform, I);
+            // rigid transform, the inverse rotation is the transpose
+            Matrix3x3 R = T.block<3, 3>(0, 0);
+            Vector3   t = T.block<3, 1>(0, 3);
+            for_each_vertex(Vs,
+                            distances,
+                            gradients,
+                            [&](const Vector3& V, Vector3& grad)
+                            {
+                                Vector3 local_grad;
+                                Float   d = box_local_distance(H, R.transpose() * (V - t), local_grad);
+                                grad = R * local_grad;
+                                return d;
+                            });
+        }
+        break;
+        case SDFGridUID: {
+            SDFGridQuery query{ig, I};
+            for_each_vertex(Vs,
+                            distances,
+                            gradients,
+                            [&](const Vector3& V, Vector3& grad)
+                            { return query.distance(V, grad); });
+        }
+        break;
+        default:
+            UIPC_ASSERT(false,
+                        "Signed distance query is not supported for implicit geometry {}, supported: HalfPlane, Sphere, Capsule, Box, SDFGrid",
+                        ig.name());
+            break;
+    }
+}
+}  // namespace uipc::geometry
@@ -1,44 +1,133 @@
 #include <uipc/geometry/utils/label_connected_vertices.h>
 #include <uipc/common/enumerate.h>
-#include <igl/connected_components.h>
+#include <uipc/common/parallel_for.h>
+#include <atomic>
 
 namespace uipc::geometry
 {
+namespace detail
+{
+    // union/find is a few atomic ops, don't spawn a thread for a few of them
+    constexpr SizeT UnionFindGrainSize = 4096;
+
+    /**
+     * @brief Lock-free union-find.
+     *
+     * A root is always linked under a smaller root, so the root of a component is its smallest vertex,
+     * no matter how the threads interleave.
+     */
+    class ConcurrentUnionFind
+    {
+      public:
+        ConcurrentUnionFind(SizeT N)
+            : m_parent(N)
+        {
+            parallel_for(
+                N,
+                [&](SizeT i)
+                { m_parent[i].store(static_cast<IndexT>(i), std::memory_order_relaxed); },
+                UnionFindGrainSize);
+        }
+
+        IndexT find(IndexT i)
+        {
+            while(true)
+            {
+                IndexT p = m_parent[i].load(std::memory_order_acquire);
+                if(p == i)
+                    return i;
+
+                IndexT gp = m_parent[p].load(std::memory_order_acquire);
+                // path halving, a failed CAS only means another thread has shortened the path
+                if(p != gp)
+                    m_parent[i].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+                i = gp;
+            }
+        }
+
+        void unite(IndexT a, IndexT b)
+        {
+            while(true)
+            {
+                a = find(a);
+                b = find(b);
+                if(a == b)
+                    return;
+                if(a < b)
+                    std::swap(a, b);
+
+                // link the larger root `a` under `b`, retry if `a` is no longer a root
+                IndexT expected = a;
+                if(m_parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+                    return;
+            }
+        }
+
+      private:
+        vector<std::atomic<IndexT>> m_parent;
+    };
+
+    template <IndexT N>
+    static void unite_simplices(ConcurrentUnionFind&                     uf,
+                                span<const Eigen::Vector<IndexT, N + 1>> simplices)
+    {
+        parallel_for(
+            simplices.size(),
+            [&](SizeT i)
+            {
+                const auto& s = simplices[i];
+                if constexpr(N == 1)
+                {
+                    UIPC_ASSERT(s[0] != s[1], "Self-loop is not allowed. In edge[{}] = ({},{})", i, s[0], s[1]);
+                }
+                for(IndexT j = 1; j <= N; ++j)
+                    uf.unite(s[0], s[j]);
+            },
+            UnionFindGrainSize);
+    }
+}  // namespace detail
+
 S<AttributeSlot<IndexT>> label_connected_vertices(SimplicialComplex& complex)
 {
-    IndexT N_vert = complex.vertices().size();
+    SizeT N_vert = complex.vertices().size();
 
     auto region = complex.vertices().find<IndexT>("region");
     if(!region)
         region = complex.vertices().create<IndexT>("region");
     auto region_view = view(*region);
 
-    std::vector<Eigen::Triplet<IndexT>> triplets{complex.edges().size() * 2};
-    auto edge_view = complex.edges().topo().view();
-
-    for(auto [i, edge] : enumerate(edge_view))
-    {
-        UIPC_ASSERT(edge[0] != edge[1],
-                    "Self-loop is not allowed. In edge[{}] = ({},{})",
-                    i,
-                    edge[0],
-                    edge[1]);
-
-        triplets[i * 2]     = {edge[0], edge[1], 1};
-        triplets[i * 2 + 1] = {edge[1], edge[0], 1};
-    }
+    detail::ConcurrentUnionFind uf{N_vert};
 
-    Eigen::SparseMatrix<IndexT> adjacency_matrix{N_vert, N_vert};
-    adjacency_matrix.setFromTriplets(triplets.begin(), triplets.end());
+    // edges are enough to connect the vertices, the higher dimension simplices
+    // are only needed if the complex doesn't have the edges
+    if(complex.edges().size() > 0)
+        detail::unite_simplices<1>(uf, complex.edges().topo().view());
+    else if(complex.tetrahedra().size() > 0)
+        detail::unite_simplices<3>(uf, complex.tetrahedra().topo().view());
+    else if(complex.triangles().size() > 0)
+        detail::unite_simplices<2>(uf, complex.triangles().topo().view());
 
-    Eigen::VectorXi C;
-    Eigen::VectorXi K;
+    // resolve the roots, the root of a region is its smallest vertex
+    vector<IndexT> roots(N_vert);
+    parallel_for(
+        N_vert,
+        [&](SizeT i) { roots[i] = uf.find(static_cast<IndexT>(i)); },
+        detail::UnionFindGrainSize);
 
-    auto N_region = igl::connected_components(adjacency_matrix, C, K);
+    // number the regions in the order of their smallest vertex
+    vector<IndexT> root_region(N_vert, -1);
+    IndexT         N_region = 0;
+    for(auto&& [i, root] : enumerate(roots))
+    {
+        if(root == static_cast<IndexT>(i))
+            root_region[i] = N_region++;
+    }
 
     // fill the region attribute
-    for(auto&& [i, r] : enumerate(region_view))
-        r = C[i];
+    parallel_for(
+        N_vert,
+        [&](SizeT i) { region_view[i] = root_region[roots[i]]; },
+        detail::UnionFindGrainSize);
 
     auto region_count = complex.meta().find<IndexT>("region_count");
     if(!region_count)
@@ -1,8 +1,54 @@
 #include <uipc/geometry/utils/label_region.h>
 #include <uipc/geometry/utils/label_connected_vertices.h>
+#include <uipc/common/parallel_for.h>
+#include <fmt/ranges.h>
 
 namespace uipc::geometry
 {
+// a region lookup per simplex is cheap, don't spawn a thread for a few of them
+constexpr SizeT RegionGrainSize = 4096;
+
+template <IndexT N>
+static void fill_simplex_region(SimplicialComplexAttributes<false, N> simplices,
+                                span<const IndexT>                    vert_region_view,
+                                std::string_view                      simplex_name)
+{
+    auto region = simplices.template find<IndexT>("region");
+    if(!region)
+        region = simplices.template create<IndexT>("region");
+
+    auto region_view = view(*region);
+    auto topo_view   = simplices.topo().view();
+
+    parallel_for(
+        topo_view.size(),
+        [&](SizeT i)
+        {
+            const auto& simplex = topo_view[i];
+            IndexT      r       = vert_region_view[simplex[0]];
+
+            for(IndexT j = 1; j <= N; ++j)
+            {
+                if(vert_region_view[simplex[j]] == r)
+                    continue;
+
+                std::array<IndexT, N + 1> vert_regions;
+                for(IndexT k = 0; k <= N; ++k)
+                    vert_regions[k] = vert_region_view[simplex[k]];
+
+                UIPC_ASSERT(false,
+                            "In the {}[{}] = ({}), vertices are not in the same region -> ({}), which is ill condition.",
+                            simplex_name,
+                            i,
+                            fmt::join(simplex.begin(), simplex.end(), ","),
+                            fmt::join(vert_regions, ","));
+            }
+
+            region_view[i] = r;
+        },
+        RegionGrainSize);
+}
+
 void label_region(SimplicialComplex& complex)
 {
     // 1) find the region of each vertex
@@ -16,83 +62,14 @@ void label_region(SimplicialComplex& complex)
 
     // 2) fill the region of each edge
     if(Dim >= 1)
-    {
-        auto edge_region = complex.edges().find<IndexT>("region");
-        if(!edge_region)
-            edge_region = complex.edges().create<IndexT>("region");
-
-        auto edge_region_view = view(*edge_region);
-        auto edge_view        = complex.edges().topo().view();
-
-        for(auto [i, edge] : enumerate(edge_view))
-        {
-            UIPC_ASSERT(vert_region_view[edge[0]] == vert_region_view[edge[1]],
-                        "In the edge[{}] = ({},{}), vertices are not in the same region -> ({},{}), which is ill condition.",
-                        i,
-                        edge[0],
-                        edge[1],
-                        vert_region_view[edge[0]],
-                        vert_region_view[edge[1]]);
-
-            edge_region_view[i] = vert_region_view[edge[0]];
-        }
-    }
+        fill_simplex_region(complex.edges(), vert_region_view, "edge");
 
     // 3) fill the region of each triangle
     if(Dim >= 2)
-    {
-        auto tri_region = complex.triangles().find<IndexT>("region");
-        if(!tri_region)
-            tri_region = complex.triangles().create<IndexT>("region");
-
-        auto tri_region_view = view(*tri_region);
-        auto tri_view        = complex.triangles().topo().view();
-
-        for(auto [i, tri] : enumerate(tri_view))
-        {
-            UIPC_ASSERT(vert_region_view[tri[0]] == vert_region_view[tri[1]]
-                            && vert_region_view[tri[1]] == vert_region_view[tri[2]],
-                        "In the triangle[{}] = ({},{},{}), vertices are not in the same region -> ({},{},{}), which is ill condition.",
-                        i,
-                        tri[0],
-                        tri[1],
-                        tri[2],
-                        vert_region_view[tri[0]],
-                        vert_region_view[tri[1]],
-                        vert_region_view[tri[2]]);
-
-            tri_region_view[i] = vert_region_view[tri[0]];
-        }
-    }
+        fill_simplex_region(complex.triangles(), vert_region_view, "triangle");
 
     // 4) fill the region of each tetrahedron
     if(Dim >= 3)
-    {
-        auto tet_region = complex.tetrahedra().find<IndexT>("region");
-        if(!tet_region)
-            tet_region = complex.tetrahedra().create<IndexT>("region");
-
-        auto tet_region_view = view(*tet_region);
-        auto tet_view        = complex.tetrahedra().topo().view();
-
-        for(auto [i, tet] : enumerate(tet_view))
-        {
-            UIPC_ASSERT(vert_region_view[tet[0]] == vert_region_view[tet[1]]
-                            && vert_region_view[tet[1]] == vert_region_view[tet[2]]
-                            && vert_region_view[tet[2]] == vert_region_view[tet[3]],
-                        "In the tetrahedron[{}] = ({},{},{},{}), vertices are not in the same region -> ({},{},{},{}), which is ill condition.",
-                        i,
-                        tet[0],
-                        tet[1],
-                        tet[2],
-                        tet[3],
-                        vert_region_view[tet[0]],
-                        vert_region_view[tet[1]],
-                        vert_region_view[tet[2]],
-                        vert_region_view[tet[3]]);
-
-            tet_region_view[i] = vert_region_view[tet[0]];
-        }
-    }
+        fill_simplex_region(complex.tetrahedra(), vert_region_view, "tetrahedron");
 }
 }  // namespace uipc::geometry
@@ -0,0 +1,86 @@
+#pragma once
+#include <uipc/common/type_define.h>
+#include <uipc/geometry/implicit_geometry.h>
+
+namespace uipc::geometry::detail
+{
+/**
+ * @brief The narrow-band storage of a SDFGrid, see docs/specification/implicit_geometries/sdf_grid.md.
+ *
+ * The grid points are grouped into cubic bricks of `brick_size^3` points. Only the bricks touching
+ * the narrow band store their values, the others are entirely inside or outside.
+ */
+class SDFGridBricks
+{
+  public:
+    static constexpr IndexT DefaultBrickSize = 8;
+    static constexpr IndexT OutsideBrick     = -1;
+    static constexpr IndexT InsideBrick      = -2;
+
+    SDFGridBricks(const Vector3i& resolution, IndexT brick_size) noexcept
+        : m_resolution(resolution)
+        , m_brick_size(brick_size)
+    {
+        for(IndexT a = 0; a < 3; ++a)
+            m_brick_resolution[a] = (resolution[a] + brick_size - 1) / brick_size;
+    }
+
+    const Vector3i& resolution() const noexcept { return m_resolution; }
+    const Vector3i& brick_resolution() const noexcept
+    {
+        return m_brick_resolution;
+    }
+    IndexT brick_size() const noexcept { return m_brick_size; }
+
+    SizeT brick_count() const noexcept
+    {
+        return m_brick_resolution.cast<SizeT>().prod();
+    }
+
+    SizeT brick_volume() const noexcept
+    {
+        return static_cast<SizeT>(m_brick_size) * m_brick_size * m_brick_size;
+    }
+
+    SizeT brick_index(IndexT bi, IndexT bj, IndexT bk) const noexcept
+    {
+        return bi + m_brick_resolution[0] * (bj + static_cast<SizeT>(m_brick_resolution[1]) * bk);
+    }
+
+    // the brick of grid point (i, j, k) and the offset of the point in it
+    std::pair<SizeT, SizeT> locate(IndexT i, IndexT j, IndexT k) const noexcept
+    {
+        IndexT B = m_brick_size;
+        SizeT  offset = i % B + B * (j % B + static_cast<SizeT>(B) * (k % B));
+        return {brick_index(i / B, j / B, k / B), offset};
+    }
+
+    Float value(const VectorXi& bricks, const VectorX& values, Float narrow_band, IndexT i, IndexT j, IndexT k) const noexcept
+    {
+        auto [brick, offset] = locate(i, j, k);
+        IndexT slot          = bricks[brick];
+        if(slot == OutsideBrick)
+            return narrow_band;
+        if(slot == InsideBrick)
+            return -narrow_band;
+        return values[slot * brick_volume() + offset];
+    }
+
+  private:
+    Vector3i m_resolution;
+    Vector3i m_brick_resolution;
+    IndexT   m_brick_size;
+};
+
+/**
+ * @brief Create a SDFGrid implicit geometry from its narrow-band storage.
+ */
+ImplicitGeometry create_sdf_grid(const Vector3&   origin,
+                                 Float            spacing,
+                                 const Vector3i&  resolution,
+                                 Float            narrow_band,
+                                 IndexT           brick_size,
+                                 const VectorXi&  bricks,
+                                 const VectorX&   values,
+                                 const Matrix4x4& transform);
+}  // namespace uipc::geometry::detail
@@ -0,0 +1,307 @@
+#include <uipc/io/geometry_asset_cache.h>
+#include <uipc/io/simplicial_complex_io.h>
+#include <uipc/geometry/geometry_atlas.h>
+#include <uipc/common/format.h>
+#include <uipc/common/log.h>
+#include <uipc/common/content_hash.h>
+#include <Eigen/Geometry>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace uipc::geometry
+{
+namespace fs = std::filesystem;
+
+/*
+ * Cache Entry File (<key>.uipcgeo)
+ *
+ * [8 bytes]  magic "UIPCGEO1"
+ * [8 bytes]  u64 size of the BSON payload
+ * [size]     BSON payload:
+ * {
+ *     "key": "<key>",
+ *     "source": "<source file name, for debugging only>",
+ *     "geometry_atlas": { ... } // GeometryAtlas::to_json(), the asset is geometry 0
+ * }
+ *
+ * Source Stamp File (<hash of the absolute source path>.uipcsrc)
+ *
+ * {
+ *     "path": "<absolute source path>",
+ *     "size": <file size in bytes>,
+ *     "mtime": <last write time, in ticks of the file clock>,
+ *     "hash": <content hash of the source>
+ * }
+ *
+ * The content of a source is only hashed again when its size or last write time changes.
+ */
+
+namespace detail
+{
+    constexpr std::string_view AssetCacheMagic = "UIPCGEO1";
+    constexpr std::string_view AssetCacheExt   = ".uipcgeo";
+    constexpr std::string_view SourceStampExt  = ".uipcsrc";
+    // bump this when the entry layout or the serialization of SimplicialComplex changes
+    constexpr U64 AssetCacheVersion = 2;
+
+    static U64 hash_file(const fs::path& path)
+    {
+        std::ifstream ifs{path, std::ios::binary};
+        if(!ifs)
+            throw GeometryAssetCacheError{
+                fmt::format("Failed to open source file: {}", path.string())};
+
+        ContentHash       hash;
+        constexpr SizeT   BlockSize = 1 << 20;
+        std::vector<char> block(BlockSize);
+        SizeT             total = 0;
+        while(ifs)
+        {
+            ifs.read(block.data(), BlockSize);
+            auto n = static_cast<SizeT>(ifs.gcount());
+            hash.update(block.data(), n);
+            total += n;
+        }
+        hash.update(total);
+        return hash.value();
+    }
+
+    // write to a unique temporary file and rename it, so that concurrent
+    // readers/writers of the same file never see a partial one
+    template <typename Write>
+    static void write_file_atomic(const fs::path& path, Write&& write)
+    {
+        std::random_device rd;
+        fs::path           tmp = path;
+        tmp += fmt::format(".{:08x}.tmp", rd());
+        {
+            std::ofstream ofs{tmp, std::ios::binary};
+            if(!ofs)
+                throw GeometryAssetCacheError{
+                    fmt::format("Failed to create cache file: {}", tmp.string())};
+            write(ofs);
+            if(!ofs)
+                throw GeometryAssetCacheError{
+                    fmt::format("Failed to write cache file: {}", tmp.string())};
+        }
+
+        std::error_code ec;
+        fs::rename(tmp, path, ec);
+        if(ec)
+        {
+            // another process may have won the race (rename doesn't overwrite on every platform),
+            // the file is equivalent, so just drop ours
+            fs::remove(tmp, ec);
+        }
+    }
+
+    // the content hash of the source, only recomputed when its size or last write time changed
+    static U64 source_hash(const fs::path& cache_dir, const fs::path& source)
+    {
+        auto path  = fs::absolute(source).lexically_normal();
+        auto size  = static_cast<U64>(fs::file_size(path));
+        auto mtime = static_cast<I64>(fs::last_write_time(path).time_since_epoch().count());
+
+        ContentHash path_hash;
+        path_hash.update(path.generic_string());
+        auto stamp_path = cache_dir / fmt::format("{:016x}{}", path_hash.value(), SourceStampExt);
+
+        {
+            std::ifstream ifs{stamp_path};
+            Json stamp = ifs ? Json::parse(ifs, nullptr, false) : Json{};
+            if(stamp.is_object() && stamp.value("path", "") == path.generic_string()
+               && stamp.value("size", U64{0}) == size && stamp.value("mtime", I64{0}) == mtime
+               && stamp.contains("hash"))
+                return stamp["hash"].get<U64>();
+        }
+
+        U64 hash = hash_file(path);
+
+        Json stamp     = Json::object();
+        stamp["path"]  = path.generic_string();
+        stamp["size"]  = size;
+        stamp["mtime"] = mtime;
+        stamp["hash"]  = hash;
+        write_file_atomic(stamp_path, [&](std::ofstream& ofs) { ofs << stamp.dump(); });
+
+        return hash;
+    }
+
+    static bool read_entry(const fs::path& path, std::string_view key, Json& atlas_json)
+    {
+        std::ifstream ifs{path, std::ios::binary};
+        if(!ifs)
+            return false;
+
+        char magic[8];
+        U64  size = 0;
+        ifs.read(magic, sizeof(magic));
+        ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if(!ifs || std::string_view{magic, sizeof(magic)} != AssetCacheMagic)
+            return false;
+
+        std::vector<std::uint8_t> bson(size);
+        ifs.read(reinterpret_cast<char*>(bson.data()), size);
+        if(static_cast<U64>(ifs.gcount()) != size)
+            return false;
+
+        Json j = Json::from_bson(bson, true, false);
+        if(j.is_discarded() || !j.is_object() || j.value("key", "") != key
+           || !j.contains("geometry_atlas"))
+            return false;
+
+        atlas_json = std::move(j["geometry_atlas"]);
+        return true;
+    }
+
+    static void write_entry(const fs::path&          path,
+                            std::string_view         key,
+                            std::string_view         source,
+                            const SimplicialComplex& sc)
+    {
+        GeometryAtlas atlas;
+        atlas.create(sc);
+
+        Json j              = Json::object();
+        j["key"]            = key;
+        j["source"]         = source;
+        j["geometry_atlas"] = atlas.to_json();
+
+        std::vector<std::uint8_t> bson = Json::to_bson(j);
+        U64                       size = bson.size();
+
+        write_file_atomic(path,
+                          [&](std::ofstream& ofs)
+                          {
+                              ofs.write(AssetCacheMagic.data(), AssetCacheMagic.size());
+                              ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                              ofs.write(reinterpret_cast<const char*>(bson.data()),
+                                        bson.size());
+                          });
+    }
+}  // namespace detail
+
+GeometryAssetCache::GeometryAssetCache(std::string_view cache_dir)
+    : m_cache_dir{cache_dir}
+{
+    std::error_code ec;
+    fs::create_directories(m_cache_dir, ec);
+    if(!fs::is_directory(m_cache_dir))
+        throw GeometryAssetCacheError{
+            fmt::format("Failed to create cache directory: {}", m_cache_dir)};
+}
+
+GeometryAssetCache::GeometryAssetCache(std::string_view cache_dir, const Matrix4x4& pre_transform)
+    : GeometryAssetCache{cache_dir}
+{
+    m_pre_transform = pre_transform;
+}
+
+GeometryAssetCache::GeometryAssetCache(std::string_view cache_dir, const Transform& pre_transform)
+    : GeometryAssetCache{cache_dir, pre_transform.matrix()}
+{
+}
+
+std::string GeometryAssetCache::key(std::string_view file_name, const Json& params) const
+{
+    fs::path path{file_name};
+    if(!fs::exists(path))
+        throw GeometryAssetCacheError{fmt::format("File does not exist: {}", file_name)};
+
+    ContentHash hash;
+    hash.update(detail::AssetCacheVersion);
+    hash.update(detail::source_hash(m_cache_dir, path));
+
+    // the extension decides the reader, so it is part of the input
+    auto ext = path.extension().string();
+    std::ranges::transform(ext, ext.begin(), ::tolower);
+    hash.update(ext);
+
+    hash.update(m_pre_transform.data(), sizeof(Float) * m_pre_transform.size());
+
+    // nlohmann::json sorts object keys, so the dump is canonical
+    hash.update(params.dump());
+
+    return fmt::format("{:016x}", hash.value());
+}
+
+bool GeometryAssetCache::contains(std::string_view file_name, const Json& params) const
+{
+    return fs::exists(entry_path(key(file_name, params)));
+}
+
+SimplicialComplex GeometryAssetCache::read(std::string_view file_name,
+                                           const Json&      params,
+                                           const Processor& process)
+{
+    auto k    = key(file_name, params);
+    auto path = fs::path{entry_path(k)};
+
+    Json atlas_json;
+    if(detail::read_entry(path, k, atlas_json))
+    {
+        GeometryAtlas atlas;
+        atlas.from_json(atlas_json);
+        auto slot = atlas.find(0);
+        auto sc   = slot ? slot->geometry().as<SimplicialComplex>() : nullptr;
+        if(sc)
+        {
+            ++m_hit_count;
+            return *sc;
+        }
+    }
+
+    ++m_miss_count;
+    spdlog::info("Asset cache miss: {} -> {}", file_name, path.string());
+
+    SimplicialComplexIO io{m_pre_transform};
+    SimplicialComplex   input = io.read(file_name);
+
+    if(!process)
+    {
+        detail::write_entry(path, k, file_name, input);
+        return input;
+    }
+
+    SimplicialComplex output = process(input, params);
+    detail::write_entry(path, k, file_name, output);
+    return output;
+}
+
+void GeometryAssetCache::clear()
+{
+    for(auto& entry : fs::directory_iterator{m_cache_dir})
+    {
+        if(!entry.is_regular_file())
+            continue;
+        auto name = entry.path().filename().string();
+        if(name.ends_with(detail::AssetCacheExt) || name.ends_with(detail::SourceStampExt)
+           || name.ends_with(".tmp"))
+        {
+            std::error_code ec;
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+std::string_view GeometryAssetCache::cache_dir() const noexcept
+{
+    return m_cache_dir;
+}
+
+SizeT GeometryAssetCache::hit_count() const noexcept
+{
+    return m_hit_count;
+}
+
+SizeT GeometryAssetCache::miss_count() const noexcept
+{
+    return m_miss_count;
+}
+
+std::string GeometryAssetCache::entry_path(std::string_view key) const
+{
+    return (fs::path{m_cache_dir} / fmt::format("{}{}", key, detail::AssetCacheExt)).string();
+}
+}  // namespace uipc::geometry
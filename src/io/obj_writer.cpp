@@ -0,0 +1,80 @@
+#include <obj_writer.h>
+#include <uipc/builtin/attribute_name.h>
+#include <iterator>
+
+namespace uipc::geometry::detail
+{
+vector<IndexT> obj_edges(const SimplicialComplex& sc)
+{
+    vector<IndexT> edges;
+    if(sc.dim() != 1 && sc.dim() != 2)
+        return edges;
+
+    // a simplicial edge may be a subset of a simplicial triangle, only the facets are written
+    auto is_facet = sc.dim() == 2 ? sc.edges().find<IndexT>(builtin::is_facet) : nullptr;
+    auto is_facet_view = is_facet ? is_facet->view() : span<const IndexT>{};
+
+    edges.reserve(sc.edges().size());
+    for(SizeT e = 0; e < sc.edges().size(); ++e)
+        if(is_facet_view.empty() || is_facet_view[e])
+            edges.push_back(static_cast<IndexT>(e));
+    return edges;
+}
+
+void format_obj_header(fmt::memory_buffer& buf, SizeT vertex_count, SizeT edge_count, SizeT face_count)
+{
+    fmt::format_to(std::back_inserter(buf),
+                   R"(#
+# File generated by Libuipc
+# Vertices {}
+# Edges {}
+# Faces {}
+#
+)",
+                   vertex_count,
+                   edge_count,
+                   face_count);
+}
+
+void format_obj(fmt::memory_buffer&      buf,
+                const SimplicialComplex& sc,
+                span<const IndexT>       edges,
+                const Matrix4x4&         transform,
+                SizeT                    vertex_offset)
+{
+    span<const Vector3> Vs =
+        sc.vertices().size() > 0 ? sc.positions().view() : span<const Vector3>{};
+    auto Es = sc.edges().size() > 0 ? sc.edges().topo().view() : span<const Vector2i>{};
+
+    auto out  = std::back_inserter(buf);
+    auto base = static_cast<IndexT>(vertex_offset) + 1;
+
+    for(auto&& v : Vs)
+    {
+        Vector3 x = transform.block<3, 3>(0, 0) * v + transform.block<3, 1>(0, 3);
+        fmt::format_to(out, "v {} {} {}\n", x[0], x[1], x[2]);
+    }
+
+    for(auto&& i : edges)
+    {
+        auto e = Es[i];
+        fmt::format_to(out, "l {} {}\n", e[0] + base, e[1] + base);
+    }
+
+    if(sc.dim() != 2 || sc.triangles().size() == 0)
+        return;
+
+    auto Fs     = sc.triangles().topo().view();
+    auto orient = sc.triangles().find<IndexT>(builtin::orient);
+    auto orient_view = orient ? orient->view() : span<const IndexT>{};
+
+    for(SizeT i = 0; i < Fs.size(); ++i)
+    {
+        auto F = Fs[i];
+        if(orient_view.empty() || orient_view[i] >= 1)  // outward orientation, write as is
+            fmt::format_to(out, "f {} {} {}\n", F[0] + base, F[1] + base, F[2] + base);
+        else  // inward orientation, flip the order
+            fmt::format_to(out, "f {} {} {}\n", F[0] + base, F[2] + base, F[1] + base);
+    }
+}
+}  // namespace uipc::geometry::detail
@@ -0,0 +1,31 @@
+#pragma once
+#include <uipc/common/format.h>
+#include <uipc/common/span.h>
+#include <uipc/common/vector.h>
+#include <uipc/geometry/simplicial_complex.h>
+
+namespace uipc::geometry::detail
+{
+/**
+ * @brief The edges written as `l` lines of an .obj file.
+ *
+ * An .obj file can only represent 0D, 1D and 2D facets, so all the edges of a 1D complex are written,
+ * the facet edges (`is_facet`, or all the edges if missing) of a 2D complex, and none otherwise.
+ */
+vector<IndexT> obj_edges(const SimplicialComplex& sc);
+
+void format_obj_header(fmt::memory_buffer& buf, SizeT vertex_count, SizeT edge_count, SizeT face_count);
+
+/**
+ * @brief Format the vertices, the `edges` and the triangles (of a 2D complex) of `sc` as .obj lines.
+ *
+ * The vertices are transformed by `transform`. `vertex_offset` is the number of vertices
+ * written before, the indices of this complex start at `vertex_offset + 1`.
+ * Inward oriented triangles (`orient`) are flipped.
+ */
+void format_obj(fmt::memory_buffer&      buf,
+                const SimplicialComplex& sc,
+                span<const IndexT>       edges,
+                const Matrix4x4&         transform,
+                SizeT                    vertex_offset);
+}  // namespace uipc::geometry::detail
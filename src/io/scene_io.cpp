@@ -4,14 +4,23 @@
 #include <filesystem>
 #include <fmt/printf.h>
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <uipc/common/content_hash.h>
+#include <uipc/common/parallel_for.h>
+#include <uipc/common/task_scheduler.h>
 #include <uipc/backend/visitors/scene_visitor.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/factory_keyword.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/geometry/simplicial_complex.h>
 #include <uipc/geometry/simplicial_complex_slot.h>
+#include <uipc/geometry/utils/apply_transform.h>
 #include <uipc/geometry/utils/extract_surface.h>
 #include <uipc/geometry/utils/merge.h>
 #include <uipc/io/simplicial_complex_io.h>
+#include <obj_writer.h>
 
 
 namespace uipc::core
@@ -20,15 +29,19 @@ namespace fs = std::filesystem;
 
 namespace detail
 {
+    struct SurfaceSource
+    {
+        IndexT                             id;
+        const geometry::SimplicialComplex* sc;
+    };
 
     template <IndexT Dim = -1>  // Dim = -1, 0, 1, 2
-    static vector<const geometry::SimplicialComplex*> collect_geometry_with_surf(
-        span<S<geometry::GeometrySlot>> geos)
+    static vector<SurfaceSource> collect_geometry_with_surf(span<S<geometry::GeometrySlot>> geos)
         requires(Dim == -1 || Dim == 0 || Dim == 1 || Dim == 2)
     {
         using namespace uipc::geometry;
         // 1) find all simplicial complex with surface
-        vector<const SimplicialComplex*> simplicial_complex_has_surf;
+        vector<SurfaceSource> simplicial_complex_has_surf;
         simplicial_complex_has_surf.reserve(geos.size());
 
         for(auto& geo : geos)
@@ -58,62 +71,306 @@ namespace detail
 
                 if(allow)
                 {
+                    bool has_surf = false;
                     switch(simplicial_complex->dim())
                     {
                         case 0:
-                            if(simplicial_complex->vertices().find<IndexT>(builtin::is_surf))
-                            {
-                                simplicial_complex_has_surf.push_back(simplicial_complex);
-                            }
+                            has_surf = simplicial_complex->vertices().find<IndexT>(builtin::is_surf) != nullptr;
                             break;
                         case 1:
-                            if(simplicial_complex->edges().find<IndexT>(builtin::is_surf))
-                            {
-                                simplicial_complex_has_surf.push_back(simplicial_complex);
-                            }
+                            has_surf = simplicial_complex->edges().find<IndexT>(builtin::is_surf) != nullptr;
                             break;
                         case 2:
                         case 3:
-                            if(simplicial_complex->triangles().find<IndexT>(builtin::is_surf))
-                            {
-                                simplicial_complex_has_surf.push_back(simplicial_complex);
-                            }
+                            has_surf = simplicial_complex->triangles().find<IndexT>(builtin::is_surf) != nullptr;
                             break;
                         default:
                             break;
                     }
+
+                    if(has_surf)
+                        simplicial_complex_has_surf.push_back({geo->id(), simplicial_complex});
                 }
             }
         }
 
         return simplicial_complex_has_surf;
     }
+
+    static vector<SurfaceSource> collect_geometry_with_surf(span<S<geometry::GeometrySlot>> geos,
+                                                            IndexT dim)
+    {
+        switch(dim)
+        {
+            case -1:
+                return collect_geometry_with_surf<-1>(geos);
+            case 0:
+                return collect_geometry_with_surf<0>(geos);
+            case 1:
+                return collect_geometry_with_surf<1>(geos);
+            case 2:
+                return collect_geometry_with_surf<2>(geos);
+            default:
+                UIPC_ERROR_WITH_LOCATION("Unsupported input dimension {} (expected dim=0/1/2).", dim);
+                return {};
+        }
+    }
+
+    // the indices of the elements labeled `is_surf`, in the same order as `extract_surface()` keeps them
+    template <typename Attributes>
+    static vector<SizeT> surf_new2old(const Attributes& attrs)
+    {
+        vector<SizeT> new2old;
+        auto          is_surf = attrs.template find<IndexT>(builtin::is_surf);
+        if(!is_surf)
+            return new2old;
+
+        auto is_surf_view = is_surf->view();
+        new2old.reserve(is_surf_view.size());
+        for(SizeT i = 0; i < is_surf_view.size(); ++i)
+            if(is_surf_view[i])
+                new2old.push_back(i);
+        return new2old;
+    }
 }  // namespace detail
 
+/**
+ * @brief Per geometry cache of the extracted tetrahedral mesh surfaces.
+ * 
+ * An entry is reused as long as the element counts and the content of the topology (and `is_surf` labels)
+ * of the source are unchanged, then only the vertex/edge/triangle attributes (e.g. positions) and the instances are refreshed.
+ */
+class SceneIO::SurfaceCache
+{
+  public:
+    class Entry
+    {
+      public:
+        const geometry::SimplicialComplex& update(const geometry::SimplicialComplex& src)
+        {
+            using namespace uipc::geometry;
+
+            auto key = Key::from(src);
+            if(!m_valid || key != m_key)
+            {
+                m_surface = uipc::make_unique<SimplicialComplex>(extract_surface(src));
+                m_v_new2old = detail::surf_new2old(src.vertices());
+                m_e_new2old = detail::surf_new2old(src.edges());
+                m_t_new2old = detail::surf_new2old(src.triangles());
+                m_key       = key;
+                m_valid     = true;
+                return *m_surface;
+            }
+
+            // the topology is unchanged, just pull the attributes again
+            const string topo_excludes[] = {string{builtin::topo}};
+            const string tri_excludes[]  = {string{builtin::parent_id},
+                                            string{builtin::is_facet},
+                                            string{builtin::topo}};
+
+            auto& R = *m_surface;
+            R.meta().copy_from(src.meta());
+            R.instances().resize(src.instances().size());
+            R.instances().copy_from(src.instances());
+            R.vertices().copy_from(src.vertices(), AttributeCopy::pull(m_v_new2old));
+            R.edges().copy_from(src.edges(), AttributeCopy::pull(m_e_new2old), {}, topo_excludes);
+            R.triangles().copy_from(src.triangles(), AttributeCopy::pull(m_t_new2old), {}, tri_excludes);
+
+            return R;
+        }
+
+      private:
+        struct Key
+        {
+            std::array<SizeT, 4> sizes{};
+            U64                  topo_hash = 0;
+
+            // keyed on the content, a buffer address may be reused by another topology,
+            // and in-place edits keep the address
+            static Key from(const geometry::SimplicialComplex& src)
+            {
+                Key k;
+                k.sizes = {src.vertices().size(),
+                           src.edges().size(),
+                           src.triangles().size(),
+                           src.tetrahedra().size()};
+
+                ContentHash hash;
+                if(src.edges().size())
+                    hash.update(src.edges().topo().view());
+                if(src.triangles().size())
+                    hash.update(src.triangles().topo().view());
+                if(src.tetrahedra().size())
+                    hash.update(src.tetrahedra().topo().view());
+
+                auto hash_is_surf = [&](const auto& elements)
+                {
+                    if(auto is_surf = elements.template find<IndexT>(builtin::is_surf))
+                        hash.update(is_surf->view());
+                };
+                hash_is_surf(src.vertices());
+                hash_is_surf(src.edges());
+                hash_is_surf(src.triangles());
+
+                k.topo_hash = hash.value();
+                return k;
+            }
+
+            bool operator==(const Key&) const = default;
+        };
+
+        bool                           m_valid = false;
+        Key                            m_key;
+        U<geometry::SimplicialComplex> m_surface;
+        vector<SizeT>                  m_v_new2old;
+        vector<SizeT>                  m_e_new2old;
+        vector<SizeT>                  m_t_new2old;
+    };
+
+    // reserve the entries up front, so the parallel `Entry::update()` calls never touch the map
+    vector<S<Entry>> prepare(span<const detail::SurfaceSource> sources)
+    {
+        std::lock_guard  lock{m_mutex};
+        vector<S<Entry>> entries(sources.size());
+        for(SizeT i = 0; i < sources.size(); ++i)
+        {
+            if(sources[i].sc->dim() != 3)
+                continue;
+            auto& entry = m_entries[sources[i].id];
+            if(!entry)
+                entry = uipc::make_shared<Entry>();
+            entries[i] = entry;
+        }
+        return entries;
+    }
+
+    // drop the entries of the geometries which are not in the scene anymore
+    void prune(span<S<geometry::GeometrySlot>> geos)
+    {
+        std::lock_guard            lock{m_mutex};
+        std::unordered_set<IndexT> alive;
+        alive.reserve(geos.size());
+        for(auto& geo : geos)
+            alive.insert(geo->id());
+        std::erase_if(m_entries, [&](const auto& kv) { return !alive.contains(kv.first); });
+    }
+
+    void clear()
+    {
+        std::lock_guard lock{m_mutex};
+        m_entries.clear();
+    }
+
+  private:
+    std::mutex                      m_mutex;
+    unordered_map<IndexT, S<Entry>> m_entries;
+};
 
 SceneIO::SceneIO(Scene& scene)
     : m_scene(scene)
+    , m_surface_cache(uipc::make_shared<SurfaceCache>())
 {
 }
 
+namespace detail
+{
+    struct SurfaceBlock
+    {
+        const geometry::SimplicialComplex* surface = nullptr;
+        vector<IndexT>                     edges;  // the edges to write
+        SizeT                              instance_count = 0;
+        SizeT                              vertex_offset  = 0;  // global offset of the first vertex
+    };
+
+    static void format_surface_block(fmt::memory_buffer& buf, const SurfaceBlock& block)
+    {
+        auto& sc = *block.surface;
+        auto  Ts = sc.transforms().view();
+        for(SizeT I = 0; I < block.instance_count; ++I)
+            geometry::detail::format_obj(
+                buf, sc, block.edges, Ts[I], block.vertex_offset + I * sc.vertices().size());
+    }
+}  // namespace detail
+
 void SceneIO::write_surface_obj(std::string_view filename)
 {
     using namespace uipc::geometry;
 
-    auto merged_surface = simplicial_surface();
+    auto scene   = backend::SceneVisitor{m_scene};
+    auto geos    = scene.geometries();
+    auto sources = detail::collect_geometry_with_surf(geos, -1);
+
+    // 1) get the surface of each geometry, tetrahedral meshes go through the cache
+    auto entries = m_surface_cache->prepare(sources);
+    m_surface_cache->prune(geos);
+
+    vector<detail::SurfaceBlock> blocks(sources.size());
+    parallel_for(sources.size(),
+                 [&](SizeT i)
+                 {
+                     auto& block   = blocks[i];
+                     block.surface = entries[i] ?
+                                         &entries[i]->update(*sources[i].sc) :
+                                         sources[i].sc;
+                     block.instance_count = block.surface->instances().size();
+                     block.edges = geometry::detail::obj_edges(*block.surface);
+                 });
+
+    // 2) the global vertex offset of each block
+    SizeT vertex_count = 0;
+    SizeT edge_count   = 0;
+    SizeT face_count   = 0;
+    for(auto& block : blocks)
+    {
+        auto& sc            = *block.surface;
+        block.vertex_offset = vertex_count;
+        vertex_count += block.instance_count * sc.vertices().size();
+        edge_count += block.instance_count * block.edges.size();
+        if(sc.dim() == 2)
+            face_count += block.instance_count * sc.triangles().size();
+    }
 
     fs::path path = fs::absolute(fs::path{filename});
 
     fs::exists(path.parent_path()) || fs::create_directories(path.parent_path());
 
-    SimplicialComplexIO io;
-    io.write_obj(path.string(), merged_surface);
+    auto abs_path = path.string();
+    auto fp       = std::fopen(abs_path.c_str(), "w");
+    if(!fp)
+    {
+        throw SceneIOError(fmt::format("Failed to open file {} for writing.", abs_path));
+    }
+
+    {
+        fmt::memory_buffer header;
+        geometry::detail::format_obj_header(header, vertex_count, edge_count, face_count);
+        std::fwrite(header.data(), 1, header.size(), fp);
+    }
+
+    // 3) format a batch of blocks in parallel, then write them in order,
+    // so only one batch of text is alive at a time
+    constexpr SizeT batch_size = 64;
+    vector<fmt::memory_buffer> bufs(std::min(batch_size, blocks.size()));
+    for(SizeT begin = 0; begin < blocks.size(); begin += batch_size)
+    {
+        SizeT count = std::min(batch_size, blocks.size() - begin);
+        parallel_for(count,
+                     [&](SizeT i)
+                     {
+                         bufs[i].clear();
+                         detail::format_surface_block(bufs[i], blocks[begin + i]);
+                     });
+
+        for(SizeT i = 0; i < count; ++i)
+            std::fwrite(bufs[i].data(), 1, bufs[i].size(), fp);
+    }
+
+    std::fclose(fp);
 
-    auto abs_path = fs::absolute(path).string();
     spdlog::info("Scene surface with Faces({}), Edges({}), Vertices({}) written to {}",
-                 merged_surface.triangles().size(),
-                 merged_surface.edges().size(),
-                 merged_surface.vertices().size(),
+                 face_count,
+                 edge_count,
+                 vertex_count,
                  abs_path);
 }
 
@@ -135,32 +392,225 @@ geometry::SimplicialComplex SceneIO::simplicial_surface(IndexT dim) const
 {
     using namespace uipc::geometry;
 
-    auto scene = backend::SceneVisitor{m_scene};
-    auto geos  = scene.geometries();
-
-    vector<const geometry::SimplicialComplex*> simplicial_complex_has_surf;
-    switch(dim)
-    {
-        case -1:
-            simplicial_complex_has_surf = detail::collect_geometry_with_surf<-1>(geos);
-            break;
-        case 0:
-            simplicial_complex_has_surf = detail::collect_geometry_with_surf<0>(geos);
-            break;
-        case 1:
-            simplicial_complex_has_surf = detail::collect_geometry_with_surf<1>(geos);
-            break;
-        case 2:
-            simplicial_complex_has_surf = detail::collect_geometry_with_surf<2>(geos);
-            break;
-        default:
-            UIPC_ERROR_WITH_LOCATION("Unsupported input dimension {} (expected dim=0/1/2).", dim);
-            break;
-    }
+    auto scene   = backend::SceneVisitor{m_scene};
+    auto geos    = scene.geometries();
+    auto sources = detail::collect_geometry_with_surf(geos, dim);
+
+    if(sources.empty())
+        return SimplicialComplex{};
+
+    auto entries = m_surface_cache->prepare(sources);
+    m_surface_cache->prune(geos);
+
+    // extract (or refresh) the surfaces and apply the instance transforms in parallel
+    vector<vector<SimplicialComplex>> instances(sources.size());
+    parallel_for(sources.size(),
+                 [&](SizeT i)
+                 {
+                     const SimplicialComplex& surface =
+                         entries[i] ? entries[i]->update(*sources[i].sc) :
+                                      *sources[i].sc;
+                     auto transformed = apply_transform(surface);
+                     instances[i].reserve(transformed.size());
+                     std::move(transformed.begin(),
+                               transformed.end(),
+                               std::back_inserter(instances[i]));
+                 });
+
+    SizeT total_instances = 0;
+    for(auto& I : instances)
+        total_instances += I.size();
+
+    vector<const SimplicialComplex*> surfaces;
+    surfaces.reserve(total_instances);
+    for(auto& I : instances)
+        for(auto& surface : I)
+            surfaces.push_back(&surface);
+
+    return merge(surfaces);
+}
 
-    return extract_surface(simplicial_complex_has_surf);
+void SceneIO::clear_surface_cache() const
+{
+    m_surface_cache->clear();
 }
 
+// A chunked scene file (.uipcs) looks like:
+//
+//  [magic: 8 bytes "UIPCSCN1"][index offset: u64]
+//  [header chunk][object chunk 0][object chunk 1]...
+//  [index]
+//
+// Every chunk and the index are BSON documents. The index records the offset and size of
+// the header chunk and of each object chunk, together with the object id and name,
+// so objects can be selected and read without touching the other chunks.
+//
+// Each object chunk has its own geometry atlas, so attribute buffers shared between the
+// geometries of one object stay shared, but buffers shared between objects are stored once
+// per object and are no longer shared after loading.
+namespace detail
+{
+    constexpr std::string_view chunked_magic = "UIPCSCN1";
+
+    static void write_chunk(std::ofstream& file, const Json& j, Json& entry)
+    {
+        std::vector<std::uint8_t> bson = Json::to_bson(j);
+
+        entry["offset"] = static_cast<U64>(file.tellp());
+        entry["size"]   = static_cast<U64>(bson.size());
+        file.write(reinterpret_cast<const char*>(bson.data()), bson.size());
+    }
+
+    static std::vector<std::uint8_t> read_chunk(std::ifstream& file, const Json& entry)
+    {
+        std::vector<std::uint8_t> bytes(entry["size"].get<U64>());
+        file.seekg(static_cast<std::streamoff>(entry["offset"].get<U64>()));
+        file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        if(!file)
+            throw SceneIOError("Failed to read a chunk, the file may be truncated.");
+        return bytes;
+    }
+
+    static void save_chunked(const Scene& scene, const fs::path& path)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if(!file)
+        {
+            throw SceneIOError(fmt::format("Failed to open file {} for writing.", path.string()));
+        }
+
+        SceneFactory sf;
+
+        U64 index_offset = 0;
+        file.write(chunked_magic.data(), chunked_magic.size());
+        file.write(reinterpret_cast<const char*>(&index_offset), sizeof(index_offset));
+
+        Json index;
+        auto header = sf.to_header_json(scene);
+        write_chunk(file, header, index["header"]);
+
+        // one chunk per object, only one object chunk is alive at a time
+        auto& objects = index["objects"];
+        objects       = Json::array();
+        for(auto& obj_json : header[builtin::__data__]["objects"])
+        {
+            Json entry;
+            auto id       = obj_json["id"].get<IndexT>();
+            entry["id"]   = id;
+            entry["name"] = obj_json["name"];
+            write_chunk(file, sf.to_object_json(scene, id), entry);
+            objects.push_back(std::move(entry));
+        }
+
+        index_offset                   = static_cast<U64>(file.tellp());
+        std::vector<std::uint8_t> bson = Json::to_bson(index);
+        file.write(reinterpret_cast<const char*>(bson.data()), bson.size());
+
+        file.seekp(chunked_magic.size());
+        file.write(reinterpret_cast<const char*>(&index_offset), sizeof(index_offset));
+    }
+
+    static S<Scene> load_chunked(const fs::path& path, const SceneIO::LoadOptions& options)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if(!file)
+        {
+            throw SceneIOError(fmt::format("Failed to open file {} for reading.", path.string()));
+        }
+
+        // 1) check the magic and read the index
+        Json index;
+        {
+            std::string magic(chunked_magic.size(), '\0');
+            U64         index_offset = 0;
+            file.read(magic.data(), magic.size());
+            file.read(reinterpret_cast<char*>(&index_offset), sizeof(index_offset));
+            if(!file || magic != chunked_magic)
+            {
+                throw SceneIOError(fmt::format("{} is not a chunked scene file.", path.string()));
+            }
+
+            file.seekg(0, std::ios::end);
+            U64 file_size = static_cast<U64>(file.tellg());
+            if(index_offset == 0 || index_offset >= file_size)
+            {
+                throw SceneIOError(
+                    fmt::format("{} has no index, the file may be truncated.", path.string()));
+            }
+
+            Json entry;
+            entry["offset"] = index_offset;
+            entry["size"]   = file_size - index_offset;
+            index           = Json::from_bson(read_chunk(file, entry));
+        }
+
+        // 2) select the objects
+        vector<const Json*> selected;
+        {
+            bool load_all = options.object_ids.empty() && options.object_names.empty();
+
+            std::unordered_set<IndexT> ids(options.object_ids.begin(),
+                                           options.object_ids.end());
+            std::unordered_set<std::string> names(options.object_names.begin(),
+                                                  options.object_names.end());
+
+            for(auto& entry : index["objects"])
+            {
+                if(load_all || ids.contains(entry["id"].get<IndexT>())
+                   || names.contains(entry["name"].get<std::string>()))
+                    selected.push_back(&entry);
+            }
+
+            if(!load_all && selected.empty())
+            {
+                spdlog::warn("No object in {} matches the given ids or names.", path.string());
+            }
+        }
+
+        Json header = Json::from_bson(read_chunk(file, index["header"]));
+
+        // 3) read the chunks in order, decode them on the TaskScheduler.
+        // at most `max_workers` chunks are in flight, which bounds the memory of the raw bytes.
+        // A finished chunk starts the next one, so a slow chunk never holds back the others
+        SizeT max_workers = options.max_workers;
+        if(max_workers == 0)
+            max_workers = TaskScheduler::instance().thread_count();
+
+        vector<SceneFactory::ObjectChunk> chunks(selected.size());
+
+        TaskGroup  group;
+        std::mutex file_mutex;
+        SizeT      next_chunk = 0;
+
+        std::function<void()> launch_next = [&]
+        {
+            SizeT                     i;
+            std::vector<std::uint8_t> bytes;
+            {
+                std::lock_guard lock{file_mutex};
+                if(next_chunk >= selected.size())
+                    return;
+                i     = next_chunk++;
+                bytes = read_chunk(file, *selected[i]);
+            }
+
+            group.run(
+                [&, i, bytes = std::move(bytes)]
+                {
+                    chunks[i] = SceneFactory::decode_object(Json::from_bson(bytes));
+                    launch_next();
+                });
+        };
+
+        for(SizeT w = 0; w < std::min(max_workers, selected.size()); ++w)
+            launch_next();
+        group.wait();
+
+        SceneFactory sf;
+        return sf.from_chunks(header, chunks);
+    }
+}  // namespace detail
+
 void SceneIO::save(const Scene& scene, std::string_view filename)
 {
     fs::path path{filename};
@@ -168,6 +618,13 @@ void SceneIO::save(const Scene& scene, std::string_view filename)
 
     auto ext = path.extension();
 
+    if(ext == ".uipcs")
+    {
+        fs::exists(path.parent_path()) || fs::create_directories(path.parent_path());
+        detail::save_chunked(scene, path);
+        return;
+    }
+
     SceneFactory sf;
     auto         scene_json = sf.to_json(scene);
 
@@ -253,6 +710,10 @@ S<Scene> SceneIO::load(std::string_view filename)
                                            path.string()));
         }
     }
+    else if(ext == ".uipcs")
+    {
+        scene = detail::load_chunked(path, LoadOptions{});
+    }
     else
     {
         throw SceneIOError(fmt::format("Unsupported file format when loading {}.", filename));
@@ -269,4 +730,28 @@ S<Scene> SceneIO::load(std::string_view filename)
 
     return scene;
 }
+S<Scene> SceneIO::load(std::string_view filename, const LoadOptions& options)
+{
+    fs::path path{filename};
+    path = fs::absolute(path);
+
+    if(path.extension() != ".uipcs")
+    {
+        throw SceneIOError(fmt::format(
+            "Loading a subset of objects needs a chunked scene file (.uipcs), yours {}.", filename));
+    }
+
+    auto scene = detail::load_chunked(path, options);
+
+    if(!scene)
+    {
+        spdlog::warn("Failed to load scene from file {}.", filename);
+    }
+    else
+    {
+        spdlog::info("Scene with {} objects loaded from file {}.", scene->objects().size(), filename);
+    }
+
+    return scene;
+}
 }  // namespace uipc::core
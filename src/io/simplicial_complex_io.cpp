@@ -1,6 +1,6 @@
 #include <uipc/io/simplicial_complex_io.h>
+#include <obj_writer.h>
 #include <uipc/geometry/utils/factory.h>
-#include <uipc/common/list.h>
 #include <igl/readMSH.h>
 #include <uipc/common/format.h>
 #include <uipc/common/enumerate.h>
@@ -170,9 +170,6 @@ void SimplicialComplexIO::write(std::string_view file_name, const SimplicialComp
 void SimplicialComplexIO::write_obj(std::string_view file_name, const SimplicialComplex& sc)
 {
     // NOTE: .obj file can only represent 0D, 1D and 2D facets
-    // simplicial edge may be a subset of a simplicial triangle
-    // here we exclude the simplicial edge that is not a facet.
-
     if(sc.dim() > 2)
     {
         throw GeometryIOError{fmt::format("Cannot write simplicial complex of dimension {} to .obj file",
@@ -186,97 +183,18 @@ void SimplicialComplexIO::write_obj(std::string_view file_name, const Simplicial
         throw GeometryIOError{fmt::format("Failed to open file {} for writing.", file_name)};
     }
 
-    span<const Vector3> Vs =
-        sc.vertices().size() > 0 ? sc.positions().view() : span<const Vector3>{};
-
-    if(Vs.size() == 0)
+    if(sc.vertices().size() == 0)
     {
         spdlog::warn("No vertices found in the simplicial complex. Writing an empty .obj file.");
     }
 
-    auto Es = sc.edges().size() > 0 ? sc.edges().topo().view() : span<const Vector2i>{};
-    auto Fs = sc.triangles().size() > 0 ? sc.triangles().topo().view() :
-                                          span<const Vector3i>{};
-
-    SizeT edge_count = 0;
-
-    list<IndexT> surf_edge_indices;
-
-    if(sc.dim() == 1)
-        edge_count = sc.edges().size();
-    else if(sc.dim() == 2)
-    {
-        auto is_facet = sc.edges().find<IndexT>(builtin::is_facet);
-        if(is_facet)
-        {
-            auto is_facet_view = is_facet->view();
-            for(auto&& [i, e] : enumerate(Es))
-            {
-                if(is_facet_view[i])
-                    surf_edge_indices.push_back(i);
-            }
-        }
-        else  // if no is_facet attribute, just write all edges
-        {
-            surf_edge_indices.resize(Es.size());
-            std::iota(surf_edge_indices.begin(), surf_edge_indices.end(), 0);
-        }
-
-        edge_count = surf_edge_indices.size();
-    }
-
-    fmt::println(fp,
-                 R"(#
-# File generated by Libuipc
-# Vertices {}
-# Edges {}
-# Faces {}
-#)",
-                 sc.vertices().size(),
-                 edge_count,
-                 sc.triangles().size());
-
-    // write vertices
-    for(auto&& v : Vs)
-        fmt::println(fp, "v {} {} {}", v[0], v[1], v[2]);
-
-    if(sc.dim() == 1)  // All edges are facets
-    {
-        // write edges
-        for(auto&& e : Es)
-            fmt::println(fp, "l {} {}", e[0] + 1, e[1] + 1);
-    }
-    else if(sc.dim() == 2)
-    {
-        // write edges
-        for(auto&& i : surf_edge_indices)
-        {
-            auto e = Es[i];
-            fmt::println(fp, "l {} {}", e[0] + 1, e[1] + 1);
-        }
+    auto edges = detail::obj_edges(sc);
 
-        // write faces
-        auto orient = sc.triangles().find<IndexT>(builtin::orient);
-
-        if(orient)
-        {
-            auto orient_view = sc.triangles().find<IndexT>(builtin::orient)->view();
-
-            for(auto&& [i, F] : enumerate(Fs))
-            {
-                if(orient_view[i] >= 1)  // outward orientation, write as is
-                    fmt::println(fp, "f {} {} {}", F[0] + 1, F[1] + 1, F[2] + 1);
-                else  // inward orientation, flip the order
-                    fmt::println(fp, "f {} {} {}", F[0] + 1, F[2] + 1, F[1] + 1);
-            }
-        }
-        else
-        {
-            for(auto&& F : Fs)
-                fmt::println(fp, "f {} {} {}", F[0] + 1, F[1] + 1, F[2] + 1);
-        }
-    }
+    fmt::memory_buffer buf;
+    detail::format_obj_header(buf, sc.vertices().size(), edges.size(), sc.triangles().size());
+    detail::format_obj(buf, sc, edges, Matrix4x4::Identity(), 0);
 
+    std::fwrite(buf.data(), 1, buf.size(), fp);
     std::fclose(fp);
 }
 
@@ -13,6 +13,12 @@ PyDiffSimVisitor::PyDiffSimVisitor(py::module& m)
             [](DiffSimVisitor& self) -> diff_sim::ParameterCollection&
             { return self.parameters(); },
             py::return_value_policy::reference_internal)
-        .def("ref", &DiffSimVisitor::ref, py::return_value_policy::reference_internal);
+        .def("ref", &DiffSimVisitor::ref, py::return_value_policy::reference_internal)
+        .def("H",
+             [](DiffSimVisitor& self) { return self.H(); },
+             py::keep_alive<0, 1>())
+        .def("pGpP",
+             [](DiffSimVisitor& self) { return self.pGpP(); },
+             py::keep_alive<0, 1>());
 }
 }  // namespace pyuipc::backend
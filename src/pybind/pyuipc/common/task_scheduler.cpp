@@ -0,0 +1,31 @@
+#include <pyuipc/common/task_scheduler.h>
+#include <uipc/common/task_scheduler.h>
+#include <pybind11/stl.h>
+
+namespace pyuipc
+{
+using namespace uipc;
+PyTaskScheduler::PyTaskScheduler(py::module& m)
+{
+    // the scheduler is owned by the uipc runtime, never deleted from python
+    auto class_TaskScheduler =
+        py::class_<TaskScheduler, std::unique_ptr<TaskScheduler, py::nodelete>>(m, "TaskScheduler");
+
+    class_TaskScheduler.def_static("instance",
+                                   &TaskScheduler::instance,
+                                   py::return_value_policy::reference);
+    class_TaskScheduler.def("thread_count", &TaskScheduler::thread_count);
+    class_TaskScheduler.def("set_thread_count", &TaskScheduler::set_thread_count, py::arg("count"));
+    class_TaskScheduler.def(
+        "set_affinity",
+        [](TaskScheduler& self, const std::vector<IndexT>& cpus)
+        { self.set_affinity(cpus); },
+        py::arg("cpus"));
+    class_TaskScheduler.def("affinity",
+                            [](TaskScheduler& self)
+                            {
+                                auto cpus = self.affinity();
+                                return std::vector<IndexT>(cpus.begin(), cpus.end());
+                            });
+}
+}  // namespace pyuipc
@@ -0,0 +1,10 @@
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc
+{
+class PyTaskScheduler
+{
+  public:
+    PyTaskScheduler(py::module& m);
+};
+}  // namespace pyuipc
@@ -13,5 +13,7 @@ PyTimer::PyTimer(py::module& m)
     class_Timer.def_static("disable_all", &Timer::disable_all);
     class_Timer.def_static("report", []() { Timer::report(); });
     class_Timer.def_static("report_as_json", Timer::report_as_json);
+    class_Timer.def_static("end_frame", &Timer::end_frame, py::arg("frame"));
+    class_Timer.def_static("report_frames_as_json", &Timer::report_frames_as_json);
 }
 }  // namespace pyuipc
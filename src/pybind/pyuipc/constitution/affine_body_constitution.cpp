@@ -2,6 +2,7 @@
 #include <uipc/constitution/affine_body_constitution.h>
 #include <uipc/constitution/constitution.h>
 #include <pyuipc/common/json.h>
+#include <pyuipc/as_numpy.h>
 namespace pyuipc::constitution
 {
 using namespace uipc::constitution;
@@ -18,10 +19,38 @@ PyAffineBodyConstitution::PyAffineBodyConstitution(py::module& m)
     class_AffineBodyConstitution.def_static("default_config",
                                             &AffineBodyConstitution::default_config);
 
-    class_AffineBodyConstitution.def("apply_to",
-                                     &AffineBodyConstitution::apply_to,
-                                     py::arg("sc"),
-                                     py::arg("kappa"),
-                                     py::arg("mass_density") = 1000.0);
+    class_AffineBodyConstitution.def(
+        "apply_to",
+        py::overload_cast<uipc::geometry::SimplicialComplex&, Float, Float>(
+            &AffineBodyConstitution::apply_to, py::const_),
+        py::arg("sc"),
+        py::arg("kappa"),
+        py::arg("mass_density") = 1000.0);
+
+    class_AffineBodyConstitution.def(
+        "apply_to",
+        [](AffineBodyConstitution& self,
+           uipc::geometry::SimplicialComplex& sc,
+           py::array_t<Float>           kappa,
+           Float                        mass_density)
+        { self.apply_to(sc, as_span<Float>(kappa), mass_density); },
+        py::arg("sc"),
+        py::arg("kappa"),
+        py::arg("mass_density") = 1000.0);
+
+    class_AffineBodyConstitution.def(
+        "apply_to_all",
+        [](AffineBodyConstitution& self, py::list scs, Float kappa, Float mass_density)
+        {
+            vector<uipc::geometry::SimplicialComplex*> ptrs;
+            ptrs.reserve(scs.size());
+            for(auto sc : scs)
+                ptrs.push_back(&sc.cast<uipc::geometry::SimplicialComplex&>());
+            py::gil_scoped_release release;
+            self.apply_to(ptrs, kappa, mass_density);
+        },
+        py::arg("scs"),
+        py::arg("kappa"),
+        py::arg("mass_density") = 1000.0);
 }
 }  // namespace pyuipc::constitution
@@ -15,11 +15,41 @@ PyStableNeoHookean::PyStableNeoHookean(py::module& m)
 
     class_StableNeoHookean.def_static("default_config", &StableNeoHookean::default_config);
 
-    class_StableNeoHookean.def("apply_to",
-                               &StableNeoHookean::apply_to,
-                               py::arg("sc"),
-                               py::arg("moduli") =
-                                   ElasticModuli::youngs_poisson(20.0_kPa, 0.49),
-                               py::arg("mass_density") = 1.0e3);
+    class_StableNeoHookean.def(
+        "apply_to",
+        py::overload_cast<uipc::geometry::SimplicialComplex&, const ElasticModuli&, Float>(
+            &StableNeoHookean::apply_to, py::const_),
+        py::arg("sc"),
+        py::arg("moduli")       = ElasticModuli::youngs_poisson(20.0_kPa, 0.49),
+        py::arg("mass_density") = 1.0e3);
+
+    class_StableNeoHookean.def(
+        "apply_to",
+        [](StableNeoHookean& self, uipc::geometry::SimplicialComplex& sc, py::list moduli, Float mass_density)
+        {
+            vector<ElasticModuli> ms;
+            ms.reserve(moduli.size());
+            for(auto m : moduli)
+                ms.push_back(m.cast<ElasticModuli>());
+            self.apply_to(sc, ms, mass_density);
+        },
+        py::arg("sc"),
+        py::arg("moduli"),
+        py::arg("mass_density") = 1.0e3);
+
+    class_StableNeoHookean.def(
+        "apply_to_all",
+        [](StableNeoHookean& self, py::list scs, const ElasticModuli& moduli, Float mass_density)
+        {
+            vector<uipc::geometry::SimplicialComplex*> ptrs;
+            ptrs.reserve(scs.size());
+            for(auto sc : scs)
+                ptrs.push_back(&sc.cast<uipc::geometry::SimplicialComplex&>());
+            py::gil_scoped_release release;
+            self.apply_to(ptrs, moduli, mass_density);
+        },
+        py::arg("scs"),
+        py::arg("moduli")       = ElasticModuli::youngs_poisson(20.0_kPa, 0.49),
+        py::arg("mass_density") = 1.0e3);
 }
 }  // namespace pyuipc::constitution
@@ -44,12 +44,21 @@ PyAnimator::PyAnimator(py::module& m)
                            {
                                throw py::type_error("The second argument must be a callable");
                            }
+                           // the callable may be copied or released by the engine without the GIL
+                           auto holder = S<py::function>(new py::function(std::move(callable)),
+                                                         [](py::function* f)
+                                                         {
+                                                             py::gil_scoped_acquire acquire;
+                                                             delete f;
+                                                         });
                            self.insert(obj,
-                                       [callable](Animation::UpdateInfo& info)
+                                       [holder](Animation::UpdateInfo& info)
                                        {
+                                           // World.advance() releases the GIL, take it back for Python code
+                                           py::gil_scoped_acquire acquire;
                                            try
                                            {
-                                               callable(py::cast(info));
+                                               (*holder)(py::cast(info));
                                            }
                                            catch(const std::exception& e)
                                            {
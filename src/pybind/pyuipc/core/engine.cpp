@@ -21,6 +21,8 @@ PyEngine::PyEngine(py::module& m)
         .def("backend_name", &Engine::backend_name)
         .def("workspace", &Engine::workspace)
         .def("features", &Engine::features, py::return_value_policy::reference_internal)
+        .def("memory_report", &Engine::memory_report)
+        .def("telemetry", &Engine::telemetry, py::return_value_policy::reference_internal)
         .def_static("default_config", &Engine::default_config);
 }
 }  // namespace pyuipc::core
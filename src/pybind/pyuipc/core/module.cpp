@@ -11,12 +11,14 @@
 #include <pyuipc/core/diff_sim.h>
 #include <pyuipc/core/sanity_checker.h>
 #include <pyuipc/core/feature_collection.h>
+#include <pyuipc/core/telemetry.h>
 
 namespace pyuipc::core
 {
 PyModule::PyModule(py::module& m)
 {
     PyFeatureCollection{m};
+    PyTelemetry{m};
 
     PyEngine{m};
 
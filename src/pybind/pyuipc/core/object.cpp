@@ -19,7 +19,9 @@ PyObject::PyObject(py::module& m)
 
     class_Object
         .def("name", &Object::name)  //
-        .def("id", &Object::id);     //
+        .def("id", &Object::id)      //
+        .def("tag", [](const Object& self) { return self.tag(); })
+        .def("tag", [](Object& self, std::string_view tag) { self.tag(tag); });
 
     class_Object.def(
         "geometries", [](Object& self) { return self.geometries(); }, py::return_value_policy::move);
@@ -1,6 +1,7 @@
 #include <pyuipc/core/scene.h>
 #include <uipc/core/scene.h>
 #include <pyuipc/common/json.h>
+#include <pybind11/numpy.h>
 
 namespace pyuipc::core
 {
@@ -64,6 +65,20 @@ PyScene::PyScene(py::module& m)
                           return ret;
                       });
 
+    class_Objects.def("find_ids",
+                      [](Scene::Objects& self, std::string_view name)
+                      {
+                          auto ids = std::move(self).find_ids(name);
+                          return py::array_t<IndexT>(ids.size(), ids.data());
+                      });
+
+    class_Objects.def("find_ids_by_tag",
+                      [](Scene::Objects& self, std::string_view tag)
+                      {
+                          auto ids = std::move(self).find_ids_by_tag(tag);
+                          return py::array_t<IndexT>(ids.size(), ids.data());
+                      });
+
     class_Objects.def("destroy",
                       [](Scene::Objects& self, IndexT id)
                       { return std::move(self).destroy(id); });
@@ -78,6 +93,17 @@ PyScene::PyScene(py::module& m)
                              return std::make_pair(geo, rest_geo);
                          });
 
+    class_Geometries.def("find_ids_by_constitution",
+                         [](Scene::Geometries& self, U64 uid)
+                         {
+                             auto ids = std::move(self).find_ids_by_constitution(uid);
+                             return py::array_t<IndexT>(ids.size(), ids.data());
+                         });
+
+    class_Geometries.def("update_constitution_index",
+                         [](Scene::Geometries& self, IndexT id)
+                         { std::move(self).update_constitution_index(id); });
+
     class_Scene.def(
         "diff_sim",
         [](Scene& self) -> DiffSim& { return self.diff_sim(); },
@@ -88,6 +114,8 @@ PyScene::PyScene(py::module& m)
         [](Scene& self) -> SanityChecker& { return self.sanity_checker(); },
         py::return_value_policy::reference_internal);
 
+    class_Scene.def("memory_report", &Scene::memory_report);
+
     class_Scene.def("__repr__",
                     [](const Scene& self) { return fmt::format("{}", self); });
 }
@@ -1,5 +1,6 @@
 #include <pyuipc/core/scene_io.h>
 #include <uipc/io/scene_io.h>
+#include <pybind11/stl.h>
 namespace pyuipc::core
 {
 using namespace uipc::core;
@@ -12,10 +13,41 @@ PySceneIO::PySceneIO(py::module& m)
         "simplicial_surface",
         [](SceneIO& self, IndexT dim) { return self.simplicial_surface(dim); },
         py::arg("dim") = -1);
+    class_SceneIO.def("clear_surface_cache", &SceneIO::clear_surface_cache);
     class_SceneIO.def_static(
         "load",
         [](std::string_view filename) { return SceneIO::load(filename); },
         py::arg("filename"));
+
+    auto class_LoadOptions = py::class_<SceneIO::LoadOptions>(class_SceneIO, "LoadOptions");
+    class_LoadOptions.def(py::init<>());
+    class_LoadOptions.def_property(
+        "object_ids",
+        [](SceneIO::LoadOptions& self)
+        { return std::vector<IndexT>(self.object_ids.begin(), self.object_ids.end()); },
+        [](SceneIO::LoadOptions& self, const std::vector<IndexT>& ids)
+        { self.object_ids.assign(ids.begin(), ids.end()); });
+    class_LoadOptions.def_property(
+        "object_names",
+        [](SceneIO::LoadOptions& self)
+        {
+            return std::vector<std::string>(self.object_names.begin(),
+                                            self.object_names.end());
+        },
+        [](SceneIO::LoadOptions& self, const std::vector<std::string>& names)
+        { self.object_names.assign(names.begin(), names.end()); });
+    class_LoadOptions.def_readwrite("max_workers", &SceneIO::LoadOptions::max_workers);
+
+    class_SceneIO.def_static(
+        "load",
+        [](std::string_view filename, const SceneIO::LoadOptions& options)
+        {
+            // decoding runs on the worker threads, which never touch Python
+            py::gil_scoped_release release;
+            return SceneIO::load(filename, options);
+        },
+        py::arg("filename"),
+        py::arg("options"));
     class_SceneIO.def(
         "save", [](SceneIO& self, std::string_view file) { self.save(file); }, py::arg("filename"));
 }
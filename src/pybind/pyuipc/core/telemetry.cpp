@@ -0,0 +1,73 @@
+#include <pyuipc/core/telemetry.h>
+#include <uipc/core/telemetry.h>
+#include <pyuipc/common/json.h>
+#include <pybind11/stl.h>
+
+namespace pyuipc::core
+{
+using namespace uipc::core;
+
+PyTelemetry::PyTelemetry(py::module& m)
+{
+    auto class_FrameTelemetry = py::class_<FrameTelemetry>(m, "FrameTelemetry");
+
+    class_FrameTelemetry.def(py::init<>())
+        .def_readonly("frame", &FrameTelemetry::frame)
+        .def_readonly("dt", &FrameTelemetry::dt)
+        .def_readonly("substep_count", &FrameTelemetry::substep_count)
+        .def_property_readonly("substep_dts",
+                               [](const FrameTelemetry& self)
+                               { return self.to_json()["substep_dts"]; })
+        .def_readonly("newton_iterations", &FrameTelemetry::newton_iterations)
+        .def_property_readonly("linear_solver_iterations",
+                               [](const FrameTelemetry& self)
+                               { return self.to_json()["linear_solver_iterations"]; })
+        .def_readonly("line_search_steps", &FrameTelemetry::line_search_steps)
+        .def_readonly("min_ccd_alpha", &FrameTelemetry::min_ccd_alpha)
+        .def_readonly("min_cfl_alpha", &FrameTelemetry::min_cfl_alpha)
+        .def_property_readonly("contact_candidates",
+                               [](const FrameTelemetry& self)
+                               { return self.to_json()["contact_candidates"]; })
+        .def_property_readonly("energies",
+                               [](const FrameTelemetry& self)
+                               { return self.to_json()["energies"]; })
+        .def_readonly("wall_time", &FrameTelemetry::wall_time)
+        .def("to_json", &FrameTelemetry::to_json);
+
+    auto class_TelemetryStream = py::class_<TelemetryStream>(m, "TelemetryStream");
+
+    class_TelemetryStream
+        .def("pop",
+             [](TelemetryStream& self) -> py::object
+             {
+                 auto record = self.pop();
+                 if(!record)
+                     return py::none();
+                 return py::cast(std::move(*record));
+             })
+        .def("pop_all",
+             [](TelemetryStream& self)
+             {
+                 auto records = self.pop_all();
+                 return std::vector<FrameTelemetry>(std::make_move_iterator(records.begin()),
+                                                    std::make_move_iterator(records.end()));
+             })
+        .def("enable", &TelemetryStream::enable, py::arg("value") = true)
+        .def("is_enabled", &TelemetryStream::is_enabled)
+        .def("size", &TelemetryStream::size)
+        .def("capacity", &TelemetryStream::capacity)
+        .def("dropped_count", &TelemetryStream::dropped_count)
+        .def_static(
+            "write_csv",
+            [](std::string_view file, const std::vector<FrameTelemetry>& records)
+            { TelemetryStream::write_csv(file, records); },
+            py::arg("file"),
+            py::arg("records"))
+        .def_static(
+            "write_json_lines",
+            [](std::string_view file, const std::vector<FrameTelemetry>& records)
+            { TelemetryStream::write_json_lines(file, records); },
+            py::arg("file"),
+            py::arg("records"));
+}
+}  // namespace pyuipc::core
@@ -1,23 +1,258 @@
 #include <pyuipc/core/world.h>
 #include <uipc/core/world.h>
 #include <uipc/core/engine.h>
+#include <uipc/core/scene.h>
+#include <uipc/backend/visitors/world_visitor.h>
+#include <future>
+#include <mutex>
+#include <unordered_set>
 
 namespace pyuipc::core
 {
 using namespace uipc::core;
 
+namespace
+{
+// worlds with a pending `advance_async()`, guarded by `busy_mutex`
+std::mutex                       busy_mutex;
+std::unordered_set<const World*> busy_worlds;
+
+void mark_busy(const World& world)
+{
+    std::lock_guard lock{busy_mutex};
+    if(!busy_worlds.insert(&world).second)
+        throw PyException(PYUIPC_MSG("An async advance of this world is pending, wait for it first."));
+}
+
+void unmark_busy(const World& world) noexcept
+{
+    std::lock_guard lock{busy_mutex};
+    busy_worlds.erase(&world);
+}
+
+void check_idle(const World& world)
+{
+    std::lock_guard lock{busy_mutex};
+    if(busy_worlds.contains(&world))
+        throw PyException(PYUIPC_MSG("An async advance of this world is pending, wait for it first."));
+}
+}  // namespace
+
+/**
+ * @brief The result of `World.advance_async()`.
+ *
+ * The worker thread advances, syncs and retrieves the world, then clones the scene geometries
+ * into this future. The clones share attribute buffers copy-on-write, so keeping the future of
+ * frame N alive while frame N+1 is simulated gives a cheap double-buffered retrieve.
+ *
+ * Until the worker is done, the world refuses any other call and the scene is locked to the worker
+ * thread, so changes from other threads throw.
+ */
+class WorldFuture
+{
+  public:
+    WorldFuture(World& world)
+        : m_world(world)
+    {
+        mark_busy(world);
+
+        std::promise<void> locked;
+        auto               locked_future = locked.get_future();
+        try
+        {
+            m_future = std::async(std::launch::async,
+                                  [this, locked = std::move(locked)]() mutable
+                                  { run(locked); });
+        }
+        catch(...)
+        {
+            unmark_busy(world);
+            throw;
+        }
+        // the scene must be locked before the caller can touch it again
+        locked_future.wait();
+    }
+
+    ~WorldFuture()
+    {
+        // never leave a running worker behind, the worker may need the GIL for animation callbacks
+        if(m_future.valid())
+        {
+            if(PyGILState_Check())
+            {
+                py::gil_scoped_release release;
+                m_future.wait();
+            }
+            else
+                m_future.wait();
+        }
+    }
+
+    /**
+     * @brief Wait for the worker, rethrow its exception, if any, on every call.
+     */
+    void wait() const
+    {
+        m_future.wait();
+        if(m_exception)
+            std::rethrow_exception(m_exception);
+    }
+
+    bool done() const
+    {
+        return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    SizeT frame() const noexcept { return m_frame; }
+
+    const vector<S<geometry::GeometrySlot>>& geometries() const noexcept
+    {
+        return m_geometries;
+    }
+
+  private:
+    void run(std::promise<void>& locked)
+    {
+        uipc::backend::WorldVisitor visitor{m_world};
+        bool                        has_scene = visitor.has_scene();
+        if(has_scene)
+            visitor.scene().lock();
+        locked.set_value();
+
+        try
+        {
+            m_world.advance();
+            m_world.sync();
+            m_world.retrieve();
+
+            m_frame = m_world.frame();
+
+            if(has_scene)
+            {
+                auto slots = visitor.scene().geometries();
+                m_geometries.reserve(slots.size());
+                for(auto& slot : slots)
+                    m_geometries.push_back(slot->clone());
+            }
+        }
+        catch(...)
+        {
+            m_exception = std::current_exception();
+        }
+
+        if(has_scene)
+            visitor.scene().unlock();
+        unmark_busy(m_world);
+    }
+
+    World&                            m_world;
+    std::shared_future<void>          m_future;
+    std::exception_ptr                m_exception;
+    SizeT                             m_frame = 0;
+    vector<S<geometry::GeometrySlot>> m_geometries;
+};
+
 PyWorld::PyWorld(py::module& m)
 {
+    auto class_WorldFuture = py::class_<WorldFuture, S<WorldFuture>>(m, "WorldFuture");
+
+    class_WorldFuture
+        .def("wait", &WorldFuture::wait, py::call_guard<py::gil_scoped_release>())
+        .def("done", &WorldFuture::done)
+        .def("frame",
+             [](WorldFuture& self)
+             {
+                 {
+                     py::gil_scoped_release release;
+                     self.wait();
+                 }
+                 return self.frame();
+             })
+        .def("geometries",
+             [](WorldFuture& self) -> py::list
+             {
+                 {
+                     py::gil_scoped_release release;
+                     self.wait();
+                 }
+                 py::list list;
+                 for(auto& slot : self.geometries())
+                     list.append(py::cast(slot));
+                 return list;
+             });
+
     auto class_World = py::class_<World>(m, "World");
 
+    // The physics step never touches Python objects except through the animation callbacks,
+    // which re-acquire the GIL themselves, so we release it to keep the host threads running.
     class_World.def(py::init<Engine&>())
-        .def("init", &World::init, py::arg("scene"))
-        .def("advance", &World::advance)
-        .def("sync", &World::sync)
-        .def("retrieve", &World::retrieve)
-        .def("dump", &World::dump)
-        .def("recover", &World::recover, py::arg("dst_frame") = ~0ull)
-        .def("backward", &World::backward)
+        .def(
+            "init",
+            [](World& self, Scene& scene)
+            {
+                check_idle(self);
+                self.init(scene);
+            },
+            py::arg("scene"))
+        .def(
+            "advance",
+            [](World& self)
+            {
+                check_idle(self);
+                self.advance();
+            },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "sync",
+            [](World& self)
+            {
+                check_idle(self);
+                self.sync();
+            },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "retrieve",
+            [](World& self)
+            {
+                check_idle(self);
+                self.retrieve();
+            },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "dump",
+            [](World& self)
+            {
+                check_idle(self);
+                return self.dump();
+            },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "recover",
+            [](World& self, SizeT dst_frame)
+            {
+                check_idle(self);
+                return self.recover(dst_frame);
+            },
+            py::arg("dst_frame") = ~0ull,
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "backward",
+            [](World& self)
+            {
+                check_idle(self);
+                self.backward();
+            },
+            py::call_guard<py::gil_scoped_release>())
+        .def(
+            "advance_async",
+            [](World& self) { return uipc::make_shared<WorldFuture>(self); },
+            py::keep_alive<0, 1>(),
+            R"(Advance, sync and retrieve one frame on a worker thread.
+
+Until the returned future is done, the other calls of the world raise, and so do changes of the scene
+(creating or destroying objects and geometries, retagging objects) from any thread but the worker.
+`wait()` can be called any number of times, it raises the exception of the worker, if any, every time.
+The geometries of the future are a snapshot of the frame, which stays valid while the next frame is simulated.)")
         .def("frame", &World::frame)
         .def("features", &World::features, py::return_value_policy::reference_internal)
         .def("is_valid", &World::is_valid);
@@ -0,0 +1,48 @@
+#include <pyuipc/diff_sim/adjoint_solver.h>
+#include <uipc/diff_sim/adjoint_solver.h>
+#include <pybind11/eigen.h>
+
+namespace pyuipc::diff_sim
+{
+using namespace uipc::diff_sim;
+
+PyAdjointSolver::PyAdjointSolver(py::module& m)
+{
+    auto class_AdjointSolver = py::class_<AdjointSolver>(m, "AdjointSolver");
+
+    py::enum_<AdjointSolver::Method>(class_AdjointSolver, "Method")
+        .value("LU", AdjointSolver::Method::LU)
+        .value("LDLT", AdjointSolver::Method::LDLT)
+        .export_values();
+
+    class_AdjointSolver.def(py::init<AdjointSolver::Method>(),
+                            py::arg("method") = AdjointSolver::Method::LU);
+
+    // the heavy calls don't touch Python objects, release the GIL
+    class_AdjointSolver.def("factorize",
+                            &AdjointSolver::factorize,
+                            py::arg("H"),
+                            py::call_guard<py::gil_scoped_release>());
+
+    class_AdjointSolver.def("solve",
+                            &AdjointSolver::solve,
+                            py::arg("dLdX"),
+                            py::call_guard<py::gil_scoped_release>());
+
+    class_AdjointSolver.def("compute_dLdP",
+                            &AdjointSolver::compute_dLdP,
+                            py::arg("pGpP"),
+                            py::arg("lambda"),
+                            py::call_guard<py::gil_scoped_release>());
+
+    class_AdjointSolver.def("solve_dLdP",
+                            &AdjointSolver::solve_dLdP,
+                            py::arg("pGpP"),
+                            py::arg("dLdX"),
+                            py::call_guard<py::gil_scoped_release>());
+
+    class_AdjointSolver.def("method", &AdjointSolver::method);
+    class_AdjointSolver.def("analyze_count", &AdjointSolver::analyze_count);
+    class_AdjointSolver.def("factorize_count", &AdjointSolver::factorize_count);
+}
+}  // namespace pyuipc::diff_sim
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::diff_sim
+{
+class PyAdjointSolver
+{
+  public:
+    PyAdjointSolver(py::module& m);
+};
+}  // namespace pyuipc::diff_sim
@@ -0,0 +1,57 @@
+#include <pyuipc/diff_sim/checkpointed_adjoint.h>
+#include <uipc/diff_sim/checkpointed_adjoint.h>
+#include <pybind11/functional.h>
+
+namespace pyuipc::diff_sim
+{
+using namespace uipc::diff_sim;
+
+PyCheckpointedAdjoint::PyCheckpointedAdjoint(py::module& m)
+{
+    auto class_CheckpointSchedule = py::class_<CheckpointSchedule>(m, "CheckpointSchedule");
+
+    py::enum_<CheckpointSchedule::ActionType>(class_CheckpointSchedule, "ActionType")
+        .value("Advance", CheckpointSchedule::ActionType::Advance)
+        .value("Dump", CheckpointSchedule::ActionType::Dump)
+        .value("Recover", CheckpointSchedule::ActionType::Recover)
+        .value("Backward", CheckpointSchedule::ActionType::Backward)
+        .value("Drop", CheckpointSchedule::ActionType::Drop)
+        .export_values();
+
+    class_CheckpointSchedule.def(py::init<SizeT, SizeT>(),
+                                 py::arg("frame_count"),
+                                 py::arg("checkpoint_count"));
+
+    class_CheckpointSchedule.def("actions",
+                                 [](const CheckpointSchedule& self)
+                                 {
+                                     py::list list;
+                                     for(auto&& action : self.actions())
+                                         list.append(py::make_tuple(action.type, action.frame));
+                                     return list;
+                                 });
+
+    class_CheckpointSchedule.def("frame_count", &CheckpointSchedule::frame_count);
+    class_CheckpointSchedule.def("checkpoint_count", &CheckpointSchedule::checkpoint_count);
+    class_CheckpointSchedule.def("advance_count", &CheckpointSchedule::advance_count);
+    class_CheckpointSchedule.def("peak_checkpoint_count",
+                                 &CheckpointSchedule::peak_checkpoint_count);
+
+    auto class_CheckpointedAdjoint = py::class_<CheckpointedAdjoint>(m, "CheckpointedAdjoint");
+
+    class_CheckpointedAdjoint.def(py::init<uipc::core::World&, SizeT>(),
+                                  py::arg("world"),
+                                  py::arg("frame_count"),
+                                  py::keep_alive<1, 2>());
+
+    // the callback re-acquires the GIL itself (pybind11/functional.h)
+    class_CheckpointedAdjoint.def("run",
+                                  &CheckpointedAdjoint::run,
+                                  py::arg("on_backward"),
+                                  py::call_guard<py::gil_scoped_release>());
+
+    class_CheckpointedAdjoint.def("schedule",
+                                  &CheckpointedAdjoint::schedule,
+                                  py::return_value_policy::reference_internal);
+}
+}  // namespace pyuipc::diff_sim
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::diff_sim
+{
+class PyCheckpointedAdjoint
+{
+  public:
+    PyCheckpointedAdjoint(py::module& m);
+};
+}  // namespace pyuipc::diff_sim
@@ -1,11 +1,15 @@
 #include <pyuipc/diff_sim/module.h>
 #include <pyuipc/diff_sim/sparse_coo_view.h>
 #include <pyuipc/diff_sim/parameter_collection.h>
+#include <pyuipc/diff_sim/checkpointed_adjoint.h>
+#include <pyuipc/diff_sim/adjoint_solver.h>
 namespace pyuipc::diff_sim
 {
 PyModule::PyModule(py::module& m)
 {
     PySparseCOOView{m};
     PyParameterCollection{m};
+    PyCheckpointedAdjoint{m};
+    PyAdjointSolver{m};
 }
 }  // namespace pyuipc::diff_sim
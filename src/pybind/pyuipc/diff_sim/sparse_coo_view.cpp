@@ -27,5 +27,7 @@ PySparseCOOView::PySparseCOOView(py::module& m)
     class_SparseCOOView.def("to_dense", &SparseCOOView::to_dense);
 
     class_SparseCOOView.def("to_sparse", &SparseCOOView::to_sparse);
+
+    class_SparseCOOView.def("to_csr", &SparseCOOView::to_csr);
 }
 }  // namespace pyuipc::diff_sim
@@ -32,5 +32,61 @@ PyFactory::PyFactory(py::module& m)
         { return ground(height, to_matrix<Vector3>(N)); },
         py::arg("height") = Float{0.0},
         py::arg("N")      = as_numpy(UnitY));
+
+    Vector3 Zero = Vector3::Zero();
+
+    m.def(
+        "sphere",
+        [](py::array_t<Float> P, Float radius)
+        { return sphere(to_matrix<Vector3>(P), radius); },
+        "Create a sphere. Host only: the cuda backend doesn't simulate contact with it.",
+        py::arg("P")      = as_numpy(Zero),
+        py::arg("radius") = Float{1.0});
+
+    m.def(
+        "capsule",
+        [](py::array_t<Float> P0, py::array_t<Float> P1, Float radius)
+        { return capsule(to_matrix<Vector3>(P0), to_matrix<Vector3>(P1), radius); },
+        "Create a capsule. Host only: the cuda backend doesn't simulate contact with it.",
+        py::arg("P0"),
+        py::arg("P1"),
+        py::arg("radius") = Float{1.0});
+
+    Vector3   Ones     = Vector3::Ones();
+    Matrix4x4 Identity = Matrix4x4::Identity();
+
+    m.def(
+        "box",
+        [](py::array_t<Float> half_extent, py::array_t<Float> transform)
+        {
+            return box(to_matrix<Vector3>(half_extent), to_matrix<Matrix4x4>(transform));
+        },
+        "Create an oriented box. Host only: the cuda backend doesn't simulate contact with it.",
+        py::arg("half_extent") = as_numpy(Ones),
+        py::arg("transform")   = as_numpy(Identity));
+
+    m.def(
+        "sdf_grid",
+        [](py::array_t<Float>       origin,
+           Float                    spacing,
+           py::array_t<IndexT>      resolution,
+           py::array_t<const Float> values,
+           Float                    narrow_band,
+           py::array_t<Float>       transform)
+        {
+            return sdf_grid(to_matrix<Vector3>(origin),
+                            spacing,
+                            to_matrix<Vector3i>(resolution),
+                            as_span<const Float>(values),
+                            narrow_band,
+                            to_matrix<Matrix4x4>(transform));
+        },
+        "Create a narrow-band SDF grid. Host only: the cuda backend doesn't simulate contact with it.",
+        py::arg("origin"),
+        py::arg("spacing"),
+        py::arg("resolution"),
+        py::arg("values"),
+        py::arg("narrow_band"),
+        py::arg("transform") = as_numpy(Identity));
 }
 }  // namespace pyuipc::geometry
@@ -0,0 +1,54 @@
+#include <pyuipc/geometry/geometry_asset_cache.h>
+#include <uipc/io/geometry_asset_cache.h>
+#include <pyuipc/as_numpy.h>
+#include <pybind11/functional.h>
+#include <Eigen/Geometry>
+
+namespace pyuipc::geometry
+{
+using namespace uipc::geometry;
+PyGeometryAssetCache::PyGeometryAssetCache(py::module& m)
+{
+    auto class_GeometryAssetCache =
+        py::class_<GeometryAssetCache>(m, "GeometryAssetCache");
+
+    class_GeometryAssetCache.def(py::init<std::string_view>(), py::arg("cache_dir"));
+
+    class_GeometryAssetCache.def(
+        py::init<>([](std::string_view cache_dir, const Transform& pre_transform)
+                   { return GeometryAssetCache(cache_dir, pre_transform); }),
+        py::arg("cache_dir"),
+        py::arg("pre_transform"));
+
+    class_GeometryAssetCache.def(
+        py::init<>(
+            [](std::string_view cache_dir, py::array_t<Float> pre_transform)
+            {
+                auto mat = to_matrix<Matrix4x4>(pre_transform);
+                return GeometryAssetCache(cache_dir, mat);
+            }),
+        py::arg("cache_dir"),
+        py::arg("pre_transform"));
+
+    class_GeometryAssetCache.def("read",
+                                 &GeometryAssetCache::read,
+                                 py::arg("file_name"),
+                                 py::arg("params")  = Json::object(),
+                                 py::arg("process") = GeometryAssetCache::Processor{});
+
+    class_GeometryAssetCache.def("key",
+                                 &GeometryAssetCache::key,
+                                 py::arg("file_name"),
+                                 py::arg("params") = Json::object());
+
+    class_GeometryAssetCache.def("contains",
+                                 &GeometryAssetCache::contains,
+                                 py::arg("file_name"),
+                                 py::arg("params") = Json::object());
+
+    class_GeometryAssetCache.def("clear", &GeometryAssetCache::clear);
+    class_GeometryAssetCache.def("cache_dir", &GeometryAssetCache::cache_dir);
+    class_GeometryAssetCache.def("hit_count", &GeometryAssetCache::hit_count);
+    class_GeometryAssetCache.def("miss_count", &GeometryAssetCache::miss_count);
+}
+}  // namespace pyuipc::geometry
@@ -0,0 +1,11 @@
+#pragma once
+#include <pyuipc/pyuipc.h>
+
+namespace pyuipc::geometry
+{
+class PyGeometryAssetCache
+{
+  public:
+    PyGeometryAssetCache(py::module& m);
+};
+}  // namespace pyuipc::geometry
@@ -14,6 +14,7 @@
 #include <pyuipc/geometry/implicit_geometry_slot.h>
 #include <pyuipc/geometry/simplicial_complex_io.h>
 #include <pyuipc/geometry/spread_sheet_io.h>
+#include <pyuipc/geometry/geometry_asset_cache.h>
 
 #include <pyuipc/geometry/utils.h>
 
@@ -39,6 +40,7 @@ PyModule::PyModule(py::module& m)
     PyAttributeIO{m};
     PySimplicialComplexIO{m};
     PySpreadSheetIO{m};
+    PyGeometryAssetCache{m};
     PyUtils{m};
 }
 }  // namespace pyuipc::geometry
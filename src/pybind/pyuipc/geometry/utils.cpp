@@ -1,6 +1,7 @@
 #include <pyuipc/geometry/utils.h>
 #include <pyuipc/as_numpy.h>
 #include <pyuipc/common/json.h>
+#include <pybind11/stl.h>
 #include <Eigen/Geometry>
 #include <uipc/geometry/utils.h>
 
@@ -32,6 +33,34 @@ static py::list list_of_sc(const vector<SimplicialComplex>& simplicial_complexes
     return list;
 }
 
+template <typename T>
+static void def_override_instance_attribute(py::module& m, bool convert)
+{
+    m.def(
+        "override_instance_attribute",
+        [](py::list clones, std::string_view name, py::array_t<T> values)
+        {
+            UIPC_ASSERT(values.ndim() == 1,
+                        "Values must be a 1D array, one value per clone, yours ndim={}",
+                        values.ndim());
+            UIPC_ASSERT(clones.size() == static_cast<SizeT>(values.size()),
+                        "Clone count ({}) mismatches value count ({}).",
+                        clones.size(),
+                        values.size());
+
+            auto V = values.template unchecked<1>();
+            for(SizeT i = 0; i < clones.size(); ++i)
+            {
+                auto& sc    = clones[i].cast<SimplicialComplex&>();
+                T     value = V(i);
+                override_instance_attribute<T>(span{&sc, 1}, name, span<const T>{&value, 1});
+            }
+        },
+        py::arg("clones"),
+        py::arg("name"),
+        py::arg("values").noconvert(!convert));
+}
+
 PyUtils::PyUtils(py::module& m)
 {
     m.def("label_surface", &label_surface);
@@ -66,6 +95,40 @@ PyUtils::PyUtils(py::module& m)
               return list;
           });
 
+    m.def(
+        "clone",
+        [](const SimplicialComplex& prototype, py::list transforms, const std::vector<std::string>& owned_vertex_attributes) -> py::list
+        {
+            vector<Matrix4x4> Ts;
+            Ts.reserve(transforms.size());
+            for(auto T : transforms)
+                Ts.push_back(to_matrix<Matrix4x4>(T.cast<py::array_t<Float>>()));
+
+            auto scs = clone(prototype, Ts, owned_vertex_attributes);
+            return list_of_sc(scs);
+        },
+        py::arg("prototype"),
+        py::arg("transforms"),
+        py::arg("owned_vertex_attributes") = std::vector<std::string>{});
+
+    m.def(
+        "instantiate",
+        [](const SimplicialComplex& prototype, py::list transforms)
+        {
+            vector<Matrix4x4> Ts;
+            Ts.reserve(transforms.size());
+            for(auto T : transforms)
+                Ts.push_back(to_matrix<Matrix4x4>(T.cast<py::array_t<Float>>()));
+
+            return instantiate(prototype, Ts);
+        },
+        py::arg("prototype"),
+        py::arg("transforms"));
+
+    // float arrays give Float attributes, the other arrays are converted to IndexT
+    def_override_instance_attribute<Float>(m, false);
+    def_override_instance_attribute<IndexT>(m, true);
+
     m.def("facet_closure", &facet_closure);
 
     m.def("label_connected_vertices", &label_connected_vertices);
@@ -98,5 +161,34 @@ PyUtils::PyUtils(py::module& m)
     m.def("optimal_transform",
           [](const SimplicialComplex& S, const SimplicialComplex& D)
           { return as_numpy(optimal_transform(S, D)); });
+
+    m.def("bake_sdf",
+          &bake_sdf,
+          py::arg("trimesh"),
+          py::arg("spacing"),
+          py::arg("narrow_band") = Float{0.0},
+          py::call_guard<py::gil_scoped_release>());
+
+    m.def("is_implicit_geometry_distance_supported", &is_implicit_geometry_distance_supported);
+
+    m.def(
+        "implicit_geometry_signed_distance",
+        [](const ImplicitGeometry& ig, IndexT instance_id, py::array_t<const Float> Vs) -> py::tuple
+        {
+            auto Vs_ = as_span_of<const Vector3>(Vs);
+
+            py::array_t<Float> distances(static_cast<py::ssize_t>(Vs_.size()));
+            py::array_t<Float> gradients({static_cast<py::ssize_t>(Vs_.size()), py::ssize_t{3}});
+            auto               ds    = as_span<Float>(distances);
+            auto               grads = as_span_of<Vector3>(gradients);
+            {
+                py::gil_scoped_release release;
+                implicit_geometry_signed_distance(ig, instance_id, Vs_, ds, grads);
+            }
+            return py::make_tuple(distances, gradients);
+        },
+        py::arg("implicit_geometry"),
+        py::arg("instance_id"),
+        py::arg("Vs"));
 }
 }  // namespace pyuipc::geometry
@@ -1,10 +1,12 @@
 #include <pyuipc/pyuipc.h>
 #include <uipc/common/uipc.h>
 #include <uipc/common/log.h>
+#include <uipc/common/parallel_for.h>
 #include <pyuipc/common/json.h>
 #include <pyuipc/common/unit.h>
 #include <pyuipc/common/uipc_type.h>
 #include <pyuipc/common/timer.h>
+#include <pyuipc/common/task_scheduler.h>
 #include <pyuipc/common/transform.h>
 #include <pyuipc/common/logger.h>
 
@@ -53,11 +55,17 @@ PYBIND11_MODULE(pyuipc, m)
     m.def("default_config", &uipc::default_config);
     m.def("config", &uipc::config);
 
+    m.def("set_parallel_thread_count", &uipc::set_parallel_thread_count, py::arg("count"));
+    m.def("parallel_thread_count", &uipc::parallel_thread_count);
+    m.def("set_deterministic", &uipc::set_deterministic, py::arg("value"));
+    m.def("is_deterministic", &uipc::is_deterministic);
+
 
     pyuipc::PyUIPCType{m};
     pyuipc::PyLogger{m};
     pyuipc::PyTransform{m};
     pyuipc::PyTimer{m};
+    pyuipc::PyTaskScheduler{m};
 
     // pyuipc.unit
     pyuipc::PyUnit{unit};
@@ -0,0 +1,16 @@
+#pragma once
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/common/span.h>
+
+namespace uipc::sanity_check
+{
+/**
+ * @brief Extract the vertices marked as too close (and the edges and triangles among them) from the scene surface,
+ * for the users to locate the problem.
+ * 
+ * @param scene_surface The scene simplicial surface
+ * @param vertex_is_too_close 1 if the vertex is too close, 0 otherwise
+ */
+geometry::SimplicialComplex create_close_mesh(const geometry::SimplicialComplex& scene_surface,
+                                              span<const IndexT> vertex_is_too_close);
+}  // namespace uipc::sanity_check
@@ -4,6 +4,7 @@
 #include <uipc/backend/visitors/geometry_visitor.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/backend/visitors/scene_visitor.h>
 #include <uipc/common/unordered_map.h>
 #include <uipc/geometry/utils/extract_surface.h>
@@ -89,14 +90,14 @@ namespace detail
                 switch(simplicial_complex->dim())
                 {
                     case 0:
-                        if(simplicial_complex->vertices().find<IndexT>(builtin::is_surf))
+                        if(simplicial_complex->vertices().find<IndexT>(builtin::key::is_surf))
                         {
                             simplicial_complex_has_surf.push_back(simplicial_complex);
                             surf_geo_ids.push_back(geo->id());
                         }
                         break;
                     case 1:
-                        if(simplicial_complex->edges().find<IndexT>(builtin::is_surf))
+                        if(simplicial_complex->edges().find<IndexT>(builtin::key::is_surf))
                         {
                             simplicial_complex_has_surf.push_back(simplicial_complex);
                             surf_geo_ids.push_back(geo->id());
@@ -104,7 +105,7 @@ namespace detail
                         break;
                     case 2:
                     case 3:
-                        if(simplicial_complex->triangles().find<IndexT>(builtin::is_surf))
+                        if(simplicial_complex->triangles().find<IndexT>(builtin::key::is_surf))
                         {
                             simplicial_complex_has_surf.push_back(simplicial_complex);
                             surf_geo_ids.push_back(geo->id());
@@ -235,9 +236,9 @@ namespace detail
 
                 // 1) Contact Element ID
                 auto contact_element_id =
-                    simplicial_complex->meta().find<IndexT>(builtin::contact_element_id);
+                    simplicial_complex->meta().find<IndexT>(builtin::key::contact_element_id);
                 auto v_is_surf =
-                    simplicial_complex->vertices().find<IndexT>(builtin::is_surf);
+                    simplicial_complex->vertices().find<IndexT>(builtin::key::is_surf);
 
                 IndexT CID        = 0;
                 bool   need_label = false;
@@ -9,9 +9,11 @@
 #include <uipc/geometry/utils/bvh.h>
 #include <uipc/geometry/utils/intersection.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/geometry/utils/distance.h>
 #include <uipc/common/map.h>
+#include <close_mesh.h>
 
 namespace std
 {
@@ -58,7 +60,7 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
             auto& geo = slot->geometry();
             if(geo.type() == builtin::ImplicitGeometry)
             {
-                auto uid = geo.meta().find<U64>(builtin::implicit_geometry_uid);
+                auto uid = geo.meta().find<U64>(builtin::key::implicit_geometry_uid);
 
                 UIPC_ASSERT(uid, "ImplicitGeometryUID not found, why can it happen?");
 
@@ -70,89 +72,6 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
         }
     }
 
-    geometry::SimplicialComplex create_close_mesh(const geometry::SimplicialComplex& scene_surface,
-                                                  const vector<IndexT>& vertex_is_too_close)
-    {
-        geometry::SimplicialComplex mesh;
-
-        // 1) Copy attributes
-        vector<SizeT> close_vertices;
-        {
-            close_vertices.reserve(vertex_is_too_close.size());
-
-            for(auto&& [I, is_close] : enumerate(vertex_is_too_close))
-            {
-                if(is_close)
-                {
-                    close_vertices.push_back(I);
-                }
-            }
-
-            mesh.vertices().resize(close_vertices.size());
-            mesh.vertices().copy_from(scene_surface.vertices(),
-                                      geometry::AttributeCopy::pull(close_vertices));
-        }
-
-
-        // 2) Find close edges and triangles
-        {
-            auto src_Es = scene_surface.edges().topo().view();
-            auto src_Fs = scene_surface.triangles().topo().view();
-
-            vector<SizeT> close_edges;
-            close_edges.reserve(src_Es.size());
-            for(auto&& [I, E] : enumerate(src_Es))
-            {
-                if(vertex_is_too_close[E[0]] && vertex_is_too_close[E[1]])
-                {
-                    close_edges.push_back(I);
-                }
-            }
-            mesh.edges().resize(close_edges.size());
-            mesh.edges().copy_from(scene_surface.edges(),
-                                   geometry::AttributeCopy::pull(close_edges));
-
-            vector<SizeT> close_triangles;
-            close_triangles.reserve(src_Fs.size());
-            for(auto&& [I, F] : enumerate(src_Fs))
-            {
-                if(vertex_is_too_close[F[0]] && vertex_is_too_close[F[1]]
-                   && vertex_is_too_close[F[2]])
-                {
-                    close_triangles.push_back(I);
-                }
-            }
-            mesh.triangles().resize(close_triangles.size());
-            mesh.triangles().copy_from(scene_surface.triangles(),
-                                       geometry::AttributeCopy::pull(close_triangles));
-        }
-
-        // 3) Remap the vertex indices in edges and triangles
-        {
-            vector<SizeT> vert_remap(scene_surface.vertices().size(), -1);
-            for(auto&& [I, V] : enumerate(close_vertices))
-            {
-                vert_remap[V] = I;
-            }
-
-            auto Map = [&]<IndexT N>(const Eigen::Vector<IndexT, N>& V) -> Eigen::Vector<IndexT, N>
-            {
-                auto ret = V;
-                for(auto& v : ret)
-                    v = vert_remap[v];
-                return ret;
-            };
-
-            auto edge_topo_view = view(mesh.edges().topo());
-            std::ranges::transform(edge_topo_view, edge_topo_view.begin(), Map);
-
-            auto tri_topo_view = view(mesh.triangles().topo());
-            std::ranges::transform(tri_topo_view, tri_topo_view.begin(), Map);
-        }
-
-        return mesh;
-    }
-
     virtual SanityCheckResult do_check(backend::SceneVisitor& scene,
                                        backend::SanityCheckMessageVisitor& msg) noexcept override
     {
@@ -195,7 +114,7 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
         UIPC_ASSERT(attr_v_object_id, "`sanity_check/object_id` is not found in scene surface");
         auto VObjectIds = attr_v_object_id->view();
 
-        auto attr_thickeness = scene_surface.vertices().find<Float>(builtin::thickness);
+        auto attr_thickeness = scene_surface.vertices().find<Float>(builtin::key::thickness);
         span<const Float> VThickness =
             attr_thickeness ? attr_thickeness->view() : span<const Float>{};  // default 0.0
 
@@ -230,7 +149,7 @@ class HalfPlaneVertexDistanceCheck final : public SanityChecker
             UIPC_ASSERT(attr_object_id, "`sanity_check/object_id` not found in half-plane");
             auto HObjectIds = attr_object_id->view();
 
-            auto attr_cid = halfplane->meta().find<IndexT>(builtin::contact_element_id);
+            auto attr_cid = halfplane->meta().find<IndexT>(builtin::key::contact_element_id);
             auto HCid = attr_cid ? attr_cid->view()[0] : 0;
 
 
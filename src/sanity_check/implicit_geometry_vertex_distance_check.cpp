@@ -0,0 +1,245 @@
+#include <uipc/core/contact_model.h>
+#include <context.h>
+#include <uipc/common/range.h>
+#include <uipc/geometry/simplicial_complex.h>
+#include <uipc/io/simplicial_complex_io.h>
+#include <sanity_checker.h>
+#include <uipc/backend/visitors/scene_visitor.h>
+#include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
+#include <uipc/builtin/geometry_type.h>
+#include <uipc/geometry/implicit_geometry.h>
+#include <uipc/geometry/utils/implicit_geometry_distance.h>
+#include <uipc/common/map.h>
+#include <close_mesh.h>
+
+namespace std
+{
+// Vector2i  set comparison
+template <>
+struct less<uipc::Vector2i>
+{
+    bool operator()(const uipc::Vector2i& lhs, const uipc::Vector2i& rhs) const
+    {
+        return lhs[0] < rhs[0] || (lhs[0] == rhs[0] && lhs[1] < rhs[1]);
+    }
+};
+}  // namespace std
+
+namespace uipc::sanity_check
+{
+/**
+ * @brief Check if any vertex is too close to the implicit colliders (Sphere, Capsule, Box, SDFGrid).
+ *
+ * HalfPlane is checked by HalfPlaneVertexDistanceCheck.
+ */
+class ImplicitGeometryVertexDistanceCheck final : public SanityChecker
+{
+  public:
+    constexpr static U64 SanityCheckerUID = 5;
+    constexpr static U64 HalfPlaneUID     = 1;  // ImplicitGeometryUID = 1
+    using SanityChecker::SanityChecker;
+
+  protected:
+    vector<geometry::ImplicitGeometry*> colliders;
+
+    virtual void build(backend::SceneVisitor& scene) override
+    {
+        auto enable_contact = scene.info()["contact"]["enable"].get<bool>();
+        if(!enable_contact)
+        {
+            throw SanityCheckerException("Contact is not enabled");
+        }
+    }
+
+    virtual U64 get_id() const noexcept override { return SanityCheckerUID; }
+
+    void collect_colliders(backend::SceneVisitor& scene)
+    {
+        auto geo_slots = scene.geometries();
+        for(auto& slot : geo_slots)
+        {
+            auto& geo = slot->geometry();
+            if(geo.type() == builtin::ImplicitGeometry)
+            {
+                auto& ig  = static_cast<geometry::ImplicitGeometry&>(geo);
+                auto  uid = ig.meta().find<U64>(builtin::key::implicit_geometry_uid);
+
+                UIPC_ASSERT(uid, "ImplicitGeometryUID not found, why can it happen?");
+
+                if(uid->view()[0] != HalfPlaneUID
+                   && geometry::is_implicit_geometry_distance_supported(ig))
+                {
+                    colliders.push_back(&ig);
+                }
+            }
+        }
+    }
+
+    virtual SanityCheckResult do_check(backend::SceneVisitor& scene,
+                                       backend::SanityCheckMessageVisitor& msg) noexcept override
+    {
+        collect_colliders(scene);
+
+        // no collider, no need to check
+        if(colliders.empty())
+            return SanityCheckResult::Success;
+
+        auto context = find<Context>();
+
+        const geometry::SimplicialComplex& scene_surface =
+            context->scene_simplicial_surface();
+
+        auto Vs = scene_surface.vertices().size() ? scene_surface.positions().view() :
+                                                    span<const Vector3>{};
+
+        if(Vs.size() == 0)  // no need to check distance
+            return SanityCheckResult::Success;
+
+        auto attr_cids =
+            scene_surface.vertices().find<IndexT>("sanity_check/contact_element_id");
+        UIPC_ASSERT(attr_cids, "`sanity_check/contact_element_id` is not found in scene surface");
+        auto CIds = attr_cids->view();
+
+        auto attr_v_geo_ids =
+            scene_surface.vertices().find<IndexT>("sanity_check/geometry_id");
+        UIPC_ASSERT(attr_v_geo_ids, "`sanity_check/geometry_id` is not found in scene surface");
+        auto VGeoIds = attr_v_geo_ids->view();
+
+        auto attr_v_object_id =
+            scene_surface.vertices().find<IndexT>("sanity_check/object_id");
+        UIPC_ASSERT(attr_v_object_id, "`sanity_check/object_id` is not found in scene surface");
+        auto VObjectIds = attr_v_object_id->view();
+
+        auto attr_thickeness = scene_surface.vertices().find<Float>(builtin::key::thickness);
+        span<const Float> VThickness =
+            attr_thickeness ? attr_thickeness->view() : span<const Float>{};  // default 0.0
+
+        auto& contact_table = context->contact_tabular();
+
+        bool too_close = false;
+
+        // key: {geo_id_0, geo_id_1}, value: {obj_id_0, obj_id_1}
+        map<Vector2i, Vector2i> close_geo_ids;
+        // key: geo_id of the collider, value: name of the collider
+        map<IndexT, std::string_view> collider_names;
+
+        vector<IndexT> vertex_too_close(Vs.size(), 0);
+        vector<Float>  distances(Vs.size());
+
+        for(auto& collider : colliders)
+        {
+            auto instance_count = collider->instances().size();
+
+            auto attr_geo_id =
+                collider->instances().find<IndexT>("sanity_check/geometry_id");
+            UIPC_ASSERT(attr_geo_id, "`sanity_check/geometry_id` not found in {}", collider->name());
+            auto IGeoIds = attr_geo_id->view();
+
+            auto attr_object_id =
+                collider->instances().find<IndexT>("sanity_check/object_id");
+            UIPC_ASSERT(attr_object_id, "`sanity_check/object_id` not found in {}", collider->name());
+            auto IObjectIds = attr_object_id->view();
+
+            auto attr_cid = collider->meta().find<IndexT>(builtin::key::contact_element_id);
+            auto ICid     = attr_cid ? attr_cid->view()[0] : 0;
+
+            for(auto I : range(instance_count))
+            {
+                // all the vertices against one instance in a batch
+                geometry::implicit_geometry_signed_distance(*collider, I, Vs, distances);
+
+                for(auto vI : range(Vs.size()))
+                {
+                    const auto& CM = contact_table.at(ICid, CIds[vI]);
+
+                    if(!CM.is_enabled())  // if unenabled, skip
+                        continue;
+
+                    auto V_thickness = VThickness.size() ? VThickness[vI] : 0.0;
+
+                    auto d = distances[vI] - V_thickness;
+
+                    if(d <= 0)  // too close
+                    {
+                        too_close = true;
+
+                        auto geo_id_0 = VGeoIds[vI];
+                        auto geo_id_1 = IGeoIds[I];
+
+                        auto obj_id_0 = VObjectIds[vI];
+                        auto obj_id_1 = IObjectIds[I];
+
+                        close_geo_ids[{geo_id_0, geo_id_1}] = {obj_id_0, obj_id_1};
+                        collider_names[geo_id_1]            = collider->name();
+
+                        vertex_too_close[vI] = 1;
+                    }
+                }
+            }
+        }
+
+        if(too_close)
+        {
+            auto& buffer = msg.message();
+
+            for(auto& [GeoIds, ObjIds] : close_geo_ids)
+            {
+                auto obj_0 = objects().find(ObjIds[0]);
+                auto obj_1 = objects().find(ObjIds[1]);
+
+                UIPC_ASSERT(obj_0 != nullptr, "Object[{}] not found", ObjIds[0]);
+                UIPC_ASSERT(obj_1 != nullptr, "Object[{}] not found", ObjIds[1]);
+
+                fmt::format_to(std::back_inserter(buffer),
+                               "Geometry({}) in Object[{}({})] is too close (distance <= 0) to {}({}) in "
+                               "Object[{}({})]\n",
+                               GeoIds[0],
+                               obj_0->name(),
+                               obj_0->id(),
+                               collider_names[GeoIds[1]],
+                               GeoIds[1],
+                               obj_1->name(),
+                               obj_1->id());
+            }
+
+            auto close_mesh = create_close_mesh(scene_surface, vertex_too_close);
+
+            fmt::format_to(std::back_inserter(buffer),
+                           "Close mesh has {} vertices, {} edges, {} triangles.\n",
+                           close_mesh.vertices().size(),
+                           close_mesh.edges().size(),
+                           close_mesh.triangles().size());
+
+            std::string name = "close_mesh";
+
+            if(scene.info()["sanity_check"]["mode"] == "normal")
+            {
+                auto output_path = this_output_path();
+                namespace fs     = std::filesystem;
+                fs::path path{output_path};
+                path /= fmt::format("{}.obj", name);
+                auto path_str = path.string();
+
+                geometry::SimplicialComplexIO io;
+                io.write(path_str, close_mesh);
+                fmt::format_to(std::back_inserter(buffer), "Close mesh is saved at {}.\n", path_str);
+            }
+
+            fmt::format_to(std::back_inserter(buffer),
+                           "Create mesh [{}<{}>] for post-processing.",
+                           name,
+                           close_mesh.type());
+
+            msg.geometries()[name] =
+                uipc::make_shared<geometry::SimplicialComplex>(std::move(close_mesh));
+
+            return SanityCheckResult::Error;
+        }
+
+        return SanityCheckResult::Success;
+    };
+};
+
+REGISTER_SANITY_CHECKER(ImplicitGeometryVertexDistanceCheck);
+}  // namespace uipc::sanity_check
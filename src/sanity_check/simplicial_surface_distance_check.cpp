@@ -8,6 +8,7 @@
 #include <uipc/geometry/utils/bvh.h>
 #include <uipc/geometry/utils/intersection.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/common/map.h>
 #include <uipc/geometry/utils/distance.h>
 #include <uipc/geometry/utils/octree.h>
@@ -192,7 +193,7 @@ class SimplicialSurfaceDistanceCheck final : public SanityChecker
         UIPC_ASSERT(attr_v_object_id, "`sanity_check/object_id` is not found in scene surface");
         auto VObjectIds = attr_v_object_id->view();
 
-        auto attr_v_thickness = scene_surface.vertices().find<Float>(builtin::thickness);
+        auto attr_v_thickness = scene_surface.vertices().find<Float>(builtin::key::thickness);
         auto VThickness =
             attr_v_thickness ? attr_v_thickness->view() : span<const Float>{};
 
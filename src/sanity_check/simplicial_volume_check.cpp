@@ -8,6 +8,7 @@
 #include <uipc/geometry/utils/bvh.h>
 #include <uipc/geometry/utils/intersection.h>
 #include <uipc/builtin/attribute_name.h>
+#include <uipc/builtin/attribute_key.h>
 #include <uipc/common/map.h>
 #include <uipc/builtin/geometry_type.h>
 #include <uipc/builtin/constitution_type.h>
@@ -58,7 +59,7 @@ class SimplicialVolumeCheck final : public SanityChecker
             auto sc = geo.as<geometry::SimplicialComplex>();
             UIPC_ASSERT(sc, "Cannot cast to simplicial complex, why can this happen?");
 
-            auto cuid = sc->meta().find<U64>(builtin::constitution_uid);
+            auto cuid = sc->meta().find<U64>(builtin::key::constitution_uid);
             if(!cuid)
                 continue;
 
@@ -69,7 +70,7 @@ class SimplicialVolumeCheck final : public SanityChecker
 
             if(uid_info.type == builtin::FiniteElement)
             {
-                auto volume      = sc->vertices().find<Float>(builtin::volume);
+                auto volume      = sc->vertices().find<Float>(builtin::key::volume);
                 auto volume_view = volume->view();
                 auto min_elem =
                     std::min_element(volume_view.begin(), volume_view.end());
@@ -83,7 +84,7 @@ class SimplicialVolumeCheck final : public SanityChecker
             else if(uid_info.type == builtin::AffineBody)
             {
 
-                auto volume      = sc->instances().find<Float>(builtin::volume);
+                auto volume      = sc->instances().find<Float>(builtin::key::volume);
                 auto volume_view = volume->view();
                 auto min_elem =
                     std::min_element(volume_view.begin(), volume_view.end());